@@ -11,6 +11,9 @@
 
 #include <diy/master.hpp>
 
+#include <cstdint>
+#include <cstring>
+
 #include <apcomp/absorption_partial.hpp>
 #include <apcomp/emission_partial.hpp>
 #include <apcomp/volume_partial.hpp>
@@ -90,9 +93,167 @@ struct AddBlock
 
 } //namespace apcomp
 
+//-------------------------------Half Precision Helpers---------------------------------------
+namespace apcomp {
+namespace detail {
+
+// float to IEEE half, round to nearest. Colors and alpha of volume
+// partials are in [0,1], so the half range is more than enough
+inline uint16_t float_to_half(const float value)
+{
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  const uint32_t sign = (bits >> 16) & 0x8000u;
+  const int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xffu) - 127 + 15;
+  uint32_t mantissa = bits & 0x7fffffu;
+
+  if(exponent <= 0)
+  {
+    // too small for a normal half, flush to a subnormal or zero
+    if(exponent < -10)
+    {
+      return static_cast<uint16_t>(sign);
+    }
+    mantissa |= 0x800000u;
+    const int shift = 14 - exponent;
+    uint32_t half = mantissa >> shift;
+    if((mantissa >> (shift - 1)) & 1u)
+    {
+      half++;
+    }
+    return static_cast<uint16_t>(sign | half);
+  }
+  else if(exponent >= 31)
+  {
+    // clamp to infinity
+    return static_cast<uint16_t>(sign | 0x7c00u);
+  }
+
+  uint32_t half = sign | (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+  // round to nearest, a carry into the exponent is still correct
+  if(mantissa & 0x1000u)
+  {
+    half++;
+  }
+  return static_cast<uint16_t>(half);
+}
+
+inline float half_to_float(const uint16_t value)
+{
+  const uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+  uint32_t exponent = (value >> 10) & 0x1fu;
+  uint32_t mantissa = value & 0x3ffu;
+  uint32_t bits;
+
+  if(exponent == 0)
+  {
+    if(mantissa == 0)
+    {
+      bits = sign;
+    }
+    else
+    {
+      // subnormal half, normalize
+      exponent = 127 - 15 + 1;
+      while((mantissa & 0x400u) == 0)
+      {
+        mantissa <<= 1;
+        exponent--;
+      }
+      mantissa &= 0x3ffu;
+      bits = sign | (exponent << 23) | (mantissa << 13);
+    }
+  }
+  else if(exponent == 31)
+  {
+    bits = sign | 0x7f800000u | (mantissa << 13);
+  }
+  else
+  {
+    bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+  }
+
+  float res;
+  std::memcpy(&res, &bits, sizeof(res));
+  return res;
+}
+
+// compact wire format for volume partials, 16 bytes instead of 24
+struct VolumePartialWire
+{
+  int32_t  m_pixel_id;
+  float    m_depth;
+  uint16_t m_rgba[4];
+};
+
+template<typename FloatType>
+inline void pack_volume_partial(const VolumePartial<FloatType> &partial,
+                                VolumePartialWire &wire)
+{
+  wire.m_pixel_id = partial.m_pixel_id;
+  wire.m_depth = partial.m_depth;
+  wire.m_rgba[0] = float_to_half(partial.m_pixel[0]);
+  wire.m_rgba[1] = float_to_half(partial.m_pixel[1]);
+  wire.m_rgba[2] = float_to_half(partial.m_pixel[2]);
+  wire.m_rgba[3] = float_to_half(partial.m_alpha);
+}
+
+template<typename FloatType>
+inline void unpack_volume_partial(const VolumePartialWire &wire,
+                                  VolumePartial<FloatType> &partial)
+{
+  partial.m_pixel_id = wire.m_pixel_id;
+  partial.m_depth = wire.m_depth;
+  partial.m_pixel[0] = half_to_float(wire.m_rgba[0]);
+  partial.m_pixel[1] = half_to_float(wire.m_rgba[1]);
+  partial.m_pixel[2] = half_to_float(wire.m_rgba[2]);
+  partial.m_alpha = half_to_float(wire.m_rgba[3]);
+}
+
+} // namespace detail
+} // namespace apcomp
+
 //-------------------------------Serialization Specializations--------------------------------
 namespace apcompdiy {
 
+template<>
+struct Serialization<apcomp::VolumePartial<float>>
+{
+
+  static void save(BinaryBuffer& bb, const apcomp::VolumePartial<float> &partial)
+  {
+    apcomp::detail::VolumePartialWire wire;
+    apcomp::detail::pack_volume_partial(partial, wire);
+    bb.save_binary((const char*) &wire, sizeof(wire));
+  }
+
+  static void load(BinaryBuffer& bb, apcomp::VolumePartial<float> &partial)
+  {
+    apcomp::detail::VolumePartialWire wire;
+    bb.load_binary((char*) &wire, sizeof(wire));
+    apcomp::detail::unpack_volume_partial(wire, partial);
+  }
+};
+
+template<>
+struct Serialization<apcomp::VolumePartial<double>>
+{
+
+  static void save(BinaryBuffer& bb, const apcomp::VolumePartial<double> &partial)
+  {
+    apcomp::detail::VolumePartialWire wire;
+    apcomp::detail::pack_volume_partial(partial, wire);
+    bb.save_binary((const char*) &wire, sizeof(wire));
+  }
+
+  static void load(BinaryBuffer& bb, apcomp::VolumePartial<double> &partial)
+  {
+    apcomp::detail::VolumePartialWire wire;
+    bb.load_binary((char*) &wire, sizeof(wire));
+    apcomp::detail::unpack_volume_partial(wire, partial);
+  }
+};
+
 template<>
 struct Serialization<apcomp::AbsorptionPartial<double>>
 {
@@ -8,8 +8,14 @@
 #include <apcomp/apcomp.hpp>
 #include <algorithm>
 #include <assert.h>
+#include <cstdint>
+#include <cstring>
 #include <limits>
 
+#ifdef APCOMP_OPENMP_ENABLED
+#include <omp.h>
+#endif
+
 #ifdef APCOMP_PARALLEL
 #include <mpi.h>
 #include <apcomp/internal/apcomp_diy_partial_redistribute.hpp>
@@ -19,6 +25,132 @@
 namespace apcomp {
 namespace detail
 {
+
+// below this many partials std::sort is faster than the radix sort
+const int radix_sort_min_size = 1 << 14;
+
+//
+// maps a depth to an unsigned int that sorts in the same order
+//
+inline uint32_t depth_key(const float depth)
+{
+  uint32_t bits;
+  std::memcpy(&bits, &depth, sizeof(bits));
+  return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+//
+// Sorts partials by pixel id, then depth (the same order as the
+// partials' operator <). Keys and indices are kept in separate arrays
+// and sorted with a parallel LSD radix sort, the partials themselves
+// are only moved once at the end.
+//
+template<typename PartialType>
+void SortPartials(std::vector<PartialType> &partials,
+                  const int min_pixel)
+{
+  const int size = static_cast<int>(partials.size());
+  if(size < radix_sort_min_size)
+  {
+    std::sort(partials.begin(), partials.end());
+    return;
+  }
+
+  std::vector<uint64_t> keys(size);
+  std::vector<uint64_t> keys_tmp(size);
+  std::vector<int> ids(size);
+  std::vector<int> ids_tmp(size);
+
+#ifdef APCOMP_OPENMP_ENABLED
+  #pragma omp parallel for
+#endif
+  for(int i = 0; i < size; ++i)
+  {
+    const uint64_t pixel = static_cast<uint64_t>(partials[i].m_pixel_id - min_pixel);
+    keys[i] = (pixel << 32) | depth_key(static_cast<float>(partials[i].m_depth));
+    ids[i] = i;
+  }
+
+  int num_chunks = 1;
+#ifdef APCOMP_OPENMP_ENABLED
+  num_chunks = omp_get_max_threads();
+#endif
+  const int chunk_size = (size + num_chunks - 1) / num_chunks;
+  std::vector<int> offsets(num_chunks * 256);
+
+  for(int shift = 0; shift < 64; shift += 8)
+  {
+    std::fill(offsets.begin(), offsets.end(), 0);
+#ifdef APCOMP_OPENMP_ENABLED
+    #pragma omp parallel for
+#endif
+    for(int c = 0; c < num_chunks; ++c)
+    {
+      const int begin = c * chunk_size;
+      const int end = std::min(size, begin + chunk_size);
+      int *counts = &offsets[c * 256];
+      for(int i = begin; i < end; ++i)
+      {
+        counts[(keys[i] >> shift) & 0xff]++;
+      }
+    }
+
+    // exclusive scan in digit major order, so each chunk scatters
+    // into its own stable range of each bucket
+    bool single_bucket = false;
+    int sum = 0;
+    for(int d = 0; d < 256; ++d)
+    {
+      int bucket_size = 0;
+      for(int c = 0; c < num_chunks; ++c)
+      {
+        const int count = offsets[c * 256 + d];
+        offsets[c * 256 + d] = sum;
+        sum += count;
+        bucket_size += count;
+      }
+      if(bucket_size == size)
+      {
+        single_bucket = true;
+      }
+    }
+
+    // every key has the same digit, nothing moves in this pass
+    if(single_bucket)
+    {
+      continue;
+    }
+
+#ifdef APCOMP_OPENMP_ENABLED
+    #pragma omp parallel for
+#endif
+    for(int c = 0; c < num_chunks; ++c)
+    {
+      const int begin = c * chunk_size;
+      const int end = std::min(size, begin + chunk_size);
+      int *bucket_offsets = &offsets[c * 256];
+      for(int i = begin; i < end; ++i)
+      {
+        const int dest = bucket_offsets[(keys[i] >> shift) & 0xff]++;
+        keys_tmp[dest] = keys[i];
+        ids_tmp[dest] = ids[i];
+      }
+    }
+    keys.swap(keys_tmp);
+    ids.swap(ids_tmp);
+  }
+
+  std::vector<PartialType> sorted(size);
+#ifdef APCOMP_OPENMP_ENABLED
+  #pragma omp parallel for
+#endif
+  for(int i = 0; i < size; ++i)
+  {
+    sorted[i] = std::move(partials[ids[i]]);
+  }
+  partials.swap(sorted);
+}
+
 template<template <typename> class PartialType, typename FloatType>
 void BlendPartials(const int &total_segments,
                    const int &total_partial_comps,
@@ -38,21 +170,15 @@ void BlendPartials(const int &total_segments,
     int current_index = pixel_work_ids[i];
     PartialType<FloatType> result = partials[current_index];
     ++current_index;
-    PartialType<FloatType> next = partials[current_index];
-    // TODO: we could just count the amount of work and make this a for loop(vectorize??)
-    while(result.m_pixel_id == next.m_pixel_id)
+    // we could break early for volumes,
+    // but blending past 1.0 alpha is no op.
+    while(current_index < total_partial_comps &&
+          partials[current_index].m_pixel_id == result.m_pixel_id)
     {
-      result.blend(next);
-      if(current_index + 1 >= total_partial_comps)
-      {
-        // we could break early for volumes,
-        // but blending past 1.0 alpha is no op.
-        break;
-      }
+      result.blend(partials[current_index]);
       ++current_index;
-      next = partials[current_index];
     }
-    output_partials[output_offset + i] = result;
+    output_partials[output_offset + i] = std::move(result);
   }
 
   //placeholder
@@ -81,19 +207,13 @@ BlendEmission(const int &total_segments,
     int current_index = pixel_work_ids[i];
     EmissionPartial<T> result = partials[current_index];
     ++current_index;
-    EmissionPartial<T> next = partials[current_index];
-    // TODO: we could just count the amount of work and make this a for loop(vectorize??)
-    while(result.m_pixel_id == next.m_pixel_id)
+    while(current_index < total_partial_comps &&
+          partials[current_index].m_pixel_id == result.m_pixel_id)
     {
-      result.blend_absorption(next);
-      if(current_index == total_partial_comps - 1)
-      {
-        break;
-      }
+      result.blend_absorption(partials[current_index]);
       ++current_index;
-      next = partials[current_index];
     }
-    output_partials[output_offset + i] = result;
+    output_partials[output_offset + i] = std::move(result);
   }
 
   //placeholder
@@ -207,7 +327,7 @@ PartialCompositor<PartialType>::~PartialCompositor()
 
 template<typename PartialType>
 void
-PartialCompositor<PartialType>::merge(const std::vector<std::vector<PartialType>> &in_partials,
+PartialCompositor<PartialType>::merge(std::vector<std::vector<PartialType>> &in_partials,
                                std::vector<PartialType> &partials,
                                int &global_min_pixel,
                                int &global_max_pixel)
@@ -215,9 +335,7 @@ PartialCompositor<PartialType>::merge(const std::vector<std::vector<PartialType>
 
   int total_partial_comps = 0;
   const int num_partial_images = static_cast<int>(in_partials.size());
-  int *offsets = new int[num_partial_images];
-  int *pixel_mins =  new int[num_partial_images];
-  int *pixel_maxs =  new int[num_partial_images];
+  std::vector<int> offsets(num_partial_images);
 
   for(int i = 0; i < num_partial_images; ++i)
   {
@@ -225,18 +343,27 @@ PartialCompositor<PartialType>::merge(const std::vector<std::vector<PartialType>
     total_partial_comps += in_partials[i].size();
   }
 
-  partials.resize(total_partial_comps);
+  if(num_partial_images == 1)
+  {
+    // nothing to merge, take the input as is
+    partials.swap(in_partials[0]);
+  }
+  else
+  {
+    partials.resize(total_partial_comps);
 
 #ifdef APCOMP_OPENMP_ENABLED
-  #pragma omp parallel for
+    #pragma omp parallel for
 #endif
-  for(int i = 0; i < num_partial_images; ++i)
-  {
-    //
-    //  Extract the partial composites into a contiguous array
-    //
-    std::copy(in_partials[i].begin(), in_partials[i].end(), partials.begin() + offsets[i]);
-  }// for each partial image
+    for(int i = 0; i < num_partial_images; ++i)
+    {
+      //
+      //  Move the partial composites into a contiguous array
+      //
+      std::move(in_partials[i].begin(), in_partials[i].end(), partials.begin() + offsets[i]);
+      std::vector<PartialType>().swap(in_partials[i]);
+    }// for each partial image
+  }
 
   //
   // Calculate the range of pixel ids
@@ -285,10 +412,6 @@ PartialCompositor<PartialType>::merge(const std::vector<std::vector<PartialType>
   global_max_pixel = mpi_max;
 #endif
 
-  delete[] offsets;
-  delete[] pixel_mins;
-  delete[] pixel_maxs;
-
 }
 
 //--------------------------------------------------------------------------------------------
@@ -298,15 +421,23 @@ PartialCompositor<PartialType>::composite_partials(std::vector<PartialType> &par
                                             std::vector<PartialType> &output_partials)
 {
   const int total_partial_comps = partials.size();
-  if(total_partial_comps == 0)
+  if(total_partial_comps < 2)
   {
-    output_partials = partials;
+    output_partials.swap(partials);
     return;
   }
   //
   // Sort the composites
   //
-  std::sort(partials.begin(), partials.end());
+  int min_pixel = std::numeric_limits<int>::max();
+#ifdef APCOMP_OPENMP_ENABLED
+  #pragma omp parallel for reduction(min:min_pixel)
+#endif
+  for(int i = 0; i < total_partial_comps; ++i)
+  {
+    min_pixel = std::min(min_pixel, partials[i].m_pixel_id);
+  }
+  detail::SortPartials(partials, min_pixel);
   //
   // Find the number of unique pixel_ids with work
   //
@@ -436,8 +567,7 @@ PartialCompositor<PartialType>::composite_partials(std::vector<PartialType> &par
 #endif
   for(int i = 0; i < total_unique_pixels; ++i)
   {
-    PartialType result = partials[unique_ids[i]];
-    output_partials[i] = result;
+    output_partials[i] = std::move(partials[unique_ids[i]]);
   }
 
   //
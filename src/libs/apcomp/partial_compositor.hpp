@@ -25,13 +25,15 @@ class APCOMP_API PartialCompositor
 public:
   PartialCompositor();
   ~PartialCompositor();
+  // note: the contents of partial_images are moved into the
+  // compositor and are left empty
   void
   composite(std::vector<std::vector<PartialType>> &partial_images,
             std::vector<PartialType> &output_partials);
   void set_background(std::vector<float> &background_values);
   void set_background(std::vector<double> &background_values);
 protected:
-  void merge(const std::vector<std::vector<PartialType>> &in_partials,
+  void merge(std::vector<std::vector<PartialType>> &in_partials,
              std::vector<PartialType> &partials,
              int &global_min_pixel,
              int &global_max_pixel);
@@ -250,7 +250,10 @@ std::shared_ptr<dray::Collection> DataObject::as_dray_collection()
       const int domains = low_order->number_of_children();
       for(int i = 0; i < domains; ++i)
       {
-        dray::DataSet dset = dray::BlueprintReader::blueprint_to_dray(low_order->child(i));
+        // fields are borrowed from the low order data instead of copied,
+        // the collection keeps it alive
+        dray::DataSet dset = dray::BlueprintReader::blueprint_to_dray(low_order->child(i),
+                                                                      low_order);
         collection->add_domain(dset);
       }
 
@@ -1375,6 +1375,16 @@ initialize_functions()
 
   //---------------------------------------------------------------------------
 
+  conduit::Node &field_divergence_sig = (*functions)["divergence"].append();
+  field_divergence_sig["return_type"] = "jitable";
+  field_divergence_sig["filter_name"] = "expr_jit_mesh_field_divergence";
+  field_divergence_sig["args/field/type"] = "field";
+  field_divergence_sig["description"] =
+      "Return a derived field that is the divergence of a vector field.";
+  field_divergence_sig["jitable"];
+
+  //---------------------------------------------------------------------------
+
   conduit::Node &field_magnitude_sig = (*functions)["magnitude"].append();
   field_magnitude_sig["return_type"] = "jitable";
   field_magnitude_sig["filter_name"] = "expr_jit_mesh_field_vector_magnitude";
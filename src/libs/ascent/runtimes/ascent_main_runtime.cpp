@@ -17,6 +17,10 @@
 // standard lib includes
 #include <string.h>
 #include <algorithm>
+#include <limits>
+#include <map>
+#include <set>
+#include <vector>
 
 //-----------------------------------------------------------------------------
 // thirdparty includes
@@ -39,6 +43,8 @@
 #include <ascent_actions_utils.hpp>
 #include <ascent_metadata.hpp>
 #include <ascent_runtime_filters.hpp>
+#include <ascent_runtime_utils.hpp>
+#include <ascent_runtime_blueprint_filters.hpp>
 #include <ascent_expression_eval.hpp>
 #include <expressions/ascent_blueprint_architect.hpp>
 #include <expressions/ascent_memory_manager.hpp>
@@ -46,12 +52,16 @@
 #include <ascent_transmogrifier.hpp>
 #include <ascent_data_object.hpp>
 #include <ascent_data_logger.hpp>
+#include <ascent_mpi_utils.hpp>
 
 #if defined(ASCENT_VTKM_ENABLED)
 #include <vtkm/cont/Error.h>
 #include <vtkh/vtkh.hpp>
 #include <vtkh/Error.hpp>
 #include <vtkh/Logger.hpp>
+#include <vtkh/filters/BlockRanges.hpp>
+#include <vtkh/filters/GhostStripper.hpp>
+#include <ascent_runtime_vtkh_filters.hpp>
 
 #ifdef VTKM_CUDA
 #include <vtkm/cont/cuda/ChooseCudaDevice.h>
@@ -60,6 +70,7 @@
 
 #if defined(ASCENT_DRAY_ENABLED)
 #include <dray/dray.hpp>
+#include <dray/utils/data_logger.hpp>
 #endif
 using namespace conduit;
 using namespace std;
@@ -92,6 +103,73 @@ class InfoHandler
 
 int InfoHandler::m_rank = 0;
 
+//-----------------------------------------------------------------------------
+namespace detail
+{
+
+// route the vtkh and dray data logs into flow::Trace
+#if defined(ASCENT_VTKM_ENABLED)
+class VTKHTraceSink : public vtkh::DataLogSink
+{
+public:
+  void Open(const std::string &entryName) override
+  {
+    flow::Trace::begin(entryName);
+  }
+  void Close() override
+  {
+    flow::Trace::end();
+  }
+  void Value(const std::string &key, const double value) override
+  {
+    flow::Trace::value(key, value);
+  }
+  void Text(const std::string &key, const std::string &value) override
+  {
+    flow::Trace::text(key, value);
+  }
+};
+#endif
+
+#if defined(ASCENT_DRAY_ENABLED)
+class DRayTraceSink : public dray::DataLogSink
+{
+public:
+  void open(const std::string &entryName) override
+  {
+    flow::Trace::begin(entryName);
+  }
+  void close() override
+  {
+    flow::Trace::end();
+  }
+  void value(const std::string &key, const double value) override
+  {
+    flow::Trace::value(key, value);
+  }
+  void text(const std::string &key, const std::string &value) override
+  {
+    flow::Trace::text(key, value);
+  }
+};
+#endif
+
+void
+set_trace_sinks(bool on)
+{
+#if defined(ASCENT_VTKM_ENABLED)
+  static VTKHTraceSink vtkh_sink;
+  vtkh::DataLogger::GetInstance()->SetSink(on ? &vtkh_sink : nullptr);
+#endif
+#if defined(ASCENT_DRAY_ENABLED)
+  static DRayTraceSink dray_sink;
+  dray::DataLogger::get_instance()->set_sink(on ? &dray_sink : nullptr);
+#endif
+  (void) on;
+}
+
+} // namespace detail
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 //
@@ -107,7 +185,9 @@ AscentRuntime::AscentRuntime()
  m_rank(0),
  m_default_output_dir("."),
  m_session_name("ascent_session"),
- m_field_filtering(false)
+ m_field_filtering(false),
+ m_trace(false),
+ m_jit_precompiled(0)
 {
     m_ghost_fields.append() = "ascent_ghosts";
     flow::filters::register_builtin();
@@ -343,6 +423,41 @@ AscentRuntime::Initialize(const conduit::Node &options)
       }
     }
 
+    // attributes memory to filters when memory_profile is on
+    flow::Workspace::set_memory_probe(AllocationManager::sample_memory);
+    bool reset_process_peak = false;
+    if(options.has_child("memory_profile_reset_peak"))
+    {
+      reset_process_peak = options["memory_profile_reset_peak"].as_string() == "true";
+    }
+    AllocationManager::set_reset_process_peak(reset_process_peak);
+
+    // regions of ascent, flow, vtkh and dray recorded into one trace
+#if defined(ASCENT_LOGGING_ENABLED)
+    m_trace = true;
+#endif
+    if(options.has_child("trace"))
+    {
+      m_trace = options["trace"].as_string() == "true";
+    }
+    if(m_trace)
+    {
+      index_t buffer_size = 1 << 20;
+      if(options.has_child("trace_buffer_size"))
+      {
+        buffer_size = options["trace_buffer_size"].to_index_t();
+        if(buffer_size < 1)
+        {
+          ASCENT_ERROR("'trace_buffer_size' must be greater than 0");
+        }
+      }
+      flow::Trace::set_rank(m_rank);
+      // the trace is process wide, if another instance is already
+      // tracing we join its trace (and keep its buffer size)
+      flow::Trace::acquire(buffer_size);
+      detail::set_trace_sinks(true);
+    }
+
     // standard flow filters
     flow::filters::register_builtin();
     // filters for ascent flow runtime.
@@ -358,6 +473,27 @@ AscentRuntime::Initialize(const conduit::Node &options)
     runtime::expressions::ExpressionEval::load_cache(m_default_output_dir,
                                                      m_session_name);
 
+#if defined(ASCENT_JIT_ENABLED)
+    // compiled kernels are kept on disk so later runs don't pay for
+    // compiling them again
+    if(options.has_path("jit/cache_dir"))
+    {
+      runtime::expressions::Jitable::set_cache_dir(
+        options["jit/cache_dir"].as_string());
+    }
+    else
+    {
+      runtime::expressions::Jitable::set_cache_dir(
+        conduit::utils::join_file_path(m_default_output_dir, ".occa"));
+    }
+
+    if(!options.has_path("jit/precompile") ||
+       options["jit/precompile"].as_string() != "false")
+    {
+      m_jit_precompiled = runtime::expressions::Jitable::precompile();
+    }
+#endif
+
     if(options.has_path("web/stream") &&
        options["web/stream"].as_string() == "true" &&
        m_rank == 0)
@@ -396,6 +532,7 @@ AscentRuntime::Initialize(const conduit::Node &options)
 void
 AscentRuntime::Info(conduit::Node &out)
 {
+    FinalizeInfo();
     out.set(m_info);
 }
 
@@ -403,6 +540,7 @@ AscentRuntime::Info(conduit::Node &out)
 conduit::Node &
 AscentRuntime::Info()
 {
+    FinalizeInfo();
     return m_info;
 }
 
@@ -413,7 +551,44 @@ AscentRuntime::ResetInfo()
     m_info.reset();
     m_info["runtime/type"] = "ascent";
     m_info["runtime/options"] = m_runtime_options;
+    m_info_finalized = false;
+}
+
+//-----------------------------------------------------------------------------
+void
+AscentRuntime::FinalizeInfo()
+{
+    if(m_info_finalized)
+    {
+        return;
+    }
+
     m_info["registered_filter_types"] = registered_filter_types();
+
+    // add flow graph details to info
+    if(!m_workspace.graph().filters().empty())
+    {
+        m_workspace.info(m_info["flow_graph"]);
+        m_info["flow_graph_dot"]      = m_workspace.graph().to_dot();
+        m_info["flow_graph_dot_html"] = m_workspace.graph().to_dot_html();
+    }
+
+    AllocationManager::memory_usage(m_info["memory"]);
+#if defined(ASCENT_JIT_ENABLED)
+    m_info["jit/precompiled_kernels"] = m_jit_precompiled;
+#endif
+    if(m_runtime_options.has_child("memory_profile") &&
+       m_runtime_options["memory_profile"].as_string() == "true")
+    {
+        m_workspace.last_memory_usage(m_info["memory/last_execute"]);
+    }
+    if(m_runtime_options.has_child("timings") &&
+       m_runtime_options["timings"].as_string() == "true")
+    {
+        m_workspace.last_timing_info(m_info["timings/last_execute"]);
+    }
+
+    m_info_finalized = true;
 }
 
 
@@ -502,6 +677,41 @@ AscentRuntime::Cleanup()
         ftimings << m_workspace.timing_info();
         ftimings.close();
     }
+    if(m_runtime_options.has_child("memory_profile") &&
+       m_runtime_options["memory_profile"].as_string() == "true")
+    {
+        // save out per filter memory info on close
+        std::stringstream fname;
+        fname << "ascent_filter_memory";
+
+#ifdef ASCENT_MPI_ENABLED
+        fname << "_" << m_rank;
+#endif
+        fname << ".csv";
+        std::ofstream fmemory;
+        std::string file_name = fname.str();
+        file_name = conduit::utils::join_file_path(m_default_output_dir,file_name);
+        fmemory.open(file_name, std::ofstream::out | std::ofstream::app);
+        fmemory << m_workspace.memory_info();
+        fmemory.close();
+    }
+#if defined(ASCENT_JIT_ENABLED)
+    runtime::expressions::Jitable::save_manifest();
+    runtime::expressions::clear_adjacency_cache();
+#endif
+#if defined(ASCENT_VTKM_ENABLED)
+    vtkh::BlockRanges::ClearCache();
+    vtkh::GhostStripper::ClearCache();
+#endif
+    m_painted_ghosts.reset();
+    m_verify_cache.reset();
+    // running temporal statistics don't survive a close
+    m_accumulate_states.reset();
+    if(m_trace)
+    {
+      SaveTrace();
+      m_trace = false;
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -509,6 +719,16 @@ void
 AscentRuntime::Publish(const conduit::Node &data)
 {
 
+#if defined(ASCENT_VTKM_ENABLED)
+    // block ranges are only valid for the data of a single publish.
+    // Ghost strip extents are re-validated on use, so they are kept
+    // across cycles
+    vtkh::BlockRanges::ClearCache();
+#endif
+#if defined(ASCENT_JIT_ENABLED)
+    // keep the adjacency of meshes that were used since the last publish
+    runtime::expressions::trim_adjacency_cache();
+#endif
     blueprint::mesh::to_multi_domain(data, m_source);
     EnsureDomainIds();
     // filter out default ghost name and
@@ -993,6 +1213,7 @@ AscentRuntime::ConvertExtractToFlow(const conduit::Node &extract,
     params["interface/module"] = "ascent_extract";
     params["interface/input"]  = "ascent_data";
     params["interface/set_output"] = "ascent_set_output";
+    params["interface/view"] = "ascent_data_view";
 
 #ifdef ASCENT_MPI_ENABLED
     // for MPI case, inspect args, if script is passed via file,
@@ -1065,6 +1286,7 @@ AscentRuntime::ConvertExtractToFlow(const conduit::Node &extract,
     params["interface/module"] = "ascent_extract";
     params["interface/input"]  = "ascent_data";
     params["interface/set_output"] = "ascent_set_output";
+    params["interface/view"] = "ascent_data_view";
 
      ostringstream py_src_final;
 #ifdef ASCENT_MPI_ENABLED
@@ -2064,6 +2286,15 @@ AscentRuntime::Execute(const conduit::Node &actions)
 
     m_workspace.enable_timings(log_timings);
 
+    bool log_memory = false;
+    if(m_runtime_options.has_child("memory_profile") &&
+       m_runtime_options["memory_profile"].as_string() == "true")
+    {
+      log_memory = true;
+    }
+
+    m_workspace.enable_memory_info(log_memory);
+
     // catch any errors that come up here and forward
     // them up as a conduit error
 
@@ -2122,33 +2353,43 @@ AscentRuntime::Execute(const conduit::Node &actions)
         // about the original mesh (like bounds)
         m_workspace.registry().add<DataObject>("source_object", &m_data_object,1);
 
-        m_workspace.info(m_info["flow_graph"]);
-        m_info["actions"] = actions;
-        // m_workspace.graph().save_dot_html("ascent_flow_graph.html");
+        // owned by the runtime, so blueprint verify can skip domains that
+        // did not change since the last execute
+        m_workspace.registry().add<runtime::filters::BlueprintVerifyCache>(
+            "blueprint_verify_cache", &m_verify_cache, -1);
 
 #if defined(ASCENT_VTKM_ENABLED)
-        if(log_timings)
+        // owned by the runtime, so accumulate filters keep their running
+        // statistics across executes
+        if(!m_accumulate_states)
         {
-          int cycle = 0;
-          if(Metadata::n_metadata.has_path("cycle"))
-          {
-            cycle = Metadata::n_metadata["cycle"].to_int32();
-          }
-          std::stringstream ss;
-          ss<<"cycle_"<<cycle;
-          vtkh::DataLogger::GetInstance()->OpenLogEntry(ss.str());
-          vtkh::DataLogger::GetInstance()->AddLogData("cycle", cycle);
+          m_accumulate_states =
+            std::make_shared<runtime::filters::TemporalAccumulateStates>();
         }
+        m_workspace.registry().add<runtime::filters::TemporalAccumulateStates>(
+            "temporal_accumulate_states", m_accumulate_states.get(), -1);
 #endif
-        // now execute the data flow graph
-        m_workspace.execute();
 
-#if defined(ASCENT_VTKM_ENABLED)
-        if(log_timings)
+        // when streaming to the web client, renders keep their
+        // encoded pngs here so we can push them without disk reads
+        if(m_web_interface.IsEnabled())
         {
-          vtkh::DataLogger::GetInstance()->CloseLogEntry();
+          m_workspace.registry().add<Node>("image_png_list", new Node(), 1);
         }
-#endif
+
+        // flow graph details are added to info on request
+        // (see FinalizeInfo), actions are already held by m_previous_actions
+        m_info["actions"].set_external(m_previous_actions);
+        // m_workspace.graph().save_dot_html("ascent_flow_graph.html");
+
+        if(flow::Trace::enabled() &&
+           Metadata::n_metadata.has_path("cycle"))
+        {
+          flow::Trace::value("cycle",
+                             Metadata::n_metadata["cycle"].to_float64());
+        }
+        // now execute the data flow graph
+        m_workspace.execute();
         if(m_save_session_actions.number_of_children() > 0)
         {
           SaveSession();
@@ -2184,16 +2425,24 @@ AscentRuntime::Execute(const conduit::Node &actions)
           runtime::expressions::ExpressionEval::get_last(m_info["expressions"]);
         }
 
-        // add flow graphviz details to info
-        m_info["flow_graph_dot"]      = m_workspace.graph().to_dot();
-        m_info["flow_graph_dot_html"] = m_workspace.graph().to_dot_html();
-
-        m_web_interface.PushRenders(render_file_names);
+        if(m_workspace.registry().has_entry("image_png_list") &&
+           m_workspace.registry().fetch<Node>("image_png_list")->number_of_children() > 0)
+        {
+          m_web_interface.PushRenders(*m_workspace.registry().fetch<Node>("image_png_list"));
+        }
+        else
+        {
+          m_web_interface.PushRenders(render_file_names);
+        }
 
-        Node msg;
-        msg["info"].set_external(m_info);
-        ascent::about(msg["about"]);
-        m_web_interface.PushMessage(msg);
+        if(m_web_interface.IsEnabled())
+        {
+          FinalizeInfo();
+          Node msg;
+          msg["info"].set_external(m_info);
+          ascent::about(msg["about"]);
+          m_web_interface.PushMessage(msg);
+        }
 
         m_workspace.registry().reset();
 
@@ -2212,27 +2461,32 @@ AscentRuntime::Execute(const conduit::Node &actions)
     // bottle vtkm and vtkh errors
     catch(vtkh::Error &e)
     {
+      FinalizeInfo();
       m_workspace.reset();
       ASCENT_ERROR("Execution failed with vtkh: "<<e.what());
     }
     catch(vtkm::cont::Error &e)
     {
+      FinalizeInfo();
       m_workspace.reset();
       ASCENT_ERROR("Execution failed with vtkm: "<<e.what());
     }
 #endif
     catch(conduit::Error &e)
     {
+      FinalizeInfo();
       m_workspace.reset();
       throw e;
     }
     catch(std::exception &e)
     {
+      FinalizeInfo();
       m_workspace.reset();
       std::cerr<<"Execution failed with exception: "<<e.what()<<"\n";
     }
     catch(...)
     {
+      FinalizeInfo();
       m_workspace.reset();
       ASCENT_ERROR("Ascent: unknown exception thrown");
     }
@@ -2333,6 +2587,39 @@ void AscentRuntime::SourceFieldFilter()
 }
 
 
+//-----------------------------------------------------------------------------
+namespace detail
+{
+
+conduit::uint64 nestset_signature(const conduit::Node &dom,
+                                  const std::string &nest_name,
+                                  const std::string &topo_name,
+                                  const conduit::Node *ghost_field)
+{
+  // small leaves (nestset windows, dims) are hashed by value and big
+  // arrays (ghosts, coordinates) by address and size
+  using runtime::filters::node_signature;
+  conduit::uint64 hash = 14695981039346656037ULL;
+  const conduit::Node &topo = dom["topologies/"+topo_name];
+  node_signature(topo, hash);
+  if(topo.has_path("coordset") &&
+     dom.has_path("coordsets/" + topo["coordset"].as_string()))
+  {
+    node_signature(dom["coordsets/" + topo["coordset"].as_string()], hash);
+  }
+  if(dom.has_path("nestsets/" + nest_name))
+  {
+    node_signature(dom["nestsets/" + nest_name], hash);
+  }
+  if(ghost_field != nullptr)
+  {
+    node_signature(*ghost_field, hash);
+  }
+  return hash;
+}
+
+} // namespace detail
+
 //-----------------------------------------------------------------------------
 void AscentRuntime::PaintNestsets()
 {
@@ -2411,6 +2698,12 @@ void AscentRuntime::PaintNestsets()
   // If there arent't ghosts associated with a nestset topology,
   // we will create them.
   std::set<std::string> new_ghosts;
+  // AMR hierarchies only change at regrids, so the painted ghosts of each
+  // domain are kept until its windows, mesh or ghost array change.
+  // Entries of domains that went away are dropped at the end
+  conduit::Node painted;
+  int painted_hits = 0;
+  int painted_misses = 0;
 
   for(int i = 0; i < num_domains; ++i)
   {
@@ -2428,6 +2721,8 @@ void AscentRuntime::PaintNestsets()
       }
 
       std::string nest_name = topo_nestsets[topo_name];
+      const std::string cache_path = std::to_string(dom["state/domain_id"].to_int64())
+                                     + "/" + topo_name;
 
       if(has_ghost)
       {
@@ -2438,20 +2733,32 @@ void AscentRuntime::PaintNestsets()
           // gave us this data. In most cases, the ascent
           // integration made the ghost zones, so it would
           // be safe to change them. That said, it would
-          // be bad practice to alter the data, so we will make a
+          // be bad practice to alter the data, so we paint a
           // copy and update our tree to point at the copy.
           const std::string ghost_path = "fields/" + ghost_name;
-          const std::string temp_path = "fields/" + ghost_name + "_bananas";
-
-          conduit::Node &field = dom["fields/" + ghost_name];
-          dom[temp_path].set(field);
-          dom.remove(ghost_path);
-          //dom.rename_child(temp_path, ghost_path);
-          dom["fields/"].rename_child(ghost_name+"_bananas", ghost_name);
-
-          conduit::Node &ghost_field = dom[ghost_path];
+          conduit::Node &field = dom[ghost_path];
+          const conduit::uint64 signature =
+            detail::nestset_signature(dom, nest_name, topo_name, &field);
 
-          runtime::expressions::paint_nestsets(nest_name, topo_name,  dom, ghost_field);
+          conduit::Node &entry = painted[cache_path];
+          if(m_painted_ghosts.has_path(cache_path) &&
+             m_painted_ghosts[cache_path + "/signature"].to_uint64() == signature)
+          {
+            entry.swap(m_painted_ghosts[cache_path]);
+            painted_hits++;
+          }
+          else
+          {
+            // only copied when the hierarchy changed
+            painted_misses++;
+            entry["signature"] = signature;
+            entry["field"].set(field);
+            runtime::expressions::paint_nestsets(nest_name,
+                                                 topo_name,
+                                                 dom,
+                                                 entry["field"]);
+          }
+          dom[ghost_path].set_external(entry["field"]);
         }
         else
         {
@@ -2464,14 +2771,36 @@ void AscentRuntime::PaintNestsets()
       {
         // there are no ghosts, so we have to build a new field
         std::string ghost_name = topo_name + "_ghosts";
-        conduit::Node &field = dom["fields/" + ghost_name];
-        field.reset();
-        runtime::expressions::paint_nestsets(nest_name, topo_name, dom, field);
+        const conduit::uint64 signature =
+          detail::nestset_signature(dom, nest_name, topo_name, nullptr);
+
+        conduit::Node &entry = painted[cache_path];
+        if(m_painted_ghosts.has_path(cache_path) &&
+           m_painted_ghosts[cache_path + "/signature"].to_uint64() == signature)
+        {
+          entry.swap(m_painted_ghosts[cache_path]);
+          painted_hits++;
+        }
+        else
+        {
+          painted_misses++;
+          entry["signature"] = signature;
+          runtime::expressions::paint_nestsets(nest_name,
+                                               topo_name,
+                                               dom,
+                                               entry["field"]);
+        }
+        dom["fields/" + ghost_name].set_external(entry["field"]);
         new_ghosts.insert(ghost_name);
       }
     }
   }
 
+  // swapping keeps the painted values where the published tree points
+  m_painted_ghosts.swap(painted);
+  ASCENT_DATA_ADD("nestset_ghosts_reused", painted_hits);
+  ASCENT_DATA_ADD("nestset_ghosts_painted", painted_misses);
+
   for(auto name : new_ghosts)
   {
     ASCENT_INFO("added new ghost field because of nestset: "<<name);
@@ -2551,6 +2880,7 @@ AscentRuntime::SaveInfo()
     // info is same on all ranks, only save rank 0
     if(m_rank == 0)
     {
+        FinalizeInfo();
         NodeConstIterator itr = m_save_info_actions.children();
         while(itr.has_next())
         {
@@ -2579,6 +2909,159 @@ AscentRuntime::SaveInfo()
     }
 }
 
+//--------------------------------------------------------------------------//
+void
+AscentRuntime::SaveTrace()
+{
+    // the last instance that is tracing writes the shared trace
+    // (instances are expected to be created and closed collectively)
+    if(!flow::Trace::release())
+    {
+      return;
+    }
+    detail::set_trace_sinks(false);
+
+    // later traces in the same process don't overwrite earlier ones
+    std::string prefix = "ascent_trace";
+    const index_t session = flow::Trace::sessions();
+    if(session > 1)
+    {
+      prefix = conduit_fmt::format("ascent_trace_{}", session);
+    }
+
+    // chrome traces, rank 0 by default
+    bool write_chrome = m_rank == 0;
+    if(m_runtime_options.has_child("trace_chrome_ranks"))
+    {
+      const conduit::Node &n_ranks = m_runtime_options["trace_chrome_ranks"];
+      write_chrome = false;
+      if(n_ranks.dtype().is_string())
+      {
+        write_chrome = n_ranks.as_string() == "all";
+      }
+      else if(n_ranks.dtype().is_number())
+      {
+        conduit::Node n_ints;
+        n_ranks.to_int64_array(n_ints);
+        int64_array ranks = n_ints.value();
+        for(index_t i = 0; i < ranks.number_of_elements(); ++i)
+        {
+          write_chrome = write_chrome || ranks[i] == m_rank;
+        }
+      }
+      else
+      {
+        NodeConstIterator itr = n_ranks.children();
+        while(itr.has_next())
+        {
+          write_chrome = write_chrome || itr.next().to_int64() == m_rank;
+        }
+      }
+    }
+
+    if(write_chrome)
+    {
+      std::string file_name = conduit_fmt::format("{}_{}.json",
+                                                  prefix,
+                                                  m_rank);
+      file_name = conduit::utils::join_file_path(m_default_output_dir,
+                                                 file_name);
+      flow::Trace::write_chrome_trace(file_name);
+    }
+
+    // per region statistics reduced across ranks on rank 0
+    conduit::Node n_summary;
+    flow::Trace::summary(n_summary);
+    int64 dropped = flow::Trace::dropped();
+    flow::Trace::clear();
+
+    // agree on the regions (by name only) so every rank uses the same
+    // index, then reduce fixed size arrays
+    std::set<std::string> region_names;
+    NodeConstIterator sitr = n_summary.children();
+    while(sitr.has_next())
+    {
+      sitr.next();
+      region_names.insert(sitr.name());
+    }
+    gather_strings(region_names);
+    const size_t num_regions = region_names.size();
+
+    const float64 inf = std::numeric_limits<float64>::infinity();
+    // {ranks, count} per region, then the dropped events
+    std::vector<int64> sums(2 * num_regions + 1, 0);
+    std::vector<float64> totals(num_regions, 0.0);
+    // {min total, fastest} and {max total, slowest} per region
+    std::vector<float64> mins(2 * num_regions, inf);
+    std::vector<float64> maxs(2 * num_regions, -inf);
+    size_t idx = 0;
+    for(const std::string &name : region_names)
+    {
+      if(n_summary.has_child(name))
+      {
+        const conduit::Node &n_stats = n_summary.child(name);
+        const float64 total = n_stats["total"].to_float64();
+        sums[2 * idx] = 1;
+        sums[2 * idx + 1] = n_stats["count"].to_int64();
+        totals[idx] = total;
+        mins[2 * idx] = total;
+        mins[2 * idx + 1] = n_stats["min"].to_float64();
+        maxs[2 * idx] = total;
+        maxs[2 * idx + 1] = n_stats["max"].to_float64();
+      }
+      idx++;
+    }
+    sums[2 * num_regions] = dropped;
+
+    int num_ranks = 1;
+#ifdef ASCENT_MPI_ENABLED
+    MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
+    MPI_Comm_size(mpi_comm, &num_ranks);
+    const int root = 0;
+    // only rank 0 needs the results, reduce in place there
+    const bool is_root = m_rank == root;
+    MPI_Reduce(is_root ? MPI_IN_PLACE : sums.data(), sums.data(),
+               (int)sums.size(), MPI_INT64_T, MPI_SUM, root, mpi_comm);
+    MPI_Reduce(is_root ? MPI_IN_PLACE : totals.data(), totals.data(),
+               (int)totals.size(), MPI_DOUBLE, MPI_SUM, root, mpi_comm);
+    MPI_Reduce(is_root ? MPI_IN_PLACE : mins.data(), mins.data(),
+               (int)mins.size(), MPI_DOUBLE, MPI_MIN, root, mpi_comm);
+    MPI_Reduce(is_root ? MPI_IN_PLACE : maxs.data(), maxs.data(),
+               (int)maxs.size(), MPI_DOUBLE, MPI_MAX, root, mpi_comm);
+#endif
+
+    if(m_rank != 0)
+    {
+      return;
+    }
+
+    conduit::Node summary;
+    summary["number_of_ranks"] = (index_t) num_ranks;
+    summary["dropped_events"] = (index_t) sums[2 * num_regions];
+    summary["regions"].set(DataType::object());
+    idx = 0;
+    for(const std::string &name : region_names)
+    {
+      // region paths contain '/'
+      conduit::Node &n_region = summary["regions"].add_child(name);
+      const int64 ranks = sums[2 * idx];
+      n_region["ranks"] = (index_t) ranks;
+      n_region["count"] = (index_t) sums[2 * idx + 1];
+      // time spent in the region per rank
+      n_region["min"] = mins[2 * idx];
+      n_region["avg"] = totals[idx] / float64(ranks);
+      n_region["max"] = maxs[2 * idx];
+      // shortest and longest single visit on any rank
+      n_region["fastest"] = mins[2 * idx + 1];
+      n_region["slowest"] = maxs[2 * idx + 1];
+      idx++;
+    }
+
+    summary.save(conduit::utils::join_file_path(m_default_output_dir,
+                                                prefix + "_summary.json"),
+                 "json");
+}
+
 //--------------------------------------------------------------------------//
 void
 AscentRuntime::SaveSession()
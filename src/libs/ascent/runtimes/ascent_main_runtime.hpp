@@ -19,8 +19,11 @@
 #include <ascent_runtime.hpp>
 #include <ascent_data_object.hpp>
 #include <ascent_web_interface.hpp>
+#include <ascent_runtime_utils.hpp>
 #include <flow.hpp>
 
+#include <memory>
+
 
 
 //-----------------------------------------------------------------------------
@@ -29,6 +32,15 @@
 namespace ascent
 {
 
+namespace runtime
+{
+namespace filters
+{
+// only defined when vtk-h is enabled
+class TemporalAccumulateStates;
+};
+};
+
 class ASCENT_API AscentRuntime : public Runtime
 {
 public:
@@ -76,6 +88,13 @@ private:
     int               m_refinement_level;
     int               m_rank;
     conduit::Node     m_ghost_fields; // a list of strings
+    // painted nestset ghosts, keyed by domain id and topology
+    conduit::Node     m_painted_ghosts;
+    // signatures of mesh domains that passed blueprint verify
+    runtime::filters::BlueprintVerifyCache m_verify_cache;
+    // running state of the accumulate filters, created on first execute
+    std::shared_ptr<runtime::filters::TemporalAccumulateStates>
+                      m_accumulate_states;
     std::string       m_default_output_dir;
 
     std::string       m_session_name;
@@ -84,11 +103,19 @@ private:
 
     bool              m_field_filtering;
     std::set<std::string> m_field_list;
+    // flow::Trace is recording for this runtime
+    bool              m_trace;
+    // kernels this rank built from the jit manifest at open
+    int               m_jit_precompiled;
 
     conduit::Node     m_comments;
 
     void              ResetInfo();
     void              AddPublishedMeshInfo();
+    // adds the diagnostic parts of info (flow graph details,
+    // registered filters) that are only built on request
+    void              FinalizeInfo();
+    bool              m_info_finalized;
 
     flow::Workspace   m_workspace;
     conduit::Node CreateDefaultFilters();
@@ -122,6 +149,9 @@ private:
 
     void SaveSession();
     void SaveInfo();
+    // drops this instance's use of the trace, the last one writes the
+    // chrome traces and the cross rank trace summary (collective)
+    void SaveTrace();
 
     void SetStatus(const std::string &msg);
     void SetStatus(const std::string &msg,
@@ -2374,30 +2374,31 @@ field_inf_count(const conduit::Node &dataset, const std::string &field)
 }
 
 conduit::Node
-field_min(const conduit::Node &dataset, const std::string &field)
+reduce_value_position(const conduit::Node &dataset,
+                      const conduit::Node &dom_results,
+                      const bool max)
 {
-  double min_value = std::numeric_limits<double>::max();
+  double best_value = max ? std::numeric_limits<double>::lowest()
+                          : std::numeric_limits<double>::max();
 
   int domain = -1;
   int domain_id = -1;
   int index = -1;
 
-  for(int i = 0; i < dataset.number_of_children(); ++i)
+  for(int i = 0; i < dom_results.number_of_children(); ++i)
   {
-    const conduit::Node &dom = dataset.child(i);
-    if(dom.has_path("fields/" + field))
+    const conduit::Node &dom_res = dom_results.child(i);
+    if(!dom_res.has_path("value") || !dom_res.has_path("index"))
     {
-      const std::string path = "fields/" + field;
-      conduit::Node res;
-      res = field_reduction_min(dom[path]);
-      double a_min = res["value"].to_float64();
-      if(a_min < min_value)
-      {
-        min_value = a_min;
-        index = res["index"].to_int32();
-        domain = i;
-        domain_id = dom["state/domain_id"].to_int32();
-      }
+      continue;
+    }
+    const double value = dom_res["value"].to_float64();
+    if(max ? value > best_value : value < best_value)
+    {
+      best_value = value;
+      index = dom_res["index"].to_int32();
+      domain = i;
+      domain_id = dataset.child(i)["state/domain_id"].to_int32();
     }
   }
 
@@ -2410,10 +2411,9 @@ field_min(const conduit::Node &dataset, const std::string &field)
 
   if(domain != -1)
   {
-    assoc_str = dataset.child(domain)["fields/" + field + "/association"].as_string();
-
+    assoc_str = dom_results.child(domain)["association"].as_string();
     const std::string topo_str =
-        dataset.child(domain)["fields/" + field + "/topology"].as_string();
+        dom_results.child(domain)["topology"].as_string();
 
     if(assoc_str == "vertex")
     {
@@ -2434,7 +2434,7 @@ field_min(const conduit::Node &dataset, const std::string &field)
   int assoc_int = assoc_str == "vertex" ? 1 : 0;
 
 #ifdef ASCENT_MPI_ENABLED
-  struct MinLoc
+  struct ValueLoc
   {
     double value;
     int rank;
@@ -2443,62 +2443,57 @@ field_min(const conduit::Node &dataset, const std::string &field)
   MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
   MPI_Comm_rank(mpi_comm, &rank);
 
-  MinLoc minloc = {min_value, rank};
-  MinLoc minloc_res;
-  MPI_Allreduce(&minloc, &minloc_res, 1, MPI_DOUBLE_INT, MPI_MINLOC, mpi_comm);
-  min_value = minloc_res.value;
+  ValueLoc valueloc = {best_value, rank};
+  ValueLoc valueloc_res;
+  MPI_Allreduce(&valueloc,
+                &valueloc_res,
+                1,
+                MPI_DOUBLE_INT,
+                max ? MPI_MAXLOC : MPI_MINLOC,
+                mpi_comm);
+  best_value = valueloc_res.value;
 
   double *ploc = loc.as_float64_ptr();
-  MPI_Bcast(ploc, 3, MPI_DOUBLE, minloc_res.rank, mpi_comm);
-  MPI_Bcast(&domain_id, 1, MPI_INT, minloc_res.rank, mpi_comm);
-  MPI_Bcast(&index, 1, MPI_INT, minloc_res.rank, mpi_comm);
+  MPI_Bcast(ploc, 3, MPI_DOUBLE, valueloc_res.rank, mpi_comm);
+  MPI_Bcast(&domain_id, 1, MPI_INT, valueloc_res.rank, mpi_comm);
+  MPI_Bcast(&index, 1, MPI_INT, valueloc_res.rank, mpi_comm);
 
   // make sure everyone has the same assoc even if they
   // didn't have the data
-  MPI_Bcast(&assoc_int, 1, MPI_INT, minloc_res.rank, mpi_comm);
+  MPI_Bcast(&assoc_int, 1, MPI_INT, valueloc_res.rank, mpi_comm);
 
   loc.set(ploc, 3);
 
-  rank = minloc_res.rank;
+  rank = valueloc_res.rank;
 #endif
   res["rank"] = rank;
   res["domain_id"] = domain_id;
   res["index"] = index;
   res["assoc"] = assoc_int == 1 ? "vertex" : "element";
   res["position"] = loc;
-  res["value"] = min_value;
+  res["value"] = best_value;
 
   return res;
 }
 
 conduit::Node
-field_sum(const conduit::Node &dataset, const std::string &field)
+reduce_sum(const conduit::Node &dom_results)
 {
-
   double sum = 0.;
   long long int count = 0;
 
-  for(int i = 0; i < dataset.number_of_children(); ++i)
+  for(int i = 0; i < dom_results.number_of_children(); ++i)
   {
-    const conduit::Node &dom = dataset.child(i);
-    if(dom.has_path("fields/" + field))
+    const conduit::Node &dom_res = dom_results.child(i);
+    if(dom_res.has_path("value"))
     {
-      const std::string path = "fields/" + field;
-      conduit::Node res;
-      res = field_reduction_sum(dom[path]);
-
-      double a_sum = res["value"].to_float64();
-      long long int a_count = res["count"].to_int64();
-
-      sum += a_sum;
-      count += a_count;
+      sum += dom_res["value"].to_float64();
+      count += dom_res["count"].to_int64();
     }
   }
 
 #ifdef ASCENT_MPI_ENABLED
-  int rank;
   MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
-  MPI_Comm_rank(mpi_comm, &rank);
   double global_sum;
   MPI_Allreduce(&sum, &global_sum, 1, MPI_DOUBLE, MPI_SUM, mpi_comm);
 
@@ -2515,115 +2510,77 @@ field_sum(const conduit::Node &dataset, const std::string &field)
   return res;
 }
 
-conduit::Node
-field_avg(const conduit::Node &dataset, const std::string &field)
+namespace detail
 {
-  conduit::Node sum = field_sum(dataset, field);
-
-  double avg = sum["value"].to_float64() / sum["count"].to_float64();
-
-  conduit::Node res;
-  res["value"] = avg;
-  return res;
-}
-
+// collects the per domain min, max or sum of a field, domains without
+// the field get an empty entry
 conduit::Node
-field_max(const conduit::Node &dataset, const std::string &field)
+field_dom_results(const conduit::Node &dataset,
+                  const std::string &field,
+                  const std::string &reduction)
 {
-  double max_value = std::numeric_limits<double>::lowest();
-
-  int domain = -1;
-  int domain_id = -1;
-  int index = -1;
-
+  conduit::Node dom_results;
   for(int i = 0; i < dataset.number_of_children(); ++i)
   {
     const conduit::Node &dom = dataset.child(i);
+    conduit::Node &dom_res = dom_results.append();
     if(dom.has_path("fields/" + field))
     {
-      //const std::string path = "fields/" + field + "/values";
-      const std::string path = "fields/" + field;
-      conduit::Node res;
-      res = field_reduction_max(dom[path]);
-      double a_max = res["value"].to_float64();
-      if(a_max > max_value)
+      const conduit::Node &n_field = dom["fields/" + field];
+      if(reduction == "min")
       {
-        max_value = a_max;
-        index = res["index"].to_int32();
-        domain = i;
-        domain_id = dom["state/domain_id"].to_int32();
+        dom_res = field_reduction_min(n_field);
       }
+      else if(reduction == "max")
+      {
+        dom_res = field_reduction_max(n_field);
+      }
+      else
+      {
+        dom_res = field_reduction_sum(n_field);
+      }
+      dom_res["association"] = n_field["association"];
+      dom_res["topology"] = n_field["topology"];
     }
   }
+  return dom_results;
+}
+} // namespace detail
 
-  double vert[3] = {0., 0., 0.};
-  conduit::Node loc;
-  loc.set(vert,3);
-  std::string assoc_str = "";
+conduit::Node
+field_min(const conduit::Node &dataset, const std::string &field)
+{
+  const conduit::Node dom_results =
+    detail::field_dom_results(dataset, field, "min");
+  return reduce_value_position(dataset, dom_results, false);
+}
 
-  if(domain != -1)
-  {
-    const std::string assoc_str =
-        dataset.child(domain)["fields/" + field + "/association"].as_string();
+conduit::Node
+field_sum(const conduit::Node &dataset, const std::string &field)
+{
+  return reduce_sum(detail::field_dom_results(dataset, field, "sum"));
+}
 
-    const std::string topo_str =
-        dataset.child(domain)["fields/" + field + "/topology"].as_string();
+conduit::Node
+field_avg(const conduit::Node &dataset, const std::string &field)
+{
+  conduit::Node sum = field_sum(dataset, field);
 
-    if(assoc_str == "vertex")
-    {
-      loc = vert_location(dataset.child(domain), index, topo_str);
-    }
-    else if(assoc_str == "element")
-    {
-      loc = element_location(dataset.child(domain), index, topo_str);
-    }
-    else
-    {
-      ASCENT_ERROR("Location for " << assoc_str << " not implemented");
-    }
-  }
+  double avg = sum["value"].to_float64() / sum["count"].to_float64();
 
-  int rank = 0;
   conduit::Node res;
-  int assoc_int = assoc_str == "vertex" ? 1 : 0;
-
-#ifdef ASCENT_MPI_ENABLED
-  struct MaxLoc
-  {
-    double value;
-    int rank;
-  };
-
-  MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
-  MPI_Comm_rank(mpi_comm, &rank);
-
-  MaxLoc maxloc = {max_value, rank};
-  MaxLoc maxloc_res;
-  MPI_Allreduce(&maxloc, &maxloc_res, 1, MPI_DOUBLE_INT, MPI_MAXLOC, mpi_comm);
-  max_value = maxloc_res.value;
-
-  double *ploc = loc.as_float64_ptr();
-  MPI_Bcast(ploc, 3, MPI_DOUBLE, maxloc_res.rank, mpi_comm);
-  MPI_Bcast(&domain_id, 1, MPI_INT, maxloc_res.rank, mpi_comm);
-  MPI_Bcast(&index, 1, MPI_INT, maxloc_res.rank, mpi_comm);
-
-  // make sure everyone has the same assoc even if they
-  // didn't have the data
-  MPI_Bcast(&assoc_int, 1, MPI_INT, maxloc_res.rank, mpi_comm);
-
-  loc.set(ploc, 3);
-  rank = maxloc_res.rank;
-#endif
-  res["rank"] = rank;
-  res["domain_id"] = domain_id;
-  res["index"] = index;
-  res["assoc"] = assoc_int == 1 ? "vertex" : "element";
-  res["position"] = loc;
-  res["value"] = max_value;
-
+  res["value"] = avg;
   return res;
 }
 
+conduit::Node
+field_max(const conduit::Node &dataset, const std::string &field)
+{
+  const conduit::Node dom_results =
+    detail::field_dom_results(dataset, field, "max");
+  return reduce_value_position(dataset, dom_results, true);
+}
+
 conduit::Node
 get_state_var(const conduit::Node &dataset, const std::string &var_name)
 {
@@ -63,6 +63,18 @@ ASCENT_API
 conduit::Node field_avg(const conduit::Node &dataset,
                         const std::string &field_name);
 
+// finish a min / max reduction from per domain results holding the
+// value, index, association and topology of each domain's extremum.
+// domains without a value are skipped
+ASCENT_API
+conduit::Node reduce_value_position(const conduit::Node &dataset,
+                                    const conduit::Node &dom_results,
+                                    const bool max);
+
+// finish a sum from per domain results holding the value and count
+ASCENT_API
+conduit::Node reduce_sum(const conduit::Node &dom_results);
+
 ASCENT_API
 conduit::Node field_nan_count(const conduit::Node &dataset,
                               const std::string &field_name);
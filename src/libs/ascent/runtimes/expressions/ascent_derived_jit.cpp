@@ -22,10 +22,17 @@
 #include <ascent_mpi_utils.hpp>
 #include <ascent_logging.hpp>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
 #include <cstring>
 #include <functional>
+#include <iomanip>
 #include <limits>
+#include <map>
+#include <set>
+#include <tuple>
 
 #ifdef ASCENT_JIT_ENABLED
 #include <occa.hpp>
@@ -33,6 +40,11 @@
 #include <stdlib.h>  
 #endif
 
+#ifdef ASCENT_MPI_ENABLED
+#include <conduit_relay_mpi.hpp>
+#include <mpi.h>
+#endif
+
 #ifdef ASCENT_CUDA_ENABLED
 #include <cuda_runtime.h>
 #include <cuda.h>
@@ -63,6 +75,7 @@ namespace expressions
 {
 
 int Jitable::m_device_id = -1;
+std::string Jitable::m_cache_dir;
 
 namespace detail
 {
@@ -105,7 +118,170 @@ type_string(const conduit::DataType &dtype)
 
 using slice_t = std::tuple<size_t, size_t, size_t>;
 
+// everything needed to launch the kernel of one domain
+struct LaunchInfo
+{
+  int dom_idx = -1;
+  conduit::int64 entries = 0;
+  // false if the kernel can't share a launch with other domains
+  bool jaggable = false;
+  // these are reference counted
+  // need to keep the mem in scope or bad things happen
+  std::vector<Array<unsigned char>> buffers;
+  // slice is {index in buffers, offset, size}
+  std::vector<slice_t> slices;
+  conduit::Node args;
+  // {slice, host destination} of outputs that live on the device
+  std::vector<std::pair<size_t, unsigned char *>> copy_backs;
+  std::string kernel_string;
+};
+
+// the variable name of a kernel parameter (e.g. "const double *braid")
+std::string
+arg_identifier(const std::string &param)
+{
+  const size_t star = param.rfind('*');
+  return star == std::string::npos ? param : param.substr(star + 1);
+}
+
+std::string
+manifest_path(const std::string &cache_dir)
+{
+  return conduit::utils::join_file_path(cache_dir, "ascent_jit_manifest.json");
+}
+
+// the manifest keeps kernels that were used by one of the last
+// manifest_max_age runs, at most manifest_max_kernels of them
+const int manifest_max_age = 8;
+const int manifest_max_kernels = 256;
+
+// kernels used by this process since the last save_manifest, keyed by
+// kernel_cache_key
+conduit::Node &
+used_kernels()
+{
+  static conduit::Node used;
+  return used;
+}
+
 #ifdef ASCENT_JIT_ENABLED
+// The same source compiles to different binaries for a different device or
+// compiler, so those are part of the key
+std::string
+kernel_cache_key(const std::string &kernel_string,
+                 const std::string &kernel_name)
+{
+  std::string signature = occa::getDevice().mode() + "\n" + kernel_name + "\n";
+  const char *flag_vars[] = {"OCCA_CXX",
+                             "OCCA_CXXFLAGS",
+                             "OCCA_CUDA_COMPILER",
+                             "OCCA_CUDA_COMPILER_FLAGS",
+                             "OCCA_HIP_COMPILER",
+                             "OCCA_HIP_COMPILER_FLAGS"};
+  for(const char *flag_var : flag_vars)
+  {
+    const char *value = getenv(flag_var);
+    signature += std::string(value == nullptr ? "" : value) + "\n";
+  }
+  signature += kernel_string;
+
+  // 64 bit FNV-1a, stable across processes unlike std::hash
+  conduit::uint64 hash = 14695981039346656037ULL;
+  for(const char c : signature)
+  {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  }
+  std::stringstream ss;
+  ss << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return ss.str();
+}
+
+// store kernels so that we don't have to recompile, even loading a cached
+// kernel from disk is slow. record adds the kernel to the used kernels
+occa::kernel
+build_kernel(const std::string &kernel_string,
+             const std::string &kernel_name,
+             const bool record = true)
+{
+  static std::unordered_map<std::string, occa::kernel> kernel_map;
+  occa::kernel occa_kernel;
+  try
+  {
+    flow::Timer kernel_compile_timer;
+    const std::string key = kernel_cache_key(kernel_string, kernel_name);
+    auto kernel_it = kernel_map.find(key);
+    if(kernel_it == kernel_map.end())
+    {
+      occa_kernel = occa::getDevice().buildKernelFromString(kernel_string,
+                                                            kernel_name);
+      kernel_map[key] = occa_kernel;
+    }
+    else
+    {
+      occa_kernel = kernel_it->second;
+    }
+    if(record && !used_kernels().has_child(key))
+    {
+      conduit::Node &entry = used_kernels()[key];
+      entry["key"] = key;
+      entry["name"] = kernel_name;
+      entry["mode"] = occa::getDevice().mode();
+      entry["source"] = kernel_string;
+    }
+    ASCENT_DATA_ADD("kernel compile", kernel_compile_timer.elapsed());
+  }
+  catch(const occa::exception &e)
+  {
+    ASCENT_ERROR("Jitable: Expression compilation failed:\n"
+                 << e.what() << "\n\n"
+                 << kernel_string);
+  }
+  catch(...)
+  {
+    ASCENT_ERROR("Jitable: Expression compilation failed with an unknown "
+                 "error.\n\n"
+                 << kernel_string);
+  }
+  return occa_kernel;
+}
+
+// pass input arguments
+void
+push_args(occa::kernel &occa_kernel,
+          const conduit::Node &args,
+          std::vector<occa::memory> &array_memories)
+{
+  occa_kernel.clearArgs();
+  flow::Timer push_args_timer;
+  const int num_args = args.number_of_children();
+  for(int i = 0; i < num_args; ++i)
+  {
+    const conduit::Node &arg = args.child(i);
+    if(arg.dtype().is_integer())
+    {
+      occa_kernel.pushArg(arg.to_int64());
+    }
+    else if(arg.dtype().is_float64())
+    {
+      occa_kernel.pushArg(arg.to_float64());
+    }
+    else if(arg.dtype().is_float32())
+    {
+      occa_kernel.pushArg(arg.to_float32());
+    }
+    else if(arg.has_path("index"))
+    {
+      occa_kernel.pushArg(array_memories[arg["index"].to_int32()]);
+    }
+    else
+    {
+      ASCENT_ERROR("JIT: Unknown argument type of argument: " << arg.name());
+    }
+  }
+  ASCENT_DATA_ADD("push_input_args", push_args_timer.elapsed());
+}
+
 void
 get_occa_mem(std::vector<Array<unsigned char>> &buffers,
              const std::vector<slice_t> &slices,
@@ -121,7 +297,8 @@ get_occa_mem(std::vector<Array<unsigned char>> &buffers,
 
   for(size_t i = 0; i < num_slices; ++i)
   {
-    ASCENT_DATA_OPEN("array_" + std::to_string(i));
+    // one region name for all arrays keeps the trace summary compact
+    ASCENT_DATA_OPEN("array");
     flow::Timer device_array_timer;
     Array<unsigned char> &buf = buffers[std::get<0>(slices[i])];
     size_t buf_offset = std::get<1>(slices[i]);
@@ -533,6 +710,302 @@ pack_topology(const std::string &topo_name,
   }
 }
 
+namespace detail
+{
+
+// adjacency is keyed by the connectivity array it was built from
+struct AdjacencyKey
+{
+  const void *connectivity;
+  conduit::index_t num_conn;
+  conduit::index_t num_points;
+  std::string shape;
+
+  bool operator<(const AdjacencyKey &other) const
+  {
+    return std::tie(connectivity, num_conn, num_points, shape) <
+           std::tie(other.connectivity, other.num_conn, other.num_points,
+                    other.shape);
+  }
+};
+
+struct AdjacencyEntry
+{
+  // used since the last trim
+  bool used = false;
+  // the key only holds the address of the connectivity, a remeshed
+  // simulation can hand us different elements at the same address
+  std::uint64_t checksum = 0;
+  conduit::Node adjacency;
+};
+
+std::uint64_t
+connectivity_checksum(const conduit::index_t_accessor &conn)
+{
+  // fnv-1a over the vertex ids
+  std::uint64_t hash = 14695981039346656037ull;
+  const conduit::index_t size = conn.number_of_elements();
+  for(conduit::index_t i = 0; i < size; ++i)
+  {
+    hash ^= static_cast<std::uint64_t>(conn[i]);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+// Packed args point at the entries, so they are only dropped between
+// publishes (trim) and on close (clear)
+std::map<AdjacencyKey, AdjacencyEntry> &
+adjacency_cache()
+{
+  static std::map<AdjacencyKey, AdjacencyEntry> cache;
+  return cache;
+}
+
+// faces of 3d shapes and edges of 2d shapes in vtk ordering
+const std::vector<std::vector<int>> &
+shape_faces(const std::string &shape)
+{
+  static const std::vector<std::vector<int>> tri = {{0, 1}, {1, 2}, {2, 0}};
+  static const std::vector<std::vector<int>> quad = {
+      {0, 1}, {1, 2}, {2, 3}, {3, 0}};
+  static const std::vector<std::vector<int>> tet = {
+      {0, 1, 3}, {1, 2, 3}, {2, 0, 3}, {0, 2, 1}};
+  static const std::vector<std::vector<int>> hex = {{0, 4, 7, 3},
+                                                    {1, 2, 6, 5},
+                                                    {0, 1, 5, 4},
+                                                    {3, 7, 6, 2},
+                                                    {0, 3, 2, 1},
+                                                    {4, 5, 6, 7}};
+  if(shape == "tri")
+  {
+    return tri;
+  }
+  else if(shape == "quad")
+  {
+    return quad;
+  }
+  else if(shape == "tet")
+  {
+    return tet;
+  }
+  else if(shape != "hex")
+  {
+    ASCENT_ERROR("JIT: adjacency is only implemented for tri, quad, tet and "
+                 "hex shapes, not '"
+                 << shape << "'.");
+  }
+  return hex;
+}
+
+// CSR list of the elements that use each vertex
+void
+build_vertex_elements(const conduit::index_t_accessor &conn,
+                      const int shape_size,
+                      const conduit::index_t num_points,
+                      conduit::Node &res)
+{
+  const conduit::index_t num_conn = conn.number_of_elements();
+  const conduit::index_t num_elements = num_conn / shape_size;
+  res["offsets"].set(conduit::DataType::int32(num_points + 1));
+  res["values"].set(conduit::DataType::int32(num_conn));
+  conduit::int32 *offsets = res["offsets"].value();
+  conduit::int32 *values = res["values"].value();
+
+  std::fill(offsets, offsets + num_points + 1, 0);
+  for(conduit::index_t i = 0; i < num_conn; ++i)
+  {
+    offsets[conn[i] + 1]++;
+  }
+  for(conduit::index_t i = 0; i < num_points; ++i)
+  {
+    offsets[i + 1] += offsets[i];
+  }
+  std::vector<conduit::int32> fill(offsets, offsets + num_points);
+  for(conduit::index_t e = 0; e < num_elements; ++e)
+  {
+    for(int v = 0; v < shape_size; ++v)
+    {
+      values[fill[conn[e * shape_size + v]]++] = static_cast<conduit::int32>(e);
+    }
+  }
+}
+
+// CSR list of the elements that share a face (3d) or edge (2d)
+void
+build_element_neighbors(const conduit::index_t_accessor &conn,
+                        const std::string &shape,
+                        const int shape_size,
+                        conduit::Node &res)
+{
+  const std::vector<std::vector<int>> &faces = shape_faces(shape);
+  const conduit::index_t num_elements = conn.number_of_elements() / shape_size;
+
+  // sorted face vertices followed by the element, sorting the whole list
+  // puts the two elements of every interior face next to each other
+  using FaceKey = std::array<conduit::index_t, 5>;
+  std::vector<FaceKey> face_keys;
+  face_keys.reserve(num_elements * faces.size());
+  for(conduit::index_t e = 0; e < num_elements; ++e)
+  {
+    for(const std::vector<int> &face : faces)
+    {
+      FaceKey key;
+      key.fill(-1);
+      for(size_t v = 0; v < face.size(); ++v)
+      {
+        key[v] = conn[e * shape_size + face[v]];
+      }
+      std::sort(key.begin(), key.begin() + face.size());
+      key[4] = e;
+      face_keys.push_back(key);
+    }
+  }
+  std::sort(face_keys.begin(), face_keys.end());
+
+  std::vector<std::pair<conduit::index_t, conduit::index_t>> pairs;
+  for(size_t i = 0; i + 1 < face_keys.size(); ++i)
+  {
+    if(std::equal(face_keys[i].begin(),
+                  face_keys[i].begin() + 4,
+                  face_keys[i + 1].begin()))
+    {
+      pairs.emplace_back(face_keys[i][4], face_keys[i + 1][4]);
+      pairs.emplace_back(face_keys[i + 1][4], face_keys[i][4]);
+      ++i;
+    }
+  }
+  std::sort(pairs.begin(), pairs.end());
+
+  res["offsets"].set(conduit::DataType::int32(num_elements + 1));
+  res["values"].set(conduit::DataType::int32(pairs.size()));
+  conduit::int32 *offsets = res["offsets"].value();
+  conduit::int32 *values = res["values"].value();
+  std::fill(offsets, offsets + num_elements + 1, 0);
+  for(size_t i = 0; i < pairs.size(); ++i)
+  {
+    offsets[pairs[i].first + 1]++;
+    values[i] = static_cast<conduit::int32>(pairs[i].second);
+  }
+  for(conduit::index_t i = 0; i < num_elements; ++i)
+  {
+    offsets[i + 1] += offsets[i];
+  }
+}
+
+} // namespace detail
+
+// Packs the CSR adjacency of a single shape unstructured topology:
+//   <topo>_vertex_element_offsets / <topo>_vertex_elements
+//   <topo>_element_neighbor_offsets / <topo>_element_neighbors
+// Adjacency is built on the host the first time a connectivity array is
+// seen and reused for as long as the same array is published.
+void
+pack_adjacency(const std::string &topo_name,
+               const conduit::Node &domain,
+               const bool vertex_elements,
+               const bool element_neighbors,
+               conduit::Node &args,
+               ArrayCode &array_code)
+{
+  const conduit::Node &topo = domain["topologies/" + topo_name];
+  if(topo["type"].as_string() != "unstructured")
+  {
+    ASCENT_ERROR("JIT: adjacency can only be packed for unstructured "
+                 "topologies.");
+  }
+  const conduit::Node &elements = topo["elements"];
+  const std::string shape = elements["shape"].as_string();
+  if(shape == "polygonal" || shape == "polyhedral" || elements.has_path("shapes"))
+  {
+    ASCENT_ERROR("JIT: adjacency is not implemented for topologies with "
+                 "multiple shapes.");
+  }
+  const int shape_size = get_num_vertices(shape);
+  std::unique_ptr<Topology> t = topologyFactory(topo_name, domain);
+
+  detail::AdjacencyKey key;
+  key.connectivity = elements["connectivity"].element_ptr(0);
+  key.num_conn = elements["connectivity"].dtype().number_of_elements();
+  key.num_points = t->get_num_points();
+  key.shape = shape;
+
+  const conduit::index_t_accessor conn =
+      elements["connectivity"].as_index_t_accessor();
+  const std::uint64_t checksum = detail::connectivity_checksum(conn);
+
+  detail::AdjacencyEntry &cached = detail::adjacency_cache()[key];
+  if(cached.checksum != checksum)
+  {
+    cached.adjacency.reset();
+    cached.checksum = checksum;
+  }
+  cached.used = true;
+  conduit::Node &entry = cached.adjacency;
+
+  if(vertex_elements && !entry.has_path("vertex_elements"))
+  {
+    ASCENT_DATA_OPEN("build_vertex_elements");
+    detail::build_vertex_elements(
+        conn, shape_size, key.num_points, entry["vertex_elements"]);
+    ASCENT_DATA_CLOSE();
+  }
+  if(element_neighbors && !entry.has_path("element_neighbors"))
+  {
+    ASCENT_DATA_OPEN("build_element_neighbors");
+    detail::build_element_neighbors(
+        conn, shape, shape_size, entry["element_neighbors"]);
+    ASCENT_DATA_CLOSE();
+  }
+
+  if(vertex_elements)
+  {
+    pack_array(entry["vertex_elements/offsets"],
+               topo_name + "_vertex_element_offsets",
+               args,
+               array_code);
+    pack_array(entry["vertex_elements/values"],
+               topo_name + "_vertex_elements",
+               args,
+               array_code);
+  }
+  if(element_neighbors)
+  {
+    pack_array(entry["element_neighbors/offsets"],
+               topo_name + "_element_neighbor_offsets",
+               args,
+               array_code);
+    pack_array(entry["element_neighbors/values"],
+               topo_name + "_element_neighbors",
+               args,
+               array_code);
+  }
+}
+
+void
+trim_adjacency_cache()
+{
+  auto &cache = detail::adjacency_cache();
+  for(auto it = cache.begin(); it != cache.end();)
+  {
+    if(!it->second.used)
+    {
+      it = cache.erase(it);
+    }
+    else
+    {
+      it->second.used = false;
+      ++it;
+    }
+  }
+}
+
+void
+clear_adjacency_cache()
+{
+  detail::adjacency_cache().clear();
+}
+
 //-----------------------------------------------------------------------------
 // -- JitExecutionPolicy
 //-----------------------------------------------------------------------------
@@ -617,6 +1090,97 @@ Jitable::generate_kernel(const int dom_idx, const conduit::Node &args) const
   return detail::indent_code(kernel_string, 0);
 }
 
+std::string
+Jitable::generate_reduction_kernel(const int dom_idx,
+                                   const conduit::Node &args,
+                                   const std::string &reduction) const
+{
+  const conduit::Node &cur_dom_info = dom_info.child(dom_idx);
+  const Kernel &kernel = kernels.at(cur_dom_info["kernel_type"].as_string());
+  std::string kernel_string;
+  kernel_string += kernel.functions.accumulate();
+  kernel_string += "@kernel void reduce(";
+  const int num_args = args.number_of_children();
+  bool first = true;
+  for(int i = 0; i < num_args; ++i)
+  {
+    const conduit::Node &arg = args.child(i);
+    std::string type;
+    if(!arg.has_path("index"))
+    {
+      type = "const " + detail::type_string(arg.dtype()) + " ";
+    }
+    if(!first)
+    {
+      kernel_string += "                    ";
+    }
+    kernel_string += type + arg.name() + (i == num_args - 1 ? ")\n{\n" : ",\n");
+    first = false;
+  }
+  kernel_string += kernel.kernel_body.accumulate();
+  kernel_string += kernel.generate_reduction(
+      reduction, arrays[dom_idx], "entries", "groups");
+  kernel_string += "}";
+  return detail::indent_code(kernel_string, 0);
+}
+
+// args are the arguments of the per-domain kernel, jagged_args the tables
+// that replace them
+std::string
+Jitable::generate_jagged_kernel(const int dom_idx,
+                                const conduit::Node &args,
+                                const conduit::Node &jagged_args) const
+{
+  const conduit::Node &cur_dom_info = dom_info.child(dom_idx);
+  const Kernel &kernel = kernels.at(cur_dom_info["kernel_type"].as_string());
+  std::string kernel_string;
+  kernel_string += kernel.functions.accumulate();
+  kernel_string += "@kernel void map_domains(";
+  const int num_args = jagged_args.number_of_children();
+  bool first = true;
+  for(int i = 0; i < num_args; ++i)
+  {
+    const conduit::Node &arg = jagged_args.child(i);
+    std::string type;
+    if(!arg.has_path("index"))
+    {
+      type = "const " + detail::type_string(arg.dtype()) + " ";
+    }
+    if(!first)
+    {
+      kernel_string += "                         ";
+    }
+    kernel_string += type + arg.name() + (i == num_args - 1 ? ")\n{\n" : ",\n");
+    first = false;
+  }
+
+  // recreate the per-domain arguments from the tables
+  std::string prelude;
+  const int num_dom_args = args.number_of_children();
+  for(int i = 0; i < num_dom_args; ++i)
+  {
+    const conduit::Node &arg = args.child(i);
+    const std::string ident = detail::arg_identifier(arg.name());
+    if(arg.has_path("index"))
+    {
+      const std::string type = arg.name().substr(0, arg.name().size() - ident.size());
+      prelude += arg.name() + " = (" + type + ")" + ident + "_ptrs[jag_dom];\n";
+    }
+    else
+    {
+      const std::string type = detail::type_string(arg.dtype());
+      prelude += "const " + type + " " + ident + " = (" + type + ")" + ident +
+                 "_vals[jag_dom];\n";
+    }
+  }
+
+  kernel_string += kernel.generate_jagged_loop(
+      "output", arrays[dom_idx], prelude, "total_entries", "dom_offsets",
+      "num_domains");
+  kernel_string += "}";
+  return detail::indent_code(kernel_string, 0);
+}
+
 void
 Jitable::fuse_vars(const Jitable &from)
 {
@@ -740,48 +1304,52 @@ Jitable::can_execute() const
 //    (e.g. "b ::map(const int &, const double *, const double &, double
 //    *)")
 
-// we put the field on the mesh when calling execute and delete it later if
-// it's an intermediate field
-
+namespace detail
+{
+// All ranks need to agree that something went wrong, otherwise whoever
+// didn't see the error would deadlock in the next collective
 void
-Jitable::execute(conduit::Node &dataset, const std::string &field_name)
+raise_jit_errors(const conduit::Node &errors)
 {
-#ifdef ASCENT_JIT_ENABLED
-  // There are a lot of possible code paths that each rank/domain could
-  // follow. All JIT code should not contain any MPI calls, but things
-  // after JIT can call MPI, so its important that we globally catch errors
-  // and halt exectution on any error. Otherwise, we will deadlock
-  conduit::Node errors;
-  try
+  bool error = errors.number_of_children() > 0;
+  error = global_someone_agrees(error);
+  if(error)
   {
-    ASCENT_DATA_OPEN("jitable_execute");
-    // TODO set this during initialization not here
-    static bool init = false;
-    if(!init)
-    {
-      // running this in a loop segfaults...
-      init_occa();
-      init = true;
-    }
-    occa::device &device = occa::getDevice();
-    ASCENT_DATA_ADD("occa device", device.mode());
-    occa::kernel occa_kernel;
-
-    // we need an association and topo so we can put the field back on the mesh
-    if(topology.empty() || topology == "none")
+    std::set<std::string> error_strs;
+    for(int i = 0; i < errors.number_of_children(); ++i)
     {
-      ASCENT_ERROR("Error while executing derived field: Could not infer the "
-                   "topology. Try using the constant_field function to set it "
-                   "explicitly.");
+      error_strs.insert(errors.child(i).as_string());
     }
-    if(association.empty() || association == "none")
+    gather_strings(error_strs);
+    conduit::Node n_errors;
+    for(auto e : error_strs)
     {
-      ASCENT_ERROR("Error while executing derived field: Could not determine the "
-                   "association. Try using the constant_field function to set it "
-                   "explicitly.");
+      n_errors.append() = e;
     }
+    ASCENT_ERROR("Jit errors: "<<n_errors.to_string());
+  }
+}
+};
+
+// we put the field on the mesh when calling execute and delete it later if
+// it's an intermediate field
+
+void
+Jitable::execute(conduit::Node &dataset, const std::string &field_name)
+{
+#ifdef ASCENT_JIT_ENABLED
+  // There are a lot of possible code paths that each rank/domain could
+  // follow. All JIT code should not contain any MPI calls, but things
+  // after JIT can call MPI, so its important that we globally catch errors
+  // and halt exectution on any error. Otherwise, we will deadlock
+  conduit::Node errors;
+  try
+  {
+    ASCENT_DATA_OPEN("jitable_execute");
+    check_executable();
 
     const int num_domains = dataset.number_of_children();
+    std::vector<detail::LaunchInfo> launches(num_domains);
     for(int dom_idx = 0; dom_idx < num_domains; ++dom_idx)
     {
       ASCENT_DATA_OPEN("domain execute");
@@ -791,18 +1359,9 @@ Jitable::execute(conduit::Node &dataset, const std::string &field_name)
 
       const Kernel &kernel = kernels.at(cur_dom_info["kernel_type"].as_string());
 
-      if(kernel.expr.empty())
-      {
-        ASCENT_ERROR("Cannot compile a kernel with an empty expr field. This "
-                     "shouldn't happen, call someone.");
-      }
-
       // the final number of entries
       const int entries = cur_dom_info["entries"].to_int64();
 
-      // pass entries into args just before we need to execute
-      cur_dom_info["args/entries"] = entries;
-
       // create output array schema and put it in array_map
       conduit::Schema output_schema;
 
@@ -823,162 +1382,174 @@ Jitable::execute(conduit::Node &dataset, const std::string &field_name)
 
       ASCENT_DATA_OPEN("host output alloc");
       n_output["values"].set(output_schema);
-      unsigned char *output_ptr =
-          static_cast<unsigned char *>(n_output["values"].data_ptr());
       // output to the host will always be compact
       ASCENT_DATA_ADD("bytes", output_schema.total_bytes_compact());
       ASCENT_DATA_CLOSE();
 
-      // these are reference counted
-      // need to keep the mem in scope or bad things happen
-      std::vector<Array<unsigned char>> array_buffers;
-      // slice is {index in array_buffers, offset, size}
-      std::vector<detail::slice_t> slices;
-      ASCENT_DATA_OPEN("host array alloc");
-      // allocate arrays
-      size_t output_index;
-      conduit::Node new_args;
-      for(const auto &array : arrays[dom_idx].array_map)
+      std::map<std::string, unsigned char *> host_outputs;
+      host_outputs["output"] =
+          static_cast<unsigned char *>(n_output["values"].data_ptr());
+      prepare_launch(dom_idx, "", host_outputs, launches[dom_idx]);
+
+      // dom["fields/" + field_name].print();
+      ASCENT_DATA_CLOSE();
+    }
+
+    // domains that generated the same kernel (e.g. the blocks of an AMR
+    // level) share a single launch
+    std::map<std::string, std::vector<detail::LaunchInfo *>> jagged;
+    for(detail::LaunchInfo &launch : launches)
+    {
+      if(launch.jaggable)
       {
-        if(array.second.codegen_array)
-        {
-          // codegen_arrays are false arrays used by the codegen
-          continue;
-        }
-        if(cur_dom_info["args"].has_path(array.first))
-        {
-          detail::device_alloc_array(cur_dom_info["args/" + array.first],
-                                     array.second.schema,
-                                     new_args,
-                                     array_buffers,
-                                     slices);
-        }
-        else
-        {
-          // not in args so doesn't point to any data, allocate a temporary
-          if(array.first == "output")
-          {
-            output_index = array_buffers.size();
-          }
-          if(array.first == "output" &&
-             (device.mode() == "Serial" || device.mode() == "OpenMP"))
-          {
-            // in Serial and OpenMP we don't need a separate output array for
-            // the device, so just pass it conduit's array
-            detail::device_alloc_temporary(array.first,
-                                           array.second.schema,
-                                           new_args,
-                                           array_buffers,
-                                           slices,
-                                           output_ptr);
-          }
-          else
-          {
-            detail::device_alloc_temporary(array.first,
-                                           array.second.schema,
-                                           new_args,
-                                           array_buffers,
-                                           slices,
-                                           nullptr);
-          }
-        }
+        jagged[launch.kernel_string].push_back(&launch);
       }
-      // copy the non-array types to new_args
-      const int original_num_args = cur_dom_info["args"].number_of_children();
-      for(int i = 0; i < original_num_args; ++i)
+      else
       {
-        const conduit::Node &arg = cur_dom_info["args"].child(i);
-        if(arg.dtype().number_of_elements() == 1 &&
-           arg.number_of_children() == 0 && !arg.dtype().is_string())
-        {
-          new_args[arg.name()] = arg;
-        }
+        run_launch(launch, "");
       }
-      ASCENT_DATA_CLOSE();
+    }
+    for(auto &group : jagged)
+    {
+      if(group.second.size() == 1)
+      {
+        run_launch(*group.second[0], "");
+      }
+      else
+      {
+        run_jagged_launch(group.second);
+      }
+    }
+    ASCENT_DATA_CLOSE();
+  }
+  catch(conduit::Error &e)
+  {
+    errors.append() = e.what();
+  }
+  catch(std::exception &e)
+  {
+    errors.append() = e.what();
+  }
+  catch(...)
+  {
+    errors.append() = "Unknown error occured in JIT";
+  }
 
-      // generate and compile the kernel
-      const std::string kernel_string = generate_kernel(dom_idx, new_args);
+  detail::raise_jit_errors(errors);
+#else
+  ASCENT_ERROR("JIT compilation for derived fields requires OCCA support"<<
+               " but Ascent was not compiled with OCCA.");
+#endif
+}
 
-      //std::cout << kernel_string << std::endl;
+// Evaluates the expression and reduces it in the same kernel so the derived
+// field is never written out. Each group of the kernel leaves one partial
+// result behind and the partials are finished on the host.
+void
+Jitable::reduce(const conduit::Node &dataset,
+                const std::string &reduction,
+                conduit::Node &dom_results)
+{
+  dom_results.reset();
+#ifdef ASCENT_JIT_ENABLED
+  conduit::Node errors;
+  try
+  {
+    ASCENT_DATA_OPEN("jitable_reduce");
+    ASCENT_DATA_ADD("reduction", reduction);
+    check_executable();
+    if(reduction != "min" && reduction != "max" && reduction != "sum")
+    {
+      ASCENT_ERROR("JIT: Unknown fused reduction '" << reduction << "'");
+    }
 
-      // store kernels so that we don't have to recompile, even loading a cached
-      // kernel from disk is slow
-      static std::unordered_map<std::string, occa::kernel> kernel_map;
-      try
+    const int num_domains = dataset.number_of_children();
+    for(int dom_idx = 0; dom_idx < num_domains; ++dom_idx)
+    {
+      ASCENT_DATA_OPEN("domain reduce");
+      conduit::Node &cur_dom_info = dom_info.child(dom_idx);
+      const Kernel &kernel = kernels.at(cur_dom_info["kernel_type"].as_string());
+      if(kernel.num_components != 1)
       {
-        flow::Timer kernel_compile_timer;
-        auto kernel_it = kernel_map.find(kernel_string);
-        if(kernel_it == kernel_map.end())
-        {
-          occa_kernel = device.buildKernelFromString(kernel_string, "map");
-          kernel_map[kernel_string] = occa_kernel;
-        }
-        else
-        {
-          occa_kernel = kernel_it->second;
-        }
-        ASCENT_DATA_ADD("kernel compile", kernel_compile_timer.elapsed());
+        ASCENT_ERROR("JIT: Only scalar expressions can be reduced. The "
+                     "expression has "
+                     << kernel.num_components << " components.");
       }
-      catch(const occa::exception &e)
+
+      const int entries = cur_dom_info["entries"].to_int64();
+      conduit::Node &dom_res = dom_results.append();
+      dom_res["count"] = entries;
+      dom_res["topology"] = topology;
+      dom_res["association"] = association;
+      if(entries == 0)
       {
-        ASCENT_ERROR("Jitable: Expression compilation failed:\n"
-                     << e.what() << "\n\n"
-                     << kernel_string);
+        ASCENT_DATA_CLOSE();
+        continue;
       }
-      catch(...)
+
+      // one partial result per group of the kernel, capped so the
+      // host side of the reduction stays trivial
+      const int group_size = Kernel::group_size;
+      const int max_groups = Kernel::max_reduction_groups;
+      const int groups =
+          std::min((entries + group_size - 1) / group_size, max_groups);
+      cur_dom_info["args/groups"] = groups;
+
+      conduit::Schema value_schema(
+          conduit::DataType::float64(groups));
+      conduit::Schema index_schema(
+          conduit::DataType::int32(groups));
+      arrays[dom_idx].array_map.insert(
+          std::make_pair("partial_value", SchemaBool(value_schema, false)));
+
+      conduit::Node n_partials;
+      n_partials["value"].set(value_schema);
+      std::map<std::string, unsigned char *> host_outputs;
+      host_outputs["partial_value"] =
+          static_cast<unsigned char *>(n_partials["value"].data_ptr());
+      if(reduction != "sum")
       {
-        ASCENT_ERROR("Jitable: Expression compilation failed with an unknown "
-                     "error.\n\n"
-                     << kernel_string);
+        arrays[dom_idx].array_map.insert(
+            std::make_pair("partial_index", SchemaBool(index_schema, false)));
+        n_partials["index"].set(index_schema);
+        host_outputs["partial_index"] =
+            static_cast<unsigned char *>(n_partials["index"].data_ptr());
       }
+      ASCENT_DATA_ADD("bytes", n_partials.total_bytes_compact());
 
-      // pass input arguments
-      occa_kernel.clearArgs();
-      // get occa mem for devices
-      std::vector<occa::memory> array_memories;
-      detail::get_occa_mem(array_buffers, slices, array_memories);
+      detail::LaunchInfo launch;
+      prepare_launch(dom_idx, reduction, host_outputs, launch);
+      run_launch(launch, reduction);
 
-      flow::Timer push_args_timer;
-      const int num_new_args = new_args.number_of_children();
-      for(int i = 0; i < num_new_args; ++i)
+      // finish the partials, first index wins ties like the unfused path
+      const double *values = n_partials["value"].as_float64_ptr();
+      if(reduction == "sum")
       {
-        const conduit::Node &arg = new_args.child(i);
-        if(arg.dtype().is_integer())
-        {
-          occa_kernel.pushArg(arg.to_int64());
-        }
-        else if(arg.dtype().is_float64())
-        {
-          occa_kernel.pushArg(arg.to_float64());
-        }
-        else if(arg.dtype().is_float32())
-        {
-          occa_kernel.pushArg(arg.to_float32());
-        }
-        else if(arg.has_path("index"))
-        {
-          occa_kernel.pushArg(array_memories[arg["index"].to_int32()]);
-        }
-        else
+        double sum = 0.;
+        for(int i = 0; i < groups; ++i)
         {
-          ASCENT_ERROR("JIT: Unknown argument type of argument: " << arg.name());
+          sum += values[i];
         }
+        dom_res["value"] = sum;
       }
-      ASCENT_DATA_ADD("push_input_args", push_args_timer.elapsed());
-
-      flow::Timer kernel_run_timer;
-      occa_kernel.run();
-      ASCENT_DATA_ADD("kernel runtime", kernel_run_timer.elapsed());
-
-      // copy back
-      flow::Timer copy_back_timer;
-      if(device.mode() != "Serial" && device.mode() != "OpenMP")
+      else
       {
-        array_memories[output_index].copyTo(output_ptr);
+        const int *indices = n_partials["index"].as_int32_ptr();
+        const bool is_max = reduction == "max";
+        double value = values[0];
+        int index = indices[0];
+        for(int i = 1; i < groups; ++i)
+        {
+          const bool better = is_max ? values[i] > value : values[i] < value;
+          if(better || (values[i] == value && indices[i] < index))
+          {
+            value = values[i];
+            index = indices[i];
+          }
+        }
+        dom_res["value"] = value;
+        dom_res["index"] = index;
       }
-      ASCENT_DATA_ADD("copy to host", copy_back_timer.elapsed());
-
-      // dom["fields/" + field_name].print();
       ASCENT_DATA_CLOSE();
     }
     ASCENT_DATA_CLOSE();
@@ -996,34 +1567,303 @@ Jitable::execute(conduit::Node &dataset, const std::string &field_name)
     errors.append() = "Unknown error occured in JIT";
   }
 
-  bool error = errors.number_of_children() > 0;
-  error = global_someone_agrees(error);
-  if(error)
+  detail::raise_jit_errors(errors);
+#else
+  ASCENT_ERROR("JIT compilation for derived fields requires OCCA support"<<
+               " but Ascent was not compiled with OCCA.");
+#endif
+}
+
+void
+Jitable::check_executable()
+{
+#ifdef ASCENT_JIT_ENABLED
+  init_occa();
+  ASCENT_DATA_ADD("occa device", occa::getDevice().mode());
+#endif
+  // we need an association and topo so we can put the field back on the mesh
+  if(topology.empty() || topology == "none")
   {
-    std::set<std::string> error_strs;
-    for(int i = 0; i < errors.number_of_children(); ++i)
+    ASCENT_ERROR("Error while executing derived field: Could not infer the "
+                 "topology. Try using the constant_field function to set it "
+                 "explicitly.");
+  }
+  if(association.empty() || association == "none")
+  {
+    ASCENT_ERROR("Error while executing derived field: Could not determine the "
+                 "association. Try using the constant_field function to set it "
+                 "explicitly.");
+  }
+}
+
+// Moves the inputs of a domain to the device and generates the map
+// (reduction == "") or fused reduction kernel for it. Every array named in
+// host_outputs is written back to the given host pointer after the run.
+void
+Jitable::prepare_launch(const int dom_idx,
+                        const std::string &reduction,
+                        const std::map<std::string, unsigned char *> &host_outputs,
+                        detail::LaunchInfo &info)
+{
+#ifdef ASCENT_JIT_ENABLED
+  occa::device &device = occa::getDevice();
+  const bool host_device =
+    device.mode() == "Serial" || device.mode() == "OpenMP";
+
+  conduit::Node &cur_dom_info = dom_info.child(dom_idx);
+  const Kernel &kernel = kernels.at(cur_dom_info["kernel_type"].as_string());
+
+  if(kernel.expr.empty())
+  {
+    ASCENT_ERROR("Cannot compile a kernel with an empty expr field. This "
+                 "shouldn't happen, call someone.");
+  }
+
+  info.dom_idx = dom_idx;
+  info.entries = cur_dom_info["entries"].to_int64();
+  // kernels that generate temporaries have code outside of the loop and
+  // can't be stitched together
+  info.jaggable = reduction.empty() && kernel.kernel_body.accumulate().empty();
+
+  // pass entries into args just before we need to execute
+  cur_dom_info["args/entries"] = static_cast<int>(info.entries);
+
+  ASCENT_DATA_OPEN("host array alloc");
+  // allocate arrays
+  for(const auto &array : arrays[dom_idx].array_map)
+  {
+    if(array.second.codegen_array)
     {
-      error_strs.insert(errors.child(i).as_string());
+      // codegen_arrays are false arrays used by the codegen
+      continue;
     }
-    gather_strings(error_strs);
-    conduit::Node n_errors;
-    for(auto e : error_strs)
+    if(cur_dom_info["args"].has_path(array.first))
     {
-      n_errors.append() = e;
+      detail::device_alloc_array(cur_dom_info["args/" + array.first],
+                                 array.second.schema,
+                                 info.args,
+                                 info.buffers,
+                                 info.slices);
+    }
+    else
+    {
+      // not in args so doesn't point to any data, allocate a temporary
+      auto host_it = host_outputs.find(array.first);
+      const bool is_output = host_it != host_outputs.end();
+      // in Serial and OpenMP we don't need a separate output array for
+      // the device, so just pass it conduit's array
+      unsigned char *host_ptr =
+        is_output && host_device ? host_it->second : nullptr;
+      detail::device_alloc_temporary(array.first,
+                                     array.second.schema,
+                                     info.args,
+                                     info.buffers,
+                                     info.slices,
+                                     host_ptr);
+      if(is_output && !host_device)
+      {
+        info.copy_backs.push_back(
+            std::make_pair(info.slices.size() - 1, host_it->second));
+      }
+    }
+  }
+  // copy the non-array types to args
+  const int original_num_args = cur_dom_info["args"].number_of_children();
+  for(int i = 0; i < original_num_args; ++i)
+  {
+    const conduit::Node &arg = cur_dom_info["args"].child(i);
+    if(arg.dtype().number_of_elements() == 1 &&
+       arg.number_of_children() == 0 && !arg.dtype().is_string())
+    {
+      info.args[arg.name()] = arg;
     }
-    ASCENT_ERROR("Jit errors: "<<n_errors.to_string());
   }
+  ASCENT_DATA_CLOSE();
 
-#else
-  ASCENT_ERROR("JIT compilation for derived fields requires OCCA support"<<
-               " but Ascent was not compiled with OCCA.");
+  // generate the kernel
+  info.kernel_string = reduction.empty()
+    ? generate_kernel(dom_idx, info.args)
+    : generate_reduction_kernel(dom_idx, info.args, reduction);
+
+  //std::cout << info.kernel_string << std::endl;
+#endif
+}
+
+// Compiles and runs the kernel of a single domain
+void
+Jitable::run_launch(detail::LaunchInfo &info, const std::string &reduction)
+{
+#ifdef ASCENT_JIT_ENABLED
+  occa::kernel occa_kernel =
+    detail::build_kernel(info.kernel_string,
+                         reduction.empty() ? "map" : "reduce");
+
+  // get occa mem for devices
+  std::vector<occa::memory> array_memories;
+  detail::get_occa_mem(info.buffers, info.slices, array_memories);
+
+  detail::push_args(occa_kernel, info.args, array_memories);
+
+  flow::Timer kernel_run_timer;
+  occa_kernel.run();
+  ASCENT_DATA_ADD("kernel runtime", kernel_run_timer.elapsed());
+
+  // copy back
+  flow::Timer copy_back_timer;
+  for(const auto &copy_back : info.copy_backs)
+  {
+    array_memories[copy_back.first].copyTo(copy_back.second);
+  }
+  ASCENT_DATA_ADD("copy to host", copy_back_timer.elapsed());
+#endif
+}
+
+// Runs the identical kernels of several domains as one launch. Every
+// argument of the per-domain kernel becomes a table indexed by domain:
+// scalars hold their per-domain values and arrays hold the address of each
+// domain's (already packed) array, so no data is copied to stitch the
+// domains together. A table of entry offsets maps a global item back to
+// its domain.
+void
+Jitable::run_jagged_launch(const std::vector<detail::LaunchInfo *> &infos)
+{
+#ifdef ASCENT_JIT_ENABLED
+  ASCENT_DATA_OPEN("jagged launch");
+  occa::device &device = occa::getDevice();
+  const std::string mode = device.mode();
+  const bool host_device = mode == "Serial" || mode == "OpenMP";
+  const int num_doms = static_cast<int>(infos.size());
+  const detail::LaunchInfo &first = *infos[0];
+  ASCENT_DATA_ADD("domains", num_doms);
+
+  conduit::Node tables;
+  conduit::Node &n_offsets = tables["dom_offsets"];
+  n_offsets.set(conduit::DataType::int64(num_doms + 1));
+  conduit::int64 *offsets = n_offsets.value();
+  offsets[0] = 0;
+  for(int d = 0; d < num_doms; ++d)
+  {
+    offsets[d + 1] = offsets[d] + infos[d]->entries;
+  }
+  const conduit::int64 total_entries = offsets[num_doms];
+
+  const int num_args = first.args.number_of_children();
+  for(int i = 0; i < num_args; ++i)
+  {
+    const conduit::Node &arg = first.args.child(i);
+    const std::string ident = detail::arg_identifier(arg.name());
+    if(arg.has_path("index"))
+    {
+      conduit::Node &n_ptrs = tables[ident + "_ptrs"];
+      n_ptrs.set(conduit::DataType::uint64(num_doms));
+      conduit::uint64 *ptrs = n_ptrs.value();
+      for(int d = 0; d < num_doms; ++d)
+      {
+        detail::LaunchInfo &info = *infos[d];
+        const detail::slice_t &slice =
+          info.slices[info.args[arg.name() + "/index"].to_int32()];
+        Array<unsigned char> &buf = info.buffers[std::get<0>(slice)];
+        unsigned char *base;
+        if(host_device)
+        {
+          base = buf.get_host_ptr();
+        }
+#ifdef ASCENT_CUDA_ENABLED
+        else if(mode == "CUDA")
+        {
+          base = buf.get_device_ptr();
+        }
+#endif
+        else
+        {
+          ASCENT_ERROR("Unknow occa mode " << mode);
+        }
+        ptrs[d] = reinterpret_cast<conduit::uint64>(base + std::get<1>(slice));
+      }
+    }
+    else if(arg.dtype().is_integer())
+    {
+      conduit::Node &n_vals = tables[ident + "_vals"];
+      n_vals.set(conduit::DataType::int64(num_doms));
+      conduit::int64 *vals = n_vals.value();
+      for(int d = 0; d < num_doms; ++d)
+      {
+        vals[d] = infos[d]->args[arg.name()].to_int64();
+      }
+    }
+    else
+    {
+      conduit::Node &n_vals = tables[ident + "_vals"];
+      n_vals.set(conduit::DataType::float64(num_doms));
+      conduit::float64 *vals = n_vals.value();
+      for(int d = 0; d < num_doms; ++d)
+      {
+        vals[d] = infos[d]->args[arg.name()].to_float64();
+      }
+    }
+  }
+
+  // all of the tables go to the device together
+  std::vector<Array<unsigned char>> buffers;
+  std::vector<detail::slice_t> slices;
+  conduit::Node jagged_args;
+  jagged_args["num_domains"] = num_doms;
+  jagged_args["total_entries"] = total_entries;
+  for(int i = 0; i < tables.number_of_children(); ++i)
+  {
+    conduit::Node &table = tables.child(i);
+    Array<unsigned char> mem;
+    mem.set(static_cast<unsigned char *>(table.data_ptr()),
+            table.total_bytes_compact());
+    buffers.push_back(mem);
+    slices.push_back(detail::slice_t(buffers.size() - 1,
+                                     0,
+                                     table.total_bytes_compact()));
+    const std::string param =
+      "const " + detail::type_string(table.dtype()) + " *" + table.name();
+    jagged_args[param + "/index"] = slices.size() - 1;
+  }
+
+  const std::string kernel_string =
+    generate_jagged_kernel(first.dom_idx, first.args, jagged_args);
+  occa::kernel occa_kernel = detail::build_kernel(kernel_string, "map_domains");
+
+  std::vector<occa::memory> array_memories;
+  detail::get_occa_mem(buffers, slices, array_memories);
+  detail::push_args(occa_kernel, jagged_args, array_memories);
+
+  flow::Timer kernel_run_timer;
+  occa_kernel.run();
+  ASCENT_DATA_ADD("kernel runtime", kernel_run_timer.elapsed());
+
+  // copy back
+  flow::Timer copy_back_timer;
+  for(detail::LaunchInfo *info : infos)
+  {
+    for(const auto &copy_back : info->copy_backs)
+    {
+      const detail::slice_t &slice = info->slices[copy_back.first];
+      Array<unsigned char> &buf = info->buffers[std::get<0>(slice)];
+      void *v_ptr = (void *)(buf.get_device_ptr() + std::get<1>(slice));
+      occa::memory mem = device.wrapMemory(v_ptr, std::get<2>(slice));
+      mem.copyTo(copy_back.second);
+    }
+  }
+  ASCENT_DATA_ADD("copy to host", copy_back_timer.elapsed());
+  ASCENT_DATA_CLOSE();
 #endif
 }
 
 void Jitable::init_occa()
 {
 #ifdef ASCENT_JIT_ENABLED
-    // running this in a loop segfaults...
+  // running this in a loop segfaults...
+  static bool init = false;
+  if(init)
+  {
+    return;
+  }
+  init = true;
 #if defined(ASCENT_CUDA_ENABLED)
   if(m_device_id == -1)
   {
@@ -1045,7 +1885,253 @@ void Jitable::init_occa()
 #else
   occa::setDevice({{"mode", "Serial"}});
 #endif
-  occa::env::setOccaCacheDir(::ascent::runtime::filters::output_dir(".occa"));
+  occa::env::setOccaCacheDir(cache_dir());
+#endif
+}
+
+std::string
+Jitable::cache_dir()
+{
+  if(m_cache_dir.empty())
+  {
+    return ::ascent::runtime::filters::output_dir(".occa");
+  }
+  return m_cache_dir;
+}
+
+void
+Jitable::set_cache_dir(const std::string &dir)
+{
+  m_cache_dir = dir;
+#ifdef ASCENT_JIT_ENABLED
+  // in case the device was already set up by an earlier open
+  occa::env::setOccaCacheDir(m_cache_dir);
+#endif
+}
+
+// The manifest lists the source of the kernels used by the last few runs
+// that used the same cache directory. Building them here moves the compile
+// stalls from the first cycles to open(). Rank 0 goes first and fills the
+// (shared) OCCA cache, the other ranks then only load the binaries.
+int
+Jitable::precompile()
+{
+  int built = 0;
+#ifdef ASCENT_JIT_ENABLED
+  const std::string manifest_file = detail::manifest_path(cache_dir());
+  conduit::Node manifest;
+  bool has_manifest = conduit::utils::is_file(manifest_file);
+  if(has_manifest)
+  {
+    try
+    {
+      manifest.load(manifest_file, "json");
+    }
+    catch(conduit::Error &e)
+    {
+      ASCENT_INFO("JIT: ignoring unreadable kernel manifest '"
+                  << manifest_file << "'");
+      has_manifest = false;
+    }
+  }
+
+  // everyone has to take part in the barriers
+  if(!global_someone_agrees(has_manifest))
+  {
+    return built;
+  }
+
+  ASCENT_DATA_OPEN("jit_precompile");
+  flow::Timer precompile_timer;
+  const bool leader = mpi_rank() == 0;
+  for(int pass = 0; pass < 2; ++pass)
+  {
+    if(has_manifest && (pass == 0) == leader)
+    {
+      init_occa();
+      const std::string mode = occa::getDevice().mode();
+      const int num_kernels = manifest.number_of_children();
+      for(int i = 0; i < num_kernels; ++i)
+      {
+        const conduit::Node &entry = manifest.child(i);
+        if(!entry.has_path("mode") || entry["mode"].as_string() != mode)
+        {
+          continue;
+        }
+        try
+        {
+          detail::build_kernel(entry["source"].as_string(),
+                               entry["name"].as_string(),
+                               false);
+          built++;
+        }
+        catch(conduit::Error &e)
+        {
+          // a stale entry, it will just be rebuilt when it is needed
+          ASCENT_INFO("JIT: failed to precompile kernel " << entry.name());
+        }
+      }
+    }
+    // barrier
+    global_agreement(true);
+  }
+  ASCENT_DATA_ADD("kernels", built);
+  ASCENT_DATA_ADD("time", precompile_timer.elapsed());
+  ASCENT_DATA_CLOSE();
+#endif
+  return built;
+}
+
+// Adds the kernels used by any rank of this process to the manifest so
+// the next run can precompile them. Only the keys are gathered, rank 0 then
+// asks one rank for the source of each kernel that is not in the manifest
+// yet. Entries age by one every run that does not use them and are dropped
+// once they are too old or the manifest is full.
+void
+Jitable::save_manifest()
+{
+#ifdef ASCENT_JIT_ENABLED
+  conduit::Node &used = detail::used_kernels();
+  const bool has_entries = used.number_of_children() > 0;
+  if(!global_someone_agrees(has_entries))
+  {
+    return;
+  }
+
+  const bool leader = mpi_rank() == 0;
+  const std::string dir = cache_dir();
+  const std::string manifest_file = detail::manifest_path(dir);
+  conduit::Node manifest;
+  if(leader && conduit::utils::is_file(manifest_file))
+  {
+    try
+    {
+      manifest.load(manifest_file, "json");
+    }
+    catch(conduit::Error &e)
+    {
+      // start over
+      manifest.reset();
+    }
+  }
+
+  // keys used by any rank and the new entries, only valid on rank 0
+  std::set<std::string> used_keys;
+  conduit::Node new_entries;
+#ifdef ASCENT_MPI_ENABLED
+  MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
+  conduit::Node keys;
+  for(int i = 0; i < used.number_of_children(); ++i)
+  {
+    keys.append() = used.child(i).name();
+  }
+  conduit::Node rank_keys;
+  conduit::relay::mpi::gather_using_schema(keys, rank_keys, 0, mpi_comm);
+
+  // the first rank that used a kernel missing from the manifest sends it
+  conduit::Node senders;
+  if(leader)
+  {
+    for(int r = 0; r < rank_keys.number_of_children(); ++r)
+    {
+      const conduit::Node &n_rank = rank_keys.child(r);
+      for(int i = 0; i < n_rank.number_of_children(); ++i)
+      {
+        const std::string key = n_rank.child(i).as_string();
+        used_keys.insert(key);
+        if(!manifest.has_child(key) && !senders.has_child(key))
+        {
+          senders[key] = r;
+        }
+      }
+    }
+  }
+  conduit::relay::mpi::broadcast_using_schema(senders, 0, mpi_comm);
+
+  const int rank = mpi_rank();
+  conduit::Node send;
+  for(int i = 0; i < senders.number_of_children(); ++i)
+  {
+    const conduit::Node &sender = senders.child(i);
+    if(sender.to_int32() == rank)
+    {
+      send[sender.name()] = used[sender.name()];
+    }
+  }
+  conduit::Node received;
+  conduit::relay::mpi::gather_using_schema(send, received, 0, mpi_comm);
+  for(int r = 0; r < received.number_of_children(); ++r)
+  {
+    const conduit::Node &n_rank = received.child(r);
+    for(int i = 0; i < n_rank.number_of_children(); ++i)
+    {
+      new_entries[n_rank.child(i).name()] = n_rank.child(i);
+    }
+  }
+#else
+  for(int i = 0; i < used.number_of_children(); ++i)
+  {
+    const conduit::Node &entry = used.child(i);
+    used_keys.insert(entry.name());
+    if(!manifest.has_child(entry.name()))
+    {
+      new_entries[entry.name()] = entry;
+    }
+  }
+#endif
+  // the next run starts counting again
+  used.reset();
+
+  if(!leader)
+  {
+    return;
+  }
+
+  // {age, key} of every entry that is young enough
+  std::vector<std::pair<int, std::string>> ages;
+  for(int i = 0; i < manifest.number_of_children(); ++i)
+  {
+    conduit::Node &entry = manifest.child(i);
+    int age = 0;
+    if(used_keys.find(entry.name()) == used_keys.end())
+    {
+      age = (entry.has_child("age") ? entry["age"].to_int32() : 0) + 1;
+    }
+    entry["age"] = age;
+    if(age <= detail::manifest_max_age)
+    {
+      ages.push_back(std::make_pair(age, entry.name()));
+    }
+  }
+  for(int i = 0; i < new_entries.number_of_children(); ++i)
+  {
+    conduit::Node &entry = new_entries.child(i);
+    entry["age"] = 0;
+    ages.push_back(std::make_pair(0, entry.name()));
+  }
+  // keep the most recently used kernels
+  std::stable_sort(ages.begin(),
+                   ages.end(),
+                   [](const std::pair<int, std::string> &a,
+                      const std::pair<int, std::string> &b)
+                   { return a.first < b.first; });
+  if(ages.size() > static_cast<size_t>(detail::manifest_max_kernels))
+  {
+    ages.resize(detail::manifest_max_kernels);
+  }
+
+  conduit::Node res;
+  for(const auto &age : ages)
+  {
+    const std::string &key = age.second;
+    res[key] = manifest.has_child(key) ? manifest[key] : new_entries[key];
+  }
+
+  if(!conduit::utils::is_directory(dir))
+  {
+    conduit::utils::create_directory(dir);
+  }
+  res.save(manifest_file, "json");
 #endif
 }
 
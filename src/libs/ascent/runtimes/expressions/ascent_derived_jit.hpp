@@ -16,6 +16,7 @@
 #include <ascent.hpp>
 #include <conduit.hpp>
 #include <flow.hpp>
+#include <map>
 #include <memory>
 
 #include "ascent_jit_array.hpp"
@@ -44,10 +45,16 @@ namespace runtime
 namespace expressions
 {
 
+namespace detail
+{
+struct LaunchInfo;
+}
+
 class Jitable
 {
 protected:
   static int m_device_id;
+  static std::string m_cache_dir;
 public:
   Jitable(const int num_domains)
   {
@@ -61,13 +68,34 @@ public:
   static void init_occa();
   static void set_device(int device_id);
   static int  num_devices();
+  // directory holding the compiled kernels and the kernel manifest,
+  // defaults to .occa in the default output directory
+  static void set_cache_dir(const std::string &dir);
+  static std::string cache_dir();
+  // builds the kernels listed in the manifest (collective), returns the
+  // number of kernels this rank built
+  static int precompile();
+  // records the kernels built so far in the manifest (collective)
+  static void save_manifest();
 
 
   void fuse_vars(const Jitable &from);
   bool can_execute() const;
   void execute(conduit::Node &dataset, const std::string &field_name);
+  // runs the expression fused with a "min", "max" or "sum" reduction
+  // without materializing the field. dom_results gets one child per
+  // domain holding the value, the index of the min/max and the count
+  void reduce(const conduit::Node &dataset,
+              const std::string &reduction,
+              conduit::Node &dom_results);
   std::string generate_kernel(const int dom_idx,
                               const conduit::Node &args) const;
+  std::string generate_reduction_kernel(const int dom_idx,
+                                        const conduit::Node &args,
+                                        const std::string &reduction) const;
+  std::string generate_jagged_kernel(const int dom_idx,
+                                     const conduit::Node &args,
+                                     const conduit::Node &jagged_args) const;
 
   // map of kernel types (e.g. for different topologies)
   std::unordered_map<std::string, Kernel> kernels;
@@ -80,6 +108,14 @@ public:
   std::string association;
   // metadata used to make the . operator work and store various jitable state
   conduit::Node obj;
+private:
+  void check_executable();
+  void prepare_launch(const int dom_idx,
+                      const std::string &reduction,
+                      const std::map<std::string, unsigned char *> &host_outputs,
+                      detail::LaunchInfo &info);
+  void run_launch(detail::LaunchInfo &info, const std::string &reduction);
+  void run_jagged_launch(const std::vector<detail::LaunchInfo *> &infos);
 };
 
 class MemoryRegion
@@ -144,6 +180,17 @@ void pack_array(const conduit::Node &array,
                 const std::string &name,
                 conduit::Node &args,
                 ArrayCode &array_code);
+// CSR vertex to element and element to element adjacency of single shape
+// unstructured topologies, cached by connectivity array. Trimming drops
+// the adjacency of meshes that were not used since the last trim
+void pack_adjacency(const std::string &topo_name,
+                    const conduit::Node &domain,
+                    const bool vertex_elements,
+                    const bool element_neighbors,
+                    conduit::Node &args,
+                    ArrayCode &array_code);
+void trim_adjacency_cache();
+void clear_adjacency_cache();
 };
 //-----------------------------------------------------------------------------
 // -- end ascent::runtime::expressions--
@@ -8,6 +8,7 @@
 #include "ascent_jit_fusion.hpp"
 #include "ascent_blueprint_architect.hpp"
 #include "ascent_blueprint_topologies.hpp"
+#include "ascent_expression_filters.hpp"
 #include <ascent_config.h>
 #include <ascent_logging.hpp>
 #include <ascent_data_object.hpp>
@@ -199,6 +200,14 @@ ExprJitFilter::execute()
       return;
     }
 
+    // reductions of a derived field are fused with the field's kernel so
+    // the field is never written out
+    if(func == "reduce")
+    {
+      execute_reduction();
+      return;
+    }
+
     // create a vector of input_jitables to be fused
     std::vector<const Jitable *> input_jitables;
     // keep around the new jitables we create
@@ -475,6 +484,7 @@ ExprJitFilter::execute()
     // fuse it
     if(func == "expr_jit_mesh_field_gradient" ||
        func == "expr_jit_mesh_field_curl"     ||
+       func == "expr_jit_mesh_field_divergence" ||
        func == "expr_jit_mesh_field_recenter" ||
        (func == "expr_jit_mesh_binning_value" && !inputs.has_path("topo")))
     {
@@ -614,6 +624,10 @@ ExprJitFilter::execute()
         {
           jitable_functions.curl();
         }
+        else if(func == "expr_jit_mesh_field_divergence")
+        {
+          jitable_functions.divergence();
+        }
         else if(func == "expr_jit_mesh_binning_paint_binning")
         {
           const int binning_port = inputs["binning/port"].to_int32();
@@ -693,6 +707,96 @@ ExprJitFilter::execute()
     ASCENT_ERROR("Jit errors: "<<n_errors.to_string());
   }
 }
+//-----------------------------------------------------------------------------
+void
+ExprJitFilter::execute_reduction()
+{
+  const std::string &reduction = params()["reduction"].as_string();
+
+  DataObject *data_object =
+    graph().workspace().registry().fetch<DataObject>("dataset");
+  conduit::Node *dataset = data_object->as_low_order_bp().get();
+  const int num_domains = dataset->number_of_children();
+
+  conduit::Node n_res;
+  if(input(0).check_type<Jitable>())
+  {
+    // copy the jitable since other filters may still use it
+    Jitable jitable(num_domains);
+    jitable.fuse_vars(*input<Jitable>(0));
+    jitable.kernels = input<Jitable>(0)->kernels;
+
+    conduit::Node dom_results;
+    jitable.reduce(*dataset, reduction == "avg" ? "sum" : reduction, dom_results);
+    if(reduction == "min" || reduction == "max")
+    {
+      n_res = reduce_value_position(*dataset, dom_results, reduction == "max");
+    }
+    else
+    {
+      n_res = reduce_sum(dom_results);
+      if(reduction == "avg")
+      {
+        n_res["value"] =
+          n_res["value"].to_float64() / n_res["count"].to_float64();
+      }
+    }
+  }
+  else
+  {
+    // the input was already executed into a field
+    const std::string field = (*input<conduit::Node>(0))["value"].as_string();
+    if(reduction != "sum" && !is_scalar_field(*dataset, field))
+    {
+      ASCENT_ERROR("Field " << reduction << ": field '" << field
+                            << "' is not a scalar field");
+    }
+    if(reduction == "min")
+    {
+      n_res = field_min(*dataset, field);
+    }
+    else if(reduction == "max")
+    {
+      n_res = field_max(*dataset, field);
+    }
+    else if(reduction == "avg")
+    {
+      n_res = field_avg(*dataset, field);
+    }
+    else
+    {
+      n_res = field_sum(*dataset, field);
+    }
+  }
+
+  // same outputs as the unfused reduction filters
+  conduit::Node *output = new conduit::Node();
+  if(reduction == "min" || reduction == "max")
+  {
+    (*output)["type"] = "value_position";
+    (*output)["attrs/value/value"] = n_res["value"];
+    (*output)["attrs/value/type"] = "double";
+    (*output)["attrs/position/value"] = n_res["position"];
+    (*output)["attrs/position/type"] = "vector";
+    // information about the element/field
+    (*output)["attrs/element/rank"] = n_res["rank"];
+    (*output)["attrs/element/domain_index"] = n_res["domain_id"];
+    (*output)["attrs/element/index"] = n_res["index"];
+    (*output)["attrs/element/assoc"] = n_res["assoc"];
+  }
+  else
+  {
+    (*output)["value"] = n_res["value"];
+    (*output)["type"] = "double";
+  }
+
+  if(reduction != "max")
+  {
+    resolve_symbol_result(graph(), output, this->name());
+  }
+  set_output<conduit::Node>(output);
+}
+
 //-----------------------------------------------------------------------------
 class ExprJitFilterFactoryFunctor
 {
@@ -43,6 +43,8 @@ public:
   virtual void execute();
 
 private:
+  void execute_reduction();
+
   int num_inputs;
   const std::shared_ptr<const JitExecutionPolicy> exec_policy;
 };
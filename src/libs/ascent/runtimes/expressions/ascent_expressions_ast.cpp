@@ -116,6 +116,25 @@ is_field_type(const std::string &type)
 {
   return type == "field" || type == "jitable";
 }
+
+// the reduction a jit filter can fuse in place of the given filter type,
+// empty if there is none
+std::string
+fusable_reduction(const std::string &filter_type)
+{
+  const std::string prefix = "expr_mesh_field_reduction_";
+  if(filter_type.compare(0, prefix.size(), prefix) != 0)
+  {
+    return "";
+  }
+  const std::string reduction = filter_type.substr(prefix.size());
+  if(reduction == "min" || reduction == "max" || reduction == "sum" ||
+     reduction == "avg")
+  {
+    return reduction;
+  }
+  return "";
+}
 } // namespace detail
 
 //-----------------------------------------------------------------------------
@@ -808,62 +827,90 @@ BuildGraphVisitor::visit(const ASTMethodCall &call)
         name = ss.str();
       }
 
-      // we will have some optional parameters, prep the null_args filter
-      if(!opt_args.empty())
+      // reductions of a jitable are fused into the jitable's kernel so the
+      // derived field never has to be executed into the dataset
+      const std::string fused_reduction =
+          detail::fusable_reduction(func["filter_name"].as_string());
+      if(!fused_reduction.empty() && args_map.size() == 1 &&
+         (*args_map.begin()->second)["type"].as_string() == "jitable")
+      {
+        const conduit::Node &arg = *args_map.begin()->second;
+        conduit::Node params;
+        params["func"] = "reduce";
+        params["filter_name"] = name;
+        params["reduction"] = fused_reduction;
+        conduit::Node &inp = params["inputs/jitable"];
+        inp = arg;
+        inp["port"] = 0;
+        w.graph().add_filter(
+            expressions::register_jit_filter(
+                w,
+                1,
+                std::make_shared<const expressions::AlwaysExecutePolicy>()),
+            name,
+            params);
+        // src, dest, port
+        w.graph().connect(arg["filter_name"].as_string(), name, 0);
+      }
+      else
       {
-        if(!w.graph().has_filter("null_arg"))
+        // we will have some optional parameters, prep the null_args filter
+        if(!opt_args.empty())
         {
-          conduit::Node null_params;
-          w.graph().add_filter("expr_null", "null_arg", null_params);
+          if(!w.graph().has_filter("null_arg"))
+          {
+            conduit::Node null_params;
+            w.graph().add_filter("expr_null", "null_arg", null_params);
+          }
         }
-      }
 
-      conduit::Node params;
-      w.graph().add_filter(func["filter_name"].as_string(), name, params);
+        conduit::Node params;
+        w.graph().add_filter(func["filter_name"].as_string(), name, params);
 
-      // connect up all the arguments
-      for(auto const &arg : args_map)
-      {
-        std::string inp_filter_name = (*arg.second)["filter_name"].as_string();
-        // we must to execute inputs that are jitables if the function is
-        // not jitable
-        if((*arg.second)["type"].as_string() == "jitable")
+        // connect up all the arguments
+        for(auto const &arg : args_map)
         {
-          // create a unique name for the filter
-          std::stringstream ss;
-          ss << "jit_method_execute_" << inp_filter_name;
-          const std::string jit_execute_name = ss.str();
-          if(!subexpr_cache.has_path(jit_execute_name))
+          std::string inp_filter_name = (*arg.second)["filter_name"].as_string();
+          // we must to execute inputs that are jitables if the function is
+          // not jitable
+          if((*arg.second)["type"].as_string() == "jitable")
           {
-            conduit::Node params;
-            params["func"] = "execute";
-            params["filter_name"] = jit_execute_name;
-            conduit::Node &inp = params["inputs/jitable"];
-            inp = *arg.second;
-            inp["port"] = 0;
-            w.graph().add_filter(
-                expressions::register_jit_filter(
-                    w,
-                    1,
-                    std::make_shared<const expressions::AlwaysExecutePolicy>()),
-                jit_execute_name,
-                params);
-            // src, dest, port
-            w.graph().connect(inp_filter_name, jit_execute_name, 0);
-            subexpr_cache[jit_execute_name];
+            // create a unique name for the filter
+            std::stringstream ss;
+            ss << "jit_method_execute_" << inp_filter_name;
+            const std::string jit_execute_name = ss.str();
+            if(!subexpr_cache.has_path(jit_execute_name))
+            {
+              conduit::Node params;
+              params["func"] = "execute";
+              params["filter_name"] = jit_execute_name;
+              conduit::Node &inp = params["inputs/jitable"];
+              inp = *arg.second;
+              inp["port"] = 0;
+              w.graph().add_filter(
+                  expressions::register_jit_filter(
+                      w,
+                      1,
+                      std::make_shared<const expressions::AlwaysExecutePolicy>()),
+                  jit_execute_name,
+                  params);
+              // src, dest, port
+              w.graph().connect(inp_filter_name, jit_execute_name, 0);
+              subexpr_cache[jit_execute_name];
+            }
+            inp_filter_name = jit_execute_name;
           }
-          inp_filter_name = jit_execute_name;
+          // src, dest, port
+          w.graph().connect(inp_filter_name, name, arg.first);
         }
-        // src, dest, port
-        w.graph().connect(inp_filter_name, name, arg.first);
-      }
 
-      // connect null filter to optional args that weren't passed in
-      for(std::unordered_set<std::string>::iterator it = opt_args.begin();
-          it != opt_args.end();
-          ++it)
-      {
-        w.graph().connect("null_arg", name, *it);
+        // connect null filter to optional args that weren't passed in
+        for(std::unordered_set<std::string>::iterator it = opt_args.begin();
+            it != opt_args.end();
+            ++it)
+        {
+          w.graph().connect("null_arg", name, *it);
+        }
       }
     }
 
@@ -326,6 +326,290 @@ FieldCode::hex_gradient(InsertionOrderedSet<std::string> &code,
   code.insert(res_name + "[2] *= " + res_name + "_inv_vol;\n");
 }
 
+// solves J * grad = v_i - v_0 where the rows of J are p_i - p_0, the
+// gradient of a linear tet is exact
+void
+FieldCode::tet_gradient(InsertionOrderedSet<std::string> &code,
+                        const std::string &res_name) const
+{
+  const std::string vertex_locs = topo_code->topo_name + "_vertex_locs";
+  const std::string vertex_values = res_name + "_vertex_values";
+  element_vertex_values(code, vertex_values, component, true);
+  code.insert({"double " + res_name + "_x[3];\n",
+               "double " + res_name + "_y[3];\n",
+               "double " + res_name + "_z[3];\n",
+               "double " + res_name + "_v[3];\n"});
+  for(int i = 0; i < 3; ++i)
+  {
+    const std::string row = std::to_string(i);
+    const std::string vert = std::to_string(i + 1);
+    code.insert({res_name + "_x[" + row + "] = " + vertex_locs + "[" + vert +
+                     "][0] - " + vertex_locs + "[0][0];\n",
+                 res_name + "_y[" + row + "] = " + vertex_locs + "[" + vert +
+                     "][1] - " + vertex_locs + "[0][1];\n",
+                 res_name + "_z[" + row + "] = " + vertex_locs + "[" + vert +
+                     "][2] - " + vertex_locs + "[0][2];\n",
+                 res_name + "_v[" + row + "] = " +
+                     array_code.index(vertex_values, vert) + " - " +
+                     array_code.index(vertex_values, "0") + ";\n"});
+  }
+  math_code.determinant_3x3(code,
+                            res_name + "_x",
+                            res_name + "_y",
+                            res_name + "_z",
+                            res_name + "_vol");
+  code.insert("const double " + res_name + "_inv_vol = 1.0 / (tiny + " +
+              res_name + "_vol);\n");
+  math_code.determinant_3x3(code,
+                            res_name + "_v",
+                            res_name + "_y",
+                            res_name + "_z",
+                            res_name + "[0]",
+                            false);
+  code.insert(res_name + "[0] *= " + res_name + "_inv_vol;\n");
+  math_code.determinant_3x3(code,
+                            res_name + "_x",
+                            res_name + "_v",
+                            res_name + "_z",
+                            res_name + "[1]",
+                            false);
+  code.insert(res_name + "[1] *= " + res_name + "_inv_vol;\n");
+  math_code.determinant_3x3(code,
+                            res_name + "_x",
+                            res_name + "_y",
+                            res_name + "_v",
+                            res_name + "[2]",
+                            false);
+  code.insert(res_name + "[2] *= " + res_name + "_inv_vol;\n");
+}
+
+// the 2d version of tet_gradient
+void
+FieldCode::tri_gradient(InsertionOrderedSet<std::string> &code,
+                        const std::string &res_name) const
+{
+  const std::string vertex_locs = topo_code->topo_name + "_vertex_locs";
+  const std::string vertex_values = res_name + "_vertex_values";
+  element_vertex_values(code, vertex_values, component, true);
+  code.insert({"double " + res_name + "_x[2];\n",
+               "double " + res_name + "_y[2];\n",
+               "double " + res_name + "_v[2];\n"});
+  for(int i = 0; i < 2; ++i)
+  {
+    const std::string row = std::to_string(i);
+    const std::string vert = std::to_string(i + 1);
+    code.insert({res_name + "_x[" + row + "] = " + vertex_locs + "[" + vert +
+                     "][0] - " + vertex_locs + "[0][0];\n",
+                 res_name + "_y[" + row + "] = " + vertex_locs + "[" + vert +
+                     "][1] - " + vertex_locs + "[0][1];\n",
+                 res_name + "_v[" + row + "] = " +
+                     array_code.index(vertex_values, vert) + " - " +
+                     array_code.index(vertex_values, "0") + ";\n"});
+  }
+  math_code.determinant_2x2(
+      code, res_name + "_x", res_name + "_y", res_name + "_area");
+  code.insert("const double " + res_name + "_inv_vol = 1.0 / (tiny + " +
+              res_name + "_area);\n");
+  math_code.determinant_2x2(
+      code, res_name + "_v", res_name + "_y", res_name + "[0]", false);
+  code.insert(res_name + "[0] *= " + res_name + "_inv_vol;\n");
+  math_code.determinant_2x2(
+      code, res_name + "_x", res_name + "_v", res_name + "[1]", false);
+  code.insert(res_name + "[1] *= " + res_name + "_inv_vol;\n");
+  code.insert(res_name + "[2] = 0;\n");
+}
+
+// minimizes sum_n ((c_n - c) . grad - (v_n - v))^2 over the neighbors n,
+// i.e. solves (A^T A) grad = A^T b. Elements whose face neighbors do not span
+// the space (e.g. corners) fall back to the elements sharing a vertex. A^T A
+// is treated as singular relative to trace(A^T A)^dim so the test does not
+// depend on the size of the elements
+void
+FieldCode::element_neighbor_gradient(InsertionOrderedSet<std::string> &code,
+                                     const std::string &res_name) const
+{
+  const std::string &topo_name = topo_code->topo_name;
+  const int num_dims = topo_code->num_dims;
+  if(num_dims != 2 && num_dims != 3)
+  {
+    ASCENT_ERROR("Gradient is not implemented for 1D unstructured meshes.");
+  }
+  const std::string shape_size = std::to_string(topo_code->shape_size);
+  const std::string ata = res_name + "_ata";
+  const std::string atb = res_name + "_atb";
+  const std::string det = res_name + "_det";
+  const std::string singular = res_name + "_singular";
+  topo_code->element_xyz(code);
+  code.insert({"double " + ata + "[3][3];\n",
+               "double " + atb + "[3];\n",
+               "double " + det + ";\n",
+               "double " + singular + ";\n",
+               "const double " + res_name + "_value = " +
+                   array_code.index(field_name, "item", component) + ";\n"});
+
+  InsertionOrderedSet<std::string> zero_code;
+  for(int a = 0; a < 3; ++a)
+  {
+    zero_code.insert(atb + "[" + std::to_string(a) + "] = 0;\n");
+    for(int b = 0; b < 3; ++b)
+    {
+      zero_code.insert(ata + "[" + std::to_string(a) + "][" +
+                       std::to_string(b) + "] = 0;\n");
+    }
+  }
+
+  // adds the neighbor res_name_nbr to A^T A and A^T b
+  InsertionOrderedSet<std::string> center_loop;
+  center_loop.insert({"for(int " + res_name + "_v = 0; " + res_name + "_v < " +
+                          shape_size + "; ++" + res_name + "_v)\n",
+                      "{\n",
+                      "const int " + res_name + "_vert = " +
+                          array_code.index(topo_name + "_connectivity",
+                                           res_name + "_nbr * " + shape_size +
+                                               " + " + res_name + "_v") +
+                          ";\n"});
+  for(int d = 0; d < num_dims; ++d)
+  {
+    center_loop.insert(res_name + "_center[" + std::to_string(d) + "] += " +
+                       array_code.index(topo_name + "_coords",
+                                        res_name + "_vert",
+                                        std::string(1, 'x' + d)) +
+                       ";\n");
+  }
+  center_loop.insert("}\n");
+
+  InsertionOrderedSet<std::string> add_nbr;
+  add_nbr.insert({"double " + res_name + "_center[3];\n",
+                  "double " + res_name + "_d[3];\n"});
+  for(int d = 0; d < num_dims; ++d)
+  {
+    add_nbr.insert(res_name + "_center[" + std::to_string(d) + "] = 0;\n");
+  }
+  add_nbr.insert(center_loop.accumulate());
+  for(int d = 0; d < num_dims; ++d)
+  {
+    const std::string d_str = std::to_string(d);
+    add_nbr.insert(res_name + "_d[" + d_str + "] = " + res_name + "_center[" +
+                   d_str + "] / " + shape_size + " - " + topo_name +
+                   "_element_loc[" + d_str + "];\n");
+  }
+  add_nbr.insert("const double " + res_name + "_dv = " +
+                 array_code.index(field_name, res_name + "_nbr", component) +
+                 " - " + res_name + "_value;\n");
+  for(int a = 0; a < num_dims; ++a)
+  {
+    const std::string a_str = std::to_string(a);
+    add_nbr.insert(atb + "[" + a_str + "] += " + res_name + "_d[" + a_str +
+                   "] * " + res_name + "_dv;\n");
+    for(int b = 0; b < num_dims; ++b)
+    {
+      const std::string b_str = std::to_string(b);
+      add_nbr.insert(ata + "[" + a_str + "][" + b_str + "] += " + res_name +
+                     "_d[" + a_str + "] * " + res_name + "_d[" + b_str +
+                     "];\n");
+    }
+  }
+
+  // det(A^T A) and the threshold below which it is considered singular, both
+  // scale with length^(2 * dim). A^T A is symmetric so its rows are its columns
+  InsertionOrderedSet<std::string> det_code;
+  std::string trace = ata + "[0][0] + " + ata + "[1][1]";
+  if(num_dims == 3)
+  {
+    math_code.determinant_3x3(
+        det_code, ata + "[0]", ata + "[1]", ata + "[2]", det, false);
+    trace += " + " + ata + "[2][2]";
+  }
+  else
+  {
+    math_code.determinant_2x2(det_code, ata + "[0]", ata + "[1]", det, false);
+  }
+  det_code.insert(singular + " = " + trace + ";\n");
+  det_code.insert(singular + " = 1.e-10 * " + singular + " * " + singular +
+                  (num_dims == 3 ? " * " + singular : "") + ";\n");
+
+  // face neighbors (packed by JitableFusion)
+  InsertionOrderedSet<std::string> nbr_loop;
+  nbr_loop.insert(
+      {"for(int " + res_name + "_n = " +
+           array_code.index(topo_name + "_element_neighbor_offsets", "item") +
+           "; " + res_name + "_n < " +
+           array_code.index(topo_name + "_element_neighbor_offsets",
+                            "item + 1") +
+           "; ++" + res_name + "_n)\n",
+       "{\n",
+       "const int " + res_name + "_nbr = " +
+           array_code.index(topo_name + "_element_neighbors", res_name + "_n") +
+           ";\n"});
+  nbr_loop.insert(add_nbr.accumulate());
+  nbr_loop.insert("}\n");
+
+  code.insert(zero_code.accumulate());
+  code.insert(nbr_loop.accumulate());
+  code.insert(det_code.accumulate());
+
+  // vertex sharing neighbors (packed by JitableFusion). Elements sharing more
+  // than one vertex are added more than once which only reweights the fit
+  const std::string offsets = topo_name + "_vertex_element_offsets";
+  InsertionOrderedSet<std::string> fallback;
+  fallback.insert({"if(fabs(" + det + ") <= " + singular + ")\n", "{\n"},
+                  false);
+  fallback.insert(zero_code.accumulate(), false);
+  fallback.insert({"for(int " + res_name + "_ev = 0; " + res_name + "_ev < " +
+                       shape_size + "; ++" + res_name + "_ev)\n",
+                   "{\n",
+                   "const int " + res_name + "_evert = " +
+                       array_code.index(topo_name + "_connectivity",
+                                        "item * " + shape_size + " + " +
+                                            res_name + "_ev") +
+                       ";\n",
+                   "for(int " + res_name + "_e = " +
+                       array_code.index(offsets, res_name + "_evert") + "; " +
+                       res_name + "_e < " +
+                       array_code.index(offsets, res_name + "_evert + 1") +
+                       "; ++" + res_name + "_e)\n",
+                   "{\n",
+                   "const int " + res_name + "_nbr = " +
+                       array_code.index(topo_name + "_vertex_elements",
+                                        res_name + "_e") +
+                       ";\n",
+                   "if(" + res_name + "_nbr != item)\n",
+                   "{\n"},
+                  false);
+  fallback.insert(add_nbr.accumulate(), false);
+  fallback.insert({"}\n", "}\n", "}\n"}, false);
+  fallback.insert(det_code.accumulate(), false);
+  fallback.insert("}\n", false);
+  code.insert(fallback.accumulate());
+
+  // elements that are still singular (e.g. a single element) get a zero
+  // gradient
+  code.insert("const double " + res_name + "_inv_det = fabs(" + det +
+              ") <= " + singular + " ? 0.0 : 1.0 / " + det + ";\n");
+  if(num_dims == 3)
+  {
+    math_code.determinant_3x3(
+        code, atb, ata + "[1]", ata + "[2]", res_name + "[0]", false);
+    math_code.determinant_3x3(
+        code, ata + "[0]", atb, ata + "[2]", res_name + "[1]", false);
+    math_code.determinant_3x3(
+        code, ata + "[0]", ata + "[1]", atb, res_name + "[2]", false);
+    code.insert({res_name + "[0] *= " + res_name + "_inv_det;\n",
+                 res_name + "[1] *= " + res_name + "_inv_det;\n",
+                 res_name + "[2] *= " + res_name + "_inv_det;\n"});
+  }
+  else
+  {
+    math_code.determinant_2x2(
+        code, atb, ata + "[1]", res_name + "[0]", false);
+    math_code.determinant_2x2(
+        code, ata + "[0]", atb, res_name + "[1]", false);
+    code.insert({res_name + "[0] *= " + res_name + "_inv_det;\n",
+                 res_name + "[1] *= " + res_name + "_inv_det;\n",
+                 res_name + "[2] = 0;\n"});
+  }
+}
+
 // if_body is executed if the target element/vertex (e.g. upper, lower, current)
 // is within the mesh boundary otherwise else_body is executed
 void
@@ -448,23 +732,40 @@ FieldCode::gradient(InsertionOrderedSet<std::string> &code) const
       {
         quad_gradient(code, gradient_name);
       }
+      else if(topo_code->shape == "tet")
+      {
+        tet_gradient(code, gradient_name);
+      }
+      else if(topo_code->shape == "tri" && topo_code->num_dims == 2)
+      {
+        tri_gradient(code, gradient_name);
+      }
       else
       {
         ASCENT_ERROR("Gradient of unstructured vertex associated fields only "
-                     "works on hex and quad shapes. The given shape was '"
+                     "works on hex, quad, tet and 2D tri shapes. The given "
+                     "shape was '"
                      << topo_code->shape << "'.");
       }
     }
     return;
   }
 
+  // element associated fields on unstructured meshes use the element
+  // neighbors and the vertex to element adjacency (packed by JitableFusion)
+  if(association == "element" && topo_code->topo_type == "unstructured")
+  {
+    element_neighbor_gradient(code, gradient_name);
+    return;
+  }
+
   // handle uniforma and rectilinear gradients
   if(topo_code->topo_type != "uniform" && topo_code->topo_type != "rectilinear")
   {
     ASCENT_ERROR("Unsupported topo_type: '"
                  << topo_code->topo_type
-                 << "'. Gradient is not implemented for unstructured "
-                    "topologies nor structured element associated fields.");
+                 << "'. Gradient is not implemented for structured element "
+                    "associated fields.");
   }
 
   if(association == "element")
@@ -580,6 +881,21 @@ FieldCode::curl(InsertionOrderedSet<std::string> &code) const
               field_name + "_0_gradient[1];\n");
 }
 
+void
+FieldCode::divergence(InsertionOrderedSet<std::string> &code) const
+{
+  // assumes the gradient for each component is present (generated in
+  // JitableFusion::divergence)
+  std::string res = "const double " + field_name + "_divergence = ";
+  for(int i = 0; i < num_components && i < 3; ++i)
+  {
+    const std::string i_str = std::to_string(i);
+    res += (i > 0 ? " + " : "") + field_name + "_" + i_str + "_gradient[" +
+           i_str + "]";
+  }
+  code.insert(res + ";\n");
+}
+
 // recursive function to run "body" for all elements surrounding a vertex in a
 // structured topology
 void
@@ -703,10 +1019,66 @@ FieldCode::recenter(InsertionOrderedSet<std::string> &code,
 
       code.insert(avg_code);
     }
+    else if(topo_code->topo_type == "unstructured")
+    {
+      // average over the vertex to element adjacency (packed by
+      // JitableFusion)
+      const std::string &topo_name = topo_code->topo_name;
+      const std::string offsets = topo_name + "_vertex_element_offsets";
+      code.insert({"const int " + res_name + "_begin = " +
+                       array_code.index(offsets, "item") + ";\n",
+                   "const int " + res_name + "_end = " +
+                       array_code.index(offsets, "item + 1") + ";\n",
+                   "const double " + res_name + "_inv_num_adj = " + res_name +
+                       "_end > " + res_name + "_begin ? 1.0 / (" + res_name +
+                       "_end - " + res_name + "_begin) : 0.0;\n"});
+
+      InsertionOrderedSet<std::string> for_loop;
+      InsertionOrderedSet<std::string> avg_code;
+      for_loop.insert({"for(int " + res_name + "_e = " + res_name +
+                           "_begin; " + res_name + "_e < " + res_name +
+                           "_end; ++" + res_name + "_e)\n",
+                       "{\n",
+                       "const int " + res_name + "_elem = " +
+                           array_code.index(topo_name + "_vertex_elements",
+                                            res_name + "_e") +
+                           ";\n"});
+      if(component == -1 && num_components > 1)
+      {
+        code.insert("double " + res_name + "_sum[" +
+                    std::to_string(num_components) + "];\n");
+        avg_code.insert("double " + res_name + "[" +
+                        std::to_string(num_components) + "];\n");
+        for(int i = 0; i < num_components; ++i)
+        {
+          const std::string i_str = std::to_string(i);
+          code.insert(res_name + "_sum[" + i_str + "] = 0;\n");
+          for_loop.insert(res_name + "_sum[" + i_str + "] += " +
+                          array_code.index(field_name, res_name + "_elem", i) +
+                          ";\n");
+          avg_code.insert(res_name + "[" + i_str + "] = " + res_name +
+                          "_sum[" + i_str + "] * " + res_name +
+                          "_inv_num_adj;\n");
+        }
+      }
+      else
+      {
+        code.insert("double " + res_name + "_sum = 0;\n");
+        for_loop.insert(
+            res_name + "_sum += " +
+            array_code.index(field_name, res_name + "_elem", component) +
+            ";\n");
+        avg_code.insert("const double " + res_name + " = " + res_name +
+                        "_sum * " + res_name + "_inv_num_adj;\n");
+      }
+      for_loop.insert("}\n");
+      code.insert(for_loop.accumulate());
+      code.insert(avg_code);
+    }
     else
     {
-      ASCENT_ERROR("Element to Vertex recenter is not implemented on "
-                   "unstructured meshes.");
+      ASCENT_ERROR("Element to Vertex recenter is not implemented on '"
+                   << topo_code->topo_type << "' topologies.");
     }
   }
 }
@@ -52,6 +52,8 @@ public:
 
   void curl(InsertionOrderedSet<std::string> &code) const;
 
+  void divergence(InsertionOrderedSet<std::string> &code) const;
+
   void recenter(InsertionOrderedSet<std::string> &code,
                 const std::string &target_association,
                 const std::string &res_name) const;
@@ -67,6 +69,21 @@ private:
   void quad_gradient(InsertionOrderedSet<std::string> &code,
                      const std::string &res_name) const;
 
+  // Calculate the element associated gradient of a vertex associated field on
+  // a tetrahedral mesh
+  void tet_gradient(InsertionOrderedSet<std::string> &code,
+                    const std::string &res_name) const;
+
+  // Calculate the element associated gradient of a vertex associated field on
+  // a triangle mesh
+  void tri_gradient(InsertionOrderedSet<std::string> &code,
+                    const std::string &res_name) const;
+
+  // Least squares gradient of an element associated field on an unstructured
+  // mesh from the centers of the face (3d) or edge (2d) neighbors
+  void element_neighbor_gradient(InsertionOrderedSet<std::string> &code,
+                                 const std::string &res_name) const;
+
   void element_vertex_values(InsertionOrderedSet<std::string> &code,
                              const std::string &res_name,
                              const int component,
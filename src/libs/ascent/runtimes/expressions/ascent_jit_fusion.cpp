@@ -612,8 +612,26 @@ JitableFusion::gradient(const int field_port, const int component)
       topologyFactory(out_jitable.topology, domain);
   std::string field_name = possible_temporary(field_port);
 
+  // out_jitable.association is shared by all domains and was already updated
+  // by the first one, use the association of the input field instead
+  const std::string &field_association =
+      input_jitables[field_port]->association;
+
+  // element gradients on unstructured meshes need the element neighbors, and
+  // the elements around each vertex for elements whose face neighbors do not
+  // span the space, of every domain, even if the kernel is already generated
+  if(topo->topo_type == "unstructured" && field_association == "element")
+  {
+    pack_adjacency(topo->topo_name,
+                   domain,
+                   true,
+                   true,
+                   out_jitable.dom_info.child(dom_idx)["args"],
+                   out_jitable.arrays[dom_idx]);
+  }
+
   if((topo->topo_type == "structured" || topo->topo_type == "unstructured") &&
-     out_jitable.association == "vertex")
+     field_association == "vertex")
   {
     // this does a vertex to cell gradient so update entries
     conduit::Node &n_entries = out_jitable.dom_info.child(dom_idx)["entries"];
@@ -681,68 +699,117 @@ JitableFusion::curl()
 }
 
 void
-JitableFusion::recenter()
+JitableFusion::divergence()
 {
+  const int field_port = inputs["field/port"].as_int32();
+  const Kernel &field_kernel = *input_kernels[field_port];
+  if(field_kernel.num_components < 2)
+  {
+    ASCENT_ERROR("Divergence is only implemented for fields with at least 2 "
+                 "components. The input field has "
+                 << field_kernel.num_components << ".");
+  }
+  const std::string field_name = possible_temporary(field_port);
+  // calling gradient here reuses the logic to update entries and association
+  for(int i = 0; i < field_kernel.num_components; ++i)
+  {
+    gradient(field_port, i);
+  }
   if(not_fused)
   {
-    const int field_port = inputs["field/port"].as_int32();
-    const Kernel &field_kernel = *input_kernels[field_port];
+    const auto topo_code = std::make_shared<const TopologyCode>(
+        out_jitable.topology, domain, out_jitable.arrays[dom_idx]);
+    FieldCode field_code = FieldCode(field_name,
+                                     out_jitable.association,
+                                     topo_code,
+                                     out_jitable.arrays[dom_idx],
+                                     field_kernel.num_components,
+                                     -1);
+    field_code.divergence(out_kernel.for_body);
+    out_kernel.expr = field_name + "_divergence";
+    out_kernel.num_components = 1;
+  }
+}
+
+void
+JitableFusion::recenter()
+{
+  const int field_port = inputs["field/port"].as_int32();
+  const Kernel &field_kernel = *input_kernels[field_port];
+  // out_jitable.association is shared by all domains and was already updated
+  // by the first one, use the association of the input field instead
+  const std::string &field_association =
+      input_jitables[field_port]->association;
 
-    std::string mode;
-    if(inputs.has_path("mode"))
+  std::string mode;
+  if(inputs.has_path("mode"))
+  {
+    const int mode_port = inputs["mode/port"].as_int32();
+    const Jitable &mode_jitable = *input_jitables[mode_port];
+    mode = mode_jitable.obj["value"].as_string();
+    if(mode != "toggle" && mode != "vertex" && mode != "element")
     {
-      const int mode_port = inputs["mode/port"].as_int32();
-      const Jitable &mode_jitable = *input_jitables[mode_port];
-      mode = mode_jitable.obj["value"].as_string();
-      if(mode != "toggle" && mode != "vertex" && mode != "element")
-      {
-        ASCENT_ERROR("recenter: Unknown mode '"
-                     << mode
-                     << "'. Known modes are 'toggle', 'vertex', 'element'.");
-      }
-      if(out_jitable.association == mode)
-      {
-        ASCENT_ERROR("Recenter: The field is already "
-                     << out_jitable.association
-                     << " associated, redundant recenter.");
-      }
+      ASCENT_ERROR("recenter: Unknown mode '"
+                   << mode
+                   << "'. Known modes are 'toggle', 'vertex', 'element'.");
     }
-    else
+    if(field_association == mode)
     {
-      mode = "toggle";
+      ASCENT_ERROR("Recenter: The field is already "
+                   << field_association
+                   << " associated, redundant recenter.");
     }
-    std::string target_association;
-    if(mode == "toggle")
+  }
+  else
+  {
+    mode = "toggle";
+  }
+  std::string target_association;
+  if(mode == "toggle")
+  {
+    if(field_association == "vertex")
     {
-      if(out_jitable.association == "vertex")
-      {
-        target_association = "element";
-      }
-      else
-      {
-        target_association = "vertex";
-      }
+      target_association = "element";
     }
     else
     {
-      target_association = mode;
+      target_association = "vertex";
     }
+  }
+  else
+  {
+    target_association = mode;
+  }
 
-    const std::string field_name = possible_temporary(field_port);
+  // update entries and association
+  conduit::Node &n_entries = out_jitable.dom_info.child(dom_idx)["entries"];
+  std::unique_ptr<Topology> topo =
+      topologyFactory(out_jitable.topology, domain);
+  if(target_association == "vertex")
+  {
+    n_entries = topo->get_num_points();
+  }
+  else
+  {
+    n_entries = topo->get_num_cells();
+  }
+  out_jitable.association = target_association;
 
-    // update entries and association
-    conduit::Node &n_entries = out_jitable.dom_info.child(dom_idx)["entries"];
-    std::unique_ptr<Topology> topo =
-        topologyFactory(out_jitable.topology, domain);
-    if(target_association == "vertex")
-    {
-      n_entries = topo->get_num_points();
-    }
-    else
-    {
-      n_entries = topo->get_num_cells();
-    }
-    out_jitable.association = target_association;
+  // vertex recentering on unstructured meshes needs the elements around each
+  // vertex of every domain, even if the kernel is already generated
+  if(topo->topo_type == "unstructured" && target_association == "vertex")
+  {
+    pack_adjacency(topo->topo_name,
+                   domain,
+                   true,
+                   false,
+                   out_jitable.dom_info.child(dom_idx)["args"],
+                   out_jitable.arrays[dom_idx]);
+  }
+
+  if(not_fused)
+  {
+    const std::string field_name = possible_temporary(field_port);
 
     const auto topo_code = std::make_shared<const TopologyCode>(
         out_jitable.topology, domain, out_jitable.arrays[dom_idx]);
@@ -59,6 +59,7 @@ public:
   void constant_field();
   void gradient();
   void curl();
+  void divergence();
   void recenter();
   void magnitude();
   void vector();
@@ -82,20 +82,8 @@ Kernel::generate_loop(const std::string &output,
          "{\n"
            "if (item < " + entries_name + ")\n"
            "{\n" +
-              for_body.accumulate();
-              if(num_components > 1)
-              {
-                for(int i = 0; i < num_components; ++i)
-                {
-                  res += array_code.index(output, "item", i) + " = " + expr +
-                    "[" + std::to_string(i) + "];\n";
-                }
-              }
-              else
-              {
-                res += array_code.index(output, "item") + " = " + expr + ";\n";
-              }
-  res +=
+              for_body.accumulate() +
+              generate_store(output, array_code) +
            "}\n"
          "}\n"
        "}\n";
@@ -103,6 +91,171 @@ Kernel::generate_loop(const std::string &output,
   // clang-format on
 }
 
+// same as generate_loop but over the items of all domains. prelude
+// declares the per-domain variables from the domain index jag_dom
+std::string
+Kernel::generate_jagged_loop(const std::string &output,
+                             const ArrayCode &array_code,
+                             const std::string &prelude,
+                             const std::string &total_name,
+                             const std::string &offsets_name,
+                             const std::string &num_domains_name) const
+{
+  // clang-format off
+  std::string res =
+    "for (int group = 0; group < " + total_name + "; group += 128; @outer)\n"
+       "{\n"
+         "for (int jag_item = group; jag_item < (group + 128); ++jag_item; @inner)\n"
+         "{\n"
+           "if (jag_item < " + total_name + ")\n"
+           "{\n"
+             // the last domain that starts at or before the item, which
+             // also skips over empty domains
+             "int jag_lo = 0;\n"
+             "int jag_hi = " + num_domains_name + " - 1;\n"
+             "while (jag_lo < jag_hi)\n"
+             "{\n"
+               "const int jag_mid = (jag_lo + jag_hi + 1) / 2;\n"
+               "if (" + offsets_name + "[jag_mid] <= jag_item)\n"
+               "{\n"
+                 "jag_lo = jag_mid;\n"
+               "}\n"
+               "else\n"
+               "{\n"
+                 "jag_hi = jag_mid - 1;\n"
+               "}\n"
+             "}\n"
+             "const int jag_dom = jag_lo;\n"
+             "const int item = jag_item - " + offsets_name + "[jag_dom];\n" +
+             prelude +
+             for_body.accumulate() +
+             generate_store(output, array_code) +
+           "}\n"
+         "}\n"
+       "}\n";
+  return res;
+  // clang-format on
+}
+
+// copy expr into the item'th entry of the array "output"
+std::string
+Kernel::generate_store(const std::string &output,
+                       const ArrayCode &array_code) const
+{
+  std::string res;
+  if(num_components > 1)
+  {
+    for(int i = 0; i < num_components; ++i)
+    {
+      res += array_code.index(output, "item", i) + " = " + expr + "[" +
+             std::to_string(i) + "];\n";
+    }
+  }
+  else
+  {
+    res += array_code.index(output, "item") + " = " + expr + ";\n";
+  }
+  return res;
+}
+
+// generate a grid-stride loop that reduces expr into "partial_value" (and
+// "partial_index" for min and max), one entry per group
+std::string
+Kernel::generate_reduction(const std::string &reduction,
+                           const ArrayCode &array_code,
+                           const std::string &entries_name,
+                           const std::string &groups_name) const
+{
+  const std::string size = std::to_string(group_size);
+  const bool has_index = reduction != "sum";
+  std::string init;
+  std::string combine;
+  if(reduction == "min")
+  {
+    init = "1.7976931348623157e+308";
+    combine = "if(value < acc || (value == acc && index < acc_index))\n"
+              "{\n"
+                "acc = value;\n"
+                "acc_index = index;\n"
+              "}\n";
+  }
+  else if(reduction == "max")
+  {
+    init = "-1.7976931348623157e+308";
+    combine = "if(value > acc || (value == acc && index < acc_index))\n"
+              "{\n"
+                "acc = value;\n"
+                "acc_index = index;\n"
+              "}\n";
+  }
+  else if(reduction == "sum")
+  {
+    init = "0.0";
+    combine = "acc += value;\n";
+  }
+  else
+  {
+    ASCENT_ERROR("JIT: Unknown reduction '" << reduction << "'");
+  }
+
+  // clang-format off
+  std::string res =
+    "for (int group = 0; group < " + groups_name + "; ++group; @outer)\n"
+    "{\n"
+      "@shared double s_value[" + size + "];\n";
+  if(has_index)
+  {
+    res += "@shared int s_index[" + size + "];\n";
+  }
+  res +=
+      "for (int thread = 0; thread < " + size + "; ++thread; @inner)\n"
+      "{\n"
+        "double acc = " + init + ";\n"
+        "int acc_index = -1;\n"
+        "for (int item = group * " + size + " + thread; item < " +
+             entries_name + "; item += " + groups_name + " * " + size + ")\n"
+        "{\n" +
+          for_body.accumulate() +
+          "const double value = " + expr + ";\n"
+          "const int index = item;\n" +
+          combine +
+        "}\n"
+        "s_value[thread] = acc;\n";
+  if(has_index)
+  {
+    res += "s_index[thread] = acc_index;\n";
+  }
+  res +=
+      "}\n"
+      // the inner loops above and below are separated by a barrier
+      "for (int thread = 0; thread < " + size + "; ++thread; @inner)\n"
+      "{\n"
+        "if (thread == 0)\n"
+        "{\n"
+          "double acc = " + init + ";\n"
+          "int acc_index = -1;\n"
+          "for (int i = 0; i < " + size + "; ++i)\n"
+          "{\n"
+            "const double value = s_value[i];\n";
+  res += has_index ? "const int index = s_index[i];\n" : "";
+  // a thread that saw nothing still holds the initial value, skip it so
+  // the index stays valid
+  res += has_index ? "if (index < 0) continue;\n" : "";
+  res +=    combine +
+          "}\n" +
+          array_code.index("partial_value", "group") + " = acc;\n";
+  if(has_index)
+  {
+    res += array_code.index("partial_index", "group") + " = acc_index;\n";
+  }
+  res +=
+        "}\n"
+      "}\n"
+    "}\n";
+  return res;
+  // clang-format on
+}
+
 //-----------------------------------------------------------------------------
 };
 //-----------------------------------------------------------------------------
@@ -46,6 +46,26 @@ public:
                             const ArrayCode &array_code,
                             const std::string &entries_name) const;
 
+  std::string generate_jagged_loop(const std::string &output,
+                                   const ArrayCode &array_code,
+                                   const std::string &prelude,
+                                   const std::string &total_name,
+                                   const std::string &offsets_name,
+                                   const std::string &num_domains_name) const;
+
+  std::string generate_store(const std::string &output,
+                             const ArrayCode &array_code) const;
+
+  // reduces expr with "min", "max" or "sum" into one partial result per
+  // group instead of writing it out
+  std::string generate_reduction(const std::string &reduction,
+                                 const ArrayCode &array_code,
+                                 const std::string &entries_name,
+                                 const std::string &groups_name) const;
+
+  static const int group_size = 128;
+  static const int max_reduction_groups = 1024;
+
   InsertionOrderedSet<std::string> functions;
   InsertionOrderedSet<std::string> kernel_body;
   InsertionOrderedSet<std::string> for_body;
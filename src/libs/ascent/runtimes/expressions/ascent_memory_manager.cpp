@@ -1,4 +1,5 @@
 #include "ascent_memory_manager.hpp"
+#include "ascent_array_registry.hpp"
 #include <ascent_logging.hpp>
 #include <ascent_logging_old.hpp>
 #include <ascent_config.h>
@@ -9,7 +10,14 @@
 #include <umpire/util/MemoryResourceTraits.hpp>
 #include <umpire/strategy/DynamicPoolList.hpp>
 #endif
+#if defined(ASCENT_DRAY_ENABLED)
+#include <dray/array_registry.hpp>
+#endif
+#include <flow_workspace.hpp>
+#include <algorithm>
 #include <cstring> // memcpy
+#include <fstream>
+#include <string>
 #include <conduit.hpp>
 
 #if defined(ASCENT_HIP_ENABLED)
@@ -38,6 +46,8 @@ int  AllocationManager::m_conduit_device_allocator_id = -1;
 bool AllocationManager::m_external_host_allocator = false;
 bool AllocationManager::m_external_device_allocator = false;
 
+bool AllocationManager::m_reset_process_peak = false;
+
 //-----------------------------------------------------------------------------
 int
 AllocationManager::host_allocator_id()
@@ -49,6 +59,13 @@ AllocationManager::host_allocator_id()
                        "Cannot access host allocator id");
 #else
     auto &rm = umpire::ResourceManager::getInstance ();
+    // devil ray creates a pool with the same name. Share it instead
+    // of making a second one
+    if(rm.isAllocator("HOST_POOL"))
+    {
+      m_host_allocator_id = rm.getAllocator("HOST_POOL").getId();
+      return m_host_allocator_id;
+    }
     auto allocator = rm.getAllocator("HOST");
     // we can use the umpire profiling to find a good default size
     auto pooled_allocator = rm.makeAllocator<umpire::strategy::DynamicPoolList>(
@@ -73,6 +90,13 @@ AllocationManager::device_allocator_id()
                        "Cannot access device allocator id");
 #else
     auto &rm = umpire::ResourceManager::getInstance ();
+    // devil ray creates a pool with the same name. Share it instead
+    // of making a second one
+    if(rm.isAllocator("GPU_POOL"))
+    {
+      m_device_allocator_id = rm.getAllocator("GPU_POOL").getId();
+      return m_device_allocator_id;
+    }
     auto allocator = rm.getAllocator("DEVICE");
     // we can use the umpire profiling to find a good default size
 
@@ -247,6 +271,195 @@ AllocationManager::set_conduit_mem_handlers()
 #endif
 }
 
+//-----------------------------------------------------------------------------
+void
+AllocationManager::memory_usage(conduit::Node &out)
+{
+  out.reset();
+  conduit::Node &host = out["host"];
+  host["conduit/bytes_allocated"] = (conduit::uint64) HostMemory::m_total_bytes_alloced;
+  host["conduit/allocations"] = (conduit::uint64) HostMemory::m_alloc_count;
+  host["conduit/frees"] = (conduit::uint64) HostMemory::m_free_count;
+  host["expression_arrays"] = (conduit::uint64) runtime::ArrayRegistry::host_usage();
+
+  conduit::Node &device = out["device"];
+  device["conduit/bytes_allocated"] = (conduit::uint64) DeviceMemory::m_total_bytes_alloced;
+  device["conduit/allocations"] = (conduit::uint64) DeviceMemory::m_alloc_count;
+  device["conduit/frees"] = (conduit::uint64) DeviceMemory::m_free_count;
+  device["expression_arrays"] = (conduit::uint64) runtime::ArrayRegistry::device_usage();
+  device["expression_arrays_high_water_mark"]
+    = (conduit::uint64) runtime::ArrayRegistry::high_water_mark();
+
+  out["expression_arrays"] = runtime::ArrayRegistry::num_arrays();
+
+#if defined(ASCENT_DRAY_ENABLED)
+  // dray arrays only count memory they own, borrowed data is
+  // already counted above
+  host["dray_arrays"] = (conduit::uint64) dray::ArrayRegistry::host_usage();
+  device["dray_arrays"] = (conduit::uint64) dray::ArrayRegistry::device_usage();
+  out["dray_arrays"] = dray::ArrayRegistry::number_of_arrays();
+#endif
+
+#if defined(ASCENT_UMPIRE_ENABLED)
+  // both libraries allocate out of these
+  auto &rm = umpire::ResourceManager::getInstance ();
+  if(m_host_allocator_id != -1)
+  {
+    umpire::Allocator host_allocator = rm.getAllocator(m_host_allocator_id);
+    host["pool/name"] = host_allocator.getName();
+    host["pool/current_size"] = (conduit::uint64) host_allocator.getCurrentSize();
+    host["pool/actual_size"] = (conduit::uint64) host_allocator.getActualSize();
+    host["pool/high_water_mark"] = (conduit::uint64) host_allocator.getHighWatermark();
+  }
+  if(m_device_allocator_id != -1)
+  {
+    umpire::Allocator device_allocator = rm.getAllocator(m_device_allocator_id);
+    device["pool/name"] = device_allocator.getName();
+    device["pool/current_size"] = (conduit::uint64) device_allocator.getCurrentSize();
+    device["pool/actual_size"] = (conduit::uint64) device_allocator.getActualSize();
+    device["pool/high_water_mark"] = (conduit::uint64) device_allocator.getHighWatermark();
+  }
+#endif
+}
+
+//-----------------------------------------------------------------------------
+namespace detail
+{
+
+// reads the resident set size and its peak (VmHWM) in bytes. Returns false
+// when /proc is not available
+bool
+read_proc_status(size_t &resident, size_t &peak)
+{
+  std::ifstream status("/proc/self/status");
+  if(!status.is_open())
+  {
+    return false;
+  }
+  bool found_rss = false;
+  bool found_hwm = false;
+  std::string line;
+  while(std::getline(status, line))
+  {
+    if(line.compare(0, 6, "VmRSS:") == 0)
+    {
+      resident = std::stoull(line.substr(6)) * 1024;
+      found_rss = true;
+    }
+    else if(line.compare(0, 6, "VmHWM:") == 0)
+    {
+      peak = std::stoull(line.substr(6)) * 1024;
+      found_hwm = true;
+    }
+  }
+  return found_rss && found_hwm;
+}
+
+// lowers VmHWM to the current resident size, needs linux >= 4.0
+bool
+reset_proc_peak()
+{
+  std::ofstream clear_refs("/proc/self/clear_refs");
+  if(!clear_refs.is_open())
+  {
+    return false;
+  }
+  clear_refs << "5";
+  return clear_refs.good();
+}
+
+// state at the last peak reset
+size_t host_current_at_reset = 0;
+size_t host_hwm_at_reset = 0;
+size_t device_current_at_reset = 0;
+size_t device_pool_hwm_at_reset = 0;
+
+} // namespace detail
+
+//-----------------------------------------------------------------------------
+void
+AllocationManager::sample_memory(bool reset_peak, flow::MemoryUsage &usage)
+{
+  usage.allocated = HostMemory::m_total_bytes_alloced +
+                    DeviceMemory::m_total_bytes_alloced;
+
+  // host: the whole process, so vtk-m and simulation memory is included.
+  // Without /proc we only know about the allocations ascent made.
+  size_t rss = 0, rss_peak = 0;
+  const bool has_proc = detail::read_proc_status(rss, rss_peak);
+  if(has_proc)
+  {
+    usage.host_current = rss;
+    // VmHWM only grows unless it is reset. If it moved since the last
+    // reset, it is the peak since then, otherwise the best we know is
+    // the resident size at the reset or now
+    if(rss_peak > detail::host_hwm_at_reset)
+    {
+      usage.host_peak = rss_peak;
+    }
+    else
+    {
+      usage.host_peak = std::max(detail::host_current_at_reset, rss);
+    }
+  }
+  else
+  {
+    usage.host_current = HostMemory::m_current_bytes;
+    usage.host_peak = HostMemory::m_peak_bytes;
+  }
+
+  // device: the shared pool holds expression, conduit and devil ray arrays
+  usage.device_current = DeviceMemory::m_current_bytes;
+  size_t pool_hwm = 0;
+#if defined(ASCENT_UMPIRE_ENABLED) && defined(ASCENT_DEVICE_ENABLED)
+  if(m_device_allocator_id != -1)
+  {
+    auto &rm = umpire::ResourceManager::getInstance ();
+    umpire::Allocator device_allocator = rm.getAllocator(m_device_allocator_id);
+    usage.device_current = device_allocator.getCurrentSize();
+    pool_hwm = device_allocator.getHighWatermark();
+  }
+#endif
+  // the pool high water mark can't be reset, but if it moved it is the
+  // peak since the reset
+  if(pool_hwm > detail::device_pool_hwm_at_reset)
+  {
+    usage.device_peak = pool_hwm;
+  }
+  else
+  {
+    usage.device_peak = std::max(detail::device_current_at_reset,
+                                 usage.device_current);
+    usage.device_peak = std::max(usage.device_peak,
+                                 DeviceMemory::m_peak_bytes);
+  }
+
+  if(reset_peak)
+  {
+    if(has_proc)
+    {
+      // a cleared VmHWM drops to the resident size
+      if(m_reset_process_peak && detail::reset_proc_peak())
+      {
+        rss_peak = rss;
+      }
+      detail::host_current_at_reset = rss;
+      detail::host_hwm_at_reset = rss_peak;
+    }
+    HostMemory::m_peak_bytes = HostMemory::m_current_bytes;
+    DeviceMemory::m_peak_bytes = DeviceMemory::m_current_bytes;
+    detail::device_current_at_reset = usage.device_current;
+    detail::device_pool_hwm_at_reset = pool_hwm;
+  }
+}
+
+//-----------------------------------------------------------------------------
+void
+AllocationManager::set_reset_process_peak(bool on)
+{
+  m_reset_process_peak = on;
+}
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 // Host Memory
@@ -255,6 +468,8 @@ AllocationManager::set_conduit_mem_handlers()
 size_t HostMemory::m_total_bytes_alloced = 0;
 size_t HostMemory::m_alloc_count = 0;
 size_t HostMemory::m_free_count = 0;
+size_t HostMemory::m_current_bytes = 0;
+size_t HostMemory::m_peak_bytes = 0;
 
 //-----------------------------------------------------------------------------
 void *
@@ -263,6 +478,8 @@ HostMemory::allocate(size_t bytes)
   m_total_bytes_alloced += bytes;
   m_alloc_count++;
 #if defined(ASCENT_UMPIRE_ENABLED)
+  m_current_bytes += bytes;
+  m_peak_bytes = std::max(m_peak_bytes, m_current_bytes);
   auto &rm = umpire::ResourceManager::getInstance ();
   const int allocator_id = AllocationManager::host_allocator_id();
   umpire::Allocator host_allocator = rm.getAllocator (allocator_id);
@@ -289,6 +506,10 @@ HostMemory::deallocate(void *data_ptr)
   auto &rm = umpire::ResourceManager::getInstance ();
   const int allocator_id = AllocationManager::host_allocator_id();
   umpire::Allocator host_allocator = rm.getAllocator (allocator_id);
+  if(data_ptr != nullptr)
+  {
+    m_current_bytes -= std::min(m_current_bytes, host_allocator.getSize(data_ptr));
+  }
   host_allocator.deallocate(data_ptr);
 #else
   return free(data_ptr);
@@ -303,6 +524,8 @@ HostMemory::deallocate(void *data_ptr)
 size_t DeviceMemory::m_total_bytes_alloced = 0;
 size_t DeviceMemory::m_alloc_count = 0;
 size_t DeviceMemory::m_free_count = 0;
+size_t DeviceMemory::m_current_bytes = 0;
+size_t DeviceMemory::m_peak_bytes = 0;
 
 //-----------------------------------------------------------------------------
 void *
@@ -316,6 +539,8 @@ DeviceMemory::allocate(size_t bytes)
 #if defined(ASCENT_DEVICE_ENABLED) && defined(ASCENT_UMPIRE_ENABLED)
   m_total_bytes_alloced += bytes;
   m_alloc_count++;
+  m_current_bytes += bytes;
+  m_peak_bytes = std::max(m_peak_bytes, m_current_bytes);
   auto &rm = umpire::ResourceManager::getInstance ();
   const int allocator_id = AllocationManager::device_allocator_id();
   umpire::Allocator device_allocator = rm.getAllocator (allocator_id);
@@ -348,6 +573,10 @@ DeviceMemory::deallocate(void *data_ptr)
   auto &rm = umpire::ResourceManager::getInstance ();
   const int allocator_id = AllocationManager::device_allocator_id();
   umpire::Allocator device_allocator = rm.getAllocator (allocator_id);
+  if(data_ptr != nullptr)
+  {
+    m_current_bytes -= std::min(m_current_bytes, device_allocator.getSize(data_ptr));
+  }
   device_allocator.deallocate (data_ptr);
 #else
   (void) data_ptr;
@@ -5,6 +5,11 @@
 #include <conduit.hpp>
 #include <ascent_exports.h>
 
+namespace flow
+{
+struct MemoryUsage;
+}
+
 namespace ascent
 {
 ///
@@ -46,6 +51,21 @@ public:
   // magic memset and memcpy
   static void set_conduit_mem_handlers();
 
+  // single report of the memory used by conduit allocations, expression
+  // arrays, devil ray arrays and the shared umpire pools
+  static void memory_usage(conduit::Node &out);
+
+  // flow memory probe: samples resident bytes and the peak since the last
+  // reset, used to attribute memory to filters. allocated only counts
+  // bytes allocated through ascent's allocators (expression arrays and
+  // conduit allocations made by ascent), not vtk-m or simulation memory
+  static void sample_memory(bool reset_peak, flow::MemoryUsage &usage);
+
+  // when on, a peak reset also lowers the process VmHWM through
+  // /proc/self/clear_refs. Off by default since that changes what any
+  // other tool reading VmHWM sees
+  static void set_reset_process_peak(bool on);
+
 private:
   static int  m_host_allocator_id;
   static int  m_device_allocator_id;
@@ -56,6 +76,8 @@ private:
   static bool m_external_host_allocator;
   static bool m_external_device_allocator;
 
+  static bool m_reset_process_peak;
+
 };
 
 //-----------------------------------------------------------------------------
@@ -70,9 +92,13 @@ struct ASCENT_API HostMemory
   static void  deallocate(void *data_ptr);
 
 private:
+  friend class AllocationManager;
   static size_t m_total_bytes_alloced;
   static size_t m_alloc_count;
   static size_t m_free_count;
+  // only tracked when the allocation size is known (umpire)
+  static size_t m_current_bytes;
+  static size_t m_peak_bytes;
 
 };
 //-----------------------------------------------------------------------------
@@ -90,9 +116,13 @@ struct ASCENT_API DeviceMemory
   static void is_device_ptr(const void *ptr, bool &is_gpu, bool &is_unified);
 
 private:
+  friend class AllocationManager;
   static size_t m_total_bytes_alloced;
   static size_t m_alloc_count;
   static size_t m_free_count;
+  // only tracked when the allocation size is known (umpire)
+  static size_t m_current_bytes;
+  static size_t m_peak_bytes;
 
 };
 
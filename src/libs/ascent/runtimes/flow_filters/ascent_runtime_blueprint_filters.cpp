@@ -30,6 +30,7 @@
 #include <ascent_metadata.hpp>
 #include <runtimes/ascent_data_object.hpp>
 #include <ascent_runtime_param_check.hpp>
+#include <ascent_runtime_utils.hpp>
 #include "expressions/ascent_expression_filters.hpp"
 #include "expressions/ascent_blueprint_architect.hpp"
 #include <flow_graph.hpp>
@@ -147,9 +148,23 @@ BlueprintVerify::execute()
     std::string verify_err_msg = "";
     if(!n_input->dtype().is_empty())
     {
-        if(!conduit::blueprint::verify(protocol,
-                                       *n_input,
-                                       v_info))
+        // meshes are mostly republished with the same layout and memory,
+        // the runtime keeps a cache so only the domains that changed
+        // are verified
+        bool valid = false;
+        Registry &reg = graph().workspace().registry();
+        if(protocol == "mesh" && reg.has_entry("blueprint_verify_cache"))
+        {
+            BlueprintVerifyCache *cache =
+                reg.fetch<BlueprintVerifyCache>("blueprint_verify_cache");
+            valid = cache->verify_mesh(*n_input, v_info);
+        }
+        else
+        {
+            valid = conduit::blueprint::verify(protocol, *n_input, v_info);
+        }
+
+        if(!valid)
         {
             verify_err_msg = v_info.to_yaml();
             local_verify_err = 1;
@@ -25,6 +25,7 @@
 // ascent includes
 //-----------------------------------------------------------------------------
 #include <ascent_logging.hpp>
+#include <ascent_data_logger.hpp>
 #include <ascent_string_utils.hpp>
 #include <ascent_runtime_param_check.hpp>
 #include <ascent_metadata.hpp>
@@ -1105,6 +1106,55 @@ bool check_image_names(const conduit::Node &params, conduit::Node &info)
   return res;
 }
 
+bool check_progressive(const conduit::Node &params,
+                       conduit::Node &info,
+                       std::vector<std::string> &valid_paths)
+{
+  bool res = true;
+  res &= check_string("progressive",params, info, false);
+  res &= check_numeric("time_budget",params, info, false);
+  valid_paths.push_back("progressive");
+  valid_paths.push_back("time_budget");
+  return res;
+}
+
+void
+parse_progressive(const conduit::Node &params, dray::Renderer &renderer)
+{
+  if(params.has_path("progressive"))
+  {
+    renderer.progressive(params["progressive"].as_string() == "true");
+  }
+
+  if(params.has_path("time_budget"))
+  {
+    float time_budget = params["time_budget"].to_float32();
+    if(time_budget < 0.f)
+    {
+      ASCENT_ERROR("Devil ray time_budget must not be negative");
+    }
+    renderer.time_budget(time_budget);
+    // the budget covers all the images the filter renders this cycle,
+    // not each camera on its own
+    renderer.start_time_budget();
+  }
+}
+
+void
+log_progressive(dray::Renderer &renderer)
+{
+  dray::ProgressiveInfo info = renderer.progressive_info();
+  // nothing rendered progressively
+  if(info.m_time == 0.f)
+  {
+    return;
+  }
+  // trace counters, this runs for every image every cycle
+  ASCENT_DATA_ADD("progressive_traced", info.m_traced);
+  ASCENT_DATA_ADD("progressive_quality", info.quality());
+  ASCENT_DATA_ADD("progressive_budget_hit", info.m_budget_hit ? 1 : 0);
+}
+
 void
 parse_params(const conduit::Node &params,
              dray::Collection *dcol,
@@ -1312,6 +1362,7 @@ DRayPseudocolor::verify_params(const conduit::Node &params,
     res &= check_numeric("line_color",params, info, false);
     res &= check_numeric("line_thickness",params, info, false);
     res &= check_string("draw_mesh",params, info, false);
+    res &= detail::check_progressive(params, info, valid_paths);
 
     ignore_paths.push_back("camera");
     ignore_paths.push_back("color_table");
@@ -1422,6 +1473,7 @@ DRayPseudocolor::execute()
     }
 
     renderer.world_annotations(annotations);
+    detail::parse_progressive(params(), renderer);
 
     const int num_images = cameras.size();
     for(int i = 0; i < num_images; ++i)
@@ -1431,6 +1483,7 @@ DRayPseudocolor::execute()
 
       if(dray::dray::mpi_rank() == 0)
       {
+        detail::log_progressive(renderer);
         fb.composite_background();
         fb.save(image_names[i]);
       }
@@ -1504,6 +1557,7 @@ DRay3Slice::verify_params(const conduit::Node &params,
 
     valid_paths.push_back("sweep/count");
     valid_paths.push_back("sweep/axis");
+    res &= detail::check_progressive(params, info, valid_paths);
 
     ignore_paths.push_back("camera");
     ignore_paths.push_back("color_table");
@@ -1809,6 +1863,7 @@ DRay3Slice::execute()
     }
 
     renderer.world_annotations(annotations);
+    detail::parse_progressive(params(), renderer);
 
     renderer.add(slicer_x);
     renderer.add(slicer_y);
@@ -1827,6 +1882,7 @@ DRay3Slice::execute()
 
       if(dray::dray::mpi_rank() == 0)
       {
+        detail::log_progressive(renderer);
         fb.composite_background();
         fb.save(work[i].m_image_name);
       }
@@ -1888,9 +1944,14 @@ DRayVolume::verify_params(const conduit::Node &params,
     // filter knobs
     res &= check_numeric("samples",params, info, false);
     res &= check_string("use_lighing",params, info, false);
+    res &= check_string("use_preintegration",params, info, false);
+    res &= check_numeric("max_step_factor",params, info, false);
 
     valid_paths.push_back("samples");
     valid_paths.push_back("use_lighting");
+    valid_paths.push_back("use_preintegration");
+    valid_paths.push_back("max_step_factor");
+    res &= detail::check_progressive(params, info, valid_paths);
 
     ignore_paths.push_back("camera");
     ignore_paths.push_back("color_table");
@@ -1974,6 +2035,22 @@ DRayVolume::execute()
       samples = params()["samples"].to_int32();
     }
 
+    bool use_preintegration = false;
+    if(params().has_path("use_preintegration"))
+    {
+      use_preintegration = params()["use_preintegration"].as_string() == "true";
+    }
+
+    float max_step_factor = 1.f;
+    if(params().has_path("max_step_factor"))
+    {
+      max_step_factor = params()["max_step_factor"].to_float32();
+      if(max_step_factor < 1.f)
+      {
+        ASCENT_ERROR("dray_volume: max_step_factor must be at least 1");
+      }
+    }
+
     if(params().has_path("load_balancing"))
     {
       const conduit::Node &load = params()["load_balancing"];
@@ -2021,6 +2098,8 @@ DRayVolume::execute()
 
     volume->color_map() = color_map;
     volume->samples(samples);
+    volume->use_preintegration(use_preintegration);
+    volume->max_step_factor(max_step_factor);
     volume->field(field_name);
     dray::Renderer renderer;
     renderer.volume(volume);
@@ -2031,6 +2110,7 @@ DRayVolume::execute()
       annotations = params()["annotations"].as_string() != "false";
     }
     renderer.world_annotations(annotations);
+    detail::parse_progressive(params(), renderer);
 
     const int num_images = cameras.size();
     for(int i = 0; i < num_images; ++i)
@@ -2040,6 +2120,7 @@ DRayVolume::execute()
 
       if(dray::dray::mpi_rank() == 0)
       {
+        detail::log_progressive(renderer);
         fb.composite_background();
         fb.save(image_names[i]);
       }
@@ -122,6 +122,7 @@ register_builtin()
     AscentRuntime::register_filter_type<VTKHIsoVolume>("transforms","isovolume");
     AscentRuntime::register_filter_type<VTKHLagrangian>("transforms","lagrangian");
     AscentRuntime::register_filter_type<VTKHLog>("transforms","log");
+    AscentRuntime::register_filter_type<VTKHTemporalAccumulate>("transforms","accumulate");
     AscentRuntime::register_filter_type<VTKHLog10>("transforms","log10");
     AscentRuntime::register_filter_type<VTKHLog2>("transforms","log2");
     AscentRuntime::register_filter_type<VTKHMarchingCubes>("transforms","contour");
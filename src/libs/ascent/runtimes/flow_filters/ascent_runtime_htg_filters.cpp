@@ -34,9 +34,18 @@
 #include <flow_graph.hpp>
 #include <flow_workspace.hpp>
 
+#ifdef ASCENT_MPI_ENABLED
+#include <mpi.h>
+#include <conduit_relay_mpi.hpp>
+#endif
+
 // std includes
+#include <algorithm>
+#include <cmath>
+#include <fstream>
 #include <limits>
 #include <set>
+#include <sstream>
 
 using namespace std;
 using namespace conduit;
@@ -128,512 +137,766 @@ verify_htg_params(const conduit::Node &params,
 }
 
 //-----------------------------------------------------------------------------
-float htg_create(const float *var_in,
-                 float *var_out,
-                 int *mask,
-                 int n_levels,
-                 int nx,
-                 int blank_value,
-                 int level,
-                 int *offsets,
-                 int i_start,
-                 int j_start,
-                 int k_start)
+// A single hyper tree built from one power-of-2 uniform domain.
+//-----------------------------------------------------------------------------
+struct HTGTree
+{
+    // index of the root cell this tree hangs from in the tree grid
+    index_t              m_index;
+    std::vector<int64>   m_nb_vertices_by_level;
+    // descriptor and mask are packed bits, most significant bit first
+    std::vector<uint8>   m_descriptor;
+    index_t              m_n_descriptor;
+    std::vector<uint8>   m_mask;
+    index_t              m_n_mask;
+    std::vector<float32> m_values;
+
+    // size of this trees arrays in the appended data section
+    index_t appended_bytes() const
+    {
+        return 4 * sizeof(uint64) +
+               m_descriptor.size() +
+               m_nb_vertices_by_level.size() * sizeof(int64) +
+               m_mask.size() +
+               m_values.size() * sizeof(float32);
+    }
+};
+
+//-----------------------------------------------------------------------------
+// Spreads the low 21 bits of v so there are two zero bits between each.
+//-----------------------------------------------------------------------------
+uint64
+htg_spread_bits(uint64 v)
+{
+    uint64 x = v & 0x1fffffULL;
+    x = (x | x << 32) & 0x1f00000000ffffULL;
+    x = (x | x << 16) & 0x1f0000ff0000ffULL;
+    x = (x | x << 8)  & 0x100f00f00f00f00fULL;
+    x = (x | x << 4)  & 0x10c30c30c30c30c3ULL;
+    x = (x | x << 2)  & 0x1249249249249249ULL;
+    return x;
+}
+
+//-----------------------------------------------------------------------------
+void
+htg_push_bit(std::vector<uint8> &bits, index_t &count, bool bit)
+{
+    if(count % 8 == 0)
+    {
+        bits.push_back(0);
+    }
+    if(bit)
+    {
+        bits.back() |= static_cast<uint8>(0x80 >> (count % 8));
+    }
+    count++;
+}
+
+//-----------------------------------------------------------------------------
+// Removes trailing zero bits, leaving at least one bit.
+//-----------------------------------------------------------------------------
+void
+htg_trim_bits(std::vector<uint8> &bits, index_t &count, index_t last_one)
 {
-    if (level < n_levels - 1)
-    {
-        // 
-        // Recurse over the 8 sub-blocks.
-        //
-        int nx_sub_box = 1 << (n_levels - level - 1);
-        int offset = offsets[level];
-        offsets[level] = offsets[level] + 8;
-
-        var_out[offset]   = htg_create(var_in, var_out, mask, n_levels, nx,
-            blank_value, level+1, offsets,
-            i_start, j_start, k_start);
-        var_out[offset+1] = htg_create(var_in, var_out, mask, n_levels, nx,
-            blank_value, level+1, offsets,
-            i_start + nx_sub_box, j_start, k_start);
-        var_out[offset+2] = htg_create(var_in, var_out, mask, n_levels, nx,
-            blank_value, level+1, offsets,
-            i_start, j_start + nx_sub_box, k_start);
-        var_out[offset+3] = htg_create(var_in, var_out, mask, n_levels, nx,
-            blank_value, level+1, offsets,
-            i_start + nx_sub_box, j_start + nx_sub_box, k_start);
-        var_out[offset+4] = htg_create(var_in, var_out, mask, n_levels, nx,
-            blank_value, level+1, offsets,
-            i_start, j_start, k_start + nx_sub_box);
-        var_out[offset+5] = htg_create(var_in, var_out, mask, n_levels, nx,
-            blank_value, level+1, offsets,
-            i_start + nx_sub_box, j_start, k_start + nx_sub_box);
-        var_out[offset+6] = htg_create(var_in, var_out, mask, n_levels, nx,
-            blank_value, level+1, offsets,
-            i_start, j_start + nx_sub_box, k_start + nx_sub_box);
-        var_out[offset+7] = htg_create(var_in, var_out, mask, n_levels, nx,
-            blank_value, level+1, offsets,
-            i_start + nx_sub_box, j_start + nx_sub_box, k_start + nx_sub_box);
-        mask[offset]   = var_out[offset]   == blank_value ? 1 : 0;
-        mask[offset+1] = var_out[offset+1] == blank_value ? 1 : 0;
-        mask[offset+2] = var_out[offset+2] == blank_value ? 1 : 0;
-        mask[offset+3] = var_out[offset+3] == blank_value ? 1 : 0;
-        mask[offset+4] = var_out[offset+4] == blank_value ? 1 : 0;
-        mask[offset+5] = var_out[offset+5] == blank_value ? 1 : 0;
-        mask[offset+6] = var_out[offset+6] == blank_value ? 1 : 0;
-        mask[offset+7] = var_out[offset+7] == blank_value ? 1 : 0;
-
-        //
-        // Calculate and return the average.
-        //
-        float ave = 0.;
-        int n_val = 0;
-        for (int l = 0; l < 8; l++)
+    count = last_one + 1;
+    if(count == 0)
+    {
+        count = 1;
+    }
+    bits.resize((count + 7) / 8);
+}
+
+//-----------------------------------------------------------------------------
+// Builds the tree for a nx^3 domain. Each level of the tree stores the
+// average of the non blank values of its children, and the children of
+// a vertex are only stored if it has at least one non blank value.
+//
+// The vertices of a level are ordered by their parent and then by
+// child id, which is exactly the morton order of the cells at that
+// level. We build the full pyramid in morton order and then walk it top
+// down to emit only the refined vertices.
+//-----------------------------------------------------------------------------
+void
+htg_build_tree(const float32 *value,
+               index_t nx,
+               float32 blank_value,
+               HTGTree &tree)
+{
+    int n_levels = 1;
+    for(index_t dim = nx; dim > 1; dim /= 2)
+    {
+        n_levels++;
+    }
+
+    std::vector<std::vector<float32>> levels(n_levels);
+    std::vector<float32> &finest = levels[n_levels - 1];
+    finest.resize(nx * nx * nx);
+
+    index_t idx = 0;
+    for(index_t k = 0; k < nx; ++k)
+    {
+        const uint64 kbits = htg_spread_bits(k) << 2;
+        for(index_t j = 0; j < nx; ++j)
         {
-            if (var_out[offset+l] != blank_value)
+            const uint64 jkbits = kbits | (htg_spread_bits(j) << 1);
+            for(index_t i = 0; i < nx; ++i)
             {
-                n_val++;
-                ave += var_out[offset+l];
+                finest[jkbits | htg_spread_bits(i)] = value[idx];
+                idx++;
             }
         }
-        if (n_val)
-            ave /= float(n_val);
-        else
-            ave = blank_value;
-        return ave;
     }
-    else
+
+    for(int l = n_levels - 2; l >= 0; --l)
     {
-        //
-        // Base case. Reorder and store the values as the finest
-        // resolution.
-        //
-        int offset = offsets[level];
-        offsets[level] = offsets[level] + 8;
-
-        int index  = (k_start)   * nx * nx + (j_start)   * nx + (i_start);
-        int index2 = (k_start)   * nx * nx + (j_start)   * nx + (i_start+1);
-        int index3 = (k_start)   * nx * nx + (j_start+1) * nx + (i_start);
-        int index4 = (k_start)   * nx * nx + (j_start+1) * nx + (i_start+1);
-        int index5 = (k_start+1) * nx * nx + (j_start)   * nx + (i_start);
-        int index6 = (k_start+1) * nx * nx + (j_start)   * nx + (i_start+1);
-        int index7 = (k_start+1) * nx * nx + (j_start+1) * nx + (i_start);
-        int index8 = (k_start+1) * nx * nx + (j_start+1) * nx + (i_start+1);
-        var_out[offset]   = var_in[index];
-        var_out[offset+1] = var_in[index2];
-        var_out[offset+2] = var_in[index3];
-        var_out[offset+3] = var_in[index4];
-        var_out[offset+4] = var_in[index5];
-        var_out[offset+5] = var_in[index6];
-        var_out[offset+6] = var_in[index7];
-        var_out[offset+7] = var_in[index8];
-        mask[offset]   = var_out[offset]   == blank_value ? 1 : 0;
-        mask[offset+1] = var_out[offset+1] == blank_value ? 1 : 0;
-        mask[offset+2] = var_out[offset+2] == blank_value ? 1 : 0;
-        mask[offset+3] = var_out[offset+3] == blank_value ? 1 : 0;
-        mask[offset+4] = var_out[offset+4] == blank_value ? 1 : 0;
-        mask[offset+5] = var_out[offset+5] == blank_value ? 1 : 0;
-        mask[offset+6] = var_out[offset+6] == blank_value ? 1 : 0;
-        mask[offset+7] = var_out[offset+7] == blank_value ? 1 : 0;
-
-        //
-        // Calculate and return the average.
-        //
-        float ave = 0.;
-        int n_val = 0;
-        for (int l = 0; l < 8; l++)
+        const std::vector<float32> &children = levels[l + 1];
+        std::vector<float32> &parents = levels[l];
+        const index_t n_parents = children.size() / 8;
+        parents.resize(n_parents);
+        for(index_t p = 0; p < n_parents; ++p)
         {
-            if (var_out[offset+l] != blank_value)
+            float32 ave = 0.f;
+            int n_val = 0;
+            for(index_t c = p * 8; c < p * 8 + 8; ++c)
             {
-                n_val++;
-                ave += var_out[offset+l];
+                if(children[c] != blank_value)
+                {
+                    n_val++;
+                    ave += children[c];
+                }
             }
+            parents[p] = n_val > 0 ? ave / float32(n_val) : blank_value;
         }
-        if (n_val)
-            ave /= float(n_val);
-        else
-            ave = blank_value;
-        return ave;
     }
+
+    tree.m_nb_vertices_by_level.clear();
+    tree.m_descriptor.clear();
+    tree.m_mask.clear();
+    tree.m_values.clear();
+    tree.m_n_descriptor = 0;
+    tree.m_n_mask = 0;
+
+    index_t last_descriptor_one = -1;
+    index_t last_mask_one = -1;
+
+    std::vector<index_t> current(1, 0);
+    std::vector<index_t> next;
+    for(int l = 0; l < n_levels; ++l)
+    {
+        const std::vector<float32> &level = levels[l];
+        const bool refinable = l < n_levels - 1;
+        tree.m_nb_vertices_by_level.push_back(current.size());
+        next.clear();
+
+        for(size_t v = 0; v < current.size(); ++v)
+        {
+            const index_t id = current[v];
+            const bool blank = level[id] == blank_value;
+
+            // replace any blank value with zero
+            tree.m_values.push_back(blank ? 0.f : level[id]);
+
+            if(blank)
+            {
+                last_mask_one = tree.m_n_mask;
+            }
+            htg_push_bit(tree.m_mask, tree.m_n_mask, blank);
+
+            if(refinable)
+            {
+                if(!blank)
+                {
+                    last_descriptor_one = tree.m_n_descriptor;
+                    for(index_t c = 0; c < 8; ++c)
+                    {
+                        next.push_back(id * 8 + c);
+                    }
+                }
+                htg_push_bit(tree.m_descriptor, tree.m_n_descriptor, !blank);
+            }
+        }
+
+        // release levels as soon as we are done with them
+        std::vector<float32>().swap(levels[l]);
+        current.swap(next);
+    }
+
+    htg_trim_bits(tree.m_descriptor, tree.m_n_descriptor, last_descriptor_one);
+    htg_trim_bits(tree.m_mask, tree.m_n_mask, last_mask_one);
 }
 
-void htg_write_file(const string &stem,
-                    const double *bounds,
-                    int n_levels,
-                    int n_vertices,
-                    int n_descriptor,
-                    int descriptor_min,
-                    int descriptor_max,
-                    const int *descriptor,
-                    int nb_vertices_by_level_max,
-                    const int *nb_vertices_by_level,
-                    int n_mask,
-                    int mask_min,
-                    int mask_max,
-                    const int *mask,
-                    double var_min,
-                    double var_max,
-                    const float *var)
+//-----------------------------------------------------------------------------
+template<typename T>
+void
+htg_append_array(std::vector<char> &buffer, const T *data, index_t count)
 {
-    //
-    // Write out the HTG VTK file. It is in ASCII format, which is the
-    // least efficient, but it's the simplest and was great for developing
-    // the algorithm. This should probably be improved at some point.
-    //
-    std::string filename = stem + ".htg";
-    ofstream *ofile = new ofstream(filename.c_str());
-
-    *ofile << "<VTKFile type=\"HyperTreeGrid\" version=\"1.0\" byte_order=\"LittleEndian\" header_type=\"UInt32\">" << endl;
-    *ofile << "  <HyperTreeGrid BranchFactor=\"2\" TransposedRootIndexing=\"0\" Dimensions=\"2 2 2\">" << endl;
-    *ofile << "    <Grid>" << endl;
-    *ofile << "      <DataArray type=\"Float64\" Name=\"XCoordinates\" NumberOfTuples=\"2\" format=\"ascii\" RangeMin=\"" << bounds[0] << "\" RangeMax=\"" << bounds[1] << "\">" << endl;
-    *ofile << "        " << bounds[0] << " " << bounds[1] << endl;
-    *ofile << "      </DataArray>" << endl;
-    *ofile << "      <DataArray type=\"Float64\" Name=\"YCoordinates\" NumberOfTuples=\"2\" format=\"ascii\" RangeMin=\"" << bounds[2] << "\" RangeMax=\"" << bounds[3] << "\">" << endl;
-    *ofile << "        " << bounds[2] << " " << bounds[3] << endl;
-    *ofile << "      </DataArray>" << endl;
-    *ofile << "      <DataArray type=\"Float64\" Name=\"ZCoordinates\" NumberOfTuples=\"2\" format=\"ascii\" RangeMin=\"" << bounds[4] << "\" RangeMax=\"" << bounds[5] << "\">" << endl;
-    *ofile << "        " << bounds[4] << " " << bounds[5] << endl;
-    *ofile << "      </DataArray>" << endl;
-    *ofile << "    </Grid>" << endl;
-    *ofile << "    <Trees>" << endl;
-    *ofile << "      <Tree Index=\"0\" NumberOfLevels=\"" << n_levels << "\" NumberOfVertices=\"" << n_vertices << "\">" << endl;
-    *ofile << "        <DataArray type=\"Bit\" Name=\"Descriptor\" NumberOfTuples=\"" << n_descriptor << "\" format=\"ascii\" RangeMin=\"" << descriptor_min << "\" RangeMax=\"" << descriptor_max << "\">" << endl;
-    for (int i = 0; i < n_descriptor; i += 6)
-    {
-        *ofile << "          ";
-        int jmax = (i + 6 < n_descriptor) ? i + 6 : n_descriptor;
-        for (int j = i; j < jmax - 1; j++)
-            *ofile << descriptor[j] << " ";
-        *ofile << descriptor[jmax-1] << endl;;
-    }
-    *ofile << "        </DataArray>" << endl;
-    *ofile << "        <DataArray type=\"Int64\" Name=\"NbVerticesByLevel\" NumberOfTuples=\"" << n_levels << "\" format=\"ascii\" RangeMin=\"1\" RangeMax=\"" << nb_vertices_by_level_max << "\">" << endl;
-    *ofile << "          ";
-    for (int i = 0; i < n_levels - 1; i++)
-        *ofile << nb_vertices_by_level[i] << " ";
-    *ofile << nb_vertices_by_level[n_levels-1] << endl;;
-    *ofile << "        </DataArray>" << endl;
-    *ofile << "        <DataArray type=\"Bit\" Name=\"Mask\" NumberOfTuples=\"" << n_mask << "\" format=\"ascii\" RangeMin=\"" << mask_min << "\" RangeMax=\"" << mask_max << "\">" << endl;
-    for (int i = 0; i < n_mask; i += 6)
-    {
-        *ofile << "          ";
-        int jmax = (i + 6 < n_mask) ? i + 6 : n_mask;
-        for (int j = i; j < jmax - 1; j++)
-            *ofile << mask[j] << " ";
-        *ofile << mask[jmax-1] << endl;;
-    }
-    *ofile << "        </DataArray>" << endl;
-    *ofile << "        <CellData>" << endl;
-    *ofile << "          <DataArray type=\"Float64\" Name=\"u\" NumberOfTuples=\"" << n_vertices << "\" format=\"ascii\" RangeMin=\"" << var_min << "\" RangeMax=\"" << var_max << "\">" << endl;
-    for (int i = 0; i < n_vertices; i += 6)
-    {
-        *ofile << "          ";
-        int jmax = (i + 6 < n_vertices) ? i + 6 : n_vertices;
-        for (int j = i; j < jmax - 1; j++)
-            *ofile << var[j] << " ";
-        *ofile << var[jmax-1] << endl;;
-    }
-    *ofile << "          </DataArray>" << endl;
-    *ofile << "        </CellData>" << endl;
-    *ofile << "      </Tree>" << endl;
-    *ofile << "    </Trees>" << endl;
-    *ofile << "  </HyperTreeGrid>" << endl;
-    *ofile << "</VTKFile>" << endl;
+    const uint64 nbytes = count * sizeof(T);
+    const char *nbytes_ptr = reinterpret_cast<const char*>(&nbytes);
+    buffer.insert(buffer.end(), nbytes_ptr, nbytes_ptr + sizeof(uint64));
+    const char *data_ptr = reinterpret_cast<const char*>(data);
+    buffer.insert(buffer.end(), data_ptr, data_ptr + nbytes);
 }
 
-void htg_write(const std::string &path,
-               double blank_value,
-               int nx,
-               const double *bounds,
-               const float *value)
+//-----------------------------------------------------------------------------
+// Serializes the local trees into the raw appended data layout.
+// Each array is prefixed by its size in bytes (header_type UInt64).
+//-----------------------------------------------------------------------------
+void
+htg_pack_trees(const std::vector<HTGTree> &trees, std::vector<char> &buffer)
 {
-    //
-    // Determine the number of levels.
-    //
-    int n_levels = 1;
-    int dim = nx;
-    while (dim > 1)
+    index_t total = 0;
+    for(size_t t = 0; t < trees.size(); ++t)
     {
-        n_levels++;
-        dim = dim / 2;
+        total += trees[t].appended_bytes();
     }
+    buffer.clear();
+    buffer.reserve(total);
 
-    //
-    // Calculate the total number of vertices.
-    //
-    int n_vertices = 0;
-    for (int i = 0; i < n_levels; i++)
-        n_vertices += 1 << i * 3;
+    for(size_t t = 0; t < trees.size(); ++t)
+    {
+        const HTGTree &tree = trees[t];
+        htg_append_array(buffer,
+                         tree.m_descriptor.data(),
+                         tree.m_descriptor.size());
+        htg_append_array(buffer,
+                         tree.m_nb_vertices_by_level.data(),
+                         tree.m_nb_vertices_by_level.size());
+        htg_append_array(buffer,
+                         tree.m_mask.data(),
+                         tree.m_mask.size());
+        htg_append_array(buffer,
+                         tree.m_values.data(),
+                         tree.m_values.size());
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Creates the xml header for the file. tree_info contains
+// [index, levels, vertices, descriptor bits, mask bits, bytes] for every
+// tree across all ranks, in the same order as the appended data.
+//-----------------------------------------------------------------------------
+std::string
+htg_header(const std::string &fname,
+           const index_t *n_trees,
+           const double *origin,
+           const double *tree_size,
+           const int64 *tree_info,
+           index_t n_total_trees,
+           double var_min,
+           double var_max)
+{
+    std::ostringstream oss;
+    oss.precision(std::numeric_limits<double>::max_digits10);
+
+    oss << "<VTKFile type=\"HyperTreeGrid\" version=\"1.0\" byte_order=\"LittleEndian\" header_type=\"UInt64\">\n";
+    oss << "  <HyperTreeGrid BranchFactor=\"2\" TransposedRootIndexing=\"0\" Dimensions=\""
+        << n_trees[0] + 1 << " " << n_trees[1] + 1 << " " << n_trees[2] + 1 << "\">\n";
+    oss << "    <Grid>\n";
+    const char *axes[3] = {"XCoordinates", "YCoordinates", "ZCoordinates"};
+    for(int d = 0; d < 3; ++d)
+    {
+        const double cmin = origin[d];
+        const double cmax = origin[d] + tree_size[d] * double(n_trees[d]);
+        oss << "      <DataArray type=\"Float64\" Name=\"" << axes[d]
+            << "\" NumberOfTuples=\"" << n_trees[d] + 1
+            << "\" format=\"ascii\" RangeMin=\"" << cmin
+            << "\" RangeMax=\"" << cmax << "\">\n";
+        oss << "       ";
+        for(index_t i = 0; i <= n_trees[d]; ++i)
+        {
+            oss << " " << origin[d] + tree_size[d] * double(i);
+        }
+        oss << "\n      </DataArray>\n";
+    }
+    oss << "    </Grid>\n";
+    oss << "    <Trees>\n";
+
+    uint64 offset = 0;
+    for(index_t t = 0; t < n_total_trees; ++t)
+    {
+        const int64 *info = tree_info + t * 6;
+        const int64 n_levels = info[1];
+        const int64 n_vertices = info[2];
+        const int64 n_descriptor = info[3];
+        const int64 n_mask = info[4];
+
+        oss << "      <Tree Index=\"" << info[0]
+            << "\" NumberOfLevels=\"" << n_levels
+            << "\" NumberOfVertices=\"" << n_vertices << "\">\n";
+        oss << "        <DataArray type=\"Bit\" Name=\"Descriptor\" NumberOfTuples=\""
+            << n_descriptor << "\" format=\"appended\" offset=\"" << offset << "\"/>\n";
+        offset += sizeof(uint64) + (n_descriptor + 7) / 8;
+        oss << "        <DataArray type=\"Int64\" Name=\"NbVerticesByLevel\" NumberOfTuples=\""
+            << n_levels << "\" format=\"appended\" offset=\"" << offset << "\"/>\n";
+        offset += sizeof(uint64) + n_levels * sizeof(int64);
+        oss << "        <DataArray type=\"Bit\" Name=\"Mask\" NumberOfTuples=\""
+            << n_mask << "\" format=\"appended\" offset=\"" << offset << "\"/>\n";
+        offset += sizeof(uint64) + (n_mask + 7) / 8;
+        oss << "        <CellData>\n";
+        oss << "          <DataArray type=\"Float32\" Name=\"" << fname
+            << "\" NumberOfTuples=\"" << n_vertices
+            << "\" format=\"appended\" RangeMin=\"" << var_min
+            << "\" RangeMax=\"" << var_max
+            << "\" offset=\"" << offset << "\"/>\n";
+        offset += sizeof(uint64) + n_vertices * sizeof(float32);
+        oss << "        </CellData>\n";
+        oss << "      </Tree>\n";
+    }
+
+    oss << "    </Trees>\n";
+    oss << "  </HyperTreeGrid>\n";
+    oss << "  <AppendedData encoding=\"raw\">\n";
+    oss << "   _";
+    return oss.str();
+}
+
+//-----------------------------------------------------------------------------
+std::string
+htg_footer()
+{
+    return "\n  </AppendedData>\n</VTKFile>\n";
+}
+
+//-----------------------------------------------------------------------------
+// Checks if a domain can be written as a hyper tree for this field.
+// On success, nx is the number of cells in each direction.
+//-----------------------------------------------------------------------------
+bool
+htg_valid_domain(const conduit::Node &dom,
+                 const std::string &fname,
+                 index_t &nx,
+                 std::string &reason)
+{
+    const std::string fpath = "fields/" + fname;
+    const std::string topo = dom[fpath + "/topology"].as_string();
+    const std::string tpath = "topologies/" + topo;
+    const std::string coords = dom[tpath + "/coordset"].as_string();
+    const std::string cpath = "coordsets/" + coords;
+
+    if(dom[fpath + "/association"].as_string() != "element")
+    {
+        reason = "htg extract requires an element association";
+        return false;
+    }
+    if(dom[cpath + "/type"].as_string() != "uniform")
+    {
+        reason = "htg extract requires a uniform mesh";
+        return false;
+    }
+    if (!dom.has_path(cpath + "/dims/k"))
+    {
+        reason = "htg extract requires a 3d mesh";
+        return false;
+    }
+
+    const index_t ni = dom[cpath + "/dims/i"].to_index_t();
+    const index_t nj = dom[cpath + "/dims/j"].to_index_t();
+    const index_t nk = dom[cpath + "/dims/k"].to_index_t();
+    if (ni != nj || nj != nk)
+    {
+        reason = "htg extract requires the dimensions to be equal";
+        return false;
+    }
+    nx = ni - 1;
+    if (nx == 0 || ((nx & (nx - 1)) != 0))
+    {
+        reason = "htg extract requires the grid dimension to be a power of 2";
+        return false;
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Writes one field as a hyper tree grid. Every domain becomes one tree
+// and the trees are arranged on a root grid. Each rank builds the trees
+// for its own domains and writes them into the appended data section
+// of a single file at its own offset.
+//-----------------------------------------------------------------------------
+bool
+htg_write_field(const Node &data,
+                const std::string &fname,
+                const std::string &filename,
+                float32 blank_value)
+{
+    const int par_rank = mpi_rank();
 
     //
-    // Calculate min and max for the variable. We only need to do
-    // the input array, since the output will contain the input and
-    // averages of the input. We exclude any blank values. If the
-    // array contains all blank values we throw an exception.
+    // Check that all domains that have the field can be written.
     //
-    int nvals = nx * nx * nx;
+    std::vector<const conduit::Node*> doms;
+    index_t nx = -1;
+    bool valid = true;
+    std::string reason;
+    const index_t num_domains = data.number_of_children();
+    for(index_t d = 0; d < num_domains; ++d)
+    {
+        const conduit::Node &dom = data.child(d);
+        if(!dom.has_path("fields/" + fname))
+        {
+            continue;
+        }
+        index_t dom_nx;
+        if(!htg_valid_domain(dom, fname, dom_nx, reason))
+        {
+            valid = false;
+            break;
+        }
+        if(nx != -1 && nx != dom_nx)
+        {
+            reason = "htg extract requires all domains to have the same dimensions";
+            valid = false;
+            break;
+        }
+        nx = dom_nx;
+        doms.push_back(&dom);
+    }
+
+    if(!global_agreement(valid))
+    {
+        if(!valid)
+        {
+            ASCENT_INFO(fname<<": "<<reason<<", skipping."<<endl);
+        }
+        return false;
+    }
 
     //
-    // Find the first non blank value.
+    // Find the root grid. Every domain covers one root cell.
+    // We reduce [origin xyz, spacing xyz, nx] so we can check that all
+    // domains agree on spacing and size.
     //
-    int i_real;
-    for (i_real = 0; i_real < nvals && value[i_real] == blank_value; i_real++)
-        /* Do nothing */;
+    const int n_reduce = 7;
+    double local_min[n_reduce];
+    double local_max[n_reduce];
+    for(int i = 0; i < n_reduce; ++i)
+    {
+        local_min[i] = std::numeric_limits<double>::max();
+        local_max[i] = std::numeric_limits<double>::lowest();
+    }
 
-    if (i_real == nvals)
+    std::vector<double> dom_origins(doms.size() * 3);
+    const char *origin_names[3] = {"origin/x", "origin/y", "origin/z"};
+    const char *spacing_names[3] = {"spacing/dx", "spacing/dy", "spacing/dz"};
+    for(size_t d = 0; d < doms.size(); ++d)
     {
-        ASCENT_ERROR("htg extract: the variable only had blank values."<<endl);
+        const conduit::Node &dom = *doms[d];
+        const std::string topo = dom["fields/" + fname + "/topology"].as_string();
+        const std::string coords = dom["topologies/" + topo + "/coordset"].as_string();
+        const conduit::Node &n_coords = dom["coordsets/" + coords];
+        for(int i = 0; i < 3; ++i)
+        {
+            const double dom_origin = n_coords.has_path(origin_names[i]) ?
+                                      n_coords[origin_names[i]].to_float64() : 0.;
+            const double dom_spacing = n_coords.has_path(spacing_names[i]) ?
+                                       n_coords[spacing_names[i]].to_float64() : 1.;
+            dom_origins[d * 3 + i] = dom_origin;
+            local_min[i] = std::min(local_min[i], dom_origin);
+            local_max[i] = std::max(local_max[i], dom_origin);
+            local_min[3 + i] = std::min(local_min[3 + i], dom_spacing);
+            local_max[3 + i] = std::max(local_max[3 + i], dom_spacing);
+        }
+        local_min[6] = std::min(local_min[6], double(nx));
+        local_max[6] = std::max(local_max[6], double(nx));
     }
 
-    float var_min = value[i_real];
-    float var_max = value[i_real];
-    for (int i = i_real + 1; i < nvals; i++)
+    double global_min[n_reduce];
+    double global_max[n_reduce];
+    for(int i = 0; i < n_reduce; ++i)
     {
-        if (value[i] != blank_value)
+        global_min[i] = local_min[i];
+        global_max[i] = local_max[i];
+    }
+#ifdef ASCENT_MPI_ENABLED
+    MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
+    MPI_Allreduce(local_min, global_min, n_reduce, MPI_DOUBLE, MPI_MIN, mpi_comm);
+    MPI_Allreduce(local_max, global_max, n_reduce, MPI_DOUBLE, MPI_MAX, mpi_comm);
+#endif
+
+    if(global_min[6] > global_max[6])
+    {
+        // nobody has this field
+        return false;
+    }
+
+    if(global_min[6] != global_max[6])
+    {
+        if(par_rank == 0)
         {
-            var_min = value[i] < var_min ? value[i] : var_min;
-            var_max = value[i] > var_max ? value[i] : var_max;
+            ASCENT_INFO(fname<<": htg extract requires all domains to have "
+                        <<"the same dimensions, skipping."<<endl);
         }
+        return false;
     }
 
-    //
-    // Set the number of vertices in each level.
-    //
-    int *nb_vertices_by_level = new int[n_levels];
-    for (int i = 0; i < n_levels; i++)
-        nb_vertices_by_level[i] = 1 << i * 3;
+    if(global_min[3] != global_max[3] ||
+       global_min[4] != global_max[4] ||
+       global_min[5] != global_max[5])
+    {
+        if(par_rank == 0)
+        {
+            ASCENT_INFO(fname<<": htg extract requires all domains to have "
+                        <<"the same spacing, skipping."<<endl);
+        }
+        return false;
+    }
+    nx = static_cast<index_t>(global_max[6]);
 
-    //
-    // Create the HTG, specifically the output variable and the mask.
-    //
-    int *mask = new int[n_vertices];
-    float *var = new float[n_vertices];
-
-    int i_level = 1;
-    int *offsets = new int[n_levels];
-    offsets[0] = 0;
-    for (int i = 1; i < n_levels; i++)
-       offsets[i] = offsets[i-1] + nb_vertices_by_level[i-1];
-    int i_start = 0;
-    int j_start = 0;
-    int k_start = 0;
-    var[0] = htg_create(value, var, mask, n_levels, nx, blank_value, i_level,
-        offsets, i_start, j_start, k_start);
-    mask[0] = var[0] == blank_value ? 1 : 0;
-    delete [] offsets;
+    // each root cell is the size of a domain
+    double origin[3];
+    double tree_size[3];
+    index_t n_trees[3];
+    for(int i = 0; i < 3; ++i)
+    {
+        origin[i] = global_min[i];
+        tree_size[i] = global_max[3 + i] * double(nx);
+        n_trees[i] = static_cast<index_t>(
+                       std::round((global_max[i] - global_min[i]) / tree_size[i])) + 1;
+    }
 
     //
-    // Compress the output variable based on the mask variable.
+    // Build the local trees.
     //
-    int *mask2 = new int[n_vertices];
-    int n_vertices2 = 9;
-    int i_var = 9;
-    int i_mask = 1;
-    for (int i = 0; i < 9; i++)
-        mask2[i] = mask[i];
-    for (int i = 1; i < n_levels - 1; i++)
-    {
-        int n_bits = 1 << i * 3;
-        int nb_vertices = 0;
-        for (int j = 0; j < n_bits; j++)
+    std::vector<HTGTree> trees(doms.size());
+    index_t local_non_blank = 0;
+    double var_min = std::numeric_limits<double>::max();
+    double var_max = std::numeric_limits<double>::lowest();
+    for(size_t d = 0; d < doms.size(); ++d)
+    {
+        const conduit::Node &values = (*doms[d])["fields/" + fname + "/values"];
+        conduit::Node res;
+        if (values.dtype().is_float32() && values.dtype().is_compact())
         {
-             if (mask[i_mask] == 0)
-             {
-                 nb_vertices += 8;
-                 for (int k = 0; k < 8; k++)
-                 {
-                     mask2[n_vertices2] = mask[i_var];
-                     var[n_vertices2] = var[i_var];
-                     n_vertices2++;
-                     i_var++;
-                 }
-             }
-             else
-             {
-                 i_var += 8;
-             }
-             i_mask++;
+            res.set_external(values);
         }
-        nb_vertices_by_level[i+1] = nb_vertices;
-    }
-    n_vertices = n_vertices2;
-    delete [] mask;
-    mask = mask2;
+        else
+        {
+            values.to_float32_array(res);
+        }
+        const float32 *value = res.value();
+
+        const index_t nvals = nx * nx * nx;
+        for(index_t i = 0; i < nvals; ++i)
+        {
+            if(value[i] != blank_value)
+            {
+                local_non_blank++;
+                var_min = std::min(var_min, double(value[i]));
+                var_max = std::max(var_max, double(value[i]));
+            }
+        }
+
+        index_t tree_ijk[3];
+        for(int i = 0; i < 3; ++i)
+        {
+            tree_ijk[i] = static_cast<index_t>(
+                            std::round((dom_origins[d * 3 + i] - origin[i]) / tree_size[i]));
+        }
+        trees[d].m_index = tree_ijk[0] +
+                           tree_ijk[1] * n_trees[0] +
+                           tree_ijk[2] * n_trees[0] * n_trees[1];
 
-    int nb_vertices_by_level_max = nb_vertices_by_level[n_levels-1];
+        htg_build_tree(value, nx, blank_value, trees[d]);
+    }
 
     //
-    // Determine the size of the mask variable. Remove any trailing zeros.
+    // Make sure there is something to write.
     //
-    int last_zero = -1;
-    int last_one = -1;
-    for (int i = 0; i < n_vertices; i++)
+    double local_range[3] = {-var_min, var_max, double(local_non_blank)};
+    double global_range[3] = {local_range[0], local_range[1], local_range[2]};
+#ifdef ASCENT_MPI_ENABLED
+    MPI_Allreduce(local_range, global_range, 2, MPI_DOUBLE, MPI_MAX, mpi_comm);
+    MPI_Allreduce(local_range + 2, global_range + 2, 1, MPI_DOUBLE, MPI_SUM, mpi_comm);
+#endif
+    if(global_range[2] == 0.)
     {
-        if (mask[i] == 0)
-            last_zero = i;
-        else
-            last_one = i;
+        ASCENT_ERROR("htg extract: the variable only had blank values."<<endl);
     }
-    int n_mask = 1;
-    int mask_min = 0;
-    int mask_max = 0;
-    if (last_one != -1)
+    var_min = -global_range[0];
+    var_max = global_range[1];
+
+    std::vector<char> buffer;
+    htg_pack_trees(trees, buffer);
+
+    conduit::Node n_info;
+    n_info.set(DataType::int64(trees.size() * 6));
+    int64 *info_ptr = n_info.value();
+    for(size_t t = 0; t < trees.size(); ++t)
     {
-        mask_max = 1;
-        n_mask = last_one + 1;
+        info_ptr[t * 6 + 0] = trees[t].m_index;
+        info_ptr[t * 6 + 1] = trees[t].m_nb_vertices_by_level.size();
+        info_ptr[t * 6 + 2] = trees[t].m_values.size();
+        info_ptr[t * 6 + 3] = trees[t].m_n_descriptor;
+        info_ptr[t * 6 + 4] = trees[t].m_n_mask;
+        info_ptr[t * 6 + 5] = trees[t].appended_bytes();
     }
+    // we don't need the trees anymore
+    std::vector<HTGTree>().swap(trees);
 
+#ifdef ASCENT_MPI_ENABLED
     //
-    // Create the descriptor variable. It is the opposite of the mask
-    // variable for all but the last level.
+    // Gather the tree descriptions on the root so it can write the
+    // header, and find where each rank writes its part of the appended
+    // data.
     //
-    int n_descriptor = 0;
-    for (int i = 0; i < n_levels-1; i++)
-        n_descriptor += nb_vertices_by_level[i];
+    conduit::Node n_all_info;
+    conduit::relay::mpi::gather_using_schema(n_info, n_all_info, 0, mpi_comm);
 
-    int *descriptor = new int[n_descriptor];
-    for (int i = 0; i < n_descriptor; i++)
-        descriptor[i] = (mask[i] == 0) ? 1 : 0;
+    uint64 local_bytes = buffer.size();
+    uint64 rank_offset = 0;
+    MPI_Exscan(&local_bytes, &rank_offset, 1, MPI_UINT64_T, MPI_SUM, mpi_comm);
+    if(par_rank == 0)
+    {
+        rank_offset = 0;
+    }
+    uint64 total_bytes = 0;
+    MPI_Allreduce(&local_bytes, &total_bytes, 1, MPI_UINT64_T, MPI_SUM, mpi_comm);
 
-    //
-    // Determine the size of the descriptor variable. Remove any trailing zeros.
-    //
-    last_zero = -1;
-    last_one = -1;
-    for (int i = 0; i < n_descriptor; i++)
+    std::string header;
+    uint64 header_size = 0;
+    if(par_rank == 0)
     {
-        if (descriptor[i] == 0)
-            last_zero = i;
-        else
-            last_one = i;
+        std::vector<int64> all_info;
+        for(index_t r = 0; r < n_all_info.number_of_children(); ++r)
+        {
+            const conduit::Node &n_rank = n_all_info.child(r);
+            const int64 *rank_info = n_rank.as_int64_ptr();
+            all_info.insert(all_info.end(),
+                            rank_info,
+                            rank_info + n_rank.dtype().number_of_elements());
+        }
+        header = htg_header(fname,
+                            n_trees,
+                            origin,
+                            tree_size,
+                            all_info.data(),
+                            all_info.size() / 6,
+                            var_min,
+                            var_max);
+        header_size = header.size();
+    }
+    MPI_Bcast(&header_size, 1, MPI_UINT64_T, 0, mpi_comm);
+
+    // remove any existing file so we don't leave stale bytes at the end
+    if(par_rank == 0 && conduit::utils::is_file(filename))
+    {
+        conduit::utils::remove_file(filename);
     }
-    n_descriptor = 1;
-    int descriptor_min = 0;
-    int descriptor_max = 0;
-    if (last_zero == -1)
-        descriptor_min = 1;
-    if (last_one != -1)
+    MPI_Barrier(mpi_comm);
+
+    MPI_File fh;
+    int err = MPI_File_open(mpi_comm,
+                            const_cast<char*>(filename.c_str()),
+                            MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                            MPI_INFO_NULL,
+                            &fh);
+    if(err != MPI_SUCCESS)
     {
-        descriptor_max = 1;
-        n_descriptor = last_one + 1;
+        ASCENT_ERROR("htg extract: failed to open '"<<filename<<"'"<<endl);
     }
 
-    //
-    // Replace any blank_value with zero.
-    //
-    for (int i = 0; i <n_vertices; i++)
+    if(par_rank == 0)
     {
-        if (var[i] == blank_value)
-            var[i] = 0.;
+        MPI_File_write_at(fh, 0, const_cast<char*>(header.data()),
+                          static_cast<int>(header.size()), MPI_CHAR,
+                          MPI_STATUS_IGNORE);
+        const std::string footer = htg_footer();
+        MPI_File_write_at(fh, header_size + total_bytes,
+                          const_cast<char*>(footer.data()),
+                          static_cast<int>(footer.size()), MPI_CHAR,
+                          MPI_STATUS_IGNORE);
     }
 
-    htg_write_file(path, bounds, n_levels, n_vertices, n_descriptor,
-                   descriptor_min, descriptor_max, descriptor,
-                   nb_vertices_by_level_max, nb_vertices_by_level,
-                   n_mask, mask_min, mask_max, mask, var_min, var_max, var);
+    // MPI counts are ints, so write large buffers in chunks
+    const uint64 max_chunk = 1ULL << 30;
+    uint64 written = 0;
+    while(written < local_bytes)
+    {
+        const uint64 chunk = std::min(max_chunk, local_bytes - written);
+        MPI_File_write_at(fh,
+                          static_cast<MPI_Offset>(header_size + rank_offset + written),
+                          buffer.data() + written,
+                          static_cast<int>(chunk),
+                          MPI_CHAR,
+                          MPI_STATUS_IGNORE);
+        written += chunk;
+    }
+    MPI_File_close(&fh);
+#else
+    const std::string header = htg_header(fname,
+                                          n_trees,
+                                          origin,
+                                          tree_size,
+                                          info_ptr,
+                                          n_info.dtype().number_of_elements() / 6,
+                                          var_min,
+                                          var_max);
+    std::ofstream ofile(filename.c_str(), std::ios::out | std::ios::binary);
+    if(!ofile.is_open())
+    {
+        ASCENT_ERROR("htg extract: failed to open '"<<filename<<"'"<<endl);
+    }
+    ofile.write(header.data(), header.size());
+    ofile.write(buffer.data(), buffer.size());
+    const std::string footer = htg_footer();
+    ofile.write(footer.data(), footer.size());
+    ofile.close();
+#endif
+    return true;
 }
 
+//-----------------------------------------------------------------------------
+// Every field has its own tree structure (blank cells are not refined),
+// so each one is written to its own file: <path>_<field>.htg. The names
+// of the files are appended to files.
+//-----------------------------------------------------------------------------
 void htg_save(const Node &data,
               const Node &fields,
               const std::string &path,
-              double blank_value)
+              double blank_value,
+              Node &files)
 {
-    if (data.number_of_children() != 1)
-    {
-        ASCENT_ERROR("htg extract requires a single domain."<<endl);
-    }
-
-    const conduit::Node &dom = data.child(0);
-
     //
     // Determine the fields. If the fields node is empty then use all
     // the fields.
     //
-    int nfields = fields.number_of_children();
     std::vector<std::string> fnames;
-    if (nfields == 0 && dom.has_path("fields"))
+    if (fields.number_of_children() == 0)
     {
-        fnames = dom["fields"].child_names();
-        nfields = fnames.size();
+        std::set<std::string> all_fields;
+        const index_t num_domains = data.number_of_children();
+        for(index_t d = 0; d < num_domains; ++d)
+        {
+            const conduit::Node &dom = data.child(d);
+            if(dom.has_path("fields"))
+            {
+                std::vector<std::string> dom_fields = dom["fields"].child_names();
+                all_fields.insert(dom_fields.begin(), dom_fields.end());
+            }
+        }
+        // ranks may have different (or no) domains
+        gather_strings(all_fields);
+        fnames.insert(fnames.end(), all_fields.begin(), all_fields.end());
     }
     else
     {
-        fnames = fields.child_names();
+        const index_t nfields = fields.number_of_children();
+        for(index_t f = 0; f < nfields; ++f)
+        {
+            const conduit::Node &n_field = fields.child(f);
+            fnames.push_back(n_field.dtype().is_string() ? n_field.as_string()
+                                                         : n_field.name());
+        }
     }
 
     //
     // Loop over the fields.
     //
-    for(int f = 0; f < nfields; ++f)
+    for(size_t f = 0; f < fnames.size(); ++f)
     {
-        const std::string fname = fnames[f];
-        if(dom.has_path("fields/" + fname))
+        const std::string filename = path + "_" + fnames[f] + ".htg";
+        if(htg_write_field(data, fnames[f], filename, static_cast<float32>(blank_value)))
         {
-            const std::string fpath = "fields/" + fname;
-            const std::string topo = dom[fpath + "/topology"].as_string();
-            const std::string tpath = "topologies/" + topo;
-            const std::string coords = dom[tpath + "/coordset"].as_string();
-            const std::string cpath = "coordsets/" + coords;
-
-            if(dom[fpath + "/association"].as_string() != "element")
-            {
-                ASCENT_INFO(fname<<": htg extract requires an element association, skipping."<<endl);
-                continue;
-            }
-            if(dom[cpath + "/type"].as_string() != "uniform")
-            {
-                ASCENT_INFO(fname<<": htg extract requires a uniform mesh, skipping."<<endl);
-                continue;
-            }
-            if (!dom.has_path(cpath + "/dims/k"))
-            {
-                ASCENT_INFO(fname<<": htg extract requires a 3d mesh, skipping."<<endl);
-                continue;
-            }
-
-            int nx, ny, nz;
-            nx = dom[cpath + "/dims/i"].to_int32();
-            ny = dom[cpath + "/dims/j"].to_int32();
-            nz = dom[cpath + "/dims/k"].to_int32();
-            if (nx != ny && ny != nz)
-            {
-                ASCENT_INFO(fname<<": htg extract requires the dimensions to be equal, skipping."<<endl);
-                continue;
-            }
-            nx = nx - 1;
-            if (nx == 0 || ((nx & (nx - 1)) != 0))
-            {
-                ASCENT_INFO(fname<<": htg extract requires the grid dimension to be a power of 2, skipping."<<endl);
-                continue;
-            }
-
-            double x0, y0, z0, dx, dy, dz;
-            double bounds[6];
-            x0 = dom[cpath + "/origin/x"].to_float64();
-            y0 = dom[cpath + "/origin/y"].to_float64();
-            z0 = dom[cpath + "/origin/z"].to_float64();
-            dx = dom[cpath + "/spacing/dx"].to_float64();
-            dy = dom[cpath + "/spacing/dy"].to_float64();
-            dz = dom[cpath + "/spacing/dz"].to_float64();
-            bounds[0] = x0;
-            bounds[1] = x0 + dx * double(nx);
-            bounds[2] = y0;
-            bounds[3] = y0 + dy * double(nx);
-            bounds[4] = z0;
-            bounds[5] = z0 + dz * double(nx);
-            conduit::Node res;
-            if (dom[fpath + "/values"].dtype().is_float() &&
-                dom[fpath + "/values"].dtype().is_compact())
-            {
-                res.set_external(dom[fpath + "/values"]);
-            }
-            else
-            {
-                dom[fpath + "/values"].to_float_array(res);
-            }
-            const float *values = res.value();
-
-            htg_write(path, blank_value, nx, bounds, values);
+            files.append() = filename;
         }
     }
 }
@@ -673,10 +936,6 @@ HTGIOSave::verify_params(const conduit::Node &params,
 void
 HTGIOSave::execute()
 {
-
-#if ASCENT_MPI_ENABLED
-    ASCENT_ERROR("htg extract only supports serial execution"<<endl);
-#endif
     std::string path;
     path = params()["path"].as_string();
     path = output_dir(path);
@@ -703,7 +962,8 @@ HTGIOSave::execute()
       fields = params()["fields"];
     }
 
-    htg_save(*in, fields, path, blank_value);
+    Node files;
+    htg_save(*in, fields, path, blank_value, files);
 
     // add this to the extract results in the registry
     if(!graph().workspace().registry().has_entry("extract_list"))
@@ -719,6 +979,7 @@ HTGIOSave::execute()
     Node &einfo = extract_list->append();
     einfo["type"] = "htg";
     einfo["path"] = path;
+    einfo["files"] = files;
 }
 
 
@@ -2037,8 +2037,37 @@ ExecScene::execute()
 
     detail::AscentScene *scene = input<detail::AscentScene>(0);
     std::vector<vtkh::Render> * renders = input<std::vector<vtkh::Render>>(1);
+
+    // the runtime adds a png list when images are streamed to the
+    // web client, in that case keep the encoded images in memory
+    // so they don't have to be read back from disk
+    conduit::Node *png_list = nullptr;
+    if(graph().workspace().registry().has_entry("image_png_list"))
+    {
+      png_list = graph().workspace().registry().fetch<Node>("image_png_list");
+      for(size_t i = 0; i < renders->size(); ++i)
+      {
+        renders->at(i).SetKeepPNG(true);
+      }
+    }
+
     scene->Execute(*renders);
 
+    if(png_list != nullptr)
+    {
+      for(size_t i = 0; i < renders->size(); ++i)
+      {
+        const std::vector<unsigned char> *png = renders->at(i).GetPNG();
+        if(png != nullptr && !png->empty())
+        {
+          conduit::Node &png_entry = png_list->append();
+          png_entry["image_name"] = renders->at(i).GetImageName() + ".png";
+          png_entry["png"].set(png->data(), png->size());
+        }
+        renders->at(i).SetKeepPNG(false);
+      }
+    }
+
     // the images should exist now so add them to the image list
     // this can be used for the web server or jupyter
 
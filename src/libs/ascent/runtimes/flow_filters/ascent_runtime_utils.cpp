@@ -16,6 +16,8 @@
 #include <ascent_string_utils.hpp>
 #include <ascent_metadata.hpp>
 
+#include <conduit_blueprint_mesh.hpp>
+
 #include <algorithm>
 
 using namespace conduit;
@@ -79,6 +81,152 @@ std::string filter_to_path(const std::string filter_name)
   }
   return res;
 }
+
+//-----------------------------------------------------------------------------
+// leaves larger than this are identified by their memory, not contents
+static const conduit::index_t signature_max_leaf_bytes = 512;
+
+static void fnv1a(const void *data, const size_t bytes, conduit::uint64 &hash)
+{
+  const unsigned char *ptr = static_cast<const unsigned char*>(data);
+  for(size_t i = 0; i < bytes; ++i)
+  {
+    hash ^= ptr[i];
+    hash *= 1099511628211ULL;
+  }
+}
+
+void node_signature(const conduit::Node &node, conduit::uint64 &hash)
+{
+  const conduit::index_t num_children = node.number_of_children();
+  if(num_children > 0)
+  {
+    for(conduit::index_t i = 0; i < num_children; ++i)
+    {
+      const std::string name = node.child(i).name();
+      fnv1a(name.c_str(), name.size(), hash);
+      node_signature(node.child(i), hash);
+    }
+    return;
+  }
+
+  const conduit::DataType &dtype = node.dtype();
+  const conduit::index_t dtype_id = dtype.id();
+  const conduit::index_t elements = dtype.number_of_elements();
+  fnv1a(&dtype_id, sizeof(dtype_id), hash);
+  fnv1a(&elements, sizeof(elements), hash);
+  if(dtype.is_empty() || dtype.is_object() || dtype.is_list())
+  {
+    return;
+  }
+
+  if(dtype.bytes_compact() <= signature_max_leaf_bytes)
+  {
+    if(dtype.is_compact())
+    {
+      fnv1a(node.element_ptr(0), dtype.bytes_compact(), hash);
+    }
+    else
+    {
+      conduit::Node compact;
+      node.compact_to(compact);
+      fnv1a(compact.data_ptr(), compact.total_bytes_compact(), hash);
+    }
+  }
+  else
+  {
+    const void *ptr = node.element_ptr(0);
+    const conduit::index_t stride = dtype.stride();
+    fnv1a(&ptr, sizeof(ptr), hash);
+    fnv1a(&stride, sizeof(stride), hash);
+  }
+}
+
+conduit::uint64 node_signature(const conduit::Node &node)
+{
+  conduit::uint64 hash = 14695981039346656037ULL;
+  node_signature(node, hash);
+  return hash;
+}
+
+//-----------------------------------------------------------------------------
+bool
+BlueprintVerifyCache::verify_domain(const conduit::Node &dom,
+                                    const conduit::index_t index,
+                                    conduit::Node &info)
+{
+  const conduit::uint64 signature = node_signature(dom);
+  if(index < (conduit::index_t)m_signatures.size() &&
+     m_signatures[index] == signature)
+  {
+    return true;
+  }
+
+  if(index >= (conduit::index_t)m_signatures.size())
+  {
+    m_signatures.resize(index + 1, 0);
+  }
+  m_last_num_verified++;
+  if(!conduit::blueprint::mesh::verify(dom, info))
+  {
+    // 0 never matches a real signature (fnv offset basis is non-zero)
+    m_signatures[index] = 0;
+    return false;
+  }
+  m_signatures[index] = signature;
+  return true;
+}
+
+bool
+BlueprintVerifyCache::verify_mesh(const conduit::Node &mesh,
+                                  conduit::Node &info)
+{
+  info.reset();
+  m_last_num_verified = 0;
+
+  if(!conduit::blueprint::mesh::is_multi_domain(mesh))
+  {
+    m_signatures.resize(1);
+    return verify_domain(mesh, 0, info);
+  }
+
+  const conduit::index_t num_domains = mesh.number_of_children();
+  if(num_domains == 0)
+  {
+    // let blueprint explain what is wrong
+    m_signatures.clear();
+    m_last_num_verified = 1;
+    return conduit::blueprint::mesh::verify(mesh, info);
+  }
+
+  bool res = true;
+  for(conduit::index_t i = 0; i < num_domains; ++i)
+  {
+    const conduit::Node &dom = mesh.child(i);
+    conduit::Node dom_info;
+    if(!verify_domain(dom, i, dom_info))
+    {
+      info["domains"][dom.name()].set(dom_info);
+      res = false;
+    }
+  }
+  m_signatures.resize(num_domains);
+  info["valid"] = res ? "true" : "false";
+  return res;
+}
+
+conduit::index_t
+BlueprintVerifyCache::last_num_verified() const
+{
+  return m_last_num_verified;
+}
+
+void
+BlueprintVerifyCache::reset()
+{
+  m_signatures.clear();
+  m_last_num_verified = 0;
+}
 //-----------------------------------------------------------------------------
 };
 //-----------------------------------------------------------------------------
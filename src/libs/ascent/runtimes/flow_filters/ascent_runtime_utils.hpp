@@ -17,6 +17,7 @@
 #include <conduit.hpp>
 #include <ascent_exports.h>
 #include <string>
+#include <vector>
 
 //-----------------------------------------------------------------------------
 // -- begin ascent:: --
@@ -47,6 +48,32 @@ std::string ASCENT_API default_dir();
 
 std::string ASCENT_API filter_to_path(const std::string filter_name);
 
+// Cheap signature of a tree: the names, dtypes and lengths of every node,
+// the values of small leaves and the address and stride of large arrays.
+// Equal signatures mean the same layout over the same memory.
+void ASCENT_API node_signature(const conduit::Node &node,
+                               conduit::uint64 &hash);
+conduit::uint64 ASCENT_API node_signature(const conduit::Node &node);
+
+// Blueprint mesh verify that remembers the signature of every domain that
+// passed and only verifies domains whose signature changed since.
+class ASCENT_API BlueprintVerifyCache
+{
+public:
+  // verifies a single or multi-domain mesh, info only holds the
+  // details of domains that were verified by this call
+  bool verify_mesh(const conduit::Node &mesh, conduit::Node &info);
+  // number of domains verified (not skipped) by the last call
+  conduit::index_t last_num_verified() const;
+  void reset();
+private:
+  bool verify_domain(const conduit::Node &dom,
+                     const conduit::index_t index,
+                     conduit::Node &info);
+  std::vector<conduit::uint64> m_signatures;
+  conduit::index_t m_last_num_verified = 0;
+};
+
 //-----------------------------------------------------------------------------
 };
 //-----------------------------------------------------------------------------
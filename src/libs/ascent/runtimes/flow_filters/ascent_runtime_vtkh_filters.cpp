@@ -68,6 +68,7 @@
 #include <vtkh/filters/UniformGrid.hpp>
 #include <vtkh/filters/Slice.hpp>
 #include <vtkh/filters/Statistics.hpp>
+#include <vtkh/filters/TemporalAccumulate.hpp>
 #include <vtkh/filters/Streamline.hpp>
 #include <vtkh/filters/WarpXStreamline.hpp>
 #include <vtkh/filters/Threshold.hpp>
@@ -722,9 +723,11 @@ VTKHCleanGrid::verify_params(const conduit::Node &params,
     bool res = true;
 
     res = check_string("topology",params, info, false) && res;
+    res = check_numeric("tolerance",params, info, false) && res;
 
     std::vector<std::string> valid_paths;
     valid_paths.push_back("topology");
+    valid_paths.push_back("tolerance");
 
 
     std::string surprises = surprise_check(valid_paths, params);
@@ -772,6 +775,13 @@ VTKHCleanGrid::execute()
     vtkh::CleanGrid cleaner;
 
     cleaner.SetInput(&data);
+    // other filters share points by topology, merging nearby
+    // points is what this filter is asked for
+    cleaner.MergePoints(true);
+    if(params().has_path("tolerance"))
+    {
+      cleaner.Tolerance(get_float64(params()["tolerance"], data_object));
+    }
 
     cleaner.Update();
 
@@ -2640,6 +2650,201 @@ VTKHLagrangian::execute()
     set_output<DataObject>(res);
 }
 
+//-----------------------------------------------------------------------------
+std::shared_ptr<vtkh::TemporalAccumulate::State>
+TemporalAccumulateStates::get_state(const std::string &name)
+{
+  auto it = m_states.find(name);
+  if(it == m_states.end())
+  {
+    auto state = std::make_shared<vtkh::TemporalAccumulate::State>();
+    m_states[name] = state;
+    return state;
+  }
+  return it->second;
+}
+
+//-----------------------------------------------------------------------------
+void
+TemporalAccumulateStates::reset(const std::string &name)
+{
+  m_states.erase(name);
+}
+
+//-----------------------------------------------------------------------------
+void
+TemporalAccumulateStates::reset()
+{
+  m_states.clear();
+}
+
+//-----------------------------------------------------------------------------
+VTKHTemporalAccumulate::VTKHTemporalAccumulate()
+:Filter()
+{
+// empty
+}
+
+//-----------------------------------------------------------------------------
+VTKHTemporalAccumulate::~VTKHTemporalAccumulate()
+{
+// empty
+}
+
+//-----------------------------------------------------------------------------
+void
+VTKHTemporalAccumulate::declare_interface(Node &i)
+{
+    i["type_name"]   = "vtkh_temporal_accumulate";
+    i["port_names"].append() = "in";
+    i["output_port"] = "true";
+}
+
+//-----------------------------------------------------------------------------
+bool
+VTKHTemporalAccumulate::verify_params(const conduit::Node &params,
+                                      conduit::Node &info)
+{
+    info.reset();
+
+    bool res = check_string("field",params, info, true);
+    res &= check_numeric("alpha",params, info, false, true);
+    res &= check_numeric("reset",params, info, false, true);
+    res &= check_string("output_prefix",params, info, false);
+
+    if(params.has_child("outputs"))
+    {
+      if(!params["outputs"].dtype().is_list())
+      {
+        res = false;
+        info["errors"].append() = "outputs is not a list";
+      }
+      else
+      {
+        NodeConstIterator itr = params["outputs"].children();
+        while(itr.has_next())
+        {
+          const Node &child = itr.next();
+          const std::string output = child.dtype().is_string() ? child.as_string() : "";
+          if(output != "mean" && output != "variance" && output != "min" &&
+             output != "max" && output != "ema" && output != "count")
+          {
+            res = false;
+            info["errors"].append() = "outputs entries must be one of: "
+                                      "'mean', 'variance', 'min', 'max', "
+                                      "'ema', 'count'";
+            break;
+          }
+        }
+      }
+    }
+
+    std::vector<std::string> valid_paths;
+    valid_paths.push_back("field");
+    valid_paths.push_back("alpha");
+    valid_paths.push_back("reset");
+    valid_paths.push_back("output_prefix");
+
+    std::vector<std::string> ignore_paths = {"outputs"};
+
+    std::string surprises = surprise_check(valid_paths, ignore_paths, params);
+
+    if(surprises != "")
+    {
+      res = false;
+      info["errors"].append() = surprises;
+    }
+    return res;
+}
+
+//-----------------------------------------------------------------------------
+void
+VTKHTemporalAccumulate::execute()
+{
+    if(!input(0).check_type<DataObject>())
+    {
+        ASCENT_ERROR("vtkh_temporal_accumulate input must be a data object");
+    }
+
+    DataObject *data_object = input<DataObject>(0);
+    if(!data_object->is_valid())
+    {
+      set_output<DataObject>(data_object);
+      return;
+    }
+    std::shared_ptr<VTKHCollection> collection = data_object->as_vtkh_collection();
+
+    std::string field_name = params()["field"].as_string();
+    if(!collection->has_field(field_name))
+    {
+      bool throw_error = false;
+      detail::field_error(field_name, this->name(), collection, throw_error);
+      // this creates a data object with an invalid soource
+      set_output<DataObject>(new DataObject());
+      return;
+    }
+
+    std::string topo_name = collection->field_topology(field_name);
+
+    vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
+
+    // the runtime keeps the state across executes, without it the
+    // statistics only cover this execute
+    TemporalAccumulateStates local_states;
+    TemporalAccumulateStates *states = &local_states;
+    if(graph().workspace().registry().has_entry("temporal_accumulate_states"))
+    {
+      states = graph().workspace().registry()
+                 .fetch<TemporalAccumulateStates>("temporal_accumulate_states");
+    }
+
+    // reset can be an expression, e.g. "cycle() % 100 == 0"
+    if(params().has_path("reset") &&
+       get_float64(params()["reset"], data_object) != 0.)
+    {
+      states->reset(this->name());
+    }
+
+    vtkh::TemporalAccumulate accumulate;
+    accumulate.SetInput(&data);
+    accumulate.SetField(field_name);
+    accumulate.SetState(states->get_state(this->name()));
+
+    if(params().has_path("alpha"))
+    {
+      accumulate.SetAlpha(get_float64(params()["alpha"], data_object));
+    }
+
+    if(params().has_path("output_prefix"))
+    {
+      accumulate.SetResultPrefix(params()["output_prefix"].as_string());
+    }
+
+    if(params().has_path("outputs"))
+    {
+      std::vector<std::string> outputs;
+      NodeConstIterator itr = params()["outputs"].children();
+      while(itr.has_next())
+      {
+        outputs.push_back(itr.next().as_string());
+      }
+      accumulate.SetOutputs(outputs);
+    }
+
+    accumulate.Update();
+
+    vtkh::DataSet *accum_output = accumulate.GetOutput();
+
+    // we need to pass through the rest of the topologies, untouched,
+    // and add the result of this operation
+    VTKHCollection *new_coll = collection->copy_without_topology(topo_name);
+    new_coll->add(*accum_output, topo_name);
+    // re wrap in data object
+    DataObject *res =  new DataObject(new_coll);
+    delete accum_output;
+    set_output<DataObject>(res);
+}
+
 //-----------------------------------------------------------------------------
 
 VTKHLog::VTKHLog()
@@ -3189,29 +3394,7 @@ VTKHHistSampling::execute()
       }
     }
 
-    // TODO: write helper functions for this
-    std::string ghost_field = "";
-    Node meta = Metadata::n_metadata;
-
-    if(meta.has_path("ghost_field"))
-    {
-
-      // there can be multiple ghost fields on different topologies
-      // We should only find one(max) associated with this vtkh data set
-      const conduit::Node ghost_list = meta["ghost_field"];
-      const int num_ghosts = ghost_list.number_of_children();
-
-      for(int i = 0; i < num_ghosts; ++i)
-      {
-        std::string ghost = ghost_list.child(i).as_string();
-        if(data.GlobalFieldExists(ghost_field))
-        {
-          ghost_field = ghost;
-          break;
-        }
-      }
-
-    }
+    std::string ghost_field = detail::ghost_field_name(data);
 
     vtkh::HistSampling hist;
 
@@ -3917,12 +4100,67 @@ VTKHStats::verify_params(const conduit::Node &params,
 {
     info.reset();
 
-    bool res = check_string("field",params, info, true);
+    bool res = true;
+    if(params.has_child("fields"))
+    {
+      if(!params["fields"].dtype().is_list() ||
+         params["fields"].number_of_children() == 0)
+      {
+        res = false;
+        info["errors"].append() = "fields is not a non-empty list of strings";
+      }
+      else
+      {
+        NodeConstIterator itr = params["fields"].children();
+        while(itr.has_next())
+        {
+          const Node &child = itr.next();
+          if(!child.dtype().is_string())
+          {
+            res = false;
+            info["errors"].append() = "fields list entries must be strings";
+            break;
+          }
+        }
+      }
+    }
+    else
+    {
+      res = check_string("field",params, info, true);
+    }
+
+    if(params.has_child("percentiles"))
+    {
+      const Node &n_percentiles = params["percentiles"];
+      if(!n_percentiles.dtype().is_number() && !n_percentiles.dtype().is_list())
+      {
+        res = false;
+        info["errors"].append() = "percentiles must be a number or a list of numbers";
+      }
+      else
+      {
+        Node n_values;
+        n_percentiles.to_float64_array(n_values);
+        float64_array values = n_values.value();
+        for(index_t i = 0; i < values.number_of_elements(); ++i)
+        {
+          if(values[i] < 0. || values[i] > 100.)
+          {
+            res = false;
+            info["errors"].append() = "percentiles must be in the range [0,100]";
+            break;
+          }
+        }
+      }
+    }
 
     std::vector<std::string> valid_paths;
     valid_paths.push_back("field");
+    valid_paths.push_back("percentiles");
 
-    std::string surprises = surprise_check(valid_paths, params);
+    std::vector<std::string> ignore_paths = {"fields"};
+
+    std::string surprises = surprise_check(valid_paths, ignore_paths, params);
 
     if(surprises != "")
     {
@@ -3951,35 +4189,118 @@ VTKHStats::execute()
     }
     std::shared_ptr<VTKHCollection> collection = data_object->as_vtkh_collection();
 
-    std::string field_name = params()["field"].as_string();
-    if(!collection->has_field(field_name))
+    std::vector<std::string> field_names;
+    if(params().has_child("fields"))
     {
-      bool throw_error = false;
-      detail::field_error(field_name, this->name(), collection, throw_error);
-      // this creates a data object with an invalid soource
-      set_output<DataObject>(new DataObject());
-      return;
+      NodeConstIterator itr = params()["fields"].children();
+      while(itr.has_next())
+      {
+        field_names.push_back(itr.next().as_string());
+      }
+    }
+    else
+    {
+      field_names.push_back(params()["field"].as_string());
     }
 
-    std::string topo_name = collection->field_topology(field_name);
+    // all the fields are processed in the same pass, so they
+    // need to live on the same topology
+    std::string topo_name;
+    for(const std::string &field_name : field_names)
+    {
+      if(!collection->has_field(field_name))
+      {
+        bool throw_error = false;
+        detail::field_error(field_name, this->name(), collection, throw_error);
+        // this creates a data object with an invalid soource
+        set_output<DataObject>(new DataObject());
+        return;
+      }
+      const std::string field_topo = collection->field_topology(field_name);
+      if(topo_name == "")
+      {
+        topo_name = field_topo;
+      }
+      else if(topo_name != field_topo)
+      {
+        ASCENT_ERROR("statistics: all fields must be associated with the "
+                     <<"same topology. Field '"<<field_name<<"' is on '"
+                     <<field_topo<<"' but expected '"<<topo_name<<"'");
+      }
+    }
 
     vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
 
+    std::vector<vtkm::Float64> percentiles;
+    if(params().has_child("percentiles"))
+    {
+      Node n_values;
+      params()["percentiles"].to_float64_array(n_values);
+      float64_array values = n_values.value();
+      for(index_t i = 0; i < values.number_of_elements(); ++i)
+      {
+        percentiles.push_back(values[i]);
+      }
+    }
+
     vtkh::Statistics stats;
-    stats.SetField(field_name);
+    stats.SetFields(field_names);
+    stats.SetPercentiles(percentiles);
+    // real ghost zones would otherwise be counted more than once
+    std::string ghost_field = detail::ghost_field_name(data);
+    if(ghost_field != "")
+    {
+      stats.SetGhostField(ghost_field);
+    }
     stats.SetInput(&data);
     stats.Update();
+    delete stats.GetOutput();
 
-    vtkh::DataSet* res = stats.GetOutput();
-    int rank = 0;
-#ifdef ASCENT_MPI_ENABLED
-    MPI_Comm mpi_comm = MPI_Comm_f2c(Workspace::default_mpi_comm());
-    MPI_Comm_rank(mpi_comm, &rank);
-#endif
-    // if(rank == 0)
-    // {
-    //   res->PrintSummary(std::cout);
-    // }
+    const vtkh::Statistics::Result &res = stats.GetResult();
+
+    // add this to the extract results in the registry
+    if(!graph().workspace().registry().has_entry("extract_list"))
+    {
+      conduit::Node *extract_list = new conduit::Node();
+      graph().workspace().registry().add<Node>("extract_list",
+                                               extract_list,
+                                               -1); // TODO keep forever?
+    }
+
+    conduit::Node *extract_list = graph().workspace().registry().fetch<Node>("extract_list");
+
+    Node &einfo = extract_list->append();
+    einfo["type"] = "statistics";
+    for(const vtkh::Statistics::FieldResult &fres : res.m_fields)
+    {
+      Node &n_field = einfo["fields/" + fres.m_name];
+      n_field["count"] = (int64) fres.m_count;
+      n_field["min"] = fres.m_min;
+      n_field["max"] = fres.m_max;
+      n_field["sum"] = fres.m_sum;
+      n_field["mean"] = fres.m_mean;
+      n_field["sample_variance"] = fres.m_sample_variance;
+      n_field["population_variance"] = fres.m_population_variance;
+      n_field["skewness"] = fres.m_skewness;
+      n_field["kurtosis"] = fres.m_kurtosis;
+      if(!fres.m_percentiles.empty())
+      {
+        n_field["percentiles"].set(fres.m_percentiles);
+      }
+    }
+    if(!res.m_percentiles.empty())
+    {
+      einfo["percentiles"].set(res.m_percentiles);
+    }
+    if(!res.m_covariance.empty())
+    {
+      for(const std::string &field_name : field_names)
+      {
+        einfo["field_order"].append() = field_name;
+      }
+      einfo["covariance"].set(res.m_covariance);
+      einfo["correlation"].set(res.m_correlation);
+    }
 }
 //-----------------------------------------------------------------------------
 
@@ -4067,9 +4388,16 @@ VTKHHistogram::execute()
       bins = get_int32(params()["bins"], data_object);
     }
 
+    // honor real ghost zones as a mask rather than stripping them
+    std::string ghost_field = detail::ghost_field_name(data);
+
     vtkh::Histogram hist;
 
     hist.SetNumBins(bins);
+    if(ghost_field != "")
+    {
+      hist.SetGhostField(ghost_field);
+    }
     vtkh::Histogram::HistogramResult res = hist.Run(data, field_name);
     int rank = 0;
 #ifdef ASCENT_MPI_ENABLED
@@ -17,6 +17,11 @@
 #include <ascent.hpp>
 
 #include <flow_filter.hpp>
+#include <vtkh/filters/TemporalAccumulate.hpp>
+
+#include <map>
+#include <memory>
+#include <string>
 
 
 //-----------------------------------------------------------------------------
@@ -227,6 +232,35 @@ public:
     virtual void   execute();
 };
 
+//-----------------------------------------------------------------------------
+// running state of the accumulate filters, keyed by filter name. The flow
+// graph is rebuilt every execute so the runtime owns it and passes it to the
+// filters through the registry as "temporal_accumulate_states"
+class ASCENT_API TemporalAccumulateStates
+{
+public:
+  std::shared_ptr<vtkh::TemporalAccumulate::State>
+       get_state(const std::string &name);
+  void reset(const std::string &name);
+  void reset();
+private:
+  std::map<std::string,
+           std::shared_ptr<vtkh::TemporalAccumulate::State>> m_states;
+};
+
+//-----------------------------------------------------------------------------
+class ASCENT_API VTKHTemporalAccumulate : public ::flow::Filter
+{
+public:
+    VTKHTemporalAccumulate();
+    virtual ~VTKHTemporalAccumulate();
+
+    virtual void   declare_interface(conduit::Node &i);
+    virtual bool   verify_params(const conduit::Node &params,
+                                 conduit::Node &info);
+    virtual void   execute();
+};
+
 //-----------------------------------------------------------------------------
 class ASCENT_API VTKHLog: public ::flow::Filter
 {
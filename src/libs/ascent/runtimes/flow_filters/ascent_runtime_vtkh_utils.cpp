@@ -13,6 +13,7 @@
 
 #include "ascent_runtime_vtkh_utils.hpp"
 #include <ascent_runtime_utils.hpp>
+#include <ascent_metadata.hpp>
 
 //-----------------------------------------------------------------------------
 // -- begin ascent:: --
@@ -154,6 +155,30 @@ std::string resolve_topology(const conduit::Node &params,
   return topo_name;
 }
 
+//-----------------------------------------------------------------------------
+std::string ghost_field_name(vtkh::DataSet &data)
+{
+  const conduit::Node &meta = Metadata::n_metadata;
+  if(!meta.has_path("ghost_field"))
+  {
+    return "";
+  }
+
+  // there can be multiple ghost fields on different topologies
+  // We should only find one(max) associated with this vtkh data set
+  const conduit::Node &ghost_list = meta["ghost_field"];
+  const int num_ghosts = ghost_list.number_of_children();
+  for(int i = 0; i < num_ghosts; ++i)
+  {
+    const std::string ghost = ghost_list.child(i).as_string();
+    if(data.GlobalFieldExists(ghost))
+    {
+      return ghost;
+    }
+  }
+  return "";
+}
+
 } // namespace detail
 //-----------------------------------------------------------------------------
 };
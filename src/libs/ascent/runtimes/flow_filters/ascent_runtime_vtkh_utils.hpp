@@ -58,6 +58,10 @@ std::string resolve_topology(const conduit::Node &params,
                              std::shared_ptr<VTKHCollection> collection,
                              bool error = true);
 
+// returns the name of the published ghost field that exists on
+// this data set or an empty string if there is none
+std::string ghost_field_name(vtkh::DataSet &data);
+
 } // namespace detail
 //-----------------------------------------------------------------------------
 };
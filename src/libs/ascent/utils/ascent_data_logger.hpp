@@ -2,31 +2,20 @@
 #define ASCENT_DATA_LOGGER_HPP
 
 #include <ascent_exports.h>
-#include <flow_timer.hpp>
+#include <flow_trace.hpp>
 
 #include <string>
-#include <stack>
-#include <map>
 #include <sstream>
+#include <type_traits>
 
-//from rover logging
 namespace ascent
 {
 
+// front end of flow::Trace for ascent, entries are trace regions and data
+// are trace counters (numbers) or annotations (everything else)
 class ASCENT_API DataLogger
 {
 public:
-  struct Block
-  {
-    int m_indent;
-    bool m_is_list;
-    bool m_at_list_item_start;
-
-    Block(int indent)
-      : m_indent(indent), m_is_list(false), m_at_list_item_start(false)
-    {  }
-  };
-
   ~DataLogger();
   static DataLogger *instance();
   void open_entry(const std::string &entryName);
@@ -36,26 +25,31 @@ public:
   template<typename T>
   void add_data(const std::string key, const T &value)
   {
-    write_indent();
-    this->m_stream << key << ": " << value <<"\n";
-    m_at_block_start = false;
+    if(flow::Trace::enabled())
+    {
+      add_data(key, value, std::is_arithmetic<T>());
+    }
   }
 
-  std::stringstream& stream() { return m_stream; }
 protected:
   DataLogger();
   DataLogger(DataLogger const &);
 
-  void write_log();
-  void write_indent();
-  DataLogger::Block& current_block();
-  std::stringstream m_stream;
+  template<typename T>
+  void add_data(const std::string &key, const T &value, std::true_type)
+  {
+    flow::Trace::value(key, static_cast<double>(value));
+  }
+
+  template<typename T>
+  void add_data(const std::string &key, const T &value, std::false_type)
+  {
+    std::stringstream ss;
+    ss << value;
+    flow::Trace::text(key, ss.str());
+  }
+
   static class DataLogger m_instance;
-  std::stack<Block> m_blocks;
-  std::stack<flow::Timer> Timers;
-  std::stack<std::map<std::string,int>> m_key_counters;
-  bool m_at_block_start;
-  int m_rank;
 };
 
 #define ASCENT_DATA_OPEN(key) ascent::DataLogger::instance()->open_entry(key);
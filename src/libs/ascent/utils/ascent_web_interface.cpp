@@ -71,12 +71,26 @@ WebInterface::WebInterface()
 :m_enabled(false),
  m_ms_poll(100),
  m_ms_timeout(100),
- m_doc_root("")
+ m_doc_root(""),
+ m_stop(false),
+ m_connected(false),
+ m_has_renders(false),
+ m_dropped_renders(0)
 {}
 
 //-----------------------------------------------------------------------------
 WebInterface::~WebInterface()
 {
+    if(m_thread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_stop = true;
+        }
+        m_cond.notify_one();
+        // the send thread flushes anything still pending before it exits
+        m_thread.join();
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -104,55 +118,78 @@ WebInterface::SetTimeout(int ms_timeout)
 void
 WebInterface::Enable()
 {
+    if(m_enabled)
+    {
+        return;
+    }
+
+    // start the server here, so any errors are reported on the
+    // caller's thread instead of escaping the send thread
+    StartServer();
     m_enabled = true;
+    m_thread = std::thread(&WebInterface::SendLoop, this);
 }
 
 //-----------------------------------------------------------------------------
-WebSocket *
-WebInterface::Connection()
+bool
+WebInterface::IsEnabled() const
 {
-    if(!m_enabled)
+    return m_enabled;
+}
+
+//-----------------------------------------------------------------------------
+void
+WebInterface::StartServer()
+{
+    if(m_server.is_running())
     {
-        return NULL;
+        return;
     }
-    // start our web server if necessary
-    if(!m_server.is_running())
-    {
-        m_server.set_port(8081);
 
-        std::string  default_root =conduit::utils::join_file_path(web_client_root_directory(),
-                                                                  "ascent");
+    m_server.set_port(8081);
 
-        // support default doc root
-        if(m_doc_root == "")
-        {
-           m_doc_root = default_root;
-        }
-        // if we aren't using the standard doc root loc, copy
-        // the necessary web client files to the requested doc root
+    std::string  default_root =conduit::utils::join_file_path(web_client_root_directory(),
+                                                              "ascent");
+
+    // support default doc root
+    if(m_doc_root == "")
+    {
+       m_doc_root = default_root;
+    }
+    // if we aren't using the standard doc root loc, copy
+    // the necessary web client files to the requested doc root
 
-        if(m_doc_root != default_root)
+    if(m_doc_root != default_root)
+    {
+        // check if m_doc_root already has resources
+        if(conduit::utils::is_file(conduit::utils::join_file_path(m_doc_root,
+                                                                  "index.html")))
         {
-            // check if m_doc_root already has resources
-            if(conduit::utils::is_file(conduit::utils::join_file_path(m_doc_root,
-                                                                      "index.html")))
+            // load ascent web resources from compiled in resource tree
+            Node ascent_rc;
+            ascent::resources::load_compiled_resource_tree("ascent_web",
+                                                            ascent_rc);
+            if(ascent_rc.dtype().is_empty())
             {
-                // load ascent web resources from compiled in resource tree
-                Node ascent_rc;
-                ascent::resources::load_compiled_resource_tree("ascent_web",
-                                                                ascent_rc);
-                if(ascent_rc.dtype().is_empty())
-                {
-                    ASCENT_ERROR("Failed to load compiled resources for ascent_web");
-                }
-
-                ascent::resources::expand_resource_tree_to_file_system(ascent_rc,
-                                                                       m_doc_root);
+                ASCENT_ERROR("Failed to load compiled resources for ascent_web");
             }
+
+            ascent::resources::expand_resource_tree_to_file_system(ascent_rc,
+                                                                   m_doc_root);
         }
+    }
+
+    m_server.set_document_root(m_doc_root);
+    m_server.serve();
+}
 
-        m_server.set_document_root(m_doc_root);
-        m_server.serve();
+//-----------------------------------------------------------------------------
+WebSocket *
+WebInterface::Connection()
+{
+    if(!m_enabled || !m_server.is_running())
+    {
+        return NULL;
     }
 
     //  Don't do any more work unless we have a valid client connection
@@ -165,31 +202,149 @@ WebInterface::Connection()
 void
 WebInterface::PushMessage(const Node &msg)
 {
-    //  Don't do any more work unless we have a valid client connection
-    // (also handles case where stream is not enabled)
-    WebSocket *wsock = Connection();
-
-    if(wsock == NULL)
+    if(!m_enabled)
     {
         return;
     }
 
-    // sent the message
-    wsock->send(msg);
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        if(!m_connected)
+        {
+            // without a client only the latest message is kept, it is
+            // sent once a client connects
+            m_pending_msgs.reset();
+        }
+        // deep copy, callers often pass external views of their info
+        m_pending_msgs.append().set(msg);
+    }
+    m_cond.notify_one();
 }
 
 //-----------------------------------------------------------------------------
 void
 WebInterface::PushRenders(const Node &renders)
 {
-    //  Don't do any more work unless we have a valid client connection
-    // (also handles case where stream is not enabled)
-    WebSocket *wsock = Connection();
-
-    if(wsock == NULL)
+    if(!m_enabled || renders.number_of_children() == 0)
     {
         return;
     }
+
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        // the last set of renders was not sent yet, replace it with the
+        // new one. Without a client that is expected, not a drop
+        if(m_has_renders && m_connected)
+        {
+            m_dropped_renders++;
+        }
+        m_pending_renders.set(renders);
+        m_has_renders = true;
+    }
+    m_cond.notify_one();
+}
+
+//-----------------------------------------------------------------------------
+void
+WebInterface::SendLoop()
+{
+    while(true)
+    {
+        Node msgs;
+        Node renders;
+        bool has_renders = false;
+        index_t dropped = 0;
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            m_cond.wait(lock, [this]
+            {
+                return m_stop ||
+                       m_has_renders ||
+                       m_pending_msgs.number_of_children() > 0;
+            });
+
+            if(m_stop &&
+               !m_has_renders &&
+               m_pending_msgs.number_of_children() == 0)
+            {
+                // nothing is left to send
+                break;
+            }
+
+            msgs.swap(m_pending_msgs);
+            renders.swap(m_pending_renders);
+            has_renders = m_has_renders;
+            dropped = m_dropped_renders;
+            m_has_renders = false;
+            m_dropped_renders = 0;
+        }
+
+        // exceptions must not escape the thread (that would terminate
+        // the process), report them and keep serving
+        try
+        {
+            //  Don't do any more work unless we have a valid client connection
+            WebSocket *wsock = Connection();
+
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                m_connected = wsock != NULL;
+                if(wsock == NULL && !m_stop)
+                {
+                    // keep the latest message and renders for when a
+                    // client connects, unless newer ones were pushed
+                    if(m_pending_msgs.number_of_children() == 0 &&
+                       msgs.number_of_children() > 0)
+                    {
+                        m_pending_msgs.append().set(
+                            msgs.child(msgs.number_of_children() - 1));
+                    }
+                    if(!m_has_renders && has_renders)
+                    {
+                        m_pending_renders.swap(renders);
+                        m_has_renders = true;
+                    }
+                }
+            }
+
+            if(wsock == NULL)
+            {
+                continue;
+            }
+
+            if(dropped > 0)
+            {
+                ASCENT_INFO("web interface dropped " << dropped
+                            << " stale set(s) of renders");
+            }
+
+            if(has_renders)
+            {
+                SendRenders(wsock, renders);
+            }
+
+            NodeConstIterator itr = msgs.children();
+            while(itr.has_next())
+            {
+                wsock->send(itr.next());
+            }
+        }
+        catch(conduit::Error &e)
+        {
+            ASCENT_WARN("web interface failed to send: " << e.message());
+        }
+        catch(std::exception &e)
+        {
+            ASCENT_WARN("web interface failed to send: " << e.what());
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+WebInterface::SendRenders(WebSocket *wsock,
+                          const Node &renders)
+{
     Node msg;
 
     NodeConstIterator itr = renders.children();
@@ -197,12 +352,25 @@ WebInterface::PushRenders(const Node &renders)
     while(itr.has_next())
     {
         const Node &curr = itr.next();
-        EncodeImage(curr.as_string(),
-                    msg["renders"].append());
-
+        if(curr.dtype().is_string())
+        {
+            EncodeImage(curr.as_string(),
+                        msg["renders"].append());
+        }
+        else if(curr.has_child("png"))
+        {
+            const Node &png = curr["png"];
+            EncodeImage((const char*)png.data_ptr(),
+                        png.dtype().number_of_elements(),
+                        msg["renders"].append());
+        }
+        else
+        {
+            EncodeImage(curr["image_name"].as_string(),
+                        msg["renders"].append());
+        }
     }
 
-
     // sent the message
     wsock->send(msg);
 }
@@ -222,10 +390,10 @@ WebInterface::EncodeImage(const std::string &png_image_path,
     std::streamsize png_raw_bytes = file.tellg();
     file.seekg(0, std::ios::beg);
 
-    // use a node to hold the buffers for raw and base64 encoded png data
+    // use a node to hold the buffer for the raw png data
     Node png_data;
-    png_data["raw"].set(DataType::c_char(png_raw_bytes));
-    char *png_raw_ptr = png_data["raw"].value();
+    png_data.set(DataType::c_char(png_raw_bytes));
+    char *png_raw_ptr = png_data.value();
 
     // read in the raw png data
     if(!file.read(png_raw_ptr, png_raw_bytes))
@@ -234,14 +402,26 @@ WebInterface::EncodeImage(const std::string &png_image_path,
         ASCENT_WARN("ERROR Reading png file " << png_image_path);
     }
 
+    EncodeImage(png_raw_ptr, (index_t)png_raw_bytes, out);
+}
+
+//-----------------------------------------------------------------------------
+void
+WebInterface::EncodeImage(const char *png_data,
+                          index_t png_bytes,
+                          conduit::Node &out)
+{
+    out.reset();
+
     // base64 encode the raw png data
-    png_data["encoded"].set(DataType::char8_str(png_raw_bytes*2));
+    Node png_encoded;
+    png_encoded.set(DataType::char8_str(png_bytes*2));
 
-    utils::base64_encode(png_raw_ptr,
-                         png_raw_bytes,
-                         png_data["encoded"].data_ptr());
+    utils::base64_encode(png_data,
+                         png_bytes,
+                         png_encoded.data_ptr());
 
-    out["data"] = "data:image/png;base64," + png_data["encoded"].as_string();
+    out["data"] = "data:image/png;base64," + png_encoded.as_string();
 }
 
 //-----------------------------------------------------------------------------
@@ -280,6 +460,13 @@ void
 WebInterface::Enable()
 {}
 
+//-----------------------------------------------------------------------------
+bool
+WebInterface::IsEnabled() const
+{
+    return false;
+}
+
 //-----------------------------------------------------------------------------
 void
 WebInterface::PushMessage(const Node &msg)
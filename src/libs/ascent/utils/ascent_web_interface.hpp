@@ -14,9 +14,16 @@
 
 #include <string>
 
+#include <ascent_config.h>
+
+#ifdef ASCENT_WEBSERVER_ENABLED
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
 #include <conduit.hpp>
 #include <conduit_relay.hpp>
-#include <ascent_config.h>
 
 //-----------------------------------------------------------------------------
 // -- begin ascent:: --
@@ -50,21 +57,54 @@ public:
     void                            SetTimeout(int ms_timeout);
 
     void                            Enable();
-
+    bool                            IsEnabled() const;
+
+    // Push methods queue their data and return right away, a
+    // background thread sends it to the client.
+    //
+    // Messages are sent in order. Only the most recent set of
+    // renders is kept, if the client falls behind older renders
+    // are dropped. Until a client connects only the latest message
+    // and set of renders are kept, they are sent on connect.
+    //
+    // Each child of renders is either the path of a png file,
+    // or a node with "image_name" and an in memory "png"
+    // (uint8 array holding the encoded png).
     void                            PushMessage(const conduit::Node &msg);
     void                            PushRenders(const conduit::Node &renders);
 
 private:
 #ifdef ASCENT_WEBSERVER_ENABLED
+    void                            StartServer();
     conduit::relay::web::WebSocket *Connection();
 
+    void                            SendLoop();
+    void                            SendRenders(conduit::relay::web::WebSocket *wsock,
+                                                const conduit::Node &renders);
+
     void                            EncodeImage(const std::string &png_file_path,
                                                 conduit::Node &out);
+    void                            EncodeImage(const char *png_data,
+                                                conduit::index_t png_bytes,
+                                                conduit::Node &out);
     bool                            m_enabled;
     conduit::relay::web::WebServer  m_server;
     int                             m_ms_poll;
     int                             m_ms_timeout;
     std::string                     m_doc_root;
+
+    // state shared with the send thread, guarded by m_lock
+    std::thread                     m_thread;
+    std::mutex                      m_lock;
+    std::condition_variable         m_cond;
+    bool                            m_stop;
+    // true once a client is connected, until then only the latest
+    // message is queued
+    bool                            m_connected;
+    conduit::Node                   m_pending_msgs;
+    conduit::Node                   m_pending_renders;
+    bool                            m_has_renders;
+    conduit::index_t                m_dropped_renders;
 #endif
 };
 
@@ -12,6 +12,8 @@
 #include <conduit.hpp>
 #include <conduit_cpp_to_c.hpp>
 
+#include <ascent_runtime_utils.hpp>
+
 #include "catalyst_impl_ascent.h"
 
 #ifdef _USE_MPI
@@ -29,6 +31,8 @@ private:
     //pointer to the ascent instance
     void* ascent = nullptr;
     std::vector<conduit::Node> actions;
+    // skips verifying domains that did not change since the last execute
+    ascent::runtime::filters::BlueprintVerifyCache verify_cache;
     //instance pointer;
     static Instance* instance;
 
@@ -65,6 +69,11 @@ public:
     {
       this->actions.clear();
     }
+
+    ascent::runtime::filters::BlueprintVerifyCache& GetVerifyCache()
+    {
+      return this->verify_cache;
+    }
 };
 
 }
@@ -120,17 +129,18 @@ enum catalyst_status catalyst_execute_ascent(const conduit_node* params)
 {
   std::cout << "[pre] Executing Execute" << std::endl;
   const conduit_cpp::Node cpp_params = conduit_cpp::cpp_node(const_cast<conduit_node*>(params));
-  conduit_cpp::Node verify_info;
   conduit_cpp::Node data = cpp_params["catalyst/channels/grid/data"];
-  if(!conduit_cpp::BlueprintMesh::verify(data,verify_info))
+  auto instance = detail::Instance::GetInstance();
+  auto ascent = instance->GetAscent();
+  conduit_node* data_c = conduit_cpp::c_node(&data);
+  conduit::Node verify_info;
+  if(!instance->GetVerifyCache().verify_mesh(*conduit::cpp_node(data_c),
+                                             verify_info))
   {
     // show details of what went awry
     verify_info.print();
   }
   // First publish the data using ascent_publish
-  auto instance = detail::Instance::GetInstance();
-  auto ascent = instance->GetAscent();
-  conduit_node* data_c = conduit_cpp::c_node(&data);
   ascent_publish(ascent, const_cast<conduit_node*>(data_c));
   // Then use catalyst_script to convert a ascent_actions.yaml to a conduit node
   // Finally, call ascent_execute with the actions and the data
@@ -154,6 +164,7 @@ enum catalyst_status catalyst_finalize_ascent(const conduit_node* params)
     ascent_close(ascent);
     ascent_destroy(ascent);
     instance->SetAscent(nullptr);
+    instance->GetVerifyCache().reset();
   }
   std::cout << "[post] Executing Finalize" << std::endl;
   return catalyst_status_ok;
@@ -85,7 +85,7 @@ template <int32 dim = 3> class AABB
   }
 
   DRAY_EXEC
-  bool contains (const Vec<Float,dim> &point)
+  bool contains (const Vec<Float,dim> &point) const
   {
     bool ret = true;
     for (int32 d = 0; d < dim; d++)
@@ -21,6 +21,20 @@ template <typename T> void Array<T>::set (const T *data, const int32 size)
   m_internals->set (data, size);
 };
 
+template <typename T>
+void Array<T>::borrow (T *data,
+                       const size_t size,
+                       const bool on_device,
+                       std::shared_ptr<void> owner)
+{
+  m_internals->borrow (data, size, on_device, owner);
+};
+
+template <typename T> bool Array<T>::is_borrowed () const
+{
+  return m_internals->is_borrowed ();
+};
+
 template <typename T> Array<T>::~Array ()
 {
 }
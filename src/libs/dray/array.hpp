@@ -26,6 +26,15 @@ template <typename T> class Array
   size_t size () const;
   void resize (const size_t size);
   void set (const T *data, const int32 size);
+  // zero copy a pointer owned by someone else (for example an Ascent
+  // conduit node). The optional owner is kept alive as long as this
+  // array references the data.
+  void borrow (T *data,
+               const size_t size,
+               const bool on_device,
+               std::shared_ptr<void> owner = nullptr);
+  // true if the data was borrowed and is not owned by this array
+  bool is_borrowed () const;
   T *get_host_ptr ();
   T *get_device_ptr ();
   const T *get_host_ptr_const () const;
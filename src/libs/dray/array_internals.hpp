@@ -16,6 +16,7 @@
 #include <umpire/Umpire.hpp>
 
 #include <iostream>
+#include <memory>
 #include <string.h>
 
 namespace dray
@@ -31,11 +32,17 @@ template <typename T> class ArrayInternals : public ArrayInternalsBase
   size_t m_size;
   bool m_cuda_enabled;
   bool m_hip_enabled;
+  // false when the pointer was borrowed from outside
+  bool m_own_host;
+  bool m_own_device;
+  // keeps borrowed memory alive
+  std::shared_ptr<void> m_owner;
 
   public:
   ArrayInternals ()
   : ArrayInternalsBase (), m_device (nullptr), m_host (nullptr),
-    m_device_dirty (true), m_host_dirty (true), m_size (0)
+    m_device_dirty (true), m_host_dirty (true), m_size (0),
+    m_own_host (true), m_own_device (true)
   {
 #ifdef DRAY_CUDA_ENABLED
     m_cuda_enabled = true;
@@ -51,7 +58,8 @@ template <typename T> class ArrayInternals : public ArrayInternalsBase
 
   ArrayInternals (const T *data, const int32 size)
   : ArrayInternalsBase (), m_device (nullptr), m_host (nullptr),
-    m_device_dirty (true), m_host_dirty (false), m_size (size)
+    m_device_dirty (true), m_host_dirty (false), m_size (size),
+    m_own_host (true), m_own_device (true)
   {
 #ifdef DRAY_CUDA_ENABLED
     m_cuda_enabled = true;
@@ -155,6 +163,37 @@ template <typename T> class ArrayInternals : public ArrayInternalsBase
     m_host_dirty = true;
   }
 
+  void borrow (T *data,
+               const size_t size,
+               const bool on_device,
+               std::shared_ptr<void> owner)
+  {
+    deallocate_host ();
+    deallocate_device ();
+
+    m_size = size;
+    m_owner = owner;
+    if (on_device && (m_cuda_enabled || m_hip_enabled))
+    {
+      m_device = data;
+      m_own_device = false;
+      m_device_dirty = false;
+      m_host_dirty = true;
+    }
+    else
+    {
+      m_host = data;
+      m_own_host = false;
+      m_host_dirty = false;
+      m_device_dirty = true;
+    }
+  }
+
+  bool is_borrowed () const
+  {
+    return !m_own_host || !m_own_device;
+  }
+
   size_t size () const
   {
     return m_size;
@@ -181,6 +220,17 @@ template <typename T> class ArrayInternals : public ArrayInternalsBase
       return get_host_ptr ();
     }
 
+    // the caller may write, borrowed memory is never written to.
+    // Stale borrowed memory is dropped, current memory is copied
+    if (m_device_dirty && m_host != nullptr)
+    {
+      detach_borrowed_device ();
+    }
+    else
+    {
+      own_device ();
+    }
+
     if (m_device == nullptr)
     {
       allocate_device ();
@@ -191,6 +241,9 @@ template <typename T> class ArrayInternals : public ArrayInternalsBase
       synch_to_device ();
     }
 
+    // the host copy is stale from here on
+    detach_borrowed_host ();
+
     // indicate that the device has the most recent data
     m_host_dirty = true;
     m_device_dirty = false;
@@ -201,7 +254,7 @@ template <typename T> class ArrayInternals : public ArrayInternalsBase
   {
     if (!m_cuda_enabled && !m_hip_enabled)
     {
-      return get_host_ptr ();
+      return get_host_ptr_const ();
     }
 
     if (m_device == nullptr)
@@ -220,6 +273,17 @@ template <typename T> class ArrayInternals : public ArrayInternalsBase
 
   T *get_host_ptr ()
   {
+    // the caller may write, borrowed memory is never written to.
+    // Stale borrowed memory is dropped, current memory is copied
+    if (m_host_dirty && m_device != nullptr)
+    {
+      detach_borrowed_host ();
+    }
+    else
+    {
+      own_host ();
+    }
+
     if (m_host == nullptr)
     {
       allocate_host ();
@@ -240,6 +304,9 @@ template <typename T> class ArrayInternals : public ArrayInternalsBase
       }
     }
 
+    // the device copy is stale from here on
+    detach_borrowed_device ();
+
     // indicate that the host has the most recent data
     m_device_dirty = true;
     m_host_dirty = false;
@@ -339,9 +406,10 @@ template <typename T> class ArrayInternals : public ArrayInternalsBase
     m_device_dirty = true;
   }
 
+  // borrowed memory is accounted for by its owner
   virtual size_t device_alloc_size () override
   {
-    if (m_device == nullptr)
+    if (m_device == nullptr || !m_own_device)
       return 0;
     else
       return static_cast<size_t> (sizeof (T)) * m_size;
@@ -349,7 +417,7 @@ template <typename T> class ArrayInternals : public ArrayInternalsBase
 
   virtual size_t host_alloc_size () override
   {
-    if (m_host == nullptr)
+    if (m_host == nullptr || !m_own_host)
       return 0;
     else
       return static_cast<size_t> (sizeof (T)) * m_size;
@@ -360,13 +428,18 @@ template <typename T> class ArrayInternals : public ArrayInternalsBase
   {
     if (m_host != nullptr)
     {
-      auto &rm = umpire::ResourceManager::getInstance ();
-      const int allocator_id = ArrayRegistry::host_allocator_id();
-      umpire::Allocator host_allocator = rm.getAllocator (allocator_id);
-      host_allocator.deallocate (m_host);
+      if (m_own_host)
+      {
+        auto &rm = umpire::ResourceManager::getInstance ();
+        const int allocator_id = ArrayRegistry::host_allocator_id();
+        umpire::Allocator host_allocator = rm.getAllocator (allocator_id);
+        host_allocator.deallocate (m_host);
+      }
       m_host = nullptr;
+      m_own_host = true;
       m_host_dirty = true;
     }
+    release_owner ();
   }
 
   void allocate_host ()
@@ -387,14 +460,70 @@ template <typename T> class ArrayInternals : public ArrayInternalsBase
     {
       if (m_device != nullptr)
       {
-        auto &rm = umpire::ResourceManager::getInstance ();
-        const int allocator_id = ArrayRegistry::device_allocator_id();
-        umpire::Allocator device_allocator = rm.getAllocator (allocator_id);
-        device_allocator.deallocate (m_device);
+        if (m_own_device)
+        {
+          auto &rm = umpire::ResourceManager::getInstance ();
+          const int allocator_id = ArrayRegistry::device_allocator_id();
+          umpire::Allocator device_allocator = rm.getAllocator (allocator_id);
+          device_allocator.deallocate (m_device);
+        }
         m_device = nullptr;
+        m_own_device = true;
         m_device_dirty = true;
       }
     }
+    release_owner ();
+  }
+
+  // copy on write: replace borrowed host memory with a private copy
+  void own_host ()
+  {
+    if (m_host == nullptr || m_own_host) return;
+    T *borrowed = m_host;
+    m_host = nullptr;
+    allocate_host ();
+    memcpy (m_host, borrowed, sizeof (T) * m_size);
+    m_own_host = true;
+    release_owner ();
+  }
+
+  void own_device ()
+  {
+    if (m_device == nullptr || m_own_device) return;
+    T *borrowed = m_device;
+    m_device = nullptr;
+    allocate_device ();
+    auto &rm = umpire::ResourceManager::getInstance ();
+    rm.copy (m_device, borrowed);
+    m_own_device = true;
+    release_owner ();
+  }
+
+  // the other side has the latest data, a borrowed copy here would be
+  // synched into, so forget it instead
+  void detach_borrowed_host ()
+  {
+    if (m_host == nullptr || m_own_host) return;
+    m_host = nullptr;
+    m_own_host = true;
+    release_owner ();
+  }
+
+  void detach_borrowed_device ()
+  {
+    if (m_device == nullptr || m_own_device) return;
+    m_device = nullptr;
+    m_own_device = true;
+    release_owner ();
+  }
+
+  // drop the reference to the owner once nothing is borrowed anymore
+  void release_owner ()
+  {
+    if (m_own_host && m_own_device)
+    {
+      m_owner.reset ();
+    }
   }
 
   void allocate_device ()
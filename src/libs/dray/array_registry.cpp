@@ -32,6 +32,12 @@ int ArrayRegistry::device_allocator_id()
   if(m_device_allocator_id == -1)
   {
     auto &rm = umpire::ResourceManager::getInstance ();
+    // Ascent creates a pool with the same name, share it
+    if(rm.isAllocator("GPU_POOL"))
+    {
+      m_device_allocator_id = rm.getAllocator("GPU_POOL").getId();
+      return m_device_allocator_id;
+    }
     auto allocator = rm.getAllocator("DEVICE");
     // we can use the umpire profiling to find a good default size
     auto pooled_allocator = rm.makeAllocator<umpire::strategy::QuickPool>(
@@ -158,6 +164,12 @@ int ArrayRegistry::host_allocator_id()
   if(m_host_allocator_id == -1)
   {
     auto &rm = umpire::ResourceManager::getInstance ();
+    // Ascent creates a pool with the same name, share it
+    if(rm.isAllocator("HOST_POOL"))
+    {
+      m_host_allocator_id = rm.getAllocator("HOST_POOL").getId();
+      return m_host_allocator_id;
+    }
     auto allocator = rm.getAllocator("HOST");
     // we can use the umpire profiling to find a good default size
     auto pooled_allocator = rm.makeAllocator<umpire::strategy::QuickPool>(
@@ -12,6 +12,31 @@
 namespace dray
 {
 
+//
+// WideBVH: a WideBVH::width-ary tree collapsed from the binary LBVH.
+// Used for traversal on the host (serial / OpenMP), where testing all
+// children of a node at once maps onto SIMD lanes.
+//
+// Layout (structure of arrays per node):
+//  m_nodes holds node_stride floats per node:
+//    [xmin x width][ymin x width][zmin x width]
+//    [xmax x width][ymax x width][zmax x width]
+//  m_children holds width ints per node:
+//    positive indices: inner node index (not an offset)
+//    negative values: leaf. real index = -index - 1 and indexes the
+//      m_leaf_nodes / m_aabb_ids arrays of the owning BVH
+//    empty_child: unused slot
+//
+struct WideBVH
+{
+  static constexpr int32 width = 4;
+  static constexpr int32 node_stride = 6 * width;
+  static constexpr int32 empty_child = -2147483647;
+
+  Array<float32> m_nodes;
+  Array<int32> m_children;
+};
+
 struct BVH
 {
   Array<Vec<float32, 4>> m_inner_nodes;
@@ -36,6 +61,10 @@ struct BVH
   //  negative values: child node. To ge the index of the child
   //    real index = -index - 1
   // [14-15] un-used
+
+  // wide layout of the same tree. Only constructed when
+  // we are not running on a device (see LinearBVHBuilder).
+  WideBVH m_wide;
 };
 
 } // namespace dray
@@ -60,6 +60,22 @@ template <class ElemT> struct DeviceMesh
 
   DRAY_EXEC_ONLY ElemT get_elem (int32 el_idx) const;
   DRAY_EXEC_ONLY Location locate (const Vec<Float, 3> &point) const;
+
+  DRAY_EXEC_ONLY bool locate_in_leaf (const int32 leaf,
+                                      const Vec<Float, 3> &point,
+                                      Location &loc) const;
+  // Starting from the element and reference coordinates in loc, walks
+  // across the faces the Newton iterate leaves through until the point is
+  // found. face_neighbors is the face_neighbors() array or null to only
+  // try the starting element. Returns false if the walk hits the boundary,
+  // turns back or takes more than max_steps elements.
+  DRAY_EXEC_ONLY bool walk (const Vec<Float, 3> &point,
+                            const int32 *face_neighbors,
+                            const int32 max_steps,
+                            Location &loc) const;
+#ifndef DRAY_DEVICE_ENABLED
+  DRAY_EXEC_ONLY Location locate_wide (const Vec<Float, 3> &point) const;
+#endif
 };
 
 
@@ -244,12 +260,239 @@ template <> struct LocateHack<2>
     return eval_inverse(elem, stats, world_coords, guess_domain, ref_coords, use_init_guess);
   }
 };
+
+// Face the reference coordinates are furthest outside of, using the face
+// ids of extract_faces(), or -1 if they are not outside.
+template <ElemType etype> struct WalkFace;
+
+template <> struct WalkFace<ElemType::Tensor>
+{
+  static constexpr int32 faces_per_elem = 6;
+
+  template <int32 dim>
+  DRAY_EXEC static int32 exit_face (const Vec<Float, dim> &ref_coords)
+  {
+    int32 face = -1;
+    Float outside = 0.f;
+    for (int32 d = 0; d < dim; ++d)
+    {
+      if (-ref_coords[d] > outside)
+      {
+        outside = -ref_coords[d];
+        face = d;
+      }
+      if (ref_coords[d] - 1.f > outside)
+      {
+        outside = ref_coords[d] - 1.f;
+        face = d + dim;
+      }
+    }
+    return face;
+  }
+
+  template <int32 dim>
+  DRAY_EXEC static Vec<Float, dim> center ()
+  {
+    Vec<Float, dim> res;
+    for (int32 d = 0; d < dim; ++d)
+    {
+      res[d] = 0.5f;
+    }
+    return res;
+  }
+};
+
+template <> struct WalkFace<ElemType::Simplex>
+{
+  static constexpr int32 faces_per_elem = 4;
+
+  template <int32 dim>
+  DRAY_EXEC static int32 exit_face (const Vec<Float, dim> &ref_coords)
+  {
+    int32 face = -1;
+    Float outside = 0.f;
+    Float origin = 1.f;
+    for (int32 d = 0; d < dim; ++d)
+    {
+      if (-ref_coords[d] > outside)
+      {
+        outside = -ref_coords[d];
+        face = d;
+      }
+      origin -= ref_coords[d];
+    }
+    // the face opposite of the origin
+    if (-origin > outside)
+    {
+      face = dim;
+    }
+    return face;
+  }
+
+  template <int32 dim>
+  DRAY_EXEC static Vec<Float, dim> center ()
+  {
+    Vec<Float, dim> res;
+    for (int32 d = 0; d < dim; ++d)
+    {
+      res[d] = 1.f / Float (dim + 1);
+    }
+    return res;
+  }
+};
+
 } // namespace detail
 
+template <class ElemT>
+DRAY_EXEC_ONLY bool DeviceMesh<ElemT>::locate_in_leaf (const int32 leaf,
+                                                       const Vec<Float, 3> &point,
+                                                       Location &loc) const
+{
+  const int32 el_idx = m_bvh.m_leaf_nodes[leaf];
+  const int32 ref_box_id = m_bvh.m_aabb_ids[leaf];
+  SubRef<dim, etype> ref_start_box = m_ref_boxs[ref_box_id];
+  bool use_init_guess = true;
+  // locate the point
+
+  Vec<Float, dim> el_coords;
+
+  bool found;
+  found = detail::LocateHack<ElemT::get_dim ()>::template eval_inverse<ElemT> (
+  get_elem (el_idx), point, ref_start_box, el_coords, use_init_guess);
+
+  if (found)
+  {
+    loc.m_cell_id = el_idx;
+    loc.m_ref_pt[0] = el_coords[0];
+    loc.m_ref_pt[1] = el_coords[1];
+    if (dim == 3)
+    {
+      loc.m_ref_pt[2] = el_coords[2];
+    }
+  }
+  return found;
+}
+
+template <class ElemT>
+DRAY_EXEC_ONLY bool DeviceMesh<ElemT>::walk (const Vec<Float, 3> &point,
+                                             const int32 *face_neighbors,
+                                             const int32 max_steps,
+                                             Location &loc) const
+{
+  using Walk = detail::WalkFace<etype>;
+
+  int32 el_idx = loc.m_cell_id;
+  if (el_idx < 0)
+  {
+    return false;
+  }
+
+  // the previous solution is the initial guess of the first element
+  Vec<Float, dim> el_coords;
+  for (int32 d = 0; d < dim; ++d)
+  {
+    el_coords[d] = loc.m_ref_pt[d];
+  }
+
+  // only used without an initial guess
+  SubRef<dim, etype> ref_box;
+  const bool use_init_guess = true;
+  int32 prev_idx = -1;
+
+  for (int32 step = 0; step < max_steps; ++step)
+  {
+    const bool found = detail::LocateHack<ElemT::get_dim ()>::template eval_inverse<ElemT> (
+    get_elem (el_idx), point, ref_box, el_coords, use_init_guess);
+
+    if (found)
+    {
+      loc.m_cell_id = el_idx;
+      loc.m_ref_pt[0] = el_coords[0];
+      loc.m_ref_pt[1] = el_coords[1];
+      if (dim == 3)
+      {
+        loc.m_ref_pt[2] = el_coords[2];
+      }
+      return true;
+    }
+
+    if (face_neighbors == nullptr)
+    {
+      break;
+    }
+
+    const int32 face = Walk::template exit_face<dim> (el_coords);
+    if (face < 0)
+    {
+      break;
+    }
+
+    const int32 next_idx = face_neighbors[el_idx * Walk::faces_per_elem + face];
+    // boundary, or the point sits between two elements that both point
+    // at each other
+    if (next_idx < 0 || next_idx == prev_idx)
+    {
+      break;
+    }
+
+    prev_idx = el_idx;
+    el_idx = next_idx;
+    el_coords = Walk::template center<dim> ();
+  }
+
+  return false;
+}
+
+#ifndef DRAY_DEVICE_ENABLED
+template <class ElemT>
+DRAY_EXEC_ONLY Location DeviceMesh<ElemT>::locate_wide (const Vec<Float, 3> &point) const
+{
+  constexpr int32 width = DeviceWideBVH::width;
+  Location loc{ -1, { -1.f, -1.f, -1.f } };
+
+  // each pop can push up to width - 1 more entries than it removes,
+  // so we need more room than the binary traversal
+  int32 todo[64 * (width - 1)];
+  int32 stackptr = 0;
+  todo[stackptr] = 0;
+
+  int32 hit[width];
+  while (stackptr >= 0)
+  {
+    const int32 current_node = todo[stackptr];
+    stackptr--;
+
+    m_bvh.m_wide.contains (current_node, point, hit);
+
+    for (int32 i = 0; i < width; ++i)
+    {
+      if (!hit[i]) continue;
+      const int32 child = m_bvh.m_wide.child (current_node, i);
+      if (child >= 0)
+      {
+        stackptr++;
+        todo[stackptr] = child;
+      }
+      else if (locate_in_leaf (-child - 1, point, loc))
+      {
+        return loc;
+      }
+    }
+  }
+
+  return loc;
+}
+#endif
+
 template <class ElemT>
 DRAY_EXEC_ONLY Location DeviceMesh<ElemT>::locate (const Vec<Float, 3> &point) const
 {
-  constexpr auto etype = ElemT::get_etype ();  //TODO use type trait instead
+#ifndef DRAY_DEVICE_ENABLED
+  if (m_bvh.m_wide.is_valid ())
+  {
+    return locate_wide (point);
+  }
+#endif
 
   Location loc{ -1, { -1.f, -1.f, -1.f } };
 
@@ -323,27 +566,8 @@ DRAY_EXEC_ONLY Location DeviceMesh<ElemT>::locate (const Vec<Float, 3> &point) c
       // leaf node
       // leafs are stored as negative numbers
       current_node = -current_node - 1; // swap the neg address
-      const int32 el_idx = m_bvh.m_leaf_nodes[current_node];
-      const int32 ref_box_id = m_bvh.m_aabb_ids[current_node];
-      SubRef<dim, etype> ref_start_box = m_ref_boxs[ref_box_id];
-      bool use_init_guess = true;
-      // locate the point
-
-      Vec<Float, dim> el_coords;
-
-      bool found;
-      found = detail::LocateHack<ElemT::get_dim ()>::template eval_inverse<ElemT> (
-      get_elem (el_idx), point, ref_start_box, el_coords, use_init_guess);
-
-      if (found)
+      if (locate_in_leaf (current_node, point, loc))
       {
-        loc.m_cell_id = el_idx;
-        loc.m_ref_pt[0] = el_coords[0];
-        loc.m_ref_pt[1] = el_coords[1];
-        if (dim == 3)
-        {
-          loc.m_ref_pt[2] = el_coords[2];
-        }
         break;
       }
 
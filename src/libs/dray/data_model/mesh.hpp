@@ -32,6 +32,14 @@ public:
   virtual int32 dims() const = 0;
   virtual AABB<3> bounds() = 0;
   virtual Array<Location> locate (Array<Vec<Float, 3>> &wpoints) = 0;
+  // same result as locate, faster for many points that are close together
+  // such as line samples or grids
+  virtual Array<Location> locate_batch (Array<Vec<Float, 3>> &wpoints) = 0;
+  // locate_batch with the points already sorted, order is a permutation
+  // that keeps nearby points together (e.g. detail::morton_order). Lets
+  // callers locating the same points in many meshes sort them once
+  virtual Array<Location> locate_batch (Array<Vec<Float, 3>> &wpoints,
+                                        const Array<int32> &order) = 0;
   virtual void to_node(conduit::Node &n_topo) = 0;
 };
 
@@ -14,12 +14,15 @@
 #include <dray/aabb.hpp>
 #include <dray/array_utils.hpp>
 #include <dray/dispatcher.hpp>
+#include <dray/morton_codes.hpp>
 #include <dray/data_model/elem_ops.hpp>
 
 #include <RAJA/RAJA.hpp>
 #include <dray/policies.hpp>
 #include <dray/error_check.hpp>
 
+#include <algorithm>
+
 
 namespace dray
 {
@@ -680,6 +683,101 @@ BVH construct_bvh (UnstructuredMesh<ElemT> &mesh, Array<typename get_subref<Elem
   return bvh;
 }
 
+// surface elements have no faces to walk across
+template <int32 dim> struct FaceNeighbors
+{
+  template <class ElemT>
+  static Array<int32> build (UnstructuredMesh<ElemT> &mesh)
+  {
+    return Array<int32> ();
+  }
+};
+
+template <> struct FaceNeighbors<3>
+{
+  template <class ElemT>
+  static Array<int32> build (UnstructuredMesh<ElemT> &mesh)
+  {
+    const int32 faces_per_elem = ElemT::get_etype () == ElemType::Tensor ? 6 : 4;
+
+    Array<Vec<int32, 4>> faces = extract_faces (mesh);
+    Array<int32> orig_ids = sort_faces (faces);
+
+    const int32 size = faces.size ();
+    Array<int32> neighbors;
+    neighbors.resize (size);
+    array_memset (neighbors, -1);
+    if (size < 2)
+    {
+      return neighbors;
+    }
+
+    const Vec<int32, 4> *faces_ptr = faces.get_device_ptr_const ();
+    const int32 *orig_ids_ptr = orig_ids.get_device_ptr_const ();
+    int32 *neighbors_ptr = neighbors.get_device_ptr ();
+
+    RAJA::forall<for_policy> (RAJA::RangeSegment (0, size - 1), [=] DRAY_LAMBDA (int32 i) {
+      // the faces are sorted, so a shared face sits next to its twin
+      if (is_same (faces_ptr[i], faces_ptr[i + 1]))
+      {
+        const int32 a = orig_ids_ptr[i];
+        const int32 b = orig_ids_ptr[i + 1];
+        neighbors_ptr[a] = b / faces_per_elem;
+        neighbors_ptr[b] = a / faces_per_elem;
+      }
+    });
+    DRAY_ERROR_CHECK();
+
+    return neighbors;
+  }
+};
+
+template <class ElemT>
+Array<int32> face_neighbors (UnstructuredMesh<ElemT> &mesh)
+{
+  DRAY_LOG_OPEN ("face_neighbors");
+  Array<int32> neighbors = FaceNeighbors<ElemT::get_dim ()>::build (mesh);
+  DRAY_LOG_CLOSE ();
+  return neighbors;
+}
+
+Array<int32> morton_order (Array<Vec<Float, 3>> &points, const AABB<3> &bounds)
+{
+  Vec<float32, 3> min_coord = bounds.min ();
+  Vec<float32, 3> extent = bounds.max () - bounds.min ();
+  Vec<float32, 3> inv_extent;
+  for (int32 i = 0; i < 3; ++i)
+  {
+    inv_extent[i] = (extent[i] == 0.f) ? 0.f : 1.f / extent[i];
+  }
+
+  const int32 size = points.size ();
+  Array<uint32> mcodes;
+  mcodes.resize (size);
+
+  const Vec<Float, 3> *points_ptr = points.get_device_ptr_const ();
+  uint32 *mcodes_ptr = mcodes.get_device_ptr ();
+
+  RAJA::forall<for_policy> (RAJA::RangeSegment (0, size), [=] DRAY_LAMBDA (int32 i) {
+    const Vec<Float, 3> point = points_ptr[i];
+    float32 x = (float32 (point[0]) - min_coord[0]) * inv_extent[0];
+    float32 y = (float32 (point[1]) - min_coord[1]) * inv_extent[1];
+    float32 z = (float32 (point[2]) - min_coord[2]) * inv_extent[2];
+    mcodes_ptr[i] = morton_3d (x, y, z);
+  });
+  DRAY_ERROR_CHECK();
+
+  Array<int32> order = array_counting (size, 0, 1);
+  // TODO: create custom sort for GPU / CPU
+  int32 *order_ptr = order.get_host_ptr ();
+  const uint32 *host_mcodes_ptr = mcodes.get_host_ptr_const ();
+  std::stable_sort (order_ptr, order_ptr + size, [=] (int32 i1, int32 i2) {
+    return host_mcodes_ptr[i1] < host_mcodes_ptr[i2];
+  });
+
+  return order;
+}
+
 } // namespace detail
 
 } // namespace dray
@@ -755,6 +853,23 @@ template BVH construct_bvh (UnstructuredMesh<MeshElem<3, ElemType::Simplex, Orde
 template BVH construct_bvh (UnstructuredMesh<MeshElem<3, ElemType::Simplex, Order::Quadratic>> &mesh,
                             Array<SubRef<3, ElemType::Simplex>> &ref_aabbs);
 
+//
+// face_neighbors();
+//
+template Array<int32> face_neighbors (UnstructuredMesh<MeshElem<2, ElemType::Tensor, Order::General>> &mesh);
+template Array<int32> face_neighbors (UnstructuredMesh<MeshElem<2, ElemType::Tensor, Order::Linear>> &mesh);
+template Array<int32> face_neighbors (UnstructuredMesh<MeshElem<2, ElemType::Tensor, Order::Quadratic>> &mesh);
+template Array<int32> face_neighbors (UnstructuredMesh<MeshElem<3, ElemType::Tensor, Order::General>> &mesh);
+template Array<int32> face_neighbors (UnstructuredMesh<MeshElem<3, ElemType::Tensor, Order::Linear>> &mesh);
+template Array<int32> face_neighbors (UnstructuredMesh<MeshElem<3, ElemType::Tensor, Order::Quadratic>> &mesh);
+
+template Array<int32> face_neighbors (UnstructuredMesh<MeshElem<2, ElemType::Simplex, Order::General>> &mesh);
+template Array<int32> face_neighbors (UnstructuredMesh<MeshElem<2, ElemType::Simplex, Order::Linear>> &mesh);
+template Array<int32> face_neighbors (UnstructuredMesh<MeshElem<2, ElemType::Simplex, Order::Quadratic>> &mesh);
+template Array<int32> face_neighbors (UnstructuredMesh<MeshElem<3, ElemType::Simplex, Order::General>> &mesh);
+template Array<int32> face_neighbors (UnstructuredMesh<MeshElem<3, ElemType::Simplex, Order::Linear>> &mesh);
+template Array<int32> face_neighbors (UnstructuredMesh<MeshElem<3, ElemType::Simplex, Order::Quadratic>> &mesh);
+
 struct GetDofDataFunctor
 {
   GetDofDataFunctor() = default;
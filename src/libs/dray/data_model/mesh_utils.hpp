@@ -56,6 +56,16 @@ Array<Vec<int32, 2>> reconstruct (Array<int32> &orig_ids);
 template <class ElemT>
 BVH construct_bvh (UnstructuredMesh<ElemT> &mesh, Array<typename get_subref<ElemT>::type> &ref_aabbs);
 
+// For each face of each element (el_id * faces_per_elem + face_id, with the
+// face ids of extract_faces) the id of the element across that face, or -1
+// on the boundary. Empty for surface meshes.
+template <class ElemT>
+Array<int32> face_neighbors (UnstructuredMesh<ElemT> &mesh);
+
+// Permutation that sorts the points along a morton curve over the bounds,
+// so that consecutive points are close in space.
+Array<int32> morton_order (Array<Vec<Float, 3>> &points, const AABB<3> &bounds);
+
 // Extracts the dof data from the given mesh.
 GridFunction<3>
 get_dof_data(Mesh *);
@@ -30,11 +30,22 @@ template <class Element> const BVH UnstructuredMesh<Element>::get_bvh ()
   return m_bvh;
 }
 
+template <class Element> const Array<int32> UnstructuredMesh<Element>::get_face_neighbors ()
+{
+  if(!m_has_face_neighbors)
+  {
+    m_face_neighbors = detail::face_neighbors (*this);
+    m_has_face_neighbors = true;
+  }
+  return m_face_neighbors;
+}
+
 template <class Element>
 UnstructuredMesh<Element>::UnstructuredMesh (const GridFunction<3u> &dof_data, int32 poly_order)
 : m_dof_data (dof_data),
   m_poly_order (poly_order),
-  m_is_constructed(false)
+  m_is_constructed(false),
+  m_has_face_neighbors(false)
 {
   // check to see if this is a valid construction
   if(Element::get_P() != Order::General)
@@ -68,7 +79,9 @@ UnstructuredMesh<Element>::UnstructuredMesh(const UnstructuredMesh &other)
     m_poly_order(other.m_poly_order),
     m_is_constructed(other.m_is_constructed),
     m_bvh(other.m_bvh),
-    m_ref_aabbs(other.m_ref_aabbs)
+    m_ref_aabbs(other.m_ref_aabbs),
+    m_has_face_neighbors(other.m_has_face_neighbors),
+    m_face_neighbors(other.m_face_neighbors)
 {
   // check to see if this is a valid construction
   if(Element::get_P() != Order::General)
@@ -97,7 +110,9 @@ UnstructuredMesh<Element>::UnstructuredMesh(UnstructuredMesh &&other)
     m_poly_order(other.m_poly_order),
     m_is_constructed(other.m_is_constructed),
     m_bvh(other.m_bvh),
-    m_ref_aabbs(other.m_ref_aabbs)
+    m_ref_aabbs(other.m_ref_aabbs),
+    m_has_face_neighbors(other.m_has_face_neighbors),
+    m_face_neighbors(other.m_face_neighbors)
 {
   // check to see if this is a valid construction
   if(Element::get_P() != Order::General)
@@ -147,6 +162,110 @@ Array<Location> UnstructuredMesh<Element>::locate (Array<Vec<Float, 3u>> &wpoint
   return locations;
 }
 
+template <class Element>
+Array<Location> UnstructuredMesh<Element>::locate_batch (Array<Vec<Float, 3u>> &wpoints)
+{
+  Timer timer;
+  Array<int32> order = detail::morton_order (wpoints, bounds ());
+  DRAY_LOG_ENTRY ("locate_batch_sort", timer.elapsed ());
+  return locate_batch (wpoints, order);
+}
+
+template <class Element>
+Array<Location> UnstructuredMesh<Element>::locate_batch (Array<Vec<Float, 3u>> &wpoints,
+                                                         const Array<int32> &order)
+{
+  DRAY_LOG_OPEN ("locate_batch");
+
+  const int32 size = wpoints.size ();
+  Array<Location> locations;
+  locations.resize (size);
+  if(size == 0)
+  {
+    DRAY_LOG_CLOSE();
+    return locations;
+  }
+
+  Timer timer;
+  // points outside the bounds can't be in any element, the slack covers
+  // points the Newton solve accepts just outside an element
+  AABB<3> mesh_bounds = bounds ();
+  const float32 slack = mesh_bounds.max_length () * 1e-5f;
+  if(slack > 0.f)
+  {
+    mesh_bounds.expand (slack);
+  }
+
+  Array<int32> neighbors = get_face_neighbors ();
+  DRAY_LOG_ENTRY ("face_neighbors", timer.elapsed ());
+  timer.reset ();
+
+  Location *loc_ptr = locations.get_device_ptr ();
+  const Vec<Float,3> *points_ptr = wpoints.get_device_ptr_const();
+  const int32 *order_ptr = order.get_device_ptr_const ();
+  const int32 *neighbors_ptr = nullptr;
+  if(neighbors.size () > 0)
+  {
+    neighbors_ptr = neighbors.get_device_ptr_const ();
+  }
+
+  DeviceMesh<Element> device_mesh (*this);
+
+  // each run is located serially so a point can start from the previous
+  // one. Shorter runs on the device keep more threads busy
+#ifdef DRAY_DEVICE_ENABLED
+  const int32 run_length = 8;
+#else
+  const int32 run_length = 64;
+#endif
+  const int32 max_walk = 16;
+  const int32 num_runs = (size + run_length - 1) / run_length;
+
+  RAJA::ReduceSum<reduce_policy, int32> walked (0);
+  RAJA::ReduceSum<reduce_policy, int32> outside (0);
+
+  RAJA::forall<for_policy> (RAJA::RangeSegment (0, num_runs), [=] DRAY_LAMBDA (int32 run) {
+
+    Location prev = { -1, { -1.f, -1.f, -1.f } };
+    const int32 begin = run * run_length;
+    const int32 end = min (begin + run_length, size);
+    for(int32 i = begin; i < end; ++i)
+    {
+      const int32 point_id = order_ptr[i];
+      const Vec<Float, 3> target_pt = points_ptr[point_id];
+      if(!mesh_bounds.contains (target_pt))
+      {
+        Location missed = { -1, { -1.f, -1.f, -1.f } };
+        loc_ptr[point_id] = missed;
+        outside += 1;
+        continue;
+      }
+      Location loc = prev;
+      if(device_mesh.walk (target_pt, neighbors_ptr, max_walk, loc))
+      {
+        walked += 1;
+      }
+      else
+      {
+        loc = device_mesh.locate (target_pt);
+      }
+      loc_ptr[point_id] = loc;
+      if(loc.m_cell_id != -1)
+      {
+        prev = loc;
+      }
+    }
+  });
+  DRAY_ERROR_CHECK();
+
+  DRAY_LOG_ENTRY ("locate", timer.elapsed ());
+  DRAY_LOG_ENTRY ("walked", walked.get ());
+  DRAY_LOG_ENTRY ("outside", outside.get ());
+  DRAY_LOG_CLOSE();
+
+  return locations;
+}
+
 template<typename Element>
 int32 UnstructuredMesh<Element>::cells() const
 {
@@ -52,6 +52,8 @@ protected:
   // we are lazy constructing these
   BVH m_bvh;
   Array<SubRef<dim, etype>> m_ref_aabbs;
+  bool m_has_face_neighbors;
+  Array<int32> m_face_neighbors;
 
   //// Accept input data (as shared).
   //// Useful for keeping same data but changing class template arguments.
@@ -84,6 +86,14 @@ public:
 
   virtual AABB<3> bounds() override;
   virtual Array<Location> locate (Array<Vec<Float, 3>> &wpoints) override;
+  // Sorts the points along a morton curve and locates short runs of
+  // consecutive points serially. Points outside the mesh bounds are skipped,
+  // the others start from the element of the previous one, with its
+  // reference coordinates as the Newton guess, walk across element faces
+  // and fall back to the BVH.
+  virtual Array<Location> locate_batch (Array<Vec<Float, 3>> &wpoints) override;
+  virtual Array<Location> locate_batch (Array<Vec<Float, 3>> &wpoints,
+                                        const Array<int32> &order) override;
   virtual void to_node(conduit::Node &n_topo) override;
 
 
@@ -97,6 +107,8 @@ public:
   UnstructuredMesh(const UnstructuredMesh &other);
 
   const BVH get_bvh ();
+  // lazily built, see detail::face_neighbors
+  const Array<int32> get_face_neighbors ();
 
   GridFunction<3u> get_dof_data ()
   {
@@ -7,22 +7,108 @@
 #define DRAY_DEVICE_BVH_HPP
 
 #include <dray/bvh.hpp>
+#include <dray/math.hpp>
 
 namespace dray
 {
 
+struct DeviceWideBVH
+{
+  static constexpr int32 width = WideBVH::width;
+  static constexpr int32 stride = WideBVH::node_stride;
+
+  const float32 *m_nodes;
+  const int32 *m_children;
+
+  DeviceWideBVH () = delete;
+  DeviceWideBVH (const WideBVH &wide)
+  : m_nodes (wide.m_nodes.get_device_ptr_const ()),
+    m_children (wide.m_children.get_device_ptr_const ())
+  {
+  }
+
+  DRAY_EXEC bool is_valid () const
+  {
+    return m_nodes != nullptr;
+  }
+
+  // test a point against all children of a node at once.
+  // hit[c] is non-zero if child c contains the point
+  template <typename T>
+  DRAY_EXEC void contains (const int32 node,
+                           const Vec<T, 3> &point,
+                           int32 hit[width]) const
+  {
+    const float32 *b = m_nodes + node * stride;
+    const int32 *c = m_children + node * width;
+    const float32 px = static_cast<float32> (point[0]);
+    const float32 py = static_cast<float32> (point[1]);
+    const float32 pz = static_cast<float32> (point[2]);
+    DRAY_SIMD_LOOP
+    for (int32 i = 0; i < width; ++i)
+    {
+      hit[i] = (px >= b[i]) & (py >= b[width + i]) & (pz >= b[2 * width + i]) &
+               (px <= b[3 * width + i]) & (py <= b[4 * width + i]) &
+               (pz <= b[5 * width + i]) & (c[i] != WideBVH::empty_child);
+    }
+  }
+
+  // slab test of a ray against all children of a node at once.
+  // hit[c] is non-zero if the ray hits child c inside [min_dist, closest_dist]
+  // and dist[c] is the entry distance
+  template <typename T>
+  DRAY_EXEC void intersect (const int32 node,
+                            const Vec<T, 3> &orig_dir,
+                            const Vec<T, 3> &inv_dir,
+                            const T &closest_dist,
+                            const T &min_dist,
+                            int32 hit[width],
+                            T dist[width]) const
+  {
+    const float32 *b = m_nodes + node * stride;
+    const int32 *c = m_children + node * width;
+    DRAY_SIMD_LOOP
+    for (int32 i = 0; i < width; ++i)
+    {
+      const T xmin = b[i] * inv_dir[0] - orig_dir[0];
+      const T ymin = b[width + i] * inv_dir[1] - orig_dir[1];
+      const T zmin = b[2 * width + i] * inv_dir[2] - orig_dir[2];
+      const T xmax = b[3 * width + i] * inv_dir[0] - orig_dir[0];
+      const T ymax = b[4 * width + i] * inv_dir[1] - orig_dir[1];
+      const T zmax = b[5 * width + i] * inv_dir[2] - orig_dir[2];
+
+      const T tmin = fmaxf (fmaxf (fmaxf (fminf (ymin, ymax), fminf (xmin, xmax)),
+                                   fminf (zmin, zmax)),
+                            min_dist);
+      const T tmax = fminf (fminf (fminf (fmaxf (ymin, ymax), fmaxf (xmin, xmax)),
+                                   fmaxf (zmin, zmax)),
+                            closest_dist);
+      hit[i] = (tmax >= tmin) & (c[i] != WideBVH::empty_child);
+      dist[i] = tmin;
+    }
+  }
+
+  DRAY_EXEC int32 child (const int32 node, const int32 i) const
+  {
+    return m_children[node * width + i];
+  }
+};
+
 struct DeviceBVH
 {
   const Vec<float32, 4> *m_inner_nodes;
   const int32 *m_leaf_nodes;
   AABB<> m_bounds;
   const int32 *m_aabb_ids;
+  // only valid on host (serial / OpenMP) builds
+  DeviceWideBVH m_wide;
 
   DeviceBVH () = delete;
   DeviceBVH (const BVH &bvh)
   : m_inner_nodes (bvh.m_inner_nodes.get_device_ptr_const ()),
     m_leaf_nodes (bvh.m_leaf_nodes.get_device_ptr_const ()),
-    m_bounds (bvh.m_bounds), m_aabb_ids (bvh.m_aabb_ids.get_device_ptr_const ())
+    m_bounds (bvh.m_bounds), m_aabb_ids (bvh.m_aabb_ids.get_device_ptr_const ()),
+    m_wide (bvh.m_wide)
   {
   }
 };
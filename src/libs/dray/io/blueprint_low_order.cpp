@@ -74,10 +74,31 @@ convert_conn(const conduit::Node &n_conn,
 }
 
 Array<Vec<Float,1>>
-copy_conduit_scalar_array(const conduit::Node &n_vals)
+copy_conduit_scalar_array(const conduit::Node &n_vals,
+                          std::shared_ptr<void> owner)
 {
   int num_vals = n_vals.dtype().number_of_elements();
   Array<Vec<Float,1>> values;
+
+  // Vec<Float,1> has the same layout as Float, so a compact array of the
+  // right type is used in place. Only external data is borrowed: its
+  // memory outlives the tree it hangs off, while data owned by the tree
+  // is freed as soon as the field is removed from it. The dray array
+  // copies the data before anything writes to it
+  const bool same_type = sizeof(Float) == sizeof(float32)
+                         ? n_vals.dtype().is_float32()
+                         : n_vals.dtype().is_float64();
+  if(owner != nullptr &&
+     same_type &&
+     n_vals.dtype().is_compact() &&
+     n_vals.is_data_external())
+  {
+    Vec<Float,1> *borrowed_ptr = static_cast<Vec<Float,1>*>(
+        const_cast<void*>(n_vals.element_ptr(0)));
+    values.borrow(borrowed_ptr, num_vals, false, owner);
+    return values;
+  }
+
   values.resize(num_vals);
 
   Vec<Float,1> *values_ptr = values.get_host_ptr();
@@ -334,7 +355,8 @@ import_scalar_field(const Node &n_field,
                     const std::string &shape,
                     const std::string &topo,
                     Array<int32> &ctrl_idx,
-                    DataSet &dataset)
+                    DataSet &dataset,
+                    std::shared_ptr<void> owner)
 {
     // if we are elemen assoced (order == 0), we have 1 dof per element
     int32 num_dofs_per_elem = 1;
@@ -349,8 +371,8 @@ import_scalar_field(const Node &n_field,
     const conduit::Node &n_vals = n_field["values"].number_of_children() == 0
          ? n_field["values"] : n_field["values"].child(0);
 
-    // copy conduit array into dray array
-    Array<Vec<Float,1>> values = detail::copy_conduit_scalar_array(n_vals);
+    // copy (or borrow) conduit array into dray array
+    Array<Vec<Float,1>> values = detail::copy_conduit_scalar_array(n_vals, owner);
 
     const std::string field_name = n_field.name();
 
@@ -607,7 +629,8 @@ import_vector_field_3d(const Node &n_field,
 } // namespace detail
 
 DataSet
-BlueprintLowOrder::import(const conduit::Node &n_dataset)
+BlueprintLowOrder::import(const conduit::Node &n_dataset,
+                          std::shared_ptr<void> owner)
 {
   DataSet dataset;
 
@@ -711,7 +734,8 @@ BlueprintLowOrder::import(const conduit::Node &n_dataset)
                                     shape,   // shape
                                     field_topo, // topo name
                                     (order == 1) ? conn : element_conn, // ctrl idx
-                                    dataset // add to this dataset
+                                    dataset, // add to this dataset
+                                    owner // keeps borrowed values alive
                                     );
     }
     else if( components == 2 )
@@ -17,7 +17,13 @@ class BlueprintLowOrder
 {
 public:
 
-  static DataSet import(const conduit::Node &n_dataset);
+  // if an owner is given, compatible field arrays that n_dataset only
+  // references (external data, e.g. published simulation memory) are
+  // borrowed instead of copied and the owner is kept alive with them.
+  // Arrays the tree owns are always copied, since removing them from the
+  // tree would free them. Borrowed arrays are copied before any write.
+  static DataSet import(const conduit::Node &n_dataset,
+                        std::shared_ptr<void> owner = nullptr);
   static
   std::shared_ptr<Mesh> import_uniform(const conduit::Node &n_coords,
                                        Array<int32> &conn,
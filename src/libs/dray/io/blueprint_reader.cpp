@@ -302,7 +302,8 @@ DataSet bp_ho_2dray (const conduit::Node &n_dataset)
 //-----------------------------------------------------------------------------
 
 template <typename T>
-DataSet bp2dray (const conduit::Node &n_domain)
+DataSet bp2dray (const conduit::Node &n_domain,
+                 std::shared_ptr<void> owner = nullptr)
 {
   DataSet dataset;
   if(is_high_order(n_domain))
@@ -311,7 +312,7 @@ DataSet bp2dray (const conduit::Node &n_domain)
   }
   else
   {
-    dataset = BlueprintLowOrder::import(n_domain);
+    dataset = BlueprintLowOrder::import(n_domain, owner);
   }
   return dataset;
 }
@@ -549,9 +550,10 @@ Collection BlueprintReader::load (const std::string &root_file, const int cycle)
 }
 
 DataSet
-BlueprintReader::blueprint_to_dray (const conduit::Node &n_dataset)
+BlueprintReader::blueprint_to_dray (const conduit::Node &n_dataset,
+                                    std::shared_ptr<void> owner)
 {
-  return detail::bp2dray<Float> (n_dataset);
+  return detail::bp2dray<Float> (n_dataset, owner);
 }
 
 } // namespace dray
@@ -26,7 +26,9 @@ class BlueprintReader
   static void save_blueprint(const std::string &root_file,
                              conduit::Node &dataset);
 
-  static DataSet blueprint_to_dray (const conduit::Node &n_dataset);
+  // see BlueprintLowOrder::import for the meaning of owner
+  static DataSet blueprint_to_dray (const conduit::Node &n_dataset,
+                                    std::shared_ptr<void> owner = nullptr);
 };
 
 } // namespace dray
@@ -13,6 +13,8 @@
 #include <dray/utils/data_logger.hpp>
 #include <dray/utils/timer.hpp>
 
+#include <vector>
+
 namespace dray
 {
 
@@ -396,6 +398,128 @@ Array<Vec<float32, 4>> emit (BVHData &data)
   return flat_bvh;
 }
 
+namespace detail
+{
+
+// a child reference in the binary layout produced by emit
+struct BinaryChild
+{
+  int32 m_child;
+  AABB<> m_aabb;
+};
+
+void binary_children (const Vec<float32, 4> *flat_ptr,
+                      const int32 offset,
+                      BinaryChild &left,
+                      BinaryChild &right)
+{
+  const Vec<float32, 4> vec1 = flat_ptr[offset + 0];
+  const Vec<float32, 4> vec2 = flat_ptr[offset + 1];
+  const Vec<float32, 4> vec3 = flat_ptr[offset + 2];
+  const Vec<float32, 4> vec4 = flat_ptr[offset + 3];
+
+  left.m_aabb.reset ();
+  left.m_aabb.include (make_vec3f (vec1[0], vec1[1], vec1[2]));
+  left.m_aabb.include (make_vec3f (vec1[3], vec2[0], vec2[1]));
+
+  right.m_aabb.reset ();
+  right.m_aabb.include (make_vec3f (vec2[2], vec2[3], vec3[0]));
+  right.m_aabb.include (make_vec3f (vec3[1], vec3[2], vec3[3]));
+
+  constexpr int32 isize = sizeof (int32);
+  memcpy (&left.m_child, &vec4[0], isize);
+  memcpy (&right.m_child, &vec4[1], isize);
+}
+
+} // namespace detail
+
+//
+// collapse the binary tree into a WideBVH::width-ary tree.
+// For every wide node we start with the two children of the
+// corresponding binary node and greedily open the inner child
+// with the largest surface area until all slots are full. Under
+// the surface area heuristic the largest child is the one most
+// likely to be visited, so pulling its children up a level gives
+// the biggest reduction in expected traversal cost.
+//
+WideBVH emit_wide (const Array<Vec<float32, 4>> &flat_bvh)
+{
+  constexpr int32 width = WideBVH::width;
+  constexpr int32 stride = WideBVH::node_stride;
+
+  const Vec<float32, 4> *flat_ptr = flat_bvh.get_host_ptr_const ();
+
+  std::vector<float32> nodes (stride, 0.f);
+  std::vector<int32> children (width, WideBVH::empty_child);
+  int32 num_nodes = 1;
+
+  // pairs of (binary node offset, wide node index)
+  std::vector<std::pair<int32, int32>> todo;
+  todo.push_back (std::make_pair (0, 0));
+
+  while (!todo.empty ())
+  {
+    const int32 binary_offset = todo.back ().first;
+    const int32 wide_node = todo.back ().second;
+    todo.pop_back ();
+
+    detail::BinaryChild slots[width];
+    int32 count = 2;
+    detail::binary_children (flat_ptr, binary_offset, slots[0], slots[1]);
+
+    while (count < width)
+    {
+      int32 best = -1;
+      float32 best_area = -1.f;
+      for (int32 i = 0; i < count; ++i)
+      {
+        if (slots[i].m_child < 0) continue;
+        const float32 area = slots[i].m_aabb.surface_area ();
+        if (area > best_area)
+        {
+          best_area = area;
+          best = i;
+        }
+      }
+
+      if (best == -1) break;
+
+      const int32 offset = slots[best].m_child;
+      detail::binary_children (flat_ptr, offset, slots[best], slots[count]);
+      count++;
+    }
+
+    for (int32 i = 0; i < count; ++i)
+    {
+      int32 child = slots[i].m_child;
+      if (child >= 0)
+      {
+        // binary inner nodes are stored as offsets
+        const int32 new_node = num_nodes++;
+        nodes.resize (num_nodes * stride, 0.f);
+        children.resize (num_nodes * width, WideBVH::empty_child);
+        todo.push_back (std::make_pair (child, new_node));
+        child = new_node;
+      }
+
+      const AABB<> &aabb = slots[i].m_aabb;
+      float32 *node_ptr = &nodes[wide_node * stride];
+      node_ptr[0 * width + i] = aabb.m_ranges[0].min ();
+      node_ptr[1 * width + i] = aabb.m_ranges[1].min ();
+      node_ptr[2 * width + i] = aabb.m_ranges[2].min ();
+      node_ptr[3 * width + i] = aabb.m_ranges[0].max ();
+      node_ptr[4 * width + i] = aabb.m_ranges[1].max ();
+      node_ptr[5 * width + i] = aabb.m_ranges[2].max ();
+      children[wide_node * width + i] = child;
+    }
+  }
+
+  WideBVH wide;
+  wide.m_nodes.set (&nodes[0], int32 (nodes.size ()));
+  wide.m_children.set (&children[0], int32 (children.size ()));
+  return wide;
+}
+
 BVH LinearBVHBuilder::construct (Array<AABB<>> aabbs)
 {
 
@@ -508,6 +632,12 @@ BVH LinearBVHBuilder::construct (Array<AABB<>> aabbs, Array<int32> primitive_ids
   DRAY_LOG_ENTRY ("emit", timer.elapsed ());
   timer.reset ();
 
+#ifndef DRAY_DEVICE_ENABLED
+  bvh.m_wide = emit_wide (bvh.m_inner_nodes);
+  DRAY_LOG_ENTRY ("emit_wide", timer.elapsed ());
+  timer.reset ();
+#endif
+
   bvh.m_leaf_nodes = bvh_data.m_leafs;
   bvh.m_bounds = bounds;
   bvh.m_aabb_ids = ids;
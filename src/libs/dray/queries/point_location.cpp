@@ -3,6 +3,7 @@
 #include <dray/error.hpp>
 #include <dray/warning.hpp>
 #include <dray/array_utils.hpp>
+#include <dray/data_model/mesh_utils.hpp>
 #include <dray/utils/data_logger.hpp>
 
 #include <dray/dray.hpp>
@@ -254,6 +255,10 @@ PointLocation::execute(Collection &collection, Array<Vec<Float,3>> &points)
     array_memset(values[i], m_empty_val);
   }
 
+  // sort the points once for all domains, each domain skips the points
+  // outside its bounds
+  Array<int32> order = detail::morton_order(points, bounds);
+
   bool has_data = false;
   for(int32 i = 0; i < collection.local_size(); ++i)
   {
@@ -261,7 +266,7 @@ PointLocation::execute(Collection &collection, Array<Vec<Float,3>> &points)
     // if the points are not found, the values won't be updated,
     // so at the end, we will should have all the field values
     DataSet data_set = collection.domain(i);
-    Array<Location> locs = data_set.mesh()->locate(points);
+    Array<Location> locs = data_set.mesh()->locate_batch(points, order);
     bool domain_has_data = detail::has_data(locs);
     if(domain_has_data)
     {
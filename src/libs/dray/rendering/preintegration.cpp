@@ -0,0 +1,159 @@
+// Copyright 2019 Lawrence Livermore National Security, LLC and other
+// Devil Ray Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include <dray/rendering/preintegration.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace dray
+{
+
+namespace detail
+{
+
+// running integrals of the extinction and of the extinction weighted
+// color over the piecewise constant bins of a sampled color map
+struct TransferIntegrals
+{
+  std::vector<float64> m_tau;
+  std::vector<float64> m_color[3];
+  std::vector<float64> m_bin_tau;
+  std::vector<float64> m_bin_color[3];
+  int32 m_bins;
+
+  TransferIntegrals(const Vec<float32, 4> *colors, const int32 num_colors)
+  {
+    // DeviceColorMap picks color floor(s * (n - 1)), so bin k covers
+    // [k, k + 1) / (n - 1)
+    m_bins = std::max(num_colors - 1, 1);
+    m_tau.resize(m_bins + 1, 0.0);
+    m_bin_tau.resize(m_bins);
+    for(int32 c = 0; c < 3; ++c)
+    {
+      m_color[c].resize(m_bins + 1, 0.0);
+      m_bin_color[c].resize(m_bins);
+    }
+
+    const float64 width = 1.0 / float64(m_bins);
+    for(int32 k = 0; k < m_bins; ++k)
+    {
+      const Vec<float32, 4> color = colors[std::min(k, num_colors - 1)];
+      // an alpha of one would be an infinite extinction
+      const float64 alpha = std::min(float64(color[3]), 0.9999);
+      m_bin_tau[k] = -std::log(1.0 - alpha);
+      m_tau[k + 1] = m_tau[k] + m_bin_tau[k] * width;
+      for(int32 c = 0; c < 3; ++c)
+      {
+        m_bin_color[c][k] = color[c];
+        m_color[c][k + 1] = m_color[c][k] + m_bin_tau[k] * color[c] * width;
+      }
+    }
+  }
+
+  int32 bin(const float64 s) const
+  {
+    return std::min(std::max(int32(s * m_bins), 0), m_bins - 1);
+  }
+
+  void integrate(const float64 s, float64 &tau, float64 color[3]) const
+  {
+    const int32 k = bin(s);
+    const float64 frac = s - float64(k) / float64(m_bins);
+    tau = m_tau[k] + m_bin_tau[k] * frac;
+    for(int32 c = 0; c < 3; ++c)
+    {
+      color[c] = m_color[c][k] + m_bin_tau[k] * m_bin_color[c][k] * frac;
+    }
+  }
+
+  Vec<float32, 4> point(const float64 s) const
+  {
+    const int32 k = bin(s);
+    Vec<float32, 4> res;
+    res[0] = float32(m_bin_color[0][k]);
+    res[1] = float32(m_bin_color[1][k]);
+    res[2] = float32(m_bin_color[2][k]);
+    res[3] = float32(m_bin_tau[k]);
+    return res;
+  }
+};
+
+} // namespace detail
+
+PreintegratedTable::PreintegratedTable(ColorMap &color_map, const int32 size)
+  : m_size(size),
+    m_range(color_map.scalar_range()),
+    m_log_scale(color_map.log_scale())
+{
+  if(m_size < 2)
+  {
+    DRAY_ERROR("PreintegratedTable size must be at least 2");
+  }
+
+  Array<Vec<float32, 4>> colors = color_map.colors();
+  const detail::TransferIntegrals integrals(colors.get_host_ptr_const(),
+                                            colors.size());
+
+  m_table.resize(m_size * m_size);
+  Vec<float32, 4> *table_ptr = m_table.get_host_ptr();
+
+  const float64 last = float64(m_size - 1);
+  for(int32 f = 0; f < m_size; ++f)
+  {
+    const float64 front = float64(f) / last;
+    float64 front_tau, front_color[3];
+    integrals.integrate(front, front_tau, front_color);
+
+    for(int32 b = 0; b < m_size; ++b)
+    {
+      const float64 back = float64(b) / last;
+      Vec<float32, 4> &entry = table_ptr[f * m_size + b];
+      if(f == b)
+      {
+        entry = integrals.point(front);
+        continue;
+      }
+
+      float64 back_tau, back_color[3];
+      integrals.integrate(back, back_tau, back_color);
+
+      // the scalar is linear along the segment, so the average over the
+      // segment is the average over [front, back] in scalar space
+      const float64 tau = back_tau - front_tau;
+      entry[3] = float32(tau / (back - front));
+      if(std::abs(tau) > 1e-12)
+      {
+        for(int32 c = 0; c < 3; ++c)
+        {
+          entry[c] = float32((back_color[c] - front_color[c]) / tau);
+        }
+      }
+      else
+      {
+        // transparent, any color will do
+        const Vec<float32, 4> mid = integrals.point(0.5 * (front + back));
+        entry[0] = mid[0];
+        entry[1] = mid[1];
+        entry[2] = mid[2];
+      }
+    }
+  }
+}
+
+int32
+PreintegratedTable::size() const
+{
+  return m_size;
+}
+
+Vec<float32, 4>
+PreintegratedTable::entry(const int32 front, const int32 back)
+{
+  return m_table.get_value(front * m_size + back);
+}
+
+} // namespace dray
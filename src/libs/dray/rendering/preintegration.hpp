@@ -0,0 +1,138 @@
+// Copyright 2019 Lawrence Livermore National Security, LLC and other
+// Devil Ray Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#ifndef DRAY_PREINTEGRATION_HPP
+#define DRAY_PREINTEGRATION_HPP
+
+#include <dray/color_map.hpp>
+#include <dray/error.hpp>
+#include <dray/math.hpp>
+
+namespace dray
+{
+
+/**
+ * The PreintegratedTable class holds a 2D transfer function table
+ * built from a color map. Entry (front, back) is the average color and
+ * extinction of a ray segment whose normalized scalar goes linearly
+ * from front to back, so features of the transfer function that fall
+ * between two samples still contribute.
+ *
+ * Extinction is stored per reference length: an alpha of the color map
+ * is the opacity of a segment of that length with a constant scalar.
+ */
+class PreintegratedTable
+{
+  protected:
+  Array<Vec<float32, 4>> m_table;
+  int32 m_size;
+  Range m_range;
+  bool m_log_scale;
+  public:
+  PreintegratedTable() = delete;
+  PreintegratedTable(ColorMap &color_map, const int32 size = 256);
+  int32 size() const;
+  /// rgb and extinction of entry (front, back)
+  Vec<float32, 4> entry(const int32 front, const int32 back);
+
+  friend class DevicePreintegratedTable;
+}; // class preintegrated table
+
+/**
+ * Device accessible preintegrated table
+ */
+class DevicePreintegratedTable
+{
+  public:
+  const Vec<float32, 4> *m_table;
+  const int32 m_size;
+  const bool m_log_scale;
+
+  Float m_inv_range;
+  Float m_min;
+  Float m_max;
+  Float m_inv_ref_length;
+
+  /// empty table for kernels that never do a lookup
+  DevicePreintegratedTable()
+  : m_table(nullptr),
+    m_size(0),
+    m_log_scale(false),
+    m_inv_range(0.f),
+    m_min(0.f),
+    m_max(0.f),
+    m_inv_ref_length(0.f)
+  {
+  }
+
+  DevicePreintegratedTable(PreintegratedTable &table, const Float ref_length)
+  : m_table(table.m_table.get_device_ptr_const()),
+    m_size(table.m_size),
+    m_log_scale(table.m_log_scale),
+    m_inv_ref_length(rcp_safe(ref_length))
+  {
+    if (table.m_range.is_empty ())
+    {
+      DRAY_ERROR ("PreintegratedTable scalar range never set");
+    }
+
+    m_min = table.m_range.min();
+    m_max = table.m_range.max();
+    if(m_log_scale)
+    {
+      if (m_min <= 0.f)
+      {
+        DRAY_ERROR (
+        "PreintegratedTable log scalar range contains values <= 0");
+      }
+      m_min = log(m_min);
+      m_max = log(m_max);
+    }
+    m_inv_range = rcp_safe (m_max - m_min);
+  }
+
+  /// maps a scalar into [0,1] the same way DeviceColorMap does
+  DRAY_EXEC float32 normalize(const Float &scalar) const
+  {
+    Float s = scalar;
+    if (m_log_scale)
+    {
+      s = log(s);
+    }
+    s = clamp(s, m_min, m_max);
+    return static_cast<float32> ((s - m_min) * m_inv_range);
+  }
+
+  /// color of a segment of the given length between two normalized
+  /// scalars. The rgb is not premultiplied, alpha is the opacity of the
+  /// whole segment
+  DRAY_EXEC Vec<float32, 4> color(const float32 front,
+                                  const float32 back,
+                                  const Float length) const
+  {
+    const float32 last = float32(m_size - 1);
+    const float32 fx = clamp(front * last, 0.f, last);
+    const float32 fy = clamp(back * last, 0.f, last);
+    const int32 x0 = min(static_cast<int32>(fx), m_size - 2);
+    const int32 y0 = min(static_cast<int32>(fy), m_size - 2);
+    const float32 tx = fx - float32(x0);
+    const float32 ty = fy - float32(y0);
+
+    const Vec<float32, 4> c00 = m_table[x0 * m_size + y0];
+    const Vec<float32, 4> c01 = m_table[x0 * m_size + y0 + 1];
+    const Vec<float32, 4> c10 = m_table[(x0 + 1) * m_size + y0];
+    const Vec<float32, 4> c11 = m_table[(x0 + 1) * m_size + y0 + 1];
+
+    Vec<float32, 4> res = (c00 * (1.f - ty) + c01 * ty) * (1.f - tx) +
+                          (c10 * (1.f - ty) + c11 * ty) * tx;
+
+    const float32 depth = res[3] * static_cast<float32>(length * m_inv_ref_length);
+    res[3] = 1.f - exp(-depth);
+    return res;
+  }
+}; // class device preintegrated table
+
+} // namespace dray
+#endif
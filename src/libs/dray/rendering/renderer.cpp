@@ -8,6 +8,7 @@
 #include <dray/rendering/screen_annotator.hpp>
 #include <dray/rendering/world_annotator.hpp>
 #include <dray/utils/data_logger.hpp>
+#include <dray/array_utils.hpp>
 #include <dray/dray.hpp>
 #include <dray/error.hpp>
 #include <dray/error_check.hpp>
@@ -16,6 +17,8 @@
 #include <apcomp/compositor.hpp>
 #include <apcomp/partial_compositor.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <vector>
 
@@ -158,15 +161,334 @@ PointLight default_light(Camera &camera)
   return light;
 }
 
+// rank 0 decides which pixels get traced, everyone traces them
+void broadcast_pixels(std::vector<int32> &pixels)
+{
+#ifdef DRAY_MPI_ENABLED
+  MPI_Comm mpi_comm = MPI_Comm_f2c(dray::mpi_comm());
+  int32 size = static_cast<int32>(pixels.size());
+  MPI_Bcast(&size, 1, MPI_INT, 0, mpi_comm);
+  pixels.resize(size);
+  if(size > 0)
+  {
+    MPI_Bcast(pixels.data(), size, MPI_INT, 0, mpi_comm);
+  }
+#endif
+}
+
+// Tracks the blocks of a progressive render. A block at stride s has its
+// corners at (x, y) and (x + s, y + s), clamped to the image, and all of
+// its corners have been traced. Blocks whose corners agree are filled by
+// interpolation, the others are split into four blocks at stride s / 2
+// after tracing the 3x3 grid of the split.
+class PixelRefiner
+{
+protected:
+  enum PixelState : uint8
+  {
+    EMPTY = 0,
+    QUEUED = 1,
+    TRACED = 2
+  };
+
+  int32 m_width;
+  int32 m_height;
+  int32 m_stride;
+  float32 m_threshold;
+  Vec<float32,4> *m_colors;
+  float32 *m_depths;
+  std::vector<uint8> m_state;
+  std::vector<Vec<int32,2>> m_blocks;
+  std::vector<Vec<int32,2>> m_split;
+
+  int32 block_end(const int32 origin, const int32 extent) const
+  {
+    return std::min(origin + m_stride, extent - 1);
+  }
+
+  // the far side of a block is the near side of the next one, so only
+  // origins inside the last column and row start a block
+  bool valid_origin(const int32 origin, const int32 extent) const
+  {
+    return origin == 0 || origin < extent - 1;
+  }
+
+  void queue(const int32 x, const int32 y, std::vector<int32> &pixels)
+  {
+    const int32 id = y * m_width + x;
+    if(m_state[id] == EMPTY)
+    {
+      m_state[id] = QUEUED;
+      pixels.push_back(id);
+    }
+  }
+
+  bool needs_split(const int32 corners[4]) const
+  {
+    int32 misses = 0;
+    float32 min_depth = infinity32();
+    float32 max_depth = neg_infinity32();
+    Vec<float32,4> min_color = m_colors[corners[0]];
+    Vec<float32,4> max_color = m_colors[corners[0]];
+    for(int32 i = 0; i < 4; ++i)
+    {
+      const float32 depth = m_depths[corners[i]];
+      if(depth == infinity32())
+      {
+        misses++;
+      }
+      else
+      {
+        min_depth = std::min(min_depth, depth);
+        max_depth = std::max(max_depth, depth);
+      }
+      const Vec<float32,4> color = m_colors[corners[i]];
+      for(int32 c = 0; c < 4; ++c)
+      {
+        min_color[c] = std::min(min_color[c], color[c]);
+        max_color[c] = std::max(max_color[c], color[c]);
+      }
+    }
+
+    // silhouette edge
+    if(misses != 0 && misses != 4)
+    {
+      return true;
+    }
+    // depth discontinuity
+    if(misses == 0 && max_depth - min_depth > 0.1f * std::abs(min_depth))
+    {
+      return true;
+    }
+    for(int32 c = 0; c < 4; ++c)
+    {
+      if(max_color[c] - min_color[c] > m_threshold)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // bilinear colors and nearest corner depths for the pixels of a block
+  // that were not traced
+  void fill(const Vec<int32,2> &block)
+  {
+    const int32 x0 = block[0];
+    const int32 y0 = block[1];
+    const int32 x1 = block_end(x0, m_width);
+    const int32 y1 = block_end(y0, m_height);
+    const float32 inv_x = x1 > x0 ? 1.f / float32(x1 - x0) : 0.f;
+    const float32 inv_y = y1 > y0 ? 1.f / float32(y1 - y0) : 0.f;
+
+    const Vec<float32,4> c00 = m_colors[y0 * m_width + x0];
+    const Vec<float32,4> c10 = m_colors[y0 * m_width + x1];
+    const Vec<float32,4> c01 = m_colors[y1 * m_width + x0];
+    const Vec<float32,4> c11 = m_colors[y1 * m_width + x1];
+
+    for(int32 y = y0; y <= y1; ++y)
+    {
+      const float32 ty = float32(y - y0) * inv_y;
+      for(int32 x = x0; x <= x1; ++x)
+      {
+        const int32 id = y * m_width + x;
+        if(m_state[id] == TRACED)
+        {
+          continue;
+        }
+        const float32 tx = float32(x - x0) * inv_x;
+        m_colors[id] = (c00 * (1.f - tx) + c10 * tx) * (1.f - ty) +
+                       (c01 * (1.f - tx) + c11 * tx) * ty;
+        const int32 nx = tx < 0.5f ? x0 : x1;
+        const int32 ny = ty < 0.5f ? y0 : y1;
+        m_depths[id] = m_depths[ny * m_width + nx];
+      }
+    }
+  }
+
+public:
+  PixelRefiner(Framebuffer &framebuffer,
+               const int32 stride,
+               const float32 threshold)
+    : m_width(framebuffer.width()),
+      m_height(framebuffer.height()),
+      m_stride(stride),
+      m_threshold(threshold),
+      m_colors(framebuffer.colors().get_host_ptr()),
+      m_depths(framebuffer.depths().get_host_ptr()),
+      m_state(size_t(framebuffer.width()) * framebuffer.height(), EMPTY)
+  {
+  }
+
+  int32 stride() const
+  {
+    return m_stride;
+  }
+
+  // the corners of all blocks at the coarse stride
+  std::vector<int32> coarse_pixels()
+  {
+    std::vector<int32> xs, ys;
+    for(int32 x = 0; x < m_width; x += m_stride)
+    {
+      xs.push_back(x);
+    }
+    if(xs.back() != m_width - 1)
+    {
+      xs.push_back(m_width - 1);
+    }
+    for(int32 y = 0; y < m_height; y += m_stride)
+    {
+      ys.push_back(y);
+    }
+    if(ys.back() != m_height - 1)
+    {
+      ys.push_back(m_height - 1);
+    }
+
+    std::vector<int32> pixels;
+    pixels.reserve(xs.size() * ys.size());
+    for(const int32 y : ys)
+    {
+      for(const int32 x : xs)
+      {
+        queue(x, y, pixels);
+      }
+    }
+
+    m_blocks.clear();
+    for(const int32 y : ys)
+    {
+      if(!valid_origin(y, m_height) || y % m_stride != 0) continue;
+      for(const int32 x : xs)
+      {
+        if(!valid_origin(x, m_width) || x % m_stride != 0) continue;
+        m_blocks.push_back({{x, y}});
+      }
+    }
+    return pixels;
+  }
+
+  // the framebuffer holds the colors of these pixels now
+  void traced(const std::vector<int32> &pixels)
+  {
+    for(const int32 id : pixels)
+    {
+      m_state[id] = TRACED;
+    }
+  }
+
+  // fills the blocks that are smooth and returns the pixels the other
+  // blocks need to be split. Call descend once they are traced or
+  // finish to give up on them
+  std::vector<int32> refine()
+  {
+    std::vector<int32> pixels;
+    m_split.clear();
+    while(m_stride > 1)
+    {
+      const int32 half = m_stride / 2;
+      for(const Vec<int32,2> &block : m_blocks)
+      {
+        const int32 x0 = block[0];
+        const int32 y0 = block[1];
+        const int32 x1 = block_end(x0, m_width);
+        const int32 y1 = block_end(y0, m_height);
+        const int32 corners[4] = {y0 * m_width + x0,
+                                  y0 * m_width + x1,
+                                  y1 * m_width + x0,
+                                  y1 * m_width + x1};
+        if(!needs_split(corners))
+        {
+          fill(block);
+          continue;
+        }
+
+        m_split.push_back(block);
+        const int32 xs[3] = {x0, std::min(x0 + half, x1), x1};
+        const int32 ys[3] = {y0, std::min(y0 + half, y1), y1};
+        for(int32 j = 0; j < 3; ++j)
+        {
+          for(int32 i = 0; i < 3; ++i)
+          {
+            queue(xs[i], ys[j], pixels);
+          }
+        }
+      }
+
+      // neighbors may have traced everything the split needs already
+      if(!pixels.empty() || m_split.empty())
+      {
+        break;
+      }
+      descend();
+    }
+    return pixels;
+  }
+
+  // the split blocks become the blocks of the next level
+  void descend()
+  {
+    const int32 half = m_stride / 2;
+    std::vector<Vec<int32,2>> blocks;
+    blocks.reserve(m_split.size() * 4);
+    for(const Vec<int32,2> &block : m_split)
+    {
+      const int32 x1 = block_end(block[0], m_width);
+      const int32 y1 = block_end(block[1], m_height);
+      for(int32 j = 0; j < 2; ++j)
+      {
+        const int32 y = block[1] + j * half;
+        if(j == 1 && y >= y1) continue;
+        for(int32 i = 0; i < 2; ++i)
+        {
+          const int32 x = block[0] + i * half;
+          if(i == 1 && x >= x1) continue;
+          blocks.push_back({{x, y}});
+        }
+      }
+    }
+    m_blocks.swap(blocks);
+    m_split.clear();
+    m_stride = half;
+  }
+
+  // fills the split blocks from their corners
+  void finish()
+  {
+    for(const Vec<int32,2> &block : m_split)
+    {
+      fill(block);
+    }
+    m_split.clear();
+  }
+};
+
 } // namespace detail
 
+float32 ProgressiveInfo::quality() const
+{
+  if(m_coarse_stride <= 1 || m_stride <= 1)
+  {
+    return 1.f;
+  }
+  const float32 levels = std::log2(float32(m_coarse_stride));
+  const float32 done = std::log2(float32(m_coarse_stride) / float32(m_stride));
+  return done / levels;
+}
+
 Renderer::Renderer()
   : m_volume(nullptr),
     m_use_lighting(true),
     m_world_annotations(false),
     m_color_bar(true),
     m_triad(false),
-    m_max_color_bars(2)
+    m_max_color_bars(2),
+    m_progressive(false),
+    m_time_budget(0.f),
+    m_shared_budget(false),
+    m_coarse_stride(8),
+    m_refinement_threshold(0.02f)
 {
 }
 
@@ -226,18 +548,8 @@ AABB<3> Renderer::bounds()
   return scene_bounds;
 }
 
-Framebuffer Renderer::render(Camera &camera)
+Array<PointLight> Renderer::create_lights(Camera &camera)
 {
-  DRAY_LOG_OPEN("render");
-  Array<Ray> rays;
-  camera.create_rays (rays);
-
-  std::vector<std::string> field_names;
-  std::vector<ColorMap> color_maps;
-
-  Framebuffer framebuffer (camera.get_width(), camera.get_height());
-  framebuffer.clear ();
-
   Array<PointLight> lights;
   if(m_lights.size() > 0)
   {
@@ -255,8 +567,164 @@ Framebuffer Renderer::render(Camera &camera)
     PointLight* light_ptr = lights.get_host_ptr();
     light_ptr[0] = light;
   }
+  return lights;
+}
+
+Framebuffer Renderer::render(Camera &camera)
+{
+  if(m_progressive)
+  {
+    return render_progressive(camera);
+  }
+
+  DRAY_LOG_OPEN("render");
+  Array<Ray> rays;
+  camera.create_rays (rays);
+
+  std::vector<std::string> field_names;
+  std::vector<ColorMap> color_maps;
+
+  Framebuffer framebuffer (camera.get_width(), camera.get_height());
+  framebuffer.clear ();
+
+  Array<PointLight> lights = create_lights(camera);
+
+  float32 composite_time = 0.f;
+  render_pass(rays,
+              camera,
+              lights,
+              framebuffer,
+              field_names,
+              color_maps,
+              composite_time);
+  annotate(framebuffer, camera, field_names, color_maps);
+
+  DRAY_LOG_CLOSE();
+
+  return framebuffer;
+}
+
+Framebuffer Renderer::render_progressive(Camera &camera)
+{
+  DRAY_LOG_OPEN("render_progressive");
+  Timer timer;
+
+  Array<Ray> all_rays;
+  camera.create_rays (all_rays);
+
+  const int32 width = camera.get_width();
+  const int32 height = camera.get_height();
+  const int64 num_pixels = int64(width) * int64(height);
+
+  std::vector<std::string> field_names;
+  std::vector<ColorMap> color_maps;
+
+  Framebuffer framebuffer (width, height);
+  framebuffer.clear ();
+
+  Array<PointLight> lights = create_lights(camera);
+
+  const bool root = dray::mpi_rank() == 0;
+  detail::PixelRefiner refiner(framebuffer,
+                               m_coarse_stride,
+                               m_refinement_threshold);
+
+  std::vector<int32> pixels;
+  if(root)
+  {
+    pixels = refiner.coarse_pixels();
+  }
+  detail::broadcast_pixels(pixels);
 
+  int64 traced = 0;
+  int32 passes = 0;
+  bool budget_hit = false;
+  while(!pixels.empty())
+  {
+    Timer pass_timer;
+    Array<int32> ids(pixels.data(), static_cast<int32>(pixels.size()));
+    Array<Ray> rays = gather(all_rays, ids);
+
+    Framebuffer pass (width, height);
+    pass.clear ();
+    field_names.clear();
+    color_maps.clear();
+    float32 composite_time = 0.f;
+    render_pass(rays, camera, lights, pass, field_names, color_maps, composite_time);
+
+    traced += static_cast<int64>(pixels.size());
+    passes++;
+    // compositing and the depth exchange work on the whole image, so
+    // they cost about the same every pass. Only tracing scales with
+    // the number of pixels
+    const float32 trace_time = std::max(pass_timer.elapsed() - composite_time, 0.f);
+    const float32 ray_cost = trace_time / float32(pixels.size());
+
+    if(root)
+    {
+      const Vec<float32,4> *pass_colors = pass.colors().get_host_ptr_const();
+      const float32 *pass_depths = pass.depths().get_host_ptr_const();
+      Vec<float32,4> *colors = framebuffer.colors().get_host_ptr();
+      float32 *depths = framebuffer.depths().get_host_ptr();
+      for(const int32 id : pixels)
+      {
+        colors[id] = pass_colors[id];
+        depths[id] = pass_depths[id];
+      }
+      refiner.traced(pixels);
+
+      pixels = refiner.refine();
+      const float32 estimate = ray_cost * float32(pixels.size()) + composite_time;
+      const float32 spent = m_shared_budget ? m_budget_timer.elapsed()
+                                            : timer.elapsed();
+      if(!pixels.empty() &&
+         m_time_budget > 0.f &&
+         spent + estimate > m_time_budget)
+      {
+        budget_hit = true;
+        pixels.clear();
+        refiner.finish();
+      }
+      else if(!pixels.empty())
+      {
+        refiner.descend();
+      }
+    }
+    else
+    {
+      pixels.clear();
+    }
+    detail::broadcast_pixels(pixels);
+  }
+
+  annotate(framebuffer, camera, field_names, color_maps);
+
+  m_progressive_info.m_coarse_stride = m_coarse_stride;
+  m_progressive_info.m_stride = budget_hit ? refiner.stride() : 1;
+  m_progressive_info.m_traced = float32(double(traced) / double(num_pixels));
+  m_progressive_info.m_budget_hit = budget_hit;
+  m_progressive_info.m_time = timer.elapsed();
+
+  DRAY_LOG_ENTRY("passes", passes);
+  DRAY_LOG_ENTRY("traced", m_progressive_info.m_traced);
+  DRAY_LOG_ENTRY("stride", m_progressive_info.m_stride);
+  DRAY_LOG_ENTRY("quality", m_progressive_info.quality());
+  DRAY_LOG_ENTRY("budget_hit", budget_hit ? 1 : 0);
+  DRAY_LOG_CLOSE();
+
+  return framebuffer;
+}
+
+void Renderer::render_pass(Array<Ray> &rays,
+                           Camera &camera,
+                           Array<PointLight> &lights,
+                           Framebuffer &framebuffer,
+                           std::vector<std::string> &field_names,
+                           std::vector<ColorMap> &color_maps,
+                           float32 &composite_time)
+{
   const int32 size = m_traceables.size();
+  composite_time = 0.f;
 
   bool need_composite = false;
   for(int i = 0; i < size; ++i)
@@ -301,7 +769,9 @@ Framebuffer Renderer::render(Camera &camera)
   // all agree to do things that might involve mpi
   if(detail::someone_agrees(need_composite))
   {
+    Timer composite_timer;
     composite(rays, camera, framebuffer, synch_depths);
+    composite_time += composite_timer.elapsed();
   }
 
   if(m_volume != nullptr)
@@ -323,6 +793,7 @@ Framebuffer Renderer::render(Camera &camera)
     std::vector<std::vector<apcomp::VolumePartial<float>>> c_partials;
     detail::convert_partials(domain_partials, c_partials);
 
+    Timer composite_timer;
     std::vector<apcomp::VolumePartial<float>> result;
     apcomp::PartialCompositor<apcomp::VolumePartial<float>> compositor;
     compositor.composite(c_partials, result);
@@ -333,9 +804,16 @@ Framebuffer Renderer::render(Camera &camera)
                                       framebuffer,
                                       need_composite);
     }
+    composite_time += composite_timer.elapsed();
 
   }
+}
 
+void Renderer::annotate(Framebuffer &framebuffer,
+                        Camera &camera,
+                        std::vector<std::string> &field_names,
+                        std::vector<ColorMap> &color_maps)
+{
   if (dray::mpi_rank() == 0)
   {
     Timer timer;
@@ -356,10 +834,6 @@ Framebuffer Renderer::render(Camera &camera)
     }
     DRAY_LOG_ENTRY("screen_annotations",timer.elapsed());
   }
-
-  DRAY_LOG_CLOSE();
-
-  return framebuffer;
 }
 
 void Renderer::composite(Array<Ray> &rays,
@@ -433,4 +907,47 @@ void Renderer::max_color_bars(const int32 max_bars)
   m_max_color_bars = max_bars;
 }
 
+void Renderer::progressive(bool on)
+{
+  m_progressive = on;
+}
+
+void Renderer::time_budget(const float32 seconds)
+{
+  if(seconds < 0.f)
+  {
+    DRAY_ERROR("Time budget must not be negative");
+  }
+  m_time_budget = seconds;
+  if(seconds > 0.f)
+  {
+    m_progressive = true;
+  }
+}
+
+void Renderer::start_time_budget()
+{
+  m_shared_budget = true;
+  m_budget_timer.reset();
+}
+
+void Renderer::coarse_stride(const int32 stride)
+{
+  if(stride < 1 || (stride & (stride - 1)) != 0)
+  {
+    DRAY_ERROR("Coarse stride must be a power of two, got "<<stride);
+  }
+  m_coarse_stride = stride;
+}
+
+void Renderer::refinement_threshold(const float32 threshold)
+{
+  m_refinement_threshold = threshold;
+}
+
+ProgressiveInfo Renderer::progressive_info() const
+{
+  return m_progressive_info;
+}
+
 } // namespace dray
@@ -11,6 +11,7 @@
 #include <dray/rendering/point_light.hpp>
 #include <dray/rendering/traceable.hpp>
 #include <dray/rendering/volume.hpp>
+#include <dray/utils/timer.hpp>
 
 #include <memory>
 #include <vector>
@@ -18,6 +19,23 @@
 namespace dray
 {
 
+/**
+ * Outcome of the last progressive render. Like the framebuffer, it is
+ * only valid on rank 0.
+ */
+struct ProgressiveInfo
+{
+  int32 m_coarse_stride = 1; // pixel spacing of the first pass
+  int32 m_stride = 1;        // finest spacing reached, 1 is full resolution
+  float32 m_traced = 1.f;    // fraction of the pixels that were traced
+  float32 m_time = 0.f;      // seconds spent rendering
+  bool m_budget_hit = false; // refinement was cut short by the time budget
+
+  /// fraction of the refinement levels that were finished, 1 when
+  /// every pixel that needed it was traced
+  float32 quality() const;
+};
+
 class Renderer
 {
 protected:
@@ -29,6 +47,27 @@ protected:
   bool m_color_bar;
   bool m_triad;
   int32 m_max_color_bars;
+  bool m_progressive;
+  float32 m_time_budget;
+  bool m_shared_budget;
+  Timer m_budget_timer;
+  int32 m_coarse_stride;
+  float32 m_refinement_threshold;
+  ProgressiveInfo m_progressive_info;
+
+  Array<PointLight> create_lights(Camera &camera);
+  void render_pass(Array<Ray> &rays,
+                   Camera &camera,
+                   Array<PointLight> &lights,
+                   Framebuffer &framebuffer,
+                   std::vector<std::string> &field_names,
+                   std::vector<ColorMap> &color_maps,
+                   float32 &composite_time);
+  void annotate(Framebuffer &framebuffer,
+                Camera &camera,
+                std::vector<std::string> &field_names,
+                std::vector<ColorMap> &color_maps);
+  Framebuffer render_progressive(Camera &camera);
 
 public:
   Renderer();
@@ -50,6 +89,25 @@ public:
   void world_annotations(bool on);
   void max_color_bars(const int32 max_bars);
 
+  /// Progressive mode traces a coarse grid of pixels first and then
+  /// refines the blocks whose corners differ in color or depth, halving
+  /// the pixel spacing each level. Pixels that are not traced are
+  /// interpolated from the corners of their block.
+  void progressive(bool on);
+  /// wall clock seconds a progressive render may take, 0 means no limit.
+  /// Refinement stops before a level that is expected to exceed it.
+  /// Setting a budget turns on progressive mode
+  void time_budget(const float32 seconds);
+  /// starts a time budget shared by the following renders, e.g. all
+  /// the images of one cycle. Without it every render gets the whole
+  /// budget
+  void start_time_budget();
+  /// pixel spacing of the first pass, a power of two
+  void coarse_stride(const int32 stride);
+  /// blocks are refined when a corner color channel differs by more
+  void refinement_threshold(const float32 threshold);
+  ProgressiveInfo progressive_info() const;
+
 };
 
 
@@ -6,6 +6,7 @@
 #include <dray/rendering/triangle_mesh.hpp>
 
 #include <dray/array_utils.hpp>
+#include <dray/device_bvh.hpp>
 #include <dray/error_check.hpp>
 #include <dray/linear_bvh_builder.hpp>
 #include <dray/rendering/device_framebuffer.hpp>
@@ -157,8 +158,132 @@ DRAY_EXEC_ONLY bool intersect_AABB (const Vec<float32, 4> *bvh,
   return (min0 > min1);
 }
 
+#ifndef DRAY_DEVICE_ENABLED
+// host traversal of the wide bvh layout. All children of a node
+// are tested against the ray at once and the hits are pushed
+// far to near so the closest child is visited first.
+Array<RayHit> intersect_wide (const Array<Ray> &rays,
+                              const BVH &bvh,
+                              const Array<Vec<float32,3>> &coords,
+                              const Array<Vec<int32,3>> &indices)
+{
+  const Vec<float32,3> *coords_ptr = coords.get_device_ptr_const ();
+  const Vec<int32,3> *indices_ptr = indices.get_device_ptr_const ();
+  const int32 *leaf_ptr = bvh.m_leaf_nodes.get_device_ptr_const ();
+  const DeviceWideBVH wide (bvh.m_wide);
+
+  const Ray *ray_ptr = rays.get_device_ptr_const ();
+
+  const int32 size = rays.size ();
+
+  Array<RayHit> hits;
+  hits.resize (size);
+
+  RayHit *hit_ptr = hits.get_device_ptr ();
+
+  RAJA::forall<for_policy> (RAJA::RangeSegment (0, size), [=] DRAY_LAMBDA (int32 i)
+  {
+    constexpr int32 width = DeviceWideBVH::width;
+    Ray ray = ray_ptr[i];
+
+    RayHit hit;
+    hit.init();
+
+    Float closest_dist = ray.m_far;
+    Float min_dist = ray.m_near;
+    const Vec<Float, 3> dir = ray.m_dir;
+    Vec<Float, 3> inv_dir;
+    inv_dir[0] = rcp_safe (dir[0]);
+    inv_dir[1] = rcp_safe (dir[1]);
+    inv_dir[2] = rcp_safe (dir[2]);
+
+    Vec<Float, 3> orig_dir;
+    orig_dir[0] = ray.m_orig[0] * inv_dir[0];
+    orig_dir[1] = ray.m_orig[1] * inv_dir[1];
+    orig_dir[2] = ray.m_orig[2] * inv_dir[2];
+
+    int32 todo[64 * (width - 1)];
+    int32 stackptr = 0;
+    todo[stackptr] = 0;
+
+    int32 child_hit[width];
+    Float child_dist[width];
+
+    while (stackptr >= 0)
+    {
+      const int32 current_node = todo[stackptr];
+      stackptr--;
+
+      wide.intersect (current_node,
+                      orig_dir,
+                      inv_dir,
+                      closest_dist,
+                      min_dist,
+                      child_hit,
+                      child_dist);
+
+      // sort the hit children far to near
+      int32 order[width];
+      int32 num_hits = 0;
+      for (int32 c = 0; c < width; ++c)
+      {
+        if (!child_hit[c]) continue;
+        int32 pos = num_hits++;
+        while (pos > 0 && child_dist[order[pos - 1]] < child_dist[c])
+        {
+          order[pos] = order[pos - 1];
+          pos--;
+        }
+        order[pos] = c;
+      }
+
+      // leaves near to far so closest_dist shrinks as fast as possible
+      for (int32 h = num_hits - 1; h >= 0; --h)
+      {
+        const int32 child = wide.child (current_node, order[h]);
+        if (child < 0)
+        {
+          TriLeafIntersector<Moller> leaf_intersector;
+          leaf_intersector.intersect_leaf (-child - 1,
+                                           ray.m_orig,
+                                           dir,
+                                           hit,
+                                           closest_dist,
+                                           min_dist,
+                                           indices_ptr,
+                                           coords_ptr,
+                                           leaf_ptr);
+        }
+      }
+
+      // inner nodes far to near so the nearest is popped first
+      for (int32 h = 0; h < num_hits; ++h)
+      {
+        const int32 child = wide.child (current_node, order[h]);
+        if (child >= 0)
+        {
+          stackptr++;
+          todo[stackptr] = child;
+        }
+      }
+    }
+
+    hit_ptr[i] = hit;
+  });
+  DRAY_ERROR_CHECK();
+  return hits;
+}
+#endif
+
 Array<RayHit> TriangleMesh::intersect (const Array<Ray> &rays)
 {
+#ifndef DRAY_DEVICE_ENABLED
+  if (m_bvh.m_wide.m_nodes.size () > 0)
+  {
+    return intersect_wide (rays, m_bvh, m_coords, m_indices);
+  }
+#endif
+
   const Vec<float32,3> *coords_ptr = m_coords.get_device_ptr_const ();
   const Vec<int32,3> *indices_ptr = m_indices.get_device_ptr_const ();
   const int32 *leaf_ptr = m_bvh.m_leaf_nodes.get_device_ptr_const ();
@@ -6,6 +6,7 @@
 #include <dray/rendering/device_framebuffer.hpp>
 #include <dray/rendering/colors.hpp>
 #include <dray/rendering/volume_shader.hpp>
+#include <dray/rendering/preintegration.hpp>
 
 #include <dray/dispatcher.hpp>
 #include <dray/array_utils.hpp>
@@ -18,6 +19,8 @@
 #include <dray/data_model/device_mesh.hpp>
 #include <dray/data_model/device_field.hpp>
 
+#include <memory>
+
 namespace dray
 {
 
@@ -66,6 +69,43 @@ Array<VolumePartial> compact_partials(const Array<VolumePartial> &partials)
   return gather(partials, compact_idxs);
 }
 
+// extent of the element at loc along dir, from the inverse jacobian.
+// Higher order elements are split by their order so the field is close
+// to linear over a step
+template<typename MeshElement>
+DRAY_EXEC_ONLY
+Float element_extent(const DeviceMesh<MeshElement> &device_mesh,
+                     const Location &loc,
+                     const Vec<Float,3> &dir)
+{
+  const MeshElement elem = device_mesh.get_elem(loc.m_cell_id);
+  Vec<Vec<Float, 3>, 3> jac_vec;
+  elem.eval_d(loc.m_ref_pt, jac_vec);
+
+  Matrix<Float, 3, 3> jacobian;
+  for(int32 rdim = 0; rdim < 3; ++rdim)
+  {
+    jacobian.set_col(rdim, jac_vec[rdim]);
+  }
+
+  bool inv_valid;
+  const Matrix<Float, 3, 3> j_inv = matrix_inverse(jacobian, inv_valid);
+  if(!inv_valid)
+  {
+    return 0.f;
+  }
+
+  // rate of change of the reference coordinates along the ray
+  const Vec<Float, 3> ref_dir = j_inv * dir;
+  Float rate = 0.f;
+  for(int32 d = 0; d < 3; ++d)
+  {
+    rate = max(rate, Float(fabs(ref_dir[d])));
+  }
+  const int32 order = max(elem.get_order(), 1);
+  return rate > 0.f ? 1.f / (rate * Float(order)) : infinity<Float>();
+}
+
 template<typename MeshElement, typename FieldElement>
 Array<VolumePartial>
 integrate_partials(UnstructuredMesh<MeshElement> &mesh,
@@ -75,7 +115,10 @@ integrate_partials(UnstructuredMesh<MeshElement> &mesh,
                    const int32 samples,
                    const AABB<3> bounds,
                    ColorMap &color_map,
-                   bool use_lighting)
+                   bool use_lighting,
+                   bool use_preintegration,
+                   const float32 max_step_factor,
+                   int64 &num_samples_taken)
 {
   DRAY_LOG_OPEN("volume");
   constexpr float32 correction_scalar = 10.f;
@@ -89,11 +132,15 @@ integrate_partials(UnstructuredMesh<MeshElement> &mesh,
   AABB<> sample_bounds = bounds;
   float32 mag = (sample_bounds.max() - sample_bounds.min()).magnitude();
   const float32 sample_dist = mag / float32(samples);
+  const float32 max_step = sample_dist * max(max_step_factor, 1.f);
+  const bool adaptive = max_step > sample_dist;
 
   const int32 num_elems = mesh.cells();
 
   DRAY_LOG_ENTRY("samples", samples);
   DRAY_LOG_ENTRY("sample_distance", sample_dist);
+  DRAY_LOG_ENTRY("max_step", max_step);
+  DRAY_LOG_ENTRY("preintegration", use_preintegration ? 1 : 0);
   DRAY_LOG_ENTRY("cells", num_elems);
   // Start the rays out at the min distance from calc ray start.
   // Note: Rays that have missed the mesh bounds will have near >= far,
@@ -119,6 +166,24 @@ integrate_partials(UnstructuredMesh<MeshElement> &mesh,
 
   DeviceColorMap d_color_map(corrected);
 
+  // the alphas of the uncorrected color map are the opacities of a
+  // segment of length sample_dist / ratio. The table is only built and
+  // moved to the device when it is used
+  std::shared_ptr<PreintegratedTable> table;
+  if(use_preintegration)
+  {
+    table = std::make_shared<PreintegratedTable>(color_map, 256);
+  }
+  const DevicePreintegratedTable d_table =
+    use_preintegration ? DevicePreintegratedTable(*table, sample_dist / ratio)
+                       : DevicePreintegratedTable();
+
+  // the step grows in transparent regions where the normalized scalar
+  // changes less than this per step
+  const Float inv_range = rcp_safe(corrected.scalar_range().length());
+  constexpr Float homogeneous_delta = 1.f / 64.f;
+  constexpr float32 transparent_alpha = 0.02f;
+
 
   VolumeShader<MeshElement, FieldElement> shader(mesh,
                                                  field,
@@ -129,6 +194,8 @@ integrate_partials(UnstructuredMesh<MeshElement> &mesh,
   mstats.resize(ray_size);
   stats::Stats *mstats_ptr = mstats.get_device_ptr();
 
+  RAJA::ReduceSum<reduce_policy, int64> samples_taken(0);
+
   // TODO: somehow load balance based on far - near
   Timer timer;
   RAJA::forall<for_policy>(RAJA::RangeSegment(0, ray_size), [=] DRAY_LAMBDA (int32 i)
@@ -139,6 +206,7 @@ integrate_partials(UnstructuredMesh<MeshElement> &mesh,
     constexpr Vec4f clear = {0.f, 0.f, 0.f, 0.f};
     const int32 partial_offset = max_segments * i;
     int32 segment = 0;
+    int32 count = 0;
 
     VolumePartial partial;
 
@@ -176,27 +244,73 @@ integrate_partials(UnstructuredMesh<MeshElement> &mesh,
       partial.m_depth = distance;
       partial.m_color = clear;
 
-      int count = 0;
       mstat.acc_candidates(1);
+      // the first sample of a segment stands for one sample_dist
+      Float step = sample_dist;
+      Float front = 0.f;
+      bool has_front = false;
       do
       {
         // we know we have a valid location
 
         Vec<float32, 4> sample_color;
-        // shade
+        Float scalar;
+        Vec<Float,3> gradient;
+        Vec<Float,3> world_pos;
         if(use_lighting)
         {
-          sample_color = shader.shaded_color(loc, ray);
+          shader.scalar_gradient(loc, scalar, gradient, world_pos);
+        }
+        else
+        {
+          scalar = shader.scalar(loc);
+        }
+
+        if(use_preintegration)
+        {
+          const float32 back = d_table.normalize(scalar);
+          sample_color = d_table.color(has_front ? d_table.normalize(front) : back,
+                                       back,
+                                       step);
         }
         else
         {
-          sample_color = shader.color(loc);
+          sample_color = d_color_map.color(scalar);
+          if(step != sample_dist)
+          {
+            // the corrected color map is for steps of sample_dist
+            sample_color[3] = 1.f - pow(1.f - sample_color[3],
+                                        float32(step / sample_dist));
+          }
+        }
+
+        // shade
+        if(use_lighting)
+        {
+          sample_color = shader.shaded_color(sample_color, gradient, world_pos, ray);
         }
 
         blend(partial.m_color, sample_color);
         count++;
 
-        distance += sample_dist;
+        if(adaptive)
+        {
+          const Float delta = has_front ? fabs(scalar - front) * inv_range : 0.f;
+          const Float extent = element_extent(device_mesh, loc, ray.m_dir);
+          const Float limit = max(Float(sample_dist), min(Float(max_step), extent));
+          if(sample_color[3] < transparent_alpha && delta < homogeneous_delta)
+          {
+            step = min(step * 2.f, limit);
+          }
+          else
+          {
+            step = sample_dist;
+          }
+        }
+        front = scalar;
+        has_front = true;
+
+        distance += step;
         Vec<Float,3> point = ray.m_orig + distance * ray.m_dir;
         loc = device_mesh.locate(point);
         found = loc.m_cell_id != -1;
@@ -214,9 +328,12 @@ integrate_partials(UnstructuredMesh<MeshElement> &mesh,
 
     } // for segments
     mstats_ptr[i] = mstat;
+    samples_taken += count;
   });
   DRAY_ERROR_CHECK();
   DRAY_LOG_ENTRY("integrate_partials",timer.elapsed());
+  num_samples_taken = samples_taken.get();
+  DRAY_LOG_ENTRY("samples_taken", num_samples_taken);
   stats::StatStore::add_ray_stats(active_rays, mstats);
 
   timer.reset();
@@ -236,20 +353,28 @@ struct IntegratePartialsFunctor
   Float m_samples;
   AABB<3> m_bounds;
   bool m_use_lighting;
+  bool m_use_preintegration;
+  float32 m_max_step_factor;
   Array<VolumePartial> m_partials;
+  int64 m_samples_taken;
   IntegratePartialsFunctor(Array<Ray> *rays,
                            Array<PointLight> &lights,
                            ColorMap &color_map,
                            Float samples,
                            AABB<3> bounds,
-                           bool use_lighting)
+                           bool use_lighting,
+                           bool use_preintegration,
+                           float32 max_step_factor)
     :
       m_rays(rays),
       m_lights(lights),
       m_color_map(color_map),
       m_samples(samples),
       m_bounds(bounds),
-      m_use_lighting(use_lighting)
+      m_use_lighting(use_lighting),
+      m_use_preintegration(use_preintegration),
+      m_max_step_factor(max_step_factor),
+      m_samples_taken(0)
 
   {
   }
@@ -264,7 +389,10 @@ struct IntegratePartialsFunctor
                                             m_samples,
                                             m_bounds,
                                             m_color_map,
-                                            m_use_lighting);
+                                            m_use_lighting,
+                                            m_use_preintegration,
+                                            m_max_step_factor,
+                                            m_samples_taken);
   }
 };
 
@@ -275,6 +403,9 @@ Volume::Volume(Collection &collection)
   : m_samples(100),
     m_collection(collection),
     m_use_lighting(true),
+    m_use_preintegration(false),
+    m_max_step_factor(1.f),
+    m_samples_taken(0),
     m_active_domain(0)
 {
   // add some default alpha
@@ -345,12 +476,22 @@ Volume::integrate(Array<Ray> &rays, Array<PointLight> &lights)
                                         m_color_map,
                                         m_samples,
                                         m_bounds,
-                                        m_use_lighting);
+                                        m_use_lighting,
+                                        m_use_preintegration,
+                                        m_max_step_factor);
   dispatch_3d(mesh, field, func);
+  m_samples_taken += func.m_samples_taken;
   return func.m_partials;
 }
 // ------------------------------------------------------------------------
 
+int64 Volume::samples_taken() const
+{
+  return m_samples_taken;
+}
+
+// ------------------------------------------------------------------------
+
 void Volume::samples(int32 num_samples)
 {
   m_samples = num_samples;
@@ -363,6 +504,24 @@ void Volume::use_lighting(bool do_it)
   m_use_lighting = do_it;
 }
 
+// ------------------------------------------------------------------------
+
+void Volume::use_preintegration(bool do_it)
+{
+  m_use_preintegration = do_it;
+}
+
+// ------------------------------------------------------------------------
+
+void Volume::max_step_factor(float32 factor)
+{
+  if(factor < 1.f)
+  {
+    DRAY_ERROR("max_step_factor must be at least 1");
+  }
+  m_max_step_factor = factor;
+}
+
 
 // ------------------------------------------------------------------------
 
@@ -25,6 +25,9 @@ protected:
   std::string m_field;
   AABB<3> m_bounds;
   bool m_use_lighting;
+  bool m_use_preintegration;
+  float32 m_max_step_factor;
+  int64 m_samples_taken;
   int32 m_active_domain;
   Range m_field_range;
 
@@ -55,6 +58,18 @@ public:
 
   void use_lighting(bool do_it);
 
+  /// blend segments between samples from a preintegrated transfer
+  /// function table instead of point samples of the color map
+  void use_preintegration(bool do_it);
+
+  /// let the step grow up to factor times the sample distance in
+  /// homogeneous, transparent regions. The step never exceeds the
+  /// extent of the current element along the ray. 1 disables it.
+  void max_step_factor(float32 factor);
+
+  /// total number of samples taken along all rays by integrate
+  int64 samples_taken() const;
+
   ColorMap& color_map();
 };
 
@@ -73,7 +73,17 @@ struct VolumeShader
     Vec<Float,3> world_pos;
     Float scalar;
     scalar_gradient(loc, scalar, gradient, world_pos);
-    Vec4f sample_color = m_color_map.color(scalar);
+    return shaded_color(m_color_map.color(scalar), gradient, world_pos, ray);
+  }
+
+  // shades a color that was already looked up, e.g. from a
+  // preintegrated table
+  DRAY_EXEC
+  Vec<float32,4> shaded_color(const Vec4f &sample_color,
+                              Vec<Float,3> gradient,
+                              const Vec<Float,3> &world_pos,
+                              const Ray &ray) const
+  {
     Vec4f acc = {0.f, 0.f, 0.f, 0.f};
     if(sample_color[3] > 0.01)
     {
@@ -157,6 +167,13 @@ struct VolumeShader
     return acc;
   }
 
+  DRAY_EXEC
+  Float scalar(const Location &loc) const
+  {
+    Vec<Vec<Float, 1>, 3> field_deriv;
+    return m_field.get_elem(loc.m_cell_id).eval_d(loc.m_ref_pt, field_deriv)[0];
+  }
+
   DRAY_EXEC
   Vec<float32,4> color(const Location &loc) const
   {
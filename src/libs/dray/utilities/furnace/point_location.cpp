@@ -30,6 +30,7 @@ int main (int argc, char *argv[])
 
   int num_points = 1000;
   int trials = 5;
+  bool batch = false;
   // parse any custon info out of config
   if (config.m_config.has_path ("trials"))
   {
@@ -39,6 +40,10 @@ int main (int argc, char *argv[])
   {
     num_points = config.m_config["points"].to_int32 ();
   }
+  if (config.m_config.has_path ("batch"))
+  {
+    batch = config.m_config["batch"].as_string () == "true";
+  }
 
   dray::AABB<3> bounds = config.m_collection.bounds();
 
@@ -74,7 +79,8 @@ int main (int argc, char *argv[])
   {
     for(int d = 0; d < domains; ++d)
     {
-      locations = config.m_collection.domain(d).mesh()->locate (points);
+      dray::Mesh *mesh = config.m_collection.domain(d).mesh();
+      locations = batch ? mesh->locate_batch (points) : mesh->locate (points);
     }
   }
 
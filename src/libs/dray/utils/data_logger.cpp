@@ -55,7 +55,8 @@ DataLogger DataLogger::m_instance;
 
 DataLogger::DataLogger()
   : m_at_block_start(true),
-    m_rank(0)
+    m_rank(0),
+    m_sink(nullptr)
 {
   m_blocks.push(Block(0));
   m_key_counters.push(std::map<std::string,int>());
@@ -87,6 +88,12 @@ DataLogger::set_rank(const int &rank)
   m_rank = rank;
 }
 
+void
+DataLogger::set_sink(DataLogSink *sink)
+{
+  m_sink = sink;
+}
+
 void
 DataLogger::write_indent()
 {
@@ -113,6 +120,11 @@ DataLogger::write_indent()
 void
 DataLogger::write_log()
 {
+  // everything went to a sink, don't leave empty files behind
+  if(m_stream.tellp() <= 0)
+  {
+    return;
+  }
   std::stringstream log_name;
   std::string log_prefix = "dray_data";
   if(const char* log_p = std::getenv("DRAY_LOG_PREFIX"))
@@ -137,6 +149,11 @@ DataLogger::write_log()
 void
 DataLogger::open(const std::string &entryName)
 {
+    if(m_sink != nullptr)
+    {
+      m_sink->open(entryName);
+      return;
+    }
     write_indent();
     // ensure that we have unique keys for valid yaml
     int key_count = m_key_counters.top()[entryName]++;
@@ -161,6 +178,11 @@ DataLogger::open(const std::string &entryName)
 void
 DataLogger::close()
 {
+  if(m_sink != nullptr)
+  {
+    m_sink->close();
+    return;
+  }
   write_indent();
   this->m_stream<<"time: "<<m_timers.top().elapsed()<<"\n";
   m_timers.pop();
@@ -7,6 +7,7 @@
 #include <fstream>
 #include <map>
 #include <stack>
+#include <type_traits>
 
 namespace dray
 {
@@ -25,6 +26,18 @@ protected:
   static class Logger* m_instance;
 };
 
+// receives the data log instead of the yaml stream, e.g. to feed a
+// trace recorder of the application embedding dray
+class DataLogSink
+{
+public:
+  virtual ~DataLogSink() {}
+  virtual void open(const std::string &entryName) = 0;
+  virtual void close() = 0;
+  virtual void value(const std::string &key, const double value) = 0;
+  virtual void text(const std::string &key, const std::string &value) = 0;
+};
+
 class DataLogger
 {
 public:
@@ -43,10 +56,18 @@ public:
   static DataLogger *get_instance();
   void open(const std::string &entryName);
   void close();
+  // not owned, nullptr restores the yaml log
+  void set_sink(DataLogSink *sink);
+  DataLogSink *sink() const { return m_sink; }
 
   template<typename T>
   void add_entry(const std::string key, const T &value)
   {
+    if(m_sink != nullptr)
+    {
+      sink_entry(key, value, std::is_arithmetic<T>());
+      return;
+    }
     write_indent();
     this->m_stream << key << ": " << value <<"\n";
     m_at_block_start = false;
@@ -59,6 +80,20 @@ protected:
   DataLogger();
   DataLogger(DataLogger const &);
 
+  template<typename T>
+  void sink_entry(const std::string &key, const T &value, std::true_type)
+  {
+    m_sink->value(key, static_cast<double>(value));
+  }
+
+  template<typename T>
+  void sink_entry(const std::string &key, const T &value, std::false_type)
+  {
+    std::stringstream ss;
+    ss << value;
+    m_sink->text(key, ss.str());
+  }
+
   void write_indent();
   DataLogger::Block& current_block();
   std::stringstream m_stream;
@@ -68,6 +103,7 @@ protected:
   std::stack<std::map<std::string,int>> m_key_counters;
   bool m_at_block_start;
   int m_rank;
+  DataLogSink *m_sink;
 };
 
 } // namspace dray
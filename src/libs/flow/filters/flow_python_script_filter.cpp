@@ -18,6 +18,7 @@
 
 // standard lib includes
 #include <iostream>
+#include <fstream>
 #include <string.h>
 #include <limits.h>
 #include <cstdlib>
@@ -108,6 +109,7 @@ PyObject* execute_python(PyObject *py_input,
     std::string module_name = "flow_script_filter";
     std::string input_func_name = "flow_input";
     std::string set_output_func_name = "flow_set_output";
+    std::string view_func_name = "flow_view";
 
     bool echo = false;
     if( params.has_path("echo") &&
@@ -133,6 +135,13 @@ PyObject* execute_python(PyObject *py_input,
         set_output_func_name = params["interface/set_output"].as_string();
     }
 
+    if( params.has_path("interface/view") )
+    {
+        view_func_name = params["interface/view"].as_string();
+    }
+
+    PyObject *py_global_dict = py_interp->global_dict();
+
     std::ostringstream filter_setup_src_oss;
     // lookup or create a new module
     filter_setup_src_oss.str("");
@@ -147,14 +156,16 @@ PyObject* execute_python(PyObject *py_input,
                          << "\n"
                          // setup the module
                          << "flow_setup_module(\"" << module_name << "\")\n";
-    FLOW_CHECK_PYTHON_ERROR(py_interp, py_interp->run_script(filter_setup_src_oss.str()));
+    FLOW_CHECK_PYTHON_ERROR(py_interp, py_interp->run_cached_script(filter_setup_src_oss.str(),
+                                                                    py_global_dict));
 
-    filter_setup_src_oss.str();
+    filter_setup_src_oss.str("");
     filter_setup_src_oss << "\n"
                          // import into the global dict
                          << "import " << module_name << "\n"
                          << "\n";
-    FLOW_CHECK_PYTHON_ERROR(py_interp, py_interp->run_script(filter_setup_src_oss.str()));
+    FLOW_CHECK_PYTHON_ERROR(py_interp, py_interp->run_cached_script(filter_setup_src_oss.str(),
+                                                                    py_global_dict));
 
 
     // fetch the module from the global dict (borrowed)
@@ -178,6 +189,8 @@ PyObject* execute_python(PyObject *py_input,
 
     // run script to establish input and output helpers in the module
     // note: global here binds to module scope
+    // the view helper returns a read-only numpy view of a leaf,
+    // which shares memory with the input node instead of copying it
     filter_setup_src_oss.str("");
     filter_setup_src_oss << "\n"
                          << "_flow_output = None\n"
@@ -188,10 +201,17 @@ PyObject* execute_python(PyObject *py_input,
                          << "def " << set_output_func_name <<  "(out):\n"
                          << "    global _flow_output\n"
                          << "    _flow_output = out\n"
+                         << "\n"
+                         << "def " << view_func_name << "(path):\n"
+                         << "    res = _flow_input[path]\n"
+                         << "    if hasattr(res, 'flags') and hasattr(res, 'view'):\n"
+                         << "        res = res.view()\n"
+                         << "        res.flags.writeable = False\n"
+                         << "    return res\n"
                          << "\n";
 
-    FLOW_CHECK_PYTHON_ERROR(py_interp, py_interp->run_script(filter_setup_src_oss.str(),
-                                                             py_mod_dict));
+    FLOW_CHECK_PYTHON_ERROR(py_interp, py_interp->run_cached_script(filter_setup_src_oss.str(),
+                                                                    py_mod_dict));
 
     // now import binding function names from the module,
     // so the names are bound to the global ns
@@ -200,10 +220,12 @@ PyObject* execute_python(PyObject *py_input,
                          << "from " << module_name
                          << " import "
                          << input_func_name << ", "
-                         << set_output_func_name
+                         << set_output_func_name << ", "
+                         << view_func_name
                          << "\n";
 
-    FLOW_CHECK_PYTHON_ERROR(py_interp, py_interp->run_script(filter_setup_src_oss.str()));
+    FLOW_CHECK_PYTHON_ERROR(py_interp, py_interp->run_cached_script(filter_setup_src_oss.str(),
+                                                                    py_global_dict));
     
     std::string filter_source_file_path = "";
     
@@ -229,17 +251,38 @@ PyObject* execute_python(PyObject *py_input,
                              << "if '__file__' in globals():\n"
                              << "    _flow_source_file_stack.append(__file__)\n"
                              << "__file__ = \"" << filter_source_file_path << "\"\n";
-        FLOW_CHECK_PYTHON_ERROR(py_interp, py_interp->run_script(filter_setup_src_oss.str()));
+        FLOW_CHECK_PYTHON_ERROR(py_interp, py_interp->run_cached_script(filter_setup_src_oss.str(),
+                                                                        py_global_dict));
     }
 
 
+    // the user script is compiled once and the code object is reused
+    // on later executions, the file name shows up in tracebacks
+    std::string filter_source_name = filter_source_file_path.empty() ?
+                                     std::string("<string>") :
+                                     filter_source_file_path;
     if( params.has_child("source") )
     {
-        FLOW_CHECK_PYTHON_ERROR(py_interp, py_interp->run_script(params["source"].as_string()));
+        FLOW_CHECK_PYTHON_ERROR(py_interp,
+                                py_interp->run_cached_script(params["source"].as_string(),
+                                                             py_global_dict,
+                                                             filter_source_name));
     }
     else // file is the other case
     {
-        FLOW_CHECK_PYTHON_ERROR(py_interp, py_interp->run_script_file(params["file"].as_string()));
+        std::ifstream ifs(filter_source_file_path.c_str());
+        if(!ifs.is_open())
+        {
+            CONDUIT_ERROR("python_script failed to open "
+                          << filter_source_file_path);
+        }
+        std::string py_script((std::istreambuf_iterator<char>(ifs)),
+                              std::istreambuf_iterator<char>());
+        ifs.close();
+        FLOW_CHECK_PYTHON_ERROR(py_interp,
+                                py_interp->run_cached_script(py_script,
+                                                             py_global_dict,
+                                                             filter_source_name));
     }
 
     PyObject *py_res = py_interp->get_dict_object(py_mod_dict,
@@ -256,7 +299,8 @@ PyObject* execute_python(PyObject *py_input,
     {
         const std::string file_stack_src = "if len(_flow_source_file_stack) > 0:\n"
                                            "    __file__ = _flow_source_file_stack.pop()\n";
-        FLOW_CHECK_PYTHON_ERROR(py_interp, py_interp->run_script(file_stack_src));
+        FLOW_CHECK_PYTHON_ERROR(py_interp, py_interp->run_cached_script(file_stack_src,
+                                                                        py_global_dict));
     }
 
     // we need to incref b/c py_res is borrowed, and flow will decref
@@ -414,6 +458,19 @@ PythonScript::verify_params(const conduit::Node &params,
             }
         }
 
+        if( n_iface.has_child("view") )
+        {
+            if( !n_iface["view"].dtype().is_string() )
+            {
+                info["errors"].append() = "parameter 'interface/view' is not a string";
+                res = false;
+            }
+            else
+            {
+                info["info"].append().set("provides 'interface/view' function name override");
+            }
+        }
+
     }
 
     return res;
@@ -33,6 +33,7 @@
 #include <flow_graph.hpp>
 #include <flow_workspace.hpp>
 #include <flow_timer.hpp>
+#include <flow_trace.hpp>
 
 // filters
 #include <flow_filters.hpp>
@@ -172,6 +172,7 @@ PythonInterpreter::PythonInterpreter()
     m_py_trace_print_exception_func = NULL;
     m_py_sio_class = NULL;
 
+    m_script_cache_capacity = 64;
 }
 
 //-----------------------------------------------------------------------------
@@ -405,6 +406,7 @@ PythonInterpreter::reset()
 {
     if(m_running)
     {
+        clear_script_cache();
         // clean gloal dict.
         PyDict_Clear(m_py_global_dict);
     }
@@ -421,6 +423,8 @@ PythonInterpreter::shutdown()
 {
     if(m_running)
     {
+        clear_script_cache();
+
         if(m_handled_init)
         {
             Py_Finalize();
@@ -498,6 +502,115 @@ PythonInterpreter::run_script(const std::string &script,
     return res;
 }
 
+//-----------------------------------------------------------------------------
+///
+/// Executes passed python script in the interpreter, reusing the
+/// compiled code object if this exact script was run before.
+///
+//-----------------------------------------------------------------------------
+bool
+PythonInterpreter::run_cached_script(const std::string &script,
+                                     PyObject *py_dict,
+                                     const std::string &fname)
+{
+    bool res = false;
+    if(m_running)
+    {
+        if(m_echo)
+        {
+            CONDUIT_INFO("PythonInterpreter::run_cached_script " << script);
+        }
+
+        const std::string key = fname + "\n" + script;
+        PyObject *py_code = NULL;
+        std::map<std::string, PyObject*>::iterator itr = m_script_cache.find(key);
+        if(itr != m_script_cache.end())
+        {
+            py_code = itr->second;
+            // move to the front of the use order
+            std::list<std::string>::iterator order_itr;
+            for(order_itr = m_script_cache_order.begin();
+                order_itr != m_script_cache_order.end();
+                ++order_itr)
+            {
+                if(*order_itr == key)
+                {
+                    m_script_cache_order.splice(m_script_cache_order.begin(),
+                                                m_script_cache_order,
+                                                order_itr);
+                    break;
+                }
+            }
+        }
+        else
+        {
+            py_code = Py_CompileString(script.c_str(),
+                                       fname.c_str(),
+                                       Py_file_input);
+            if(py_code == NULL)
+            {
+                check_error();
+                return false;
+            }
+            m_script_cache[key] = py_code;
+            m_script_cache_order.push_front(key);
+            // scripts that change every execution (for example ones
+            // with generated values) would otherwise grow the cache
+            // without bound
+            trim_script_cache();
+        }
+
+#ifdef IS_PY3K
+        PyObject *py_res = PyEval_EvalCode(py_code, py_dict, py_dict);
+#else
+        PyObject *py_res = PyEval_EvalCode((PyCodeObject*)py_code,
+                                           py_dict,
+                                           py_dict);
+#endif
+        Py_XDECREF(py_res);
+        if(!check_error())
+            res = true;
+    }
+    return res;
+}
+
+//-----------------------------------------------------------------------------
+void
+PythonInterpreter::clear_script_cache()
+{
+    std::map<std::string, PyObject*>::iterator itr;
+    for(itr = m_script_cache.begin(); itr != m_script_cache.end(); ++itr)
+    {
+        Py_XDECREF(itr->second);
+    }
+    m_script_cache.clear();
+    m_script_cache_order.clear();
+}
+
+//-----------------------------------------------------------------------------
+void
+PythonInterpreter::set_script_cache_capacity(int capacity)
+{
+    // the script being run always stays cached
+    m_script_cache_capacity = capacity < 1 ? 1 : capacity;
+    trim_script_cache();
+}
+
+//-----------------------------------------------------------------------------
+void
+PythonInterpreter::trim_script_cache()
+{
+    // drop the least recently used scripts
+    while((int)m_script_cache_order.size() > m_script_cache_capacity)
+    {
+        std::map<std::string, PyObject*>::iterator itr
+            = m_script_cache.find(m_script_cache_order.back());
+        Py_XDECREF(itr->second);
+        m_script_cache.erase(itr);
+        m_script_cache_order.pop_back();
+    }
+}
+
 //-----------------------------------------------------------------------------
 ///
 /// Executes passed python script in the interpreter
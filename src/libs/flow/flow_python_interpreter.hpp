@@ -17,6 +17,8 @@
 #include <Python.h>
 
 #include <flow_exports.h>
+#include <list>
+#include <map>
 #include <string>
 #include <conduit.hpp>
 
@@ -73,6 +75,22 @@ public:
     bool         run_script_file(const std::string &fname,
                                  PyObject *py_dict);
 
+    /// script exec in specific dict, compiling each unique source
+    /// only once. Use for scripts that are executed repeatedly.
+    /// fname is used as the file name in tracebacks
+    bool         run_cached_script(const std::string &script,
+                                   PyObject *py_dict,
+                                   const std::string &fname = "<string>");
+    /// drops all cached compiled scripts
+    void         clear_script_cache();
+    /// max number of compiled scripts kept, the least recently
+    /// used script is dropped when a new one does not fit
+    void         set_script_cache_capacity(int capacity);
+    int          script_cache_capacity() const
+                    { return m_script_cache_capacity; }
+    int          script_cache_size() const
+                    { return (int)m_script_cache.size(); }
+
     /// set into global dict
     bool         set_global_object(PyObject *py_obj,
                                    const std::string &name);
@@ -109,6 +127,7 @@ private:
                                        PyObject *py_eval,
                                        PyObject *py_etrace,
                                        std::string &res);
+    void         trim_script_cache();
 
     bool         m_handled_init;
     bool         m_running;
@@ -124,6 +143,12 @@ private:
     PyObject    *m_py_trace_print_exception_func;
     PyObject    *m_py_sio_class;
 
+    // compiled code objects, keyed by file name + source
+    std::map<std::string, PyObject*> m_script_cache;
+    // cache keys, most recently used first
+    std::list<std::string>           m_script_cache_order;
+    int                              m_script_cache_capacity;
+
 };
 
 
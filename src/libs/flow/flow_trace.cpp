@@ -0,0 +1,611 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) Lawrence Livermore National Security, LLC and other Ascent
+// Project developers. See top-level LICENSE AND COPYRIGHT files for dates and
+// other details. No copyright assignment is required to contribute to Ascent.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+
+//-----------------------------------------------------------------------------
+///
+/// file: flow_trace.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "flow_trace.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+using namespace conduit;
+using namespace std;
+
+//-----------------------------------------------------------------------------
+// -- begin flow:: --
+//-----------------------------------------------------------------------------
+namespace flow
+{
+
+//-----------------------------------------------------------------------------
+// -- begin flow::detail --
+//-----------------------------------------------------------------------------
+namespace detail
+{
+
+enum TraceEventType : uint8_t
+{
+    TRACE_BEGIN,
+    TRACE_END,
+    TRACE_VALUE,
+    TRACE_TEXT
+};
+
+struct TraceEvent
+{
+    uint64_t time_ns;
+    double   value;
+    // interned name, and interned text for TRACE_TEXT
+    uint32_t name;
+    uint32_t text;
+    uint32_t thread;
+    uint8_t  type;
+};
+
+struct TraceRegionStats
+{
+    index_t count = 0;
+    double  total = 0.0;
+    double  min   = 0.0;
+    double  max   = 0.0;
+};
+
+struct TraceOpenRegion
+{
+    uint32_t name;
+    uint32_t path;
+    uint64_t start_ns;
+};
+
+// everything a thread needs to record without taking the global lock,
+// string ids are interned globally and cached here
+struct TraceThreadState
+{
+    uint64_t generation = 0;
+    uint32_t id = 0;
+    vector<TraceOpenRegion> stack;
+    unordered_map<string, uint32_t> names;
+    // (parent path, name) -> path
+    unordered_map<uint64_t, uint32_t> paths;
+    unordered_map<uint32_t, TraceRegionStats> stats;
+};
+
+struct TraceState
+{
+    atomic<bool>     enabled;
+    // bumped by clear(), thread states of older generations are dropped
+    atomic<uint64_t> generation;
+    atomic<uint64_t> next;
+    vector<TraceEvent> events;
+    int rank;
+    chrono::steady_clock::time_point epoch;
+
+    mutex strings_mutex;
+    unordered_map<string, uint32_t> ids;
+    vector<string> strings;
+
+    mutex threads_mutex;
+    vector<shared_ptr<TraceThreadState>> threads;
+
+    mutex users_mutex;
+    index_t users;
+    index_t sessions;
+
+    TraceState()
+    : enabled(false),
+      generation(1),
+      next(0),
+      events(1 << 16),
+      rank(0),
+      epoch(chrono::steady_clock::now()),
+      users(0),
+      sessions(0)
+    {}
+};
+
+const uint32_t TRACE_NO_PATH = 0xffffffff;
+
+TraceState &
+trace_state()
+{
+    static TraceState state;
+    return state;
+}
+
+uint32_t
+intern(const string &value)
+{
+    TraceState &state = trace_state();
+    lock_guard<mutex> lock(state.strings_mutex);
+    auto it = state.ids.find(value);
+    if(it != state.ids.end())
+    {
+        return it->second;
+    }
+    const uint32_t id = (uint32_t) state.strings.size();
+    state.strings.push_back(value);
+    state.ids[value] = id;
+    return id;
+}
+
+string
+lookup(const uint32_t id)
+{
+    TraceState &state = trace_state();
+    lock_guard<mutex> lock(state.strings_mutex);
+    return id < state.strings.size() ? state.strings[id] : string();
+}
+
+TraceThreadState &
+thread_state()
+{
+    thread_local shared_ptr<TraceThreadState> thread;
+    TraceState &state = trace_state();
+    const uint64_t generation = state.generation.load(memory_order_acquire);
+    if(!thread || thread->generation != generation)
+    {
+        thread = make_shared<TraceThreadState>();
+        thread->generation = generation;
+        lock_guard<mutex> lock(state.threads_mutex);
+        thread->id = (uint32_t) state.threads.size();
+        state.threads.push_back(thread);
+    }
+    return *thread;
+}
+
+uint32_t
+thread_intern(TraceThreadState &thread, const string &value)
+{
+    auto it = thread.names.find(value);
+    if(it != thread.names.end())
+    {
+        return it->second;
+    }
+    const uint32_t id = intern(value);
+    thread.names[value] = id;
+    return id;
+}
+
+uint32_t
+thread_path(TraceThreadState &thread,
+            const uint32_t parent,
+            const uint32_t name)
+{
+    const uint64_t key = (uint64_t(parent) << 32) | name;
+    auto it = thread.paths.find(key);
+    if(it != thread.paths.end())
+    {
+        return it->second;
+    }
+    string path = lookup(name);
+    if(parent != TRACE_NO_PATH)
+    {
+        path = lookup(parent) + "/" + path;
+    }
+    const uint32_t id = intern(path);
+    thread.paths[key] = id;
+    return id;
+}
+
+uint64_t
+now_ns()
+{
+    return (uint64_t) chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now() - trace_state().epoch).count();
+}
+
+void
+record(const TraceEventType type,
+       const uint32_t name,
+       const uint32_t text,
+       const double value,
+       const uint32_t thread,
+       const uint64_t time_ns)
+{
+    TraceState &state = trace_state();
+    const uint64_t slot = state.next.fetch_add(1, memory_order_relaxed);
+    TraceEvent &event = state.events[slot % state.events.size()];
+    event.time_ns = time_ns;
+    event.value   = value;
+    event.name    = name;
+    event.text    = text;
+    event.thread  = thread;
+    event.type    = type;
+}
+
+void
+write_json_string(ostream &os, const string &value)
+{
+    os << '"';
+    for(const char c : value)
+    {
+        switch(c)
+        {
+            case '"':  os << "\\\""; break;
+            case '\\': os << "\\\\"; break;
+            case '\n': os << "\\n";  break;
+            case '\t': os << "\\t";  break;
+            case '\r': os << "\\r";  break;
+            default:
+                if((unsigned char) c < 0x20)
+                {
+                    os << "\\u" << hex << setw(4) << setfill('0')
+                       << (int) c << dec << setfill(' ');
+                }
+                else
+                {
+                    os << c;
+                }
+        }
+    }
+    os << '"';
+}
+
+};
+//-----------------------------------------------------------------------------
+// -- end flow::detail --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+Trace::enable(bool enabled)
+{
+    detail::trace_state().enabled.store(enabled, memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+bool
+Trace::enabled()
+{
+    return detail::trace_state().enabled.load(memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+void
+Trace::acquire(index_t num_events)
+{
+    detail::TraceState &state = detail::trace_state();
+    lock_guard<mutex> lock(state.users_mutex);
+    if(state.users == 0)
+    {
+        enable(false);
+        set_capacity(num_events);
+        state.sessions++;
+        enable(true);
+    }
+    state.users++;
+}
+
+//-----------------------------------------------------------------------------
+bool
+Trace::release()
+{
+    detail::TraceState &state = detail::trace_state();
+    lock_guard<mutex> lock(state.users_mutex);
+    if(state.users == 0)
+    {
+        return false;
+    }
+    state.users--;
+    if(state.users > 0)
+    {
+        return false;
+    }
+    enable(false);
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+index_t
+Trace::sessions()
+{
+    detail::TraceState &state = detail::trace_state();
+    lock_guard<mutex> lock(state.users_mutex);
+    return state.sessions;
+}
+
+//-----------------------------------------------------------------------------
+void
+Trace::set_capacity(index_t num_events)
+{
+    if(enabled())
+    {
+        // other threads may be writing into the buffer
+        return;
+    }
+    detail::TraceState &state = detail::trace_state();
+    const size_t size = (size_t) std::max(num_events, (index_t) 1);
+    if(state.events.size() != size)
+    {
+        state.events.assign(size, detail::TraceEvent());
+    }
+    clear();
+}
+
+//-----------------------------------------------------------------------------
+index_t
+Trace::capacity()
+{
+    return (index_t) detail::trace_state().events.size();
+}
+
+//-----------------------------------------------------------------------------
+void
+Trace::set_rank(int rank)
+{
+    detail::trace_state().rank = rank;
+}
+
+//-----------------------------------------------------------------------------
+void
+Trace::clear()
+{
+    detail::TraceState &state = detail::trace_state();
+    {
+        lock_guard<mutex> lock(state.threads_mutex);
+        state.threads.clear();
+    }
+    {
+        lock_guard<mutex> lock(state.strings_mutex);
+        state.ids.clear();
+        state.strings.clear();
+    }
+    state.next.store(0);
+    state.epoch = chrono::steady_clock::now();
+    state.generation.fetch_add(1, memory_order_release);
+}
+
+//-----------------------------------------------------------------------------
+void
+Trace::begin(const std::string &name)
+{
+    if(!enabled())
+    {
+        return;
+    }
+    detail::TraceThreadState &thread = detail::thread_state();
+    const uint64_t now = detail::now_ns();
+    const uint32_t name_id = detail::thread_intern(thread, name);
+    const uint32_t parent = thread.stack.empty() ? detail::TRACE_NO_PATH
+                                                 : thread.stack.back().path;
+    const uint32_t path = detail::thread_path(thread, parent, name_id);
+    thread.stack.push_back({name_id, path, now});
+    detail::record(detail::TRACE_BEGIN, name_id, 0, 0.0, thread.id, now);
+}
+
+//-----------------------------------------------------------------------------
+void
+Trace::end()
+{
+    if(!enabled())
+    {
+        return;
+    }
+    detail::TraceThreadState &thread = detail::thread_state();
+    if(thread.stack.empty())
+    {
+        // opened before the trace was enabled or cleared
+        return;
+    }
+    const uint64_t now = detail::now_ns();
+    const detail::TraceOpenRegion region = thread.stack.back();
+    thread.stack.pop_back();
+
+    const double seconds = double(now - region.start_ns) * 1e-9;
+    detail::TraceRegionStats &stats = thread.stats[region.path];
+    if(stats.count == 0)
+    {
+        stats.min = seconds;
+        stats.max = seconds;
+    }
+    else
+    {
+        stats.min = std::min(stats.min, seconds);
+        stats.max = std::max(stats.max, seconds);
+    }
+    stats.count++;
+    stats.total += seconds;
+
+    detail::record(detail::TRACE_END, region.name, 0, 0.0, thread.id, now);
+}
+
+//-----------------------------------------------------------------------------
+void
+Trace::value(const std::string &name, double value)
+{
+    if(!enabled())
+    {
+        return;
+    }
+    detail::TraceThreadState &thread = detail::thread_state();
+    detail::record(detail::TRACE_VALUE,
+                   detail::thread_intern(thread, name),
+                   0,
+                   value,
+                   thread.id,
+                   detail::now_ns());
+}
+
+//-----------------------------------------------------------------------------
+void
+Trace::text(const std::string &name, const std::string &value)
+{
+    if(!enabled())
+    {
+        return;
+    }
+    detail::TraceThreadState &thread = detail::thread_state();
+    detail::record(detail::TRACE_TEXT,
+                   detail::thread_intern(thread, name),
+                   detail::thread_intern(thread, value),
+                   0.0,
+                   thread.id,
+                   detail::now_ns());
+}
+
+//-----------------------------------------------------------------------------
+index_t
+Trace::dropped()
+{
+    detail::TraceState &state = detail::trace_state();
+    const uint64_t next = state.next.load();
+    const uint64_t cap  = state.events.size();
+    return next > cap ? (index_t)(next - cap) : 0;
+}
+
+//-----------------------------------------------------------------------------
+void
+Trace::write_chrome_trace(const std::string &file_name)
+{
+    detail::TraceState &state = detail::trace_state();
+    ofstream os(file_name.c_str());
+    if(!os.is_open())
+    {
+        CONDUIT_ERROR("Trace: failed to open '" << file_name << "'");
+    }
+
+    vector<string> strings;
+    {
+        lock_guard<mutex> lock(state.strings_mutex);
+        strings = state.strings;
+    }
+
+    const int pid = state.rank;
+    os << "{\"traceEvents\":[\n";
+    os << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid
+       << ",\"args\":{\"name\":\"rank " << pid << "\"}}";
+
+    const uint64_t next  = state.next.load();
+    const uint64_t cap   = state.events.size();
+    const uint64_t first = next > cap ? next - cap : 0;
+    os << std::fixed << std::setprecision(3);
+    // regions open per thread, once the buffer wrapped the oldest ends
+    // may have lost their begin
+    unordered_map<uint32_t, index_t> open;
+    for(uint64_t i = first; i < next; ++i)
+    {
+        const detail::TraceEvent &event = state.events[i % cap];
+        if(event.type == detail::TRACE_BEGIN)
+        {
+            open[event.thread]++;
+        }
+        else if(event.type == detail::TRACE_END)
+        {
+            index_t &depth = open[event.thread];
+            if(depth == 0)
+            {
+                continue;
+            }
+            depth--;
+        }
+        os << ",\n{\"name\":";
+        detail::write_json_string(os, strings[event.name]);
+        os << ",\"ts\":" << double(event.time_ns) * 1e-3
+           << ",\"pid\":" << pid
+           << ",\"tid\":" << event.thread;
+        switch(event.type)
+        {
+            case detail::TRACE_BEGIN:
+                os << ",\"ph\":\"B\"}";
+                break;
+            case detail::TRACE_END:
+                os << ",\"ph\":\"E\"}";
+                break;
+            case detail::TRACE_VALUE:
+                os << ",\"ph\":\"C\",\"args\":{\"value\":"
+                   << std::setprecision(17) << event.value
+                   << std::setprecision(3) << "}}";
+                break;
+            default:
+                os << ",\"ph\":\"i\",\"s\":\"t\",\"args\":{\"value\":";
+                detail::write_json_string(os, strings[event.text]);
+                os << "}}";
+        }
+    }
+    os << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped\":"
+       << dropped() << "}}\n";
+}
+
+//-----------------------------------------------------------------------------
+void
+Trace::summary(conduit::Node &out)
+{
+    detail::TraceState &state = detail::trace_state();
+    out.reset();
+
+    // merge the statistics of all threads by path
+    std::map<string, detail::TraceRegionStats> merged;
+    {
+        lock_guard<mutex> lock(state.threads_mutex);
+        for(const auto &thread : state.threads)
+        {
+            for(const auto &entry : thread->stats)
+            {
+                const detail::TraceRegionStats &stats = entry.second;
+                detail::TraceRegionStats &res =
+                    merged[detail::lookup(entry.first)];
+                if(res.count == 0)
+                {
+                    res = stats;
+                    continue;
+                }
+                res.count += stats.count;
+                res.total += stats.total;
+                res.min = std::min(res.min, stats.min);
+                res.max = std::max(res.max, stats.max);
+            }
+        }
+    }
+
+    for(const auto &entry : merged)
+    {
+        // paths contain '/', don't let conduit build a hierarchy
+        Node &region = out.add_child(entry.first);
+        region["count"] = (int64) entry.second.count;
+        region["total"] = entry.second.total;
+        region["min"]   = entry.second.min;
+        region["max"]   = entry.second.max;
+    }
+}
+
+//-----------------------------------------------------------------------------
+TraceRegion::TraceRegion(const std::string &name)
+: m_active(Trace::enabled())
+{
+    if(m_active)
+    {
+        Trace::begin(name);
+    }
+}
+
+//-----------------------------------------------------------------------------
+TraceRegion::~TraceRegion()
+{
+    if(m_active)
+    {
+        Trace::end();
+    }
+}
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end flow:: --
+//-----------------------------------------------------------------------------
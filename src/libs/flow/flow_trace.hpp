@@ -0,0 +1,111 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) Lawrence Livermore National Security, LLC and other Ascent
+// Project developers. See top-level LICENSE AND COPYRIGHT files for dates and
+// other details. No copyright assignment is required to contribute to Ascent.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+
+//-----------------------------------------------------------------------------
+///
+/// file: flow_trace.hpp
+///
+//-----------------------------------------------------------------------------
+
+#ifndef FLOW_TRACE_HPP
+#define FLOW_TRACE_HPP
+
+#include <conduit.hpp>
+#include <flow_exports.h>
+
+#include <string>
+
+//-----------------------------------------------------------------------------
+// -- begin flow:: --
+//-----------------------------------------------------------------------------
+namespace flow
+{
+
+//-----------------------------------------------------------------------------
+///
+/// Process wide trace recorder.
+///
+/// Regions (begin/end pairs), values and text annotations are recorded as
+/// fixed size binary events in a ring buffer; when the buffer is full the
+/// oldest events are overwritten. Every thread keeps its own region stack
+/// and per region statistics, so the summary is complete even when the
+/// buffer wrapped. Recording is a no-op while the trace is disabled.
+///
+/// The events can be exported as Chrome trace json (chrome://tracing,
+/// https://ui.perfetto.dev), the summary as a conduit node.
+///
+//-----------------------------------------------------------------------------
+class FLOW_API Trace
+{
+public:
+    /// turns recording on or off, events are kept
+    static void     enable(bool enabled);
+    static bool     enabled();
+    /// reference counted enable for independent users of the trace (e.g.
+    /// several Ascent instances). The first user starts an empty trace with
+    /// the given capacity, later users join it as is
+    static void     acquire(conduit::index_t num_events);
+    /// drops a reference. The last user turns recording off and gets true
+    /// back, it is the one that should export and clear the trace
+    static bool     release();
+    /// number of traces started by acquire() so far
+    static conduit::index_t sessions();
+    /// number of events in the ring buffer, clears the trace. Ignored while
+    /// recording
+    static void     set_capacity(conduit::index_t num_events);
+    static conduit::index_t capacity();
+    /// used as the process id of exported events
+    static void     set_rank(int rank);
+    /// drops all events and statistics
+    static void     clear();
+
+    /// opens a region on the calling thread
+    static void     begin(const std::string &name);
+    /// closes the innermost open region of the calling thread
+    static void     end();
+    /// records a counter value
+    static void     value(const std::string &name, double value);
+    /// records a text annotation
+    static void     text(const std::string &name, const std::string &value);
+
+    /// number of events overwritten since the last clear
+    static conduit::index_t dropped();
+
+    /// writes the events in the buffer as chrome trace json. Ends whose
+    /// begin was overwritten are left out. Call while no thread is recording
+    static void     write_chrome_trace(const std::string &file_name);
+
+    /// per region statistics of all threads:
+    ///   out[name]/{count, total, min, max} (seconds)
+    /// regions are named by their full path (outer/inner). Call while no
+    /// thread is recording
+    static void     summary(conduit::Node &out);
+};
+
+//-----------------------------------------------------------------------------
+/// opens a region on construction and closes it on destruction
+class FLOW_API TraceRegion
+{
+public:
+    explicit TraceRegion(const std::string &name);
+            ~TraceRegion();
+private:
+    bool m_active;
+};
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end flow:: --
+//-----------------------------------------------------------------------------
+
+
+
+#endif
+//-----------------------------------------------------------------------------
+// -- end header ifdef guard
+//-----------------------------------------------------------------------------
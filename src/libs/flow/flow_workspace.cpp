@@ -13,12 +13,14 @@
 
 #include "flow_workspace.hpp"
 #include "flow_timer.hpp"
+#include "flow_trace.hpp"
 
 // standard lib includes
 #include <iostream>
 #include <string.h>
 #include <limits.h>
 #include <cstdlib>
+#include <algorithm>
 
 using namespace conduit;
 using namespace std;
@@ -34,7 +36,9 @@ namespace flow
 // pick a safe non-inited value w/o the mpi headers, but
 // we will try this strategy.
 int Workspace::m_default_mpi_comm = -1;
+MemoryProbeMethod Workspace::m_memory_probe = NULL;
 static int g_timing_exec_count = 0;
+static int g_memory_exec_count = 0;
 
 //-----------------------------------------------------------------------------
 class Workspace::ExecutionPlan
@@ -210,12 +214,27 @@ Workspace::ExecutionPlan::bf_topo_sort_visit(Graph &graph,
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+MemoryUsage::MemoryUsage()
+: host_current(0),
+  device_current(0),
+  host_peak(0),
+  device_peak(0),
+  allocated(0)
+{
+
+}
+
 //-----------------------------------------------------------------------------
 Workspace::Workspace()
 :m_graph(this),
  m_registry(),
  m_timing_info(),
- m_enable_timings(false)
+ m_enable_timings(false),
+ m_memory_info(),
+ m_enable_memory_info(false),
+ m_last_memory_usage(),
+ m_last_timing_info()
 {
 
 }
@@ -267,7 +286,21 @@ Workspace::traversals(Node &traversals)
 void
 Workspace::execute()
 {
+    TraceRegion trace_exec("execute");
     Timer t_total_exec;
+    const bool record_memory = m_enable_memory_info && m_memory_probe != NULL;
+    MemoryUsage mem_start, mem_total;
+    if(record_memory)
+    {
+        m_memory_probe(true, mem_start);
+        mem_total = mem_start;
+    }
+
+    if(m_enable_timings)
+    {
+        m_last_timing_info.reset();
+    }
+
     Node traversals;
     ExecutionPlan::generate(graph(),traversals);
     // execute traversals
@@ -298,16 +331,47 @@ Workspace::execute()
                 f->set_input(port_name,&registry().fetch(f_input_name));
             }
 
+            MemoryUsage mem_before, mem_after;
+            if(record_memory)
+            {
+                // peaks are measured per filter
+                m_memory_probe(true, mem_before);
+            }
+
             Timer t_flt_exec;
             // execute
-            f->execute();
+            {
+                TraceRegion trace_flt(f->name());
+                f->execute();
+            }
 
             if(m_enable_timings)
             {
+                const float elapsed = t_flt_exec.elapsed();
                 m_timing_info << g_timing_exec_count
                               << " " << f->name()
-                              << " " << std::fixed << t_flt_exec.elapsed()
+                              << " " << std::fixed << elapsed
                               <<"\n";
+                // filter names may contain '/'
+                m_last_timing_info["filters"].add_child(f->name()) =
+                    (float64) elapsed;
+            }
+
+            if(record_memory)
+            {
+                m_memory_probe(false, mem_after);
+                m_memory_info << g_memory_exec_count
+                              << " " << f->name()
+                              << " " << mem_after.allocated - mem_before.allocated
+                              << " " << mem_after.host_peak
+                              << " " << mem_after.device_peak
+                              << " " << mem_after.host_current
+                              << " " << mem_after.device_current
+                              << "\n";
+                mem_total.host_peak = std::max(mem_total.host_peak,
+                                               mem_after.host_peak);
+                mem_total.device_peak = std::max(mem_total.device_peak,
+                                                 mem_after.device_peak);
             }
 
             // if has output, set output
@@ -338,14 +402,37 @@ Workspace::execute()
 
     if(m_enable_timings)
     {
+        const float elapsed = t_total_exec.elapsed();
         m_timing_info << g_timing_exec_count
                       << " [total] "
-                      << std::fixed << t_total_exec.elapsed()
+                      << std::fixed << elapsed
                       <<"\n";
         g_timing_exec_count++;
+        m_last_timing_info["total"] = (float64) elapsed;
     }
 
-
+    if(record_memory)
+    {
+        MemoryUsage mem_end;
+        m_memory_probe(false, mem_end);
+        const size_t allocated = mem_end.allocated - mem_start.allocated;
+        m_memory_info << g_memory_exec_count
+                      << " [total] "
+                      << allocated
+                      << " " << mem_total.host_peak
+                      << " " << mem_total.device_peak
+                      << " " << mem_end.host_current
+                      << " " << mem_end.device_current
+                      << "\n";
+        g_memory_exec_count++;
+
+        m_last_memory_usage.reset();
+        m_last_memory_usage["allocated"] = (uint64) allocated;
+        m_last_memory_usage["host_peak"] = (uint64) mem_total.host_peak;
+        m_last_memory_usage["device_peak"] = (uint64) mem_total.device_peak;
+        m_last_memory_usage["host_resident"] = (uint64) mem_end.host_current;
+        m_last_memory_usage["device_resident"] = (uint64) mem_end.device_current;
+    }
 
 }
 //-----------------------------------------------------------------------------
@@ -355,6 +442,19 @@ void Workspace::enable_timings(bool enabled)
   m_enable_timings = enabled;
 }
 
+//-----------------------------------------------------------------------------
+void Workspace::enable_memory_info(bool enabled)
+{
+  m_enable_memory_info = enabled;
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::set_memory_probe(MemoryProbeMethod probe)
+{
+    m_memory_probe = probe;
+}
+
 //-----------------------------------------------------------------------------
 void
 Workspace::reset()
@@ -373,6 +473,10 @@ Workspace::info(Node &out) const
     graph().info(out["graph"]);
     registry().info(out["registry"]);
     out["timings"] = timing_info();
+    if(m_enable_memory_info)
+    {
+        out["memory"] = memory_info();
+    }
 }
 
 
@@ -412,6 +516,7 @@ Workspace::reset_timing_info()
 {
     g_timing_exec_count = 0;
     m_timing_info.str("");
+    m_last_timing_info.reset();
 }
 //-----------------------------------------------------------------------------
 string
@@ -420,6 +525,36 @@ Workspace::timing_info() const
     return m_timing_info.str();
 }
 
+//-----------------------------------------------------------------------------
+void
+Workspace::last_timing_info(Node &out) const
+{
+    out.set(m_last_timing_info);
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::reset_memory_info()
+{
+    g_memory_exec_count = 0;
+    m_memory_info.str("");
+    m_last_memory_usage.reset();
+}
+
+//-----------------------------------------------------------------------------
+string
+Workspace::memory_info() const
+{
+    return m_memory_info.str();
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::last_memory_usage(Node &out) const
+{
+    out.set(m_last_memory_usage);
+}
+
 //-----------------------------------------------------------------------------
 Filter *
 Workspace::create_filter(const std::string &filter_type_name)
@@ -36,6 +36,27 @@ namespace flow
 ///
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+/// Memory usage sampled around each filter execution.
+//-----------------------------------------------------------------------------
+struct FLOW_API MemoryUsage
+{
+    MemoryUsage();
+
+    /// bytes currently resident
+    size_t host_current;
+    size_t device_current;
+    /// peak resident bytes since the peak was last reset
+    size_t host_peak;
+    size_t device_peak;
+    /// total bytes allocated so far
+    size_t allocated;
+};
+
+/// fills out the current usage, and resets the peaks to the current
+/// usage afterwards when reset_peak is true
+typedef void (*MemoryProbeMethod)(bool reset_peak, MemoryUsage &usage);
+
 //-----------------------------------------------------------------------------
 class FLOW_API Workspace
 {
@@ -83,6 +104,23 @@ public:
     void           reset_timing_info();
     /// return a string of recorded timing events
     std::string    timing_info() const;
+    /// seconds spent in each filter (under "filters") and in total by the
+    /// last execute
+    void           last_timing_info(conduit::Node &out) const;
+
+    /// resets state used to capture memory events
+    void           reset_memory_info();
+    /// return a string of recorded memory events, one line per filter
+    /// execution:
+    ///  exec_count filter_name allocated_bytes host_peak device_peak
+    ///             host_resident device_resident
+    std::string    memory_info() const;
+    /// peaks and allocation volume of the last execute
+    void           last_memory_usage(conduit::Node &out) const;
+
+    /// set the method used to sample memory usage. Without one, no memory
+    /// events are recorded
+    static void    set_memory_probe(MemoryProbeMethod probe);
 
     // ------------------------------------------------------------------------
     /// Interface to set and obtain the MPI communicator.
@@ -144,12 +182,14 @@ public:
     }
 
     void enable_timings(bool enabled);
+    void enable_memory_info(bool enabled);
 
 private:
 
     static Filter *create_filter(const std::string &filter_type);
 
     static int  m_default_mpi_comm;
+    static MemoryProbeMethod m_memory_probe;
 
     class ExecutionPlan;
     class FilterFactory;
@@ -158,6 +198,10 @@ private:
     Registry          m_registry;
     std::stringstream m_timing_info;
     bool              m_enable_timings;
+    std::stringstream m_memory_info;
+    bool              m_enable_memory_info;
+    conduit::Node     m_last_memory_usage;
+    conduit::Node     m_last_timing_info;
 
 };
 
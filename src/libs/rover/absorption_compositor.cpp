@@ -0,0 +1,210 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) Lawrence Livermore National Security, LLC and other Ascent
+// Project developers. See top-level LICENSE AND COPYRIGHT files for dates and
+// other details. No copyright assignment is required to contribute to Ascent.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#include <algorithm>
+#include <limits>
+
+#include <absorption_compositor.hpp>
+
+#ifdef ROVER_PARALLEL
+#include <mpi.h>
+#endif
+
+namespace rover {
+
+namespace detail
+{
+#ifdef ROVER_PARALLEL
+template<typename FloatType> MPI_Datatype mpi_float_type();
+template<> MPI_Datatype mpi_float_type<vtkm::Float32>() { return MPI_FLOAT; }
+template<> MPI_Datatype mpi_float_type<vtkm::Float64>() { return MPI_DOUBLE; }
+#endif
+} // namespace detail
+
+template<typename FloatType>
+AbsorptionCompositor<FloatType>::AbsorptionCompositor()
+  : m_mpi_comm_id(0),
+    m_reduce_scatter_min_channels(16),
+    m_max_reduce_values(1ll << 24)
+{
+}
+
+template<typename FloatType>
+void
+AbsorptionCompositor<FloatType>::set_comm_handle(int mpi_comm_id)
+{
+  m_mpi_comm_id = mpi_comm_id;
+}
+
+template<typename FloatType>
+void
+AbsorptionCompositor<FloatType>::set_reduce_scatter_min_channels(int num_channels)
+{
+  m_reduce_scatter_min_channels = num_channels;
+}
+
+template<typename FloatType>
+void
+AbsorptionCompositor<FloatType>::set_max_reduce_values(long long num_values)
+{
+  m_max_reduce_values = std::max(1ll, num_values);
+}
+
+template<typename FloatType>
+void
+AbsorptionCompositor<FloatType>::composite(std::vector<vtkh::AbsorptionPartial<FloatType>> &partials,
+                                           const int num_pixels,
+                                           const int num_bins,
+                                           std::vector<vtkh::AbsorptionPartial<FloatType>> &result)
+{
+  int rank = 0;
+  int procs = 1;
+#ifdef ROVER_PARALLEL
+  MPI_Comm comm = MPI_Comm_f2c(m_mpi_comm_id);
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &procs);
+#endif
+  const bool reduce_scatter = procs > 1 &&
+                              num_bins >= m_reduce_scatter_min_channels;
+
+  result.clear();
+  if(num_pixels <= 0 || num_bins <= 0)
+  {
+    return;
+  }
+
+  // sorted by pixel so each chunk only touches a contiguous range
+  std::sort(partials.begin(), partials.end());
+  const int num_partials = static_cast<int>(partials.size());
+
+  // chunk size is a multiple of procs so it splits evenly
+  int chunk_pixels = static_cast<int>(std::max(1ll, m_max_reduce_values / num_bins));
+  chunk_pixels = std::max(procs, (chunk_pixels / procs) * procs);
+  chunk_pixels = std::min(chunk_pixels, num_pixels);
+
+  const double no_hit = std::numeric_limits<double>::max();
+  std::vector<FloatType> bins;
+  std::vector<double> depths;
+
+  int partial_index = 0;
+  for(int chunk_start = 0; chunk_start < num_pixels; chunk_start += chunk_pixels)
+  {
+    const int chunk_size = std::min(chunk_pixels, num_pixels - chunk_start);
+    bins.assign(static_cast<size_t>(chunk_size) * num_bins, FloatType(1));
+    depths.assign(chunk_size, no_hit);
+
+    while(partial_index < num_partials &&
+          partials[partial_index].m_pixel_id < chunk_start + chunk_size)
+    {
+      const vtkh::AbsorptionPartial<FloatType> &partial = partials[partial_index];
+      const int pixel = partial.m_pixel_id - chunk_start;
+      FloatType *pixel_bins = &bins[static_cast<size_t>(pixel) * num_bins];
+      for(int b = 0; b < num_bins; ++b)
+      {
+        pixel_bins[b] *= partial.m_bins[b];
+      }
+      depths[pixel] = std::min(depths[pixel], partial.m_depth);
+      ++partial_index;
+    }
+
+#ifdef ROVER_PARALLEL
+    MPI_Datatype float_type = detail::mpi_float_type<FloatType>();
+    if(reduce_scatter)
+    {
+      // each rank reduces a slice of the chunk and rank 0 gathers
+      // the slices. The last rank takes the remainder.
+      std::vector<int> pixel_counts(procs, chunk_size / procs);
+      pixel_counts[procs - 1] += chunk_size % procs;
+      std::vector<int> bin_counts(procs);
+      std::vector<int> pixel_offsets(procs, 0);
+      std::vector<int> bin_offsets(procs, 0);
+      for(int p = 0; p < procs; ++p)
+      {
+        bin_counts[p] = pixel_counts[p] * num_bins;
+        if(p > 0)
+        {
+          pixel_offsets[p] = pixel_offsets[p - 1] + pixel_counts[p - 1];
+          bin_offsets[p] = bin_offsets[p - 1] + bin_counts[p - 1];
+        }
+      }
+
+      std::vector<FloatType> slice_bins(bin_counts[rank]);
+      std::vector<double> slice_depths(pixel_counts[rank]);
+      MPI_Reduce_scatter(bins.data(),
+                         slice_bins.data(),
+                         bin_counts.data(),
+                         float_type,
+                         MPI_PROD,
+                         comm);
+      MPI_Reduce_scatter(depths.data(),
+                         slice_depths.data(),
+                         pixel_counts.data(),
+                         MPI_DOUBLE,
+                         MPI_MIN,
+                         comm);
+
+      MPI_Gatherv(slice_bins.data(),
+                  bin_counts[rank],
+                  float_type,
+                  bins.data(),
+                  bin_counts.data(),
+                  bin_offsets.data(),
+                  float_type,
+                  0,
+                  comm);
+      MPI_Gatherv(slice_depths.data(),
+                  pixel_counts[rank],
+                  MPI_DOUBLE,
+                  depths.data(),
+                  pixel_counts.data(),
+                  pixel_offsets.data(),
+                  MPI_DOUBLE,
+                  0,
+                  comm);
+    }
+    else if(procs > 1)
+    {
+      if(rank == 0)
+      {
+        MPI_Reduce(MPI_IN_PLACE, bins.data(), static_cast<int>(bins.size()),
+                   float_type, MPI_PROD, 0, comm);
+        MPI_Reduce(MPI_IN_PLACE, depths.data(), chunk_size,
+                   MPI_DOUBLE, MPI_MIN, 0, comm);
+      }
+      else
+      {
+        MPI_Reduce(bins.data(), NULL, static_cast<int>(bins.size()),
+                   float_type, MPI_PROD, 0, comm);
+        MPI_Reduce(depths.data(), NULL, chunk_size,
+                   MPI_DOUBLE, MPI_MIN, 0, comm);
+      }
+    }
+#endif
+
+    if(rank == 0)
+    {
+      // keep only pixels that some ray reached
+      for(int i = 0; i < chunk_size; ++i)
+      {
+        if(depths[i] == no_hit)
+        {
+          continue;
+        }
+        vtkh::AbsorptionPartial<FloatType> pixel;
+        pixel.m_pixel_id = chunk_start + i;
+        pixel.m_depth = depths[i];
+        pixel.m_bins.assign(bins.begin() + static_cast<size_t>(i) * num_bins,
+                            bins.begin() + static_cast<size_t>(i + 1) * num_bins);
+        result.push_back(pixel);
+      }
+    }
+  }
+}
+
+template class AbsorptionCompositor<vtkm::Float32>;
+template class AbsorptionCompositor<vtkm::Float64>;
+
+}; // namespace rover
@@ -0,0 +1,53 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) Lawrence Livermore National Security, LLC and other Ascent
+// Project developers. See top-level LICENSE AND COPYRIGHT files for dates and
+// other details. No copyright assignment is required to contribute to Ascent.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#ifndef rover_absorption_compositor_h
+#define rover_absorption_compositor_h
+
+#include <vector>
+
+#include <rover_exports.h>
+#include <vtkh/compositing/AbsorptionPartial.hpp>
+
+namespace rover
+{
+
+//
+// Absorption only partials can be blended in any order, so instead
+// of exchanging and depth sorting partials we multiply them into a
+// dense per pixel transmission buffer and reduce that with a product.
+// Pixels are reduced in chunks to bound memory, and with many channels
+// each chunk is reduce-scattered across ranks and gathered on rank 0.
+//
+template<typename FloatType>
+class ROVER_API AbsorptionCompositor
+{
+public:
+  AbsorptionCompositor();
+
+  // fortran handle of the communicator, ignored in serial builds
+  void set_comm_handle(int mpi_comm_id);
+  // channel count from which chunks are reduce-scattered
+  void set_reduce_scatter_min_channels(int num_channels);
+  // upper bound on the number of values reduced at once
+  void set_max_reduce_values(long long num_values);
+
+  // Multiplies the partials of all ranks into one partial per pixel
+  // that any of them reached. The result is only valid on rank 0, and
+  // is empty if no rank had a partial. The local partials are sorted
+  // by pixel id in place.
+  void composite(std::vector<vtkh::AbsorptionPartial<FloatType>> &partials,
+                 const int num_pixels,
+                 const int num_bins,
+                 std::vector<vtkh::AbsorptionPartial<FloatType>> &result);
+protected:
+  int       m_mpi_comm_id;
+  int       m_reduce_scatter_min_channels;
+  long long m_max_reduce_values;
+};
+
+}; // namespace rover
+#endif
@@ -188,7 +188,9 @@ struct PartialImage
     m_width = width;
     m_height = height;
     const int size = static_cast<int>(partials.size());
-    const int num_bins = static_cast<int>(partials.at(0).m_bins.size());
+    // with no partials every pixel is background, one bin per channel
+    const int num_bins = size > 0 ? static_cast<int>(partials[0].m_bins.size())
+                                  : static_cast<int>(background.size());
     allocate(size,num_bins);
 
     auto id_portal = m_pixel_ids.WritePortal();
@@ -226,7 +228,8 @@ struct PartialImage
     m_width = width;
     m_height = height;
     const int size = static_cast<int>(partials.size());
-    const int num_bins = static_cast<int>(partials.at(0).m_bins.size());
+    const int num_bins = size > 0 ? static_cast<int>(partials[0].m_bins.size())
+                                  : static_cast<int>(background.size());
     allocate(size,num_bins);
 
     auto id_portal = m_pixel_ids.WritePortal();
@@ -6,8 +6,11 @@
 
 
 #include <assert.h>
+#include <algorithm>
 #include <fstream>
+#include <limits>
 #include <vtkh/compositing/PartialCompositor.hpp>
+#include <absorption_compositor.hpp>
 #include <scheduler.hpp>
 #include <png_utils/ascent_png_encoder.hpp>
 #include <utils/rover_logging.hpp>
@@ -290,34 +293,48 @@ void Scheduler<FloatType>::composite()
     }
     else
     {
-      vtkh::PartialCompositor<vtkh::AbsorptionPartial<FloatType>> compositor;
-      compositor.set_background(m_background);
+      composite_absorption();
+    }
+  }
+  ROVER_INFO("Schedule: compositing complete");
+}
+
+template<typename FloatType>
+void
+Scheduler<FloatType>::composite_absorption()
+{
+  int rank = 0;
+  AbsorptionCompositor<FloatType> compositor;
 #ifdef ROVER_PARALLEL
-      compositor.set_comm_handle(MPI_Comm_c2f(m_comm_handle));
+  MPI_Comm_rank(m_comm_handle, &rank);
+  compositor.set_comm_handle(MPI_Comm_c2f(m_comm_handle));
 #endif
-      const int num_partials = m_partial_images.size();
-      int width = m_partial_images[0].m_width;
-      int height = m_partial_images[0].m_height;
-      std::vector<std::vector<vtkh::AbsorptionPartial<FloatType>>> partials;
-      partials.resize(num_partials);
-      for(int i = 0; i < num_partials; ++i)
-      {
-        m_partial_images[i].extract_partials(partials[i]);
-      }
-      std::vector<vtkh::AbsorptionPartial<FloatType>> result;
-      compositor.composite(partials, result);
-      PartialImage<FloatType> p_result;
+  const int width = m_partial_images[0].m_width;
+  const int height = m_partial_images[0].m_height;
+  const int num_bins = static_cast<int>(m_background.size());
 
-      if(rank == 0)
-      {
-        // data only valid on rank = 0
-        p_result.store(result,m_background, width, height);
-      }
+  std::vector<vtkh::AbsorptionPartial<FloatType>> partials;
+  const int num_partial_images = m_partial_images.size();
+  for(int i = 0; i < num_partial_images; ++i)
+  {
+    std::vector<vtkh::AbsorptionPartial<FloatType>> image_partials;
+    m_partial_images[i].extract_partials(image_partials);
+    partials.insert(partials.end(), image_partials.begin(), image_partials.end());
+  }
 
-      m_result = p_result;
-    }
+  std::vector<vtkh::AbsorptionPartial<FloatType>> result;
+  compositor.composite(partials, width * height, num_bins, result);
+
+  PartialImage<FloatType> p_result;
+
+  if(rank == 0)
+  {
+    // data only valid on rank = 0. If no ray hit anything the
+    // result is empty and every pixel gets the background
+    p_result.store(result,m_background, width, height);
   }
-  ROVER_INFO("Schedule: compositing complete");
+
+  m_result = p_result;
 }
 //
 // in the other schedulers this method will be far from trivial
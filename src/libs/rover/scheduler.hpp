@@ -49,6 +49,7 @@ public:
   virtual void get_result(Image<vtkm::Float64> &image) override;
 protected:
   void composite();
+  void composite_absorption();
   void set_global_scalar_range();
   void set_global_bounds();
   int  get_global_channels();
@@ -54,7 +54,8 @@ DataLogger DataLogger::Instance;
 
 DataLogger::DataLogger()
   : AtBlockStart(true),
-    Rank(0)
+    Rank(0),
+    Sink(nullptr)
 {
   Blocks.push(Block(0));
   KeyCounters.push(std::map<std::string,int>());
@@ -86,6 +87,12 @@ DataLogger::SetRank(int rank)
   Rank = rank;
 }
 
+void
+DataLogger::SetSink(DataLogSink *sink)
+{
+  Sink = sink;
+}
+
 void
 DataLogger::WriteIndent()
 {
@@ -112,6 +119,11 @@ DataLogger::WriteIndent()
 void
 DataLogger::WriteLog()
 {
+  // everything went to a sink, don't leave empty files behind
+  if(Stream.tellp() <= 0)
+  {
+    return;
+  }
   std::stringstream log_name;
 
   std::string log_prefix = "vtkh_data";
@@ -139,6 +151,11 @@ DataLogger::WriteLog()
 void
 DataLogger::OpenLogEntry(const std::string &entryName)
 {
+    if(Sink != nullptr)
+    {
+      Sink->Open(entryName);
+      return;
+    }
     WriteIndent();
     // ensure that we have unique keys for valid yaml
     int key_count = KeyCounters.top()[entryName]++;
@@ -164,6 +181,11 @@ DataLogger::OpenLogEntry(const std::string &entryName)
 void
 DataLogger::CloseLogEntry()
 {
+  if(Sink != nullptr)
+  {
+    Sink->Close();
+    return;
+  }
   WriteIndent();
   this->Stream<<"time : "<<Timers.top().elapsed()<<"\n";
   Timers.pop();
@@ -7,6 +7,7 @@
 
 #include <stack>
 #include <sstream>
+#include <type_traits>
 //from rover logging
 namespace vtkh
 {
@@ -28,6 +29,18 @@ protected:
   static std::map<std::string, Logger*> Loggers;
 };
 
+// receives the data log instead of the yaml stream, e.g. to feed a
+// trace recorder of the application embedding vtkh
+class VTKH_API DataLogSink
+{
+public:
+  virtual ~DataLogSink() {}
+  virtual void Open(const std::string &entryName) = 0;
+  virtual void Close() = 0;
+  virtual void Value(const std::string &key, const double value) = 0;
+  virtual void Text(const std::string &key, const std::string &value) = 0;
+};
+
 class VTKH_API DataLogger
 {
 public:
@@ -47,10 +60,18 @@ public:
   void OpenLogEntry(const std::string &entryName);
   void CloseLogEntry();
   void SetRank(int rank);
+  // not owned, nullptr restores the yaml log
+  void SetSink(DataLogSink *sink);
+  DataLogSink *GetSink() const { return Sink; }
 
   template<typename T>
   void AddLogData(const std::string key, const T &value)
   {
+    if(Sink != nullptr)
+    {
+      SinkLogData(key, value, std::is_arithmetic<T>());
+      return;
+    }
     WriteIndent();
     this->Stream << key << ": " << value <<"\n";
     AtBlockStart = false;
@@ -61,6 +82,20 @@ protected:
   DataLogger();
   DataLogger(DataLogger const &);
 
+  template<typename T>
+  void SinkLogData(const std::string &key, const T &value, std::true_type)
+  {
+    Sink->Value(key, static_cast<double>(value));
+  }
+
+  template<typename T>
+  void SinkLogData(const std::string &key, const T &value, std::false_type)
+  {
+    std::stringstream ss;
+    ss << value;
+    Sink->Text(key, ss.str());
+  }
+
   void WriteLog();
   void WriteIndent();
   DataLogger::Block& CurrentBlock();
@@ -71,6 +106,7 @@ protected:
   std::stack<std::map<std::string,int>> KeyCounters;
   bool AtBlockStart;
   int Rank;
+  DataLogSink *Sink;
 };
 
 #ifdef VTKH_ENABLE_LOGGING
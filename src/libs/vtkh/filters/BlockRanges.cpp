@@ -0,0 +1,514 @@
+#include <vtkh/filters/BlockRanges.hpp>
+#include <vtkh/Error.hpp>
+#include <vtkh/Logger.hpp>
+#include <vtkh/utils/vtkm_dataset_info.hpp>
+#include <vtkh/vtkm_filters/vtkmExtractStructured.hpp>
+
+#include <vtkm/Math.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ArrayRangeCompute.h>
+#include <vtkm/cont/CellSetExplicit.h>
+#include <vtkm/worklet/DispatcherMapField.h>
+#include <vtkm/worklet/WorkletMapField.h>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace vtkh
+{
+
+namespace detail
+{
+
+class BlockRange : public vtkm::worklet::WorkletMapField
+{
+protected:
+  vtkm::Id3 m_field_dims;
+  vtkm::Id3 m_num_blocks;
+  vtkm::Id m_block_size;
+  // point fields: blocks include the points on their far side
+  vtkm::Id m_overlap;
+public:
+  VTKM_CONT
+  BlockRange(const vtkm::Id3 field_dims,
+             const vtkm::Id3 num_blocks,
+             const vtkm::Id block_size,
+             const bool points)
+    : m_field_dims(field_dims),
+      m_num_blocks(num_blocks),
+      m_block_size(block_size),
+      m_overlap(points ? 1 : 0)
+  {
+  }
+
+  typedef void ControlSignature(FieldIn, WholeArrayIn, FieldOut, FieldOut);
+  typedef void ExecutionSignature(_1, _2, _3, _4);
+
+  template<typename PortalType>
+  VTKM_EXEC
+  void operator()(const vtkm::Id &block,
+                  const PortalType &values,
+                  vtkm::Float64 &min,
+                  vtkm::Float64 &max) const
+  {
+    vtkm::Id3 start, end;
+    vtkm::Id3 block_idx(block % m_num_blocks[0],
+                        (block / m_num_blocks[0]) % m_num_blocks[1],
+                        block / (m_num_blocks[0] * m_num_blocks[1]));
+    for(vtkm::IdComponent d = 0; d < 3; ++d)
+    {
+      start[d] = block_idx[d] * m_block_size;
+      end[d] = vtkm::Min(start[d] + m_block_size + m_overlap, m_field_dims[d]);
+    }
+
+    min = vtkm::Infinity64();
+    max = vtkm::NegativeInfinity64();
+    for(vtkm::Id k = start[2]; k < end[2]; ++k)
+    {
+      for(vtkm::Id j = start[1]; j < end[1]; ++j)
+      {
+        const vtkm::Id row = (k * m_field_dims[1] + j) * m_field_dims[0];
+        for(vtkm::Id i = start[0]; i < end[0]; ++i)
+        {
+          // NaNs fail both comparisons and are left out
+          const vtkm::Float64 value = static_cast<vtkm::Float64>(values.Get(row + i));
+          if(value < min)
+          {
+            min = value;
+          }
+          if(value > max)
+          {
+            max = value;
+          }
+        }
+      }
+    }
+  }
+}; //class BlockRange
+
+bool RangeIntersects(const vtkm::Range &range,
+                     const std::vector<vtkm::Range> &intervals)
+{
+  for(const vtkm::Range &interval : intervals)
+  {
+    if(range.Min <= interval.Max && range.Max >= interval.Min)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+vtkm::Id default_block_size = 16;
+
+// Pyramids of the current cycle, keyed by domain and field. An entry keeps
+// the field array it was built from so a different array (for example the
+// same field after a threshold) is never mistaken for it.
+struct RangesKey
+{
+  vtkm::Id m_domain_id;
+  std::string m_field_name;
+
+  bool operator<(const RangesKey &other) const
+  {
+    return std::tie(m_domain_id, m_field_name) <
+           std::tie(other.m_domain_id, other.m_field_name);
+  }
+};
+
+struct RangesEntry
+{
+  vtkm::cont::UnknownArrayHandle m_data;
+  vtkm::cont::Field::Association m_assoc;
+  std::shared_ptr<const BlockRanges> m_ranges;
+};
+
+// entries hold on to arrays, keep this small
+const std::size_t max_ranges_cache_entries = 1 << 10;
+
+std::mutex &ranges_cache_mutex()
+{
+  static std::mutex m;
+  return m;
+}
+
+std::map<RangesKey, RangesEntry> &ranges_cache()
+{
+  static std::map<RangesKey, RangesEntry> cache;
+  return cache;
+}
+
+} // namespace detail
+
+BlockRanges::BlockRanges()
+  : m_structured(false),
+    m_block_size(detail::default_block_size),
+    m_point_dims(1, 1, 1),
+    m_cell_dims(1, 1, 1)
+{
+}
+
+vtkm::Range
+BlockRanges::GetRange() const
+{
+  return m_range;
+}
+
+bool
+BlockRanges::IsStructured() const
+{
+  return m_structured;
+}
+
+vtkm::Id
+BlockRanges::GetNumberOfBlocks() const
+{
+  if(m_levels.empty())
+  {
+    return 0;
+  }
+  return static_cast<vtkm::Id>(m_levels[0].size());
+}
+
+bool
+BlockRanges::Intersects(const std::vector<vtkm::Range> &intervals) const
+{
+  return detail::RangeIntersects(m_range, intervals);
+}
+
+void
+BlockRanges::Build(const vtkm::cont::DataSet &domain,
+                   const std::string &field_name)
+{
+  const vtkm::cont::Field &field = domain.GetField(field_name);
+
+  int topo_dims;
+  int dims[3] = {1, 1, 1};
+  m_structured = VTKMDataSetInfo::IsStructured(domain, topo_dims) &&
+                 VTKMDataSetInfo::GetPointDims(domain.GetCellSet(), dims);
+
+  if(!m_structured)
+  {
+    vtkm::cont::ArrayHandle<vtkm::Range> range =
+      vtkm::cont::ArrayRangeCompute(field.GetData());
+    m_range = range.ReadPortal().Get(0);
+    return;
+  }
+
+  for(int d = 0; d < 3; ++d)
+  {
+    m_point_dims[d] = dims[d];
+    m_cell_dims[d] = std::max(vtkm::Id(dims[d]) - 1, vtkm::Id(1));
+  }
+
+  const bool points = field.GetAssociation() ==
+                      vtkm::cont::Field::Association::Points;
+  vtkm::Id3 num_blocks;
+  for(int d = 0; d < 3; ++d)
+  {
+    num_blocks[d] = (m_cell_dims[d] + m_block_size - 1) / m_block_size;
+  }
+  const vtkm::Id total_blocks = num_blocks[0] * num_blocks[1] * num_blocks[2];
+
+  vtkm::cont::ArrayHandle<vtkm::Float64> mins, maxs;
+  vtkm::worklet::DispatcherMapField<detail::BlockRange>(
+      detail::BlockRange(points ? m_point_dims : m_cell_dims,
+                         num_blocks,
+                         m_block_size,
+                         points))
+    .Invoke(vtkm::cont::ArrayHandleIndex(total_blocks),
+            field.GetData().ResetTypes(vtkm::TypeListFieldScalar(),
+                                       VTKM_DEFAULT_STORAGE_LIST{}),
+            mins,
+            maxs);
+
+  // the pyramid itself is tiny, build the coarser levels on the host
+  m_levels.clear();
+  m_level_dims.clear();
+  m_levels.emplace_back(total_blocks);
+  m_level_dims.push_back(num_blocks);
+  auto min_portal = mins.ReadPortal();
+  auto max_portal = maxs.ReadPortal();
+  for(vtkm::Id i = 0; i < total_blocks; ++i)
+  {
+    m_levels[0][i] = vtkm::Range(min_portal.Get(i), max_portal.Get(i));
+  }
+
+  while(m_levels.back().size() > 1)
+  {
+    const vtkm::Id3 fine_dims = m_level_dims.back();
+    vtkm::Id3 coarse_dims;
+    for(int d = 0; d < 3; ++d)
+    {
+      coarse_dims[d] = (fine_dims[d] + 1) / 2;
+    }
+    std::vector<vtkm::Range> coarse(coarse_dims[0] * coarse_dims[1] * coarse_dims[2]);
+    const std::vector<vtkm::Range> &fine = m_levels.back();
+    for(vtkm::Id k = 0; k < fine_dims[2]; ++k)
+    {
+      for(vtkm::Id j = 0; j < fine_dims[1]; ++j)
+      {
+        for(vtkm::Id i = 0; i < fine_dims[0]; ++i)
+        {
+          const vtkm::Id parent = ((k / 2) * coarse_dims[1] + j / 2) * coarse_dims[0] + i / 2;
+          coarse[parent].Include(fine[(k * fine_dims[1] + j) * fine_dims[0] + i]);
+        }
+      }
+    }
+    m_levels.push_back(coarse);
+    m_level_dims.push_back(coarse_dims);
+  }
+
+  m_range = m_levels.back()[0];
+}
+
+void
+BlockRanges::ActiveBlocks(const std::vector<vtkm::Range> &intervals,
+                          const int level,
+                          const vtkm::Id3 &block,
+                          vtkm::Id3 &min_block,
+                          vtkm::Id3 &max_block,
+                          vtkm::Id &count) const
+{
+  const vtkm::Id3 &dims = m_level_dims[level];
+  const vtkm::Range &range =
+    m_levels[level][(block[2] * dims[1] + block[1]) * dims[0] + block[0]];
+  if(!detail::RangeIntersects(range, intervals))
+  {
+    return;
+  }
+
+  if(level == 0)
+  {
+    for(int d = 0; d < 3; ++d)
+    {
+      min_block[d] = std::min(min_block[d], block[d]);
+      max_block[d] = std::max(max_block[d], block[d]);
+    }
+    count++;
+    return;
+  }
+
+  const vtkm::Id3 &child_dims = m_level_dims[level - 1];
+  for(vtkm::Id k = block[2] * 2; k < std::min(block[2] * 2 + 2, child_dims[2]); ++k)
+  {
+    for(vtkm::Id j = block[1] * 2; j < std::min(block[1] * 2 + 2, child_dims[1]); ++j)
+    {
+      for(vtkm::Id i = block[0] * 2; i < std::min(block[0] * 2 + 2, child_dims[0]); ++i)
+      {
+        ActiveBlocks(intervals, level - 1, vtkm::Id3(i, j, k), min_block, max_block, count);
+      }
+    }
+  }
+}
+
+vtkm::Id
+BlockRanges::ActiveExtents(const std::vector<vtkm::Range> &intervals,
+                           vtkm::RangeId3 &voi) const
+{
+  if(!m_structured)
+  {
+    throw Error("BlockRanges: active extents need a structured domain");
+  }
+
+  const vtkm::Id max_id = std::numeric_limits<vtkm::Id>::max();
+  vtkm::Id3 min_block(max_id, max_id, max_id);
+  vtkm::Id3 max_block(-1, -1, -1);
+  vtkm::Id count = 0;
+  ActiveBlocks(intervals,
+               static_cast<int>(m_levels.size()) - 1,
+               vtkm::Id3(0, 0, 0),
+               min_block,
+               max_block,
+               count);
+  if(count == 0)
+  {
+    return 0;
+  }
+
+  // blocks -> cells -> points, max is exclusive
+  vtkm::Id3 start, end;
+  for(int d = 0; d < 3; ++d)
+  {
+    start[d] = min_block[d] * m_block_size;
+    const vtkm::Id cell_end = std::min((max_block[d] + 1) * m_block_size,
+                                       m_cell_dims[d]);
+    end[d] = std::min(cell_end + 1, m_point_dims[d]);
+  }
+  voi = vtkm::RangeId3(start[0], end[0], start[1], end[1], start[2], end[2]);
+  return count;
+}
+
+std::shared_ptr<const BlockRanges>
+BlockRanges::Get(const vtkm::cont::DataSet &domain,
+                 const vtkm::Id domain_id,
+                 const std::string &field_name,
+                 const bool use_cache)
+{
+  const vtkm::cont::Field &field = domain.GetField(field_name);
+
+  detail::RangesKey key;
+  key.m_domain_id = domain_id;
+  key.m_field_name = field_name;
+
+  if(use_cache)
+  {
+    std::lock_guard<std::mutex> lock(detail::ranges_cache_mutex());
+    auto it = detail::ranges_cache().find(key);
+    if(it != detail::ranges_cache().end() &&
+       it->second.m_assoc == field.GetAssociation() &&
+       it->second.m_data.GetBuffers() == field.GetData().GetBuffers())
+    {
+      VTKH_DATA_ADD("block_ranges_cache_hit", 1);
+      return it->second.m_ranges;
+    }
+  }
+
+  VTKH_DATA_OPEN("build_block_ranges");
+  std::shared_ptr<BlockRanges> ranges(new BlockRanges());
+  ranges->Build(domain, field_name);
+  VTKH_DATA_ADD("blocks", ranges->GetNumberOfBlocks());
+  VTKH_DATA_CLOSE();
+
+  if(use_cache)
+  {
+    std::lock_guard<std::mutex> lock(detail::ranges_cache_mutex());
+    if(detail::ranges_cache().size() >= detail::max_ranges_cache_entries)
+    {
+      detail::ranges_cache().clear();
+    }
+    detail::RangesEntry &entry = detail::ranges_cache()[key];
+    entry.m_data = field.GetData();
+    entry.m_assoc = field.GetAssociation();
+    entry.m_ranges = ranges;
+  }
+  return ranges;
+}
+
+bool
+BlockRanges::Cull(vtkm::cont::DataSet &domain,
+                  const vtkm::Id domain_id,
+                  const std::string &field_name,
+                  const std::vector<vtkm::Range> &intervals,
+                  const bool use_cache,
+                  vtkm::cont::DataSet &output)
+{
+  output = domain;
+  if(!domain.HasField(field_name))
+  {
+    return true;
+  }
+
+  const vtkm::cont::Field &field = domain.GetField(field_name);
+  const bool supported_assoc =
+    field.GetAssociation() == vtkm::cont::Field::Association::Points ||
+    field.GetAssociation() == vtkm::cont::Field::Association::Cells;
+  if(!supported_assoc || field.GetData().GetNumberOfComponentsFlat() != 1)
+  {
+    return true;
+  }
+
+  std::shared_ptr<const BlockRanges> ranges = Get(domain, domain_id, field_name, use_cache);
+  if(!ranges->Intersects(intervals))
+  {
+    VTKH_DATA_ADD("culled_domain", domain_id);
+    return false;
+  }
+
+  // filters recenter cell fields before they use them, and cropping
+  // would change the recentered values on the new boundary
+  if(!ranges->IsStructured() ||
+     field.GetAssociation() != vtkm::cont::Field::Association::Points)
+  {
+    return true;
+  }
+
+  vtkm::RangeId3 voi;
+  if(ranges->ActiveExtents(intervals, voi) == 0)
+  {
+    return false;
+  }
+
+  // cropping copies the fields, only worth it if it removes a good part
+  // of the domain
+  const vtkm::Id kept = std::max(voi.X.Length() - 1, vtkm::Id(1)) *
+                        std::max(voi.Y.Length() - 1, vtkm::Id(1)) *
+                        std::max(voi.Z.Length() - 1, vtkm::Id(1));
+  const vtkm::Id total = domain.GetNumberOfCells();
+  if(kept * 4 >= total * 3)
+  {
+    return true;
+  }
+
+  VTKH_DATA_OPEN("crop_to_active_blocks");
+  VTKH_DATA_ADD("kept_cells", kept);
+  VTKH_DATA_ADD("total_cells", total);
+  vtkh::vtkmExtractStructured extract;
+  output = extract.Run(domain,
+                       voi,
+                       vtkm::Id3(1, 1, 1),
+                       vtkm::filter::FieldSelection(vtkm::filter::FieldSelection::Mode::All));
+  VTKH_DATA_CLOSE();
+  return true;
+}
+
+vtkm::cont::DataSet
+BlockRanges::EmptyDomain(const vtkm::cont::DataSet &domain,
+                         const vtkm::filter::FieldSelection &fields)
+{
+  vtkm::cont::DataSet output;
+
+  vtkm::cont::CellSetExplicit<> cells;
+  cells.Fill(0,
+             vtkm::cont::ArrayHandle<vtkm::UInt8>(),
+             vtkm::cont::ArrayHandle<vtkm::Id>(),
+             vtkm::cont::make_ArrayHandle<vtkm::Id>({0}));
+  output.SetCellSet(cells);
+
+  const vtkm::IdComponent num_fields = domain.GetNumberOfFields();
+  for(vtkm::IdComponent i = 0; i < num_fields; ++i)
+  {
+    const vtkm::cont::Field &field = domain.GetField(i);
+    if(domain.HasCoordinateSystem(field.GetName()))
+    {
+      output.AddCoordinateSystem(
+        vtkm::cont::CoordinateSystem(field.GetName(),
+                                     vtkm::cont::ArrayHandle<vtkm::Vec3f>()));
+      continue;
+    }
+
+    const bool sized = field.IsPointField() || field.IsCellField();
+    if(!sized || !fields.IsFieldSelected(field))
+    {
+      continue;
+    }
+    // same value type, no values
+    vtkm::cont::UnknownArrayHandle data = field.GetData().NewInstance();
+    data.Allocate(0);
+    output.AddField(vtkm::cont::Field(field.GetName(), field.GetAssociation(), data));
+  }
+  return output;
+}
+
+void
+BlockRanges::SetBlockSize(const vtkm::Id block_size)
+{
+  if(block_size < 1)
+  {
+    throw Error("BlockRanges: block size must be greater than 0");
+  }
+  detail::default_block_size = block_size;
+  ClearCache();
+}
+
+void
+BlockRanges::ClearCache()
+{
+  std::lock_guard<std::mutex> lock(detail::ranges_cache_mutex());
+  detail::ranges_cache().clear();
+}
+
+} //  namespace vtkh
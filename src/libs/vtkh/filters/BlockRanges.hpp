@@ -0,0 +1,94 @@
+#ifndef VTK_H_BLOCK_RANGES_HPP
+#define VTK_H_BLOCK_RANGES_HPP
+
+#include <vtkh/vtkh_exports.h>
+#include <vtkh/vtkh.hpp>
+
+#include <vtkm/Range.h>
+#include <vtkm/RangeId3.h>
+#include <vtkm/cont/DataSet.h>
+#include <vtkm/filter/FieldSelection.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace vtkh
+{
+
+// Min/max pyramid of a scalar field over blocks of cells of a domain.
+// The finest level holds the range of each block of cells, every coarser
+// level merges 2x2x2 blocks, up to a single range for the whole domain.
+// Filters that only produce output where the field crosses a value
+// (contour, isovolume, slice) use it to skip whole domains and to crop
+// structured domains to the blocks that can produce output.
+// Unstructured domains only get the domain range.
+class VTKH_API BlockRanges
+{
+public:
+  // range of the field over the whole domain
+  vtkm::Range GetRange() const;
+  // true if any value of the field can fall in any of the intervals
+  bool Intersects(const std::vector<vtkm::Range> &intervals) const;
+  // smallest box of points covering all blocks whose range intersects
+  // any of the intervals. Only valid for structured domains, returns
+  // the number of active blocks
+  vtkm::Id ActiveExtents(const std::vector<vtkm::Range> &intervals,
+                         vtkm::RangeId3 &voi) const;
+  bool IsStructured() const;
+  vtkm::Id GetNumberOfBlocks() const;
+
+  // builds the pyramid of a point or cell field. If use_cache is true
+  // the result is remembered for later calls with the same field data
+  static std::shared_ptr<const BlockRanges>
+  Get(const vtkm::cont::DataSet &domain,
+      const vtkm::Id domain_id,
+      const std::string &field_name,
+      const bool use_cache = true);
+
+  // Crops a domain to what can produce output for the intervals. Returns
+  // false if nothing in the domain can, otherwise output is either the
+  // domain itself or a cropped copy of a structured domain (point
+  // fields only)
+  static bool Cull(vtkm::cont::DataSet &domain,
+                   const vtkm::Id domain_id,
+                   const std::string &field_name,
+                   const std::vector<vtkm::Range> &intervals,
+                   const bool use_cache,
+                   vtkm::cont::DataSet &output);
+
+  // What filters emit for a domain Cull dropped: no points or cells,
+  // but the same coordinate systems and the selected fields (empty), so
+  // the output has the same domains as without culling
+  static vtkm::cont::DataSet EmptyDomain(const vtkm::cont::DataSet &domain,
+                                         const vtkm::filter::FieldSelection &fields);
+
+  // cells per block along each axis, defaults to 16
+  static void SetBlockSize(const vtkm::Id block_size);
+  // the cache holds on to field arrays, so it has to be cleared
+  // whenever the data changes (once per cycle)
+  static void ClearCache();
+
+protected:
+  BlockRanges();
+  void Build(const vtkm::cont::DataSet &domain, const std::string &field_name);
+  void ActiveBlocks(const std::vector<vtkm::Range> &intervals,
+                    const int level,
+                    const vtkm::Id3 &block,
+                    vtkm::Id3 &min_block,
+                    vtkm::Id3 &max_block,
+                    vtkm::Id &count) const;
+
+  bool m_structured;
+  vtkm::Range m_range;
+  vtkm::Id m_block_size;
+  vtkm::Id3 m_point_dims;
+  vtkm::Id3 m_cell_dims;
+  // number of blocks along each axis, per level
+  std::vector<vtkm::Id3> m_level_dims;
+  // per level, x fastest
+  std::vector<std::vector<vtkm::Range>> m_levels;
+};
+
+} //namespace vtkh
+#endif
@@ -9,7 +9,8 @@ namespace vtkh
 
 
 CleanGrid::CleanGrid()
-  : m_tolerance(-1.)
+  : m_merge_points(false),
+    m_tolerance(-1.)
 {
 
 }
@@ -39,6 +40,7 @@ CleanGrid::DoExecute()
     this->m_input->GetDomain(i, dom, domain_id);
 
     vtkh::vtkmCleanGrid cleaner;
+    cleaner.merge_points(m_merge_points);
     if(m_tolerance != -1.)
     {
       cleaner.tolerance(m_tolerance);
@@ -61,6 +63,12 @@ CleanGrid::GetName() const
   return "vtkh::CleanGrid";
 }
 
+void
+CleanGrid::MergePoints(const bool on)
+{
+  m_merge_points = on;
+}
+
 void
 CleanGrid::Tolerance(const vtkm::Float64 tolerance)
 {
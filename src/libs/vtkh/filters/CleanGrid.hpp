@@ -16,11 +16,16 @@ public:
   CleanGrid();
   virtual ~CleanGrid();
   std::string GetName() const override;
+  // merge points that are within the tolerance of each other. Off by
+  // default, the output only keeps the points cells use
+  void MergePoints(const bool on);
+  // merge tolerance, only used when merging points
   void Tolerance(const vtkm::Float64 tolerance);
 protected:
   void PreExecute() override;
   void PostExecute() override;
   void DoExecute() override;
+  bool m_merge_points;
   vtkm::Float64 m_tolerance;
 };
 
@@ -12,6 +12,9 @@
 #include <vtkm/BinaryOperators.h>
 
 #include <limits>
+#include <map>
+#include <mutex>
+#include <tuple>
 
 namespace vtkh
 {
@@ -278,8 +281,212 @@ bool CanStrip(vtkm::cont::Field  &ghost_field,
   return can_strip;
 }
 
+template<int DIMS>
+class StripExtentsMatch : public vtkm::worklet::WorkletMapField
+{
+protected:
+  vtkm::Vec<vtkm::Id,3> m_cell_dims;
+  vtkm::Int32 m_min_value;
+  vtkm::Int32 m_max_value;
+  vtkm::Vec<vtkm::Id,3> m_valid_min;
+  vtkm::Vec<vtkm::Id,3> m_valid_max;
+public:
+  VTKM_CONT
+  StripExtentsMatch(vtkm::Vec<vtkm::Id,3> cell_dims,
+                    vtkm::Int32 min_value,
+                    vtkm::Int32 max_value,
+                    vtkm::Vec<vtkm::Id,3> valid_min,
+                    vtkm::Vec<vtkm::Id,3> valid_max)
+    : m_cell_dims(cell_dims),
+      m_min_value(min_value),
+      m_max_value(max_value),
+      m_valid_min(valid_min),
+      m_valid_max(valid_max)
+  {
+  }
+
+  typedef void ControlSignature(FieldIn, FieldOut);
+  typedef void ExecutionSignature(_1, WorkIndex, _2);
+
+  template<typename T>
+  VTKM_EXEC
+  void operator()(const T &value, const vtkm::Id &index, vtkm::UInt8 &mismatch) const
+  {
+    // the extents are still exact if every valid zone is inside
+    // them and every ghost zone is outside of them
+    const bool valid = value >= m_min_value && value <= m_max_value;
+
+    vtkm::Vec<vtkm::Id,3> logical = get_logical<DIMS>(index, m_cell_dims);
+    bool inside = true;
+    for(vtkm::Int32 i = 0; i < DIMS; ++i)
+    {
+      if(logical[i] < m_valid_min[i] || logical[i] > m_valid_max[i])
+      {
+        inside = false;
+      }
+    }
+    mismatch = valid != inside ? 1 : 0;
+  }
+}; //class StripExtentsMatch
+
+// Structured strip extents from previous cycles. Ghost layouts almost
+// never change between cycles, so we remember the extents per domain
+// and only pay for a single validation pass instead of re-deriving them.
+struct StripKey
+{
+  vtkm::Id m_domain_id;
+  std::string m_field_name;
+  vtkm::Int32 m_min_value;
+  vtkm::Int32 m_max_value;
+  vtkm::Vec<vtkm::Id,3> m_cell_dims;
+
+  bool operator<(const StripKey &other) const
+  {
+    return std::tie(m_domain_id, m_field_name, m_min_value, m_max_value,
+                    m_cell_dims[0], m_cell_dims[1], m_cell_dims[2]) <
+           std::tie(other.m_domain_id, other.m_field_name,
+                    other.m_min_value, other.m_max_value,
+                    other.m_cell_dims[0], other.m_cell_dims[1],
+                    other.m_cell_dims[2]);
+  }
+};
+
+struct StripExtents
+{
+  vtkm::Vec<vtkm::Id,3> m_min;
+  vtkm::Vec<vtkm::Id,3> m_max;
+};
+
+// keep the cache from growing without bound when domain ids churn
+const std::size_t max_strip_cache_entries = 1 << 14;
+
+std::mutex &strip_cache_mutex()
+{
+  static std::mutex m;
+  return m;
+}
+
+std::map<StripKey, StripExtents> &strip_cache()
+{
+  static std::map<StripKey, StripExtents> cache;
+  return cache;
+}
+
+bool CachedExtents(const StripKey &key, StripExtents &extents)
+{
+  std::lock_guard<std::mutex> lock(strip_cache_mutex());
+  auto it = strip_cache().find(key);
+  if(it == strip_cache().end())
+  {
+    return false;
+  }
+  extents = it->second;
+  return true;
+}
+
+void CacheExtents(const StripKey &key, const StripExtents &extents)
+{
+  std::lock_guard<std::mutex> lock(strip_cache_mutex());
+  if(strip_cache().size() >= max_strip_cache_entries)
+  {
+    strip_cache().clear();
+  }
+  strip_cache()[key] = extents;
+}
+
+void ForgetExtents(const StripKey &key)
+{
+  std::lock_guard<std::mutex> lock(strip_cache_mutex());
+  strip_cache().erase(key);
+}
+
+template<int DIMS>
+bool ExtentsStillValid(vtkm::cont::Field &ghost_field,
+                       const vtkm::Int32 min_value,
+                       const vtkm::Int32 max_value,
+                       const StripExtents &extents,
+                       vtkm::Vec<vtkm::Id,3> cell_dims)
+{
+  VTKH_DATA_OPEN("validate_cached_strip");
+  vtkm::cont::ArrayHandle<vtkm::UInt8> mismatch;
+
+  vtkm::worklet::DispatcherMapField<StripExtentsMatch<DIMS>>
+    (StripExtentsMatch<DIMS>(cell_dims,
+                             min_value,
+                             max_value,
+                             extents.m_min,
+                             extents.m_max))
+     .Invoke(ghost_field.GetData().ResetTypes(vtkm::TypeListScalarAll(),
+                                              VTKM_DEFAULT_STORAGE_LIST{}),
+         mismatch);
+
+  vtkm::UInt8 res = vtkm::cont::Algorithm::Reduce(mismatch,
+                                                  vtkm::UInt8(0),
+                                                  vtkm::Maximum());
+  VTKH_DATA_ADD("valid", res == 0 ? 1 : 0);
+  VTKH_DATA_CLOSE();
+  return res == 0;
+}
+
+template<int DIMS>
+bool StructuredStripDims(vtkm::cont::Field &ghost_field,
+                         const vtkm::Id domain_id,
+                         const std::string &field_name,
+                         const vtkm::Int32 min_value,
+                         const vtkm::Int32 max_value,
+                         vtkm::Vec<vtkm::Id,3> &min,
+                         vtkm::Vec<vtkm::Id,3> &max,
+                         vtkm::Vec<vtkm::Id,3> cell_dims,
+                         vtkm::Id size,
+                         bool &should_strip)
+{
+  StripKey key;
+  key.m_domain_id = domain_id;
+  key.m_field_name = field_name;
+  key.m_min_value = min_value;
+  key.m_max_value = max_value;
+  key.m_cell_dims = cell_dims;
+
+  StripExtents extents;
+  if(CachedExtents(key, extents))
+  {
+    if(ExtentsStillValid<DIMS>(ghost_field,
+                               min_value,
+                               max_value,
+                               extents,
+                               cell_dims))
+    {
+      min = extents.m_min;
+      max = extents.m_max;
+      // a cached entry always describes a proper subset,
+      // otherwise we would have passed the domain through
+      should_strip = true;
+      return true;
+    }
+    ForgetExtents(key);
+  }
+
+  bool can_strip = CanStrip<DIMS>(ghost_field,
+                                  min_value,
+                                  max_value,
+                                  min,
+                                  max,
+                                  cell_dims,
+                                  size,
+                                  should_strip);
+  if(can_strip && should_strip)
+  {
+    extents.m_min = min;
+    extents.m_max = max;
+    CacheExtents(key, extents);
+  }
+  return can_strip;
+}
+
 bool StructuredStrip(vtkm::cont::DataSet &dataset,
                      vtkm::cont::Field   &ghost_field,
+                     const vtkm::Id domain_id,
+                     const std::string &field_name,
                      const vtkm::Int32 min_value,
                      const vtkm::Int32 max_value,
                      vtkm::Vec<vtkm::Id,3> &min,
@@ -301,14 +508,16 @@ bool StructuredStrip(vtkm::cont::DataSet &dataset,
     cell_dims[0] = dims[0] - 1;
     size = cell_dims[0];
 
-    can_strip = CanStrip<1>(ghost_field,
-                            min_value,
-                            max_value,
-                            min,
-                            max,
-                            cell_dims,
-                            size,
-                            should_strip);
+    can_strip = StructuredStripDims<1>(ghost_field,
+                                       domain_id,
+                                       field_name,
+                                       min_value,
+                                       max_value,
+                                       min,
+                                       max,
+                                       cell_dims,
+                                       size,
+                                       should_strip);
   }
   else if(cell_set.IsType<vtkm::cont::CellSetStructured<2>>())
   {
@@ -316,14 +525,16 @@ bool StructuredStrip(vtkm::cont::DataSet &dataset,
     cell_dims[1] = dims[1] - 1;
     size = cell_dims[0] * cell_dims[1];
 
-    can_strip = CanStrip<2>(ghost_field,
-                            min_value,
-                            max_value,
-                            min,
-                            max,
-                            cell_dims,
-                            size,
-                            should_strip);
+    can_strip = StructuredStripDims<2>(ghost_field,
+                                       domain_id,
+                                       field_name,
+                                       min_value,
+                                       max_value,
+                                       min,
+                                       max,
+                                       cell_dims,
+                                       size,
+                                       should_strip);
   }
   else if(cell_set.IsType<vtkm::cont::CellSetStructured<3>>())
   {
@@ -332,14 +543,16 @@ bool StructuredStrip(vtkm::cont::DataSet &dataset,
     cell_dims[2] = dims[2] - 1;
     size = cell_dims[0] * cell_dims[1] * cell_dims[2];
 
-    can_strip = CanStrip<3>(ghost_field,
-                            min_value,
-                            max_value,
-                            min,
-                            max,
-                            cell_dims,
-                            size,
-                            should_strip);
+    can_strip = StructuredStripDims<3>(ghost_field,
+                                       domain_id,
+                                       field_name,
+                                       min_value,
+                                       max_value,
+                                       min,
+                                       max,
+                                       cell_dims,
+                                       size,
+                                       should_strip);
   }
 
   VTKH_DATA_CLOSE();
@@ -431,6 +644,8 @@ void GhostStripper::DoExecute()
       bool should_strip; // just because we can doesn't mean we should
       bool can_strip = detail::StructuredStrip(dom,
                                               field,
+                                              domain_id,
+                                              m_field_name,
                                               m_min_value,
                                               m_max_value,
                                               min,
@@ -483,6 +698,13 @@ void GhostStripper::DoExecute()
 
 }
 
+void
+GhostStripper::ClearCache()
+{
+  std::lock_guard<std::mutex> lock(detail::strip_cache_mutex());
+  detail::strip_cache().clear();
+}
+
 std::string
 GhostStripper::GetName() const
 {
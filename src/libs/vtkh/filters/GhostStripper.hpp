@@ -20,6 +20,11 @@ public:
   void SetMinValue(const vtkm::Int32 min);
   void SetMaxValue(const vtkm::Int32 min);
 
+  // Structured strip extents are remembered per domain across
+  // executions and re-validated with a single pass. This drops them,
+  // Ascent does so on every publish and on close.
+  static void ClearCache();
+
 protected:
   void PreExecute() override;
   void PostExecute() override;
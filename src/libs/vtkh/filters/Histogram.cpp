@@ -5,6 +5,8 @@
 #include <vtkh/vtkm_filters/vtkmHistogram.hpp>
 #include <vtkm/filter/density_estimate/worklet/FieldHistogram.h>
 #include <vtkm/cont/PartitionedDataSet.h>
+#include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayCopy.h>
 
 #ifdef VTKH_PARALLEL
 #include <mpi.h>
@@ -16,11 +18,23 @@ namespace vtkh
 namespace detail
 {
 
+struct IsRealZone
+{
+  VTKM_EXEC_CONT
+  bool operator()(const vtkm::Int32 &ghost) const
+  {
+    return ghost == 0;
+  }
+};
+
 struct HistoFunctor
 {
 
   vtkm::Range m_range;
   vtkm::Id m_num_bins;
+  // optional per-value ghost mask
+  bool m_masked = false;
+  vtkm::cont::ArrayHandle<vtkm::Int32> m_ghosts;
 
   vtkm::cont::ArrayHandle<vtkm::Id> m_bins;
   vtkm::Float64 m_bin_delta;
@@ -34,7 +48,18 @@ struct HistoFunctor
 
     //TODO:Rewrite using vtkm::filter::density_estimate::Histogram
     vtkm::worklet::FieldHistogram worklet;
-    worklet.Run(array,m_num_bins,min_range,max_range,bin_delta,m_bins);
+    if(m_masked)
+    {
+      // only the field values of real zones are compacted,
+      // the mesh itself is never copied
+      vtkm::cont::ArrayHandle<T> real_values;
+      vtkm::cont::Algorithm::CopyIf(array, m_ghosts, real_values, IsRealZone());
+      worklet.Run(real_values,m_num_bins,min_range,max_range,bin_delta,m_bins);
+    }
+    else
+    {
+      worklet.Run(array,m_num_bins,min_range,max_range,bin_delta,m_bins);
+    }
     m_bin_delta = static_cast<vtkm::Float64>(bin_delta);
   }
 };
@@ -92,6 +117,12 @@ Histogram::SetNumBins(const int num_bins)
   m_num_bins = num_bins;
 }
 
+void
+Histogram::SetGhostField(const std::string &ghost_field)
+{
+  m_ghost_field = ghost_field;
+}
+
 void 
 Histogram::PreExecute()
 {
@@ -300,6 +331,18 @@ Histogram::Run(vtkh::DataSet &data_set, const std::string &field_name)
     hist.m_num_bins = m_num_bins;
     hist.m_range = range;
 
+    if(m_ghost_field != "" && dom.HasField(m_ghost_field))
+    {
+      vtkm::cont::Field ghosts = dom.GetField(m_ghost_field);
+      // ghosts are zonal, so we can only mask zonal fields
+      if(field.GetAssociation() == vtkm::cont::Field::Association::Cells &&
+         ghosts.GetNumberOfValues() == field.GetNumberOfValues())
+      {
+        vtkm::cont::ArrayCopyShallowIfPossible(ghosts.GetData(), hist.m_ghosts);
+        hist.m_masked = true;
+      }
+    }
+
     field.GetData().ResetTypes(vtkm::TypeListFieldScalar(), VTKM_DEFAULT_STORAGE_LIST{}).CastAndCall(hist);
     HistogramResult dom_hist;
     dom_hist.m_bins = hist.m_bins;
@@ -35,11 +35,15 @@ public:
   std::string GetName() const override;
   void SetRange(const vtkm::Range &range);
   void SetNumBins(const int num_bins);
+  // cells whose ghost value is non-zero are masked out of Run()
+  // instead of stripping the ghost zones from the mesh beforehand
+  void SetGhostField(const std::string &ghost_field);
 protected:
   void PreExecute() override;
   void PostExecute() override;
   void DoExecute() override;
   std::string m_field_name; 
+  std::string m_ghost_field;
   int m_num_bins;
   vtkm::Range m_range;
 };
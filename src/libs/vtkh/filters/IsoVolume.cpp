@@ -1,5 +1,6 @@
 #include "IsoVolume.hpp"
 
+#include <vtkh/filters/BlockRanges.hpp>
 #include <vtkh/filters/ClipField.hpp>
 #include <vtkh/filters/CleanGrid.hpp>
 
@@ -43,30 +44,72 @@ IsoVolume::PostExecute()
 
 void IsoVolume::DoExecute()
 {
-
-  ClipField max_clip;
-  max_clip.SetInput(this->m_input);
-  max_clip.SetField(m_field_name);
-  max_clip.SetClipValue(m_range.Max);
-  max_clip.SetInvertClip(true);
-  max_clip.Update();
-
-  DataSet *clipped = max_clip.GetOutput();
-
-  ClipField min_clip;
-  min_clip.SetInput(clipped);
-  min_clip.SetField(m_field_name);
-  min_clip.SetClipValue(m_range.Min);
-  min_clip.Update();
-
-  delete clipped;
-  DataSet *iso = min_clip.GetOutput();
-  CleanGrid cleaner;
-  cleaner.SetInput(iso);
-  cleaner.Update();
-  delete iso;
-  this->m_output = cleaner.GetOutput();
-
+  // drop domains and blocks of cells that are entirely outside the range.
+  // Dropped domains come back as empty domains, like clipping would give
+  DataSet culled;
+  std::vector<vtkm::cont::DataSet> empty_domains;
+  std::vector<vtkm::Id> empty_domain_ids;
+  std::vector<vtkm::Range> intervals = {m_range};
+  const int num_domains = this->m_input->GetNumberOfDomains();
+  for(int i = 0; i < num_domains; ++i)
+  {
+    vtkm::Id domain_id;
+    vtkm::cont::DataSet dom;
+    this->m_input->GetDomain(i, dom, domain_id);
+
+    if(!dom.HasField(m_field_name))
+    {
+      culled.AddDomain(dom, domain_id);
+      continue;
+    }
+
+    vtkm::cont::DataSet active;
+    if(BlockRanges::Cull(dom, domain_id, m_field_name, intervals, true, active))
+    {
+      culled.AddDomain(active, domain_id);
+    }
+    else
+    {
+      empty_domains.push_back(BlockRanges::EmptyDomain(dom, this->GetFieldSelection()));
+      empty_domain_ids.push_back(domain_id);
+    }
+  }
+
+  if(culled.GlobalFieldExists(m_field_name))
+  {
+    ClipField max_clip;
+    max_clip.SetInput(&culled);
+    max_clip.SetField(m_field_name);
+    max_clip.SetClipValue(m_range.Max);
+    max_clip.SetInvertClip(true);
+    max_clip.Update();
+
+    DataSet *clipped = max_clip.GetOutput();
+
+    ClipField min_clip;
+    min_clip.SetInput(clipped);
+    min_clip.SetField(m_field_name);
+    min_clip.SetClipValue(m_range.Min);
+    min_clip.Update();
+
+    delete clipped;
+    DataSet *iso = min_clip.GetOutput();
+    CleanGrid cleaner;
+    cleaner.SetInput(iso);
+    cleaner.Update();
+    delete iso;
+    this->m_output = cleaner.GetOutput();
+  }
+  else
+  {
+    // nothing is inside the range anywhere
+    this->m_output = new DataSet();
+  }
+
+  for(size_t i = 0; i < empty_domains.size(); ++i)
+  {
+    this->m_output->AddDomain(empty_domains[i], empty_domain_ids[i]);
+  }
 }
 
 std::string
@@ -5,7 +5,7 @@
 #include <vtkh/filters/ContourTree.hpp>
 #endif
 
-#include <vtkh/filters/CleanGrid.hpp>
+#include <vtkh/filters/BlockRanges.hpp>
 #include <vtkh/filters/Recenter.hpp>
 #include <vtkh/vtkm_filters/vtkmMarchingCubes.hpp>
 
@@ -16,7 +16,8 @@ namespace vtkh
 
 MarchingCubes::MarchingCubes()
  : m_levels(10),
-   m_use_contour_tree(false)
+   m_use_contour_tree(false),
+   m_use_block_range_cache(true)
 {
 
 }
@@ -47,6 +48,12 @@ MarchingCubes::SetUseContourTree(bool on)
   m_use_contour_tree = on;
 }
 
+void
+MarchingCubes::SetUseBlockRangeCache(bool on)
+{
+  m_use_block_range_cache = on;
+}
+
 void
 MarchingCubes::SetIsoValues(const double *iso_values, const int &num_values)
 {
@@ -124,7 +131,7 @@ void MarchingCubes::PostExecute()
 
 void MarchingCubes::DoExecute()
 {
-  DataSet temp_data;
+  this->m_output = new DataSet();
   vtkh::DataSet *old_input = this->m_input;
 
 
@@ -144,6 +151,12 @@ void MarchingCubes::DoExecute()
     delete_input = true;
   }
 
+  std::vector<vtkm::Range> iso_ranges;
+  for(const double iso : m_iso_values)
+  {
+    iso_ranges.push_back(vtkm::Range(iso, iso));
+  }
+
   const int num_domains = this->m_input->GetNumberOfDomains();
   for(int i = 0; i < num_domains; ++i)
   {
@@ -157,22 +170,33 @@ void MarchingCubes::DoExecute()
       continue;
     }
 
+    // skip domains and blocks of cells that no iso value passes through.
+    // A recentered field is gone after this filter, don't cache it
+    vtkm::cont::DataSet active;
+    if(!BlockRanges::Cull(dom,
+                          domain_id,
+                          m_field_name,
+                          iso_ranges,
+                          m_use_block_range_cache && !delete_input,
+                          active))
+    {
+      // contouring it would have produced an empty domain
+      this->m_output->AddDomain(BlockRanges::EmptyDomain(dom, this->GetFieldSelection()),
+                                domain_id);
+      continue;
+    }
+
     vtkh::vtkmMarchingCubes marcher;
 
-    auto dataset = marcher.Run(dom,
+    auto dataset = marcher.Run(active,
                                m_field_name,
                                m_iso_values,
                                this->GetFieldSelection());
 
-    temp_data.AddDomain(dataset, domain_id);
+    this->m_output->AddDomain(dataset, domain_id);
 
   }
 
-  CleanGrid cleaner;
-  cleaner.SetInput(&temp_data);
-  cleaner.Update();
-  this->m_output = cleaner.GetOutput();
-
   if(delete_input)
   {
     delete m_input;
@@ -19,6 +19,9 @@ public:
   void SetIsoValues(const double *iso_values, const int &num_values);
   void SetLevels(const int &levels);
   void SetUseContourTree(bool on);
+  // remember the block ranges of the field for other filters in this
+  // cycle, turn off for temporary fields
+  void SetUseBlockRangeCache(bool on);
   const std::vector<double>& GetIsoValues() const
   {
     return m_iso_values;
@@ -34,6 +37,7 @@ protected:
   std::string m_field_name;
   int m_levels;
   bool m_use_contour_tree;
+  bool m_use_block_range_cache;
 };
 
 } //namespace vtkh
@@ -1,7 +1,6 @@
 #include <vtkh/filters/Slice.hpp>
 #include <vtkh/Error.hpp>
 #include <vtkh/filters/MarchingCubes.hpp>
-#include <vtkh/filters/CleanGrid.hpp>
 #include <vtkh/filters/IsoVolume.hpp>
 #include <vtkh/vtkm_filters/vtkmClip.hpp>
 #include <vtkm/filter/contour/Slice.h>
@@ -657,6 +656,8 @@ Slice::DoExecute()
     marcher.SetInput(&temp_ds);
     marcher.SetIsoValue(0.);
     marcher.SetField(fname);
+    // the slice field only lives for this plane
+    marcher.SetUseBlockRangeCache(false);
     marcher.Update();
     slices.push_back(marcher.GetOutput());
   } // each slice
@@ -897,7 +898,6 @@ void SliceImplicit::PostExecute()
 void SliceImplicit::DoExecute()
 {
 
-  DataSet data_set;
   const int global_domains = this->m_input->GetGlobalNumberOfDomains();
   if(global_domains == 0)
   {
@@ -909,7 +909,7 @@ void SliceImplicit::DoExecute()
   }
 
   // TODO: Do we need to do anything special for multi plane?
-  
+  this->m_output = new DataSet();
   const int num_domains = this->m_input->GetNumberOfDomains();
   for(int i = 0; i < num_domains; ++i)
   {
@@ -920,14 +920,11 @@ void SliceImplicit::DoExecute()
     vtkm::filter::contour::Slice slicer;
     slicer.SetImplicitFunction(m_internals->m_func);
     slicer.SetFieldsToPass(this->GetFieldSelection());
+    // points on the same edge are shared by edge id, no clean pass needed
+    slicer.SetMergeDuplicatePoints(true);
     auto dataset = slicer.Execute(dom);
-    data_set.AddDomain(dataset, domain_id);
+    this->m_output->AddDomain(dataset, domain_id);
   }
-
-  CleanGrid cleaner;
-  cleaner.SetInput(&data_set);
-  cleaner.Update();
-  this->m_output = cleaner.GetOutput();
 }
 
 std::string
@@ -1102,6 +1099,8 @@ AutoSliceLevels::DoExecute()
     marcher.SetInput(&temp_ds);
     marcher.SetIsoValue(0.);
     marcher.SetField(fname);
+    // the slice field only lives for this plane
+    marcher.SetUseBlockRangeCache(false);
     marcher.Update();
     
     vtkh::DataSet* output = marcher.GetOutput();
@@ -1,11 +1,16 @@
 #include <vtkh/filters/Statistics.hpp>
-#include <vtkh/vtkm_filters/vtkmStatistics.hpp>
 #include <vtkh/Error.hpp>
 #include <vtkh/Logger.hpp>
-#include <vtkm/cont/Algorithm.h>
-#include <vtkm/cont/ArrayHandleCast.h>
-#include <vtkm/cont/Invoker.h>
+#include <vtkh/utils/QuantileSketch.hpp>
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandle.h>
 #include <vtkm/cont/PartitionedDataSet.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <sstream>
 #include <vector>
 
 #ifdef VTKH_PARALLEL
@@ -18,6 +23,402 @@ namespace vtkh
 namespace detail
 {
 
+// single pass central moments up to 4th order, see
+// Pebay, "Formulas for Robust, One-Pass Parallel Computation of
+// Covariances and Arbitrary-Order Statistical Moments", 2008
+struct Moments
+{
+  static constexpr int size = 8;
+
+  double m_n    = 0.;
+  double m_mean = 0.;
+  double m_m2   = 0.;
+  double m_m3   = 0.;
+  double m_m4   = 0.;
+  double m_min  = std::numeric_limits<double>::infinity();
+  double m_max  = -std::numeric_limits<double>::infinity();
+  double m_sum  = 0.;
+
+  void Add(const double x)
+  {
+    const double n1 = m_n;
+    m_n += 1.;
+    const double delta = x - m_mean;
+    const double delta_n = delta / m_n;
+    const double delta_n2 = delta_n * delta_n;
+    const double term1 = delta * delta_n * n1;
+    m_mean += delta_n;
+    m_m4 += term1 * delta_n2 * (m_n * m_n - 3. * m_n + 3.)
+          + 6. * delta_n2 * m_m2 - 4. * delta_n * m_m3;
+    m_m3 += term1 * delta_n * (m_n - 2.) - 3. * delta_n * m_m2;
+    m_m2 += term1;
+    m_min = std::min(m_min, x);
+    m_max = std::max(m_max, x);
+    m_sum += x;
+  }
+
+  void Merge(const Moments &other)
+  {
+    if(other.m_n == 0.)
+    {
+      return;
+    }
+    if(m_n == 0.)
+    {
+      *this = other;
+      return;
+    }
+    const double na = m_n;
+    const double nb = other.m_n;
+    const double n = na + nb;
+    const double delta = other.m_mean - m_mean;
+    const double delta2 = delta * delta;
+    const double delta3 = delta2 * delta;
+    const double delta4 = delta2 * delta2;
+
+    const double m4 = m_m4 + other.m_m4
+      + delta4 * na * nb * (na * na - na * nb + nb * nb) / (n * n * n)
+      + 6. * delta2 * (na * na * other.m_m2 + nb * nb * m_m2) / (n * n)
+      + 4. * delta * (na * other.m_m3 - nb * m_m3) / n;
+    const double m3 = m_m3 + other.m_m3
+      + delta3 * na * nb * (na - nb) / (n * n)
+      + 3. * delta * (na * other.m_m2 - nb * m_m2) / n;
+    const double m2 = m_m2 + other.m_m2 + delta2 * na * nb / n;
+
+    m_m4 = m4;
+    m_m3 = m3;
+    m_m2 = m2;
+    m_mean += delta * nb / n;
+    m_n = n;
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+    m_sum += other.m_sum;
+  }
+
+  void Serialize(std::vector<double> &buffer) const
+  {
+    const double vals[size] = {m_n, m_mean, m_m2, m_m3, m_m4, m_min, m_max, m_sum};
+    buffer.insert(buffer.end(), vals, vals + size);
+  }
+
+  void Deserialize(const double *buffer)
+  {
+    m_n    = buffer[0];
+    m_mean = buffer[1];
+    m_m2   = buffer[2];
+    m_m3   = buffer[3];
+    m_m4   = buffer[4];
+    m_min  = buffer[5];
+    m_max  = buffer[6];
+    m_sum  = buffer[7];
+  }
+};
+
+struct CoMoments
+{
+  static constexpr int size = 6;
+
+  double m_n      = 0.;
+  double m_mean_x = 0.;
+  double m_mean_y = 0.;
+  double m_m2_x   = 0.;
+  double m_m2_y   = 0.;
+  double m_c      = 0.;
+
+  void Add(const double x, const double y)
+  {
+    m_n += 1.;
+    const double dx = x - m_mean_x;
+    const double dy = y - m_mean_y;
+    m_mean_x += dx / m_n;
+    m_mean_y += dy / m_n;
+    m_c += dx * (y - m_mean_y);
+    m_m2_x += dx * (x - m_mean_x);
+    m_m2_y += dy * (y - m_mean_y);
+  }
+
+  void Merge(const CoMoments &other)
+  {
+    if(other.m_n == 0.)
+    {
+      return;
+    }
+    if(m_n == 0.)
+    {
+      *this = other;
+      return;
+    }
+    const double na = m_n;
+    const double nb = other.m_n;
+    const double n = na + nb;
+    const double dx = other.m_mean_x - m_mean_x;
+    const double dy = other.m_mean_y - m_mean_y;
+    m_c += other.m_c + dx * dy * na * nb / n;
+    m_m2_x += other.m_m2_x + dx * dx * na * nb / n;
+    m_m2_y += other.m_m2_y + dy * dy * na * nb / n;
+    m_mean_x += dx * nb / n;
+    m_mean_y += dy * nb / n;
+    m_n = n;
+  }
+
+  void Serialize(std::vector<double> &buffer) const
+  {
+    const double vals[size] = {m_n, m_mean_x, m_mean_y, m_m2_x, m_m2_y, m_c};
+    buffer.insert(buffer.end(), vals, vals + size);
+  }
+
+  void Deserialize(const double *buffer)
+  {
+    m_n      = buffer[0];
+    m_mean_x = buffer[1];
+    m_mean_y = buffer[2];
+    m_m2_x   = buffer[3];
+    m_m2_y   = buffer[4];
+    m_c      = buffer[5];
+  }
+};
+
+// all the partial state of one rank
+struct StatsState
+{
+  std::vector<Moments> m_moments;
+  // upper triangle, pair (i,j) with i < j
+  std::vector<CoMoments> m_co_moments;
+  std::vector<QuantileSketch> m_sketches;
+
+  StatsState(const int num_fields, const bool sketch)
+    : m_moments(num_fields),
+      m_co_moments(num_fields * (num_fields - 1) / 2)
+  {
+    if(sketch)
+    {
+      m_sketches.resize(num_fields);
+    }
+  }
+
+  static int PairIndex(const int i, const int j, const int num_fields)
+  {
+    // index into the upper triangle, i < j
+    return i * num_fields - i * (i + 1) / 2 + (j - i - 1);
+  }
+
+  void Merge(const StatsState &other)
+  {
+    for(size_t i = 0; i < m_moments.size(); ++i)
+    {
+      m_moments[i].Merge(other.m_moments[i]);
+    }
+    for(size_t i = 0; i < m_co_moments.size(); ++i)
+    {
+      m_co_moments[i].Merge(other.m_co_moments[i]);
+    }
+    for(size_t i = 0; i < m_sketches.size(); ++i)
+    {
+      m_sketches[i].Merge(other.m_sketches[i]);
+    }
+  }
+
+  void Serialize(std::vector<double> &buffer) const
+  {
+    for(const auto &m : m_moments) m.Serialize(buffer);
+    for(const auto &c : m_co_moments) c.Serialize(buffer);
+    for(const auto &s : m_sketches) s.Serialize(buffer);
+  }
+
+  void Deserialize(const double *buffer)
+  {
+    std::size_t pos = 0;
+    for(auto &m : m_moments)
+    {
+      m.Deserialize(buffer + pos);
+      pos += Moments::size;
+    }
+    for(auto &c : m_co_moments)
+    {
+      c.Deserialize(buffer + pos);
+      pos += CoMoments::size;
+    }
+    for(auto &s : m_sketches)
+    {
+      pos += s.Deserialize(buffer + pos);
+    }
+  }
+};
+
+void AccumulateDomain(vtkm::cont::DataSet &dom,
+                      const std::vector<std::string> &field_names,
+                      const std::string &ghost_field,
+                      StatsState &state)
+{
+  const int num_fields = static_cast<int>(field_names.size());
+
+  // the arrays are moved to the host in bulk once, the accumulators
+  // then walk raw pointers
+  vtkm::cont::ArrayHandle<vtkm::Int32> ghosts;
+  bool has_ghosts = false;
+  if(ghost_field != "" && dom.HasField(ghost_field))
+  {
+    vtkm::cont::ArrayCopyShallowIfPossible(dom.GetField(ghost_field).GetData(), ghosts);
+    has_ghosts = true;
+  }
+  auto ghost_portal = ghosts.ReadPortal();
+  const vtkm::Int32 *ghost_values = ghost_portal.GetArray();
+
+  // fields with the same association share an index space, so
+  // we walk each group once and feed every accumulator per value
+  std::map<vtkm::cont::Field::Association, std::vector<int>> groups;
+  std::vector<vtkm::cont::ArrayHandle<vtkm::Float64>> arrays(num_fields);
+  for(int f = 0; f < num_fields; ++f)
+  {
+    if(!dom.HasField(field_names[f]))
+    {
+      continue;
+    }
+    vtkm::cont::Field field = dom.GetField(field_names[f]);
+    vtkm::cont::ArrayCopyShallowIfPossible(field.GetData(), arrays[f]);
+    groups[field.GetAssociation()].push_back(f);
+  }
+
+  for(auto &group : groups)
+  {
+    const std::vector<int> &members = group.second;
+    const vtkm::Id size = arrays[members[0]].GetNumberOfValues();
+    const int num_members = static_cast<int>(members.size());
+
+    using PortalType = vtkm::cont::ArrayHandle<vtkm::Float64>::ReadPortalType;
+    std::vector<PortalType> portals;
+    std::vector<const vtkm::Float64*> values;
+    for(const int f : members)
+    {
+      if(arrays[f].GetNumberOfValues() != size)
+      {
+        std::stringstream msg;
+        msg<<"Statistics: field '"<<field_names[f]<<"' has "
+           <<arrays[f].GetNumberOfValues()<<" values but expected "<<size;
+        throw Error(msg.str());
+      }
+      portals.push_back(arrays[f].ReadPortal());
+      values.push_back(portals.back().GetArray());
+    }
+
+    const bool masked = has_ghosts &&
+                        group.first == vtkm::cont::Field::Association::Cells &&
+                        ghosts.GetNumberOfValues() == size;
+
+    const bool sketch = !state.m_sketches.empty();
+    for(vtkm::Id i = 0; i < size; ++i)
+    {
+      if(masked && ghost_values[i] != 0)
+      {
+        continue;
+      }
+      for(int a = 0; a < num_members; ++a)
+      {
+        const int fa = members[a];
+        const double x = values[a][i];
+        state.m_moments[fa].Add(x);
+        if(sketch)
+        {
+          state.m_sketches[fa].Insert(x);
+        }
+        // members are in field order, so fa < fb
+        for(int b = a + 1; b < num_members; ++b)
+        {
+          const int pair = StatsState::PairIndex(fa, members[b], num_fields);
+          state.m_co_moments[pair].Add(x, values[b][i]);
+        }
+      }
+    }
+  }
+}
+
+// binomial tree reduce to rank 0 followed by a broadcast of the merged
+// state, so no rank ever holds more than one other rank's sketches
+void GlobalMerge(StatsState &state)
+{
+#ifdef VTKH_PARALLEL
+  MPI_Comm mpi_comm = MPI_Comm_f2c(vtkh::GetMPICommHandle());
+  int procs;
+  int rank;
+  MPI_Comm_size(mpi_comm, &procs);
+  MPI_Comm_rank(mpi_comm, &rank);
+  if(procs == 1)
+  {
+    return;
+  }
+
+  const int num_fields = static_cast<int>(state.m_moments.size());
+  const bool sketch = !state.m_sketches.empty();
+  const int tag = 0;
+  std::vector<double> buffer;
+  // the merge order only depends on the number of ranks, so the answer
+  // is the same every time
+  for(int step = 1; step < procs; step *= 2)
+  {
+    if(rank % (2 * step) == step)
+    {
+      buffer.clear();
+      state.Serialize(buffer);
+      MPI_Send(buffer.data(), static_cast<int>(buffer.size()), MPI_DOUBLE,
+               rank - step, tag, mpi_comm);
+      break;
+    }
+    else if(rank % (2 * step) == 0 && rank + step < procs)
+    {
+      // sketches serialize to a variable size
+      MPI_Status status;
+      MPI_Probe(rank + step, tag, mpi_comm, &status);
+      int count;
+      MPI_Get_count(&status, MPI_DOUBLE, &count);
+      buffer.resize(count);
+      MPI_Recv(buffer.data(), count, MPI_DOUBLE, rank + step, tag,
+               mpi_comm, MPI_STATUS_IGNORE);
+      StatsState other(num_fields, sketch);
+      other.Deserialize(buffer.data());
+      state.Merge(other);
+    }
+  }
+
+  int size = 0;
+  if(rank == 0)
+  {
+    buffer.clear();
+    state.Serialize(buffer);
+    size = static_cast<int>(buffer.size());
+  }
+  MPI_Bcast(&size, 1, MPI_INT, 0, mpi_comm);
+  buffer.resize(size);
+  MPI_Bcast(buffer.data(), size, MPI_DOUBLE, 0, mpi_comm);
+  if(rank != 0)
+  {
+    StatsState global(num_fields, sketch);
+    global.Deserialize(buffer.data());
+    state = global;
+  }
+#else
+  (void) state;
+#endif
+}
+
+void AddScalar(vtkm::cont::DataSet &dom, const std::string &name, const double value)
+{
+  std::vector<vtkm::Float64> vals(1, value);
+  vtkm::cont::Field field(name,
+                          vtkm::cont::Field::Association::WholeDataSet,
+                          vtkm::cont::make_ArrayHandle(vals, vtkm::CopyFlag::On));
+  dom.AddField(field);
+}
+
+void AddArray(vtkm::cont::DataSet &dom,
+              const std::string &name,
+              const std::vector<vtkm::Float64> &vals)
+{
+  vtkm::cont::Field field(name,
+                          vtkm::cont::Field::Association::WholeDataSet,
+                          vtkm::cont::make_ArrayHandle(vals, vtkm::CopyFlag::On));
+  dom.AddField(field);
+}
+
 } // namespace detail
 
 Statistics::Statistics()
@@ -33,19 +434,65 @@ Statistics::~Statistics()
 void
 Statistics::SetField(const std::string &field_name)
 {
-  m_field_name = field_name;
+  m_field_names.clear();
+  m_field_names.push_back(field_name);
+}
+
+void
+Statistics::AddField(const std::string &field_name)
+{
+  m_field_names.push_back(field_name);
+}
+
+void
+Statistics::SetFields(const std::vector<std::string> &field_names)
+{
+  m_field_names = field_names;
 }
 
 std::string
 Statistics::GetField() const
 {
-  return m_field_name;
+  if(m_field_names.empty())
+  {
+    return "";
+  }
+  return m_field_names[0];
+}
+
+void
+Statistics::SetPercentiles(const std::vector<vtkm::Float64> &percentiles)
+{
+  for(const vtkm::Float64 p : percentiles)
+  {
+    if(p < 0. || p > 100.)
+    {
+      throw Error("Statistics: percentiles must be in the range [0,100]");
+    }
+  }
+  m_percentiles = percentiles;
+}
+
+void
+Statistics::SetGhostField(const std::string &ghost_field)
+{
+  m_ghost_field = ghost_field;
+}
+
+const Statistics::Result &
+Statistics::GetResult() const
+{
+  return m_result;
 }
 
 void
 Statistics::PreExecute()
 {
   Filter::PreExecute();
+  if(m_field_names.empty())
+  {
+    throw Error("Statistics: no fields specified");
+  }
 }
 
 void
@@ -60,42 +507,113 @@ void Statistics::DoExecute()
   VTKH_DATA_ADD("device", GetCurrentDevice());
   VTKH_DATA_ADD("input_cells", this->m_input->GetNumberOfCells());
   VTKH_DATA_ADD("input_domains", this->m_input->GetNumberOfDomains());
+  VTKH_DATA_ADD("fields", m_field_names.size());
   const int num_domains = this->m_input->GetNumberOfDomains();
+  const int num_fields = static_cast<int>(m_field_names.size());
   this->m_output = new DataSet();
 
-  if(!this->m_input->GlobalFieldExists(m_field_name))
+  for(const std::string &field_name : m_field_names)
   {
-    throw Error("Statistics: field : '"+m_field_name+"' does not exist'");
+    if(!this->m_input->GlobalFieldExists(field_name))
+    {
+      throw Error("Statistics: field : '"+field_name+"' does not exist'");
+    }
+    if(this->m_input->NumberOfComponents(field_name) != 1)
+    {
+      throw Error("Statistics: field : '"+field_name+"' must be a scalar");
+    }
   }
 
-  std::vector<vtkm::cont::DataSet> vtkm_ds;
+  detail::StatsState state(num_fields, !m_percentiles.empty());
 
-  
   for(int i = 0; i < num_domains; ++i)
   {
     vtkm::Id domain_id;
     vtkm::cont::DataSet dom;
     this->m_input->GetDomain(i, dom, domain_id);
-    if(dom.HasField(m_field_name))
+    detail::AccumulateDomain(dom, m_field_names, m_ghost_field, state);
+  }
+
+  detail::GlobalMerge(state);
+
+  m_result = Result();
+  m_result.m_percentiles = m_percentiles;
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+
+  for(int f = 0; f < num_fields; ++f)
+  {
+    const detail::Moments &m = state.m_moments[f];
+    FieldResult res;
+    res.m_name = m_field_names[f];
+    res.m_count = static_cast<vtkm::Id>(m.m_n);
+    res.m_min = m.m_n > 0 ? m.m_min : nan;
+    res.m_max = m.m_n > 0 ? m.m_max : nan;
+    res.m_sum = m.m_sum;
+    res.m_mean = m.m_n > 0 ? m.m_mean : nan;
+    res.m_population_variance = m.m_n > 0 ? m.m_m2 / m.m_n : nan;
+    res.m_sample_variance = m.m_n > 1 ? m.m_m2 / (m.m_n - 1.) : nan;
+    res.m_skewness = m.m_m2 > 0 ? std::sqrt(m.m_n) * m.m_m3 / std::pow(m.m_m2, 1.5) : nan;
+    res.m_kurtosis = m.m_m2 > 0 ? m.m_n * m.m_m4 / (m.m_m2 * m.m_m2) : nan;
+    for(const vtkm::Float64 p : m_percentiles)
     {
-      vtkm_ds.push_back(dom);
+      res.m_percentiles.push_back(state.m_sketches[f].Quantile(p / 100.));
     }
+    m_result.m_fields.push_back(res);
   }
 
-  vtkm::cont::PartitionedDataSet data_pds(vtkm_ds);
-  vtkmStatistics stats;
-  auto result = stats.Run(data_pds, m_field_name);
+  if(num_fields > 1)
+  {
+    m_result.m_covariance.resize(num_fields * num_fields, nan);
+    m_result.m_correlation.resize(num_fields * num_fields, nan);
+    for(int a = 0; a < num_fields; ++a)
+    {
+      m_result.m_covariance[a * num_fields + a] = m_result.m_fields[a].m_sample_variance;
+      m_result.m_correlation[a * num_fields + a] = 1.;
+      for(int b = a + 1; b < num_fields; ++b)
+      {
+        const detail::CoMoments &c =
+          state.m_co_moments[detail::StatsState::PairIndex(a, b, num_fields)];
+        if(c.m_n < 2.)
+        {
+          continue;
+        }
+        const double cov = c.m_c / (c.m_n - 1.);
+        const double denom = std::sqrt(c.m_m2_x * c.m_m2_y);
+        const double corr = denom > 0. ? c.m_c / denom : nan;
+        m_result.m_covariance[a * num_fields + b] = cov;
+        m_result.m_covariance[b * num_fields + a] = cov;
+        m_result.m_correlation[a * num_fields + b] = corr;
+        m_result.m_correlation[b * num_fields + a] = corr;
+      }
+    }
+  }
 
-  int size = result.GetNumberOfFields();
+  // keep the single field output names the same as before,
+  // and prefix them with the field name when there are several
   vtkm::cont::DataSet dom;
-  
-  for(int i = 0; i < size; i++)
-  {
-    //g_field will have assoc=Global which only goes with vtkm::PDS
-    //convert to new field with assoc=WholeDataSet to put in vtkm::DS
-    vtkm::cont::Field g_field = result.GetField(i);
-    vtkm::cont::Field field(g_field.GetName(),vtkm::cont::Field::Association::WholeDataSet,g_field.GetData());
-    dom.AddField(field);
+  for(const FieldResult &res : m_result.m_fields)
+  {
+    const std::string prefix = num_fields > 1 ? res.m_name + "_" : "";
+    detail::AddScalar(dom, prefix + "N", double(res.m_count));
+    detail::AddScalar(dom, prefix + "Min", res.m_min);
+    detail::AddScalar(dom, prefix + "Max", res.m_max);
+    detail::AddScalar(dom, prefix + "Sum", res.m_sum);
+    detail::AddScalar(dom, prefix + "Mean", res.m_mean);
+    detail::AddScalar(dom, prefix + "SampleStddev", std::sqrt(res.m_sample_variance));
+    detail::AddScalar(dom, prefix + "PopulationStddev", std::sqrt(res.m_population_variance));
+    detail::AddScalar(dom, prefix + "SampleVariance", res.m_sample_variance);
+    detail::AddScalar(dom, prefix + "PopulationVariance", res.m_population_variance);
+    detail::AddScalar(dom, prefix + "Skewness", res.m_skewness);
+    detail::AddScalar(dom, prefix + "Kurtosis", res.m_kurtosis);
+    if(!res.m_percentiles.empty())
+    {
+      detail::AddArray(dom, prefix + "Percentiles", res.m_percentiles);
+    }
+  }
+  if(num_fields > 1)
+  {
+    detail::AddArray(dom, "Covariance", m_result.m_covariance);
+    detail::AddArray(dom, "Correlation", m_result.m_correlation);
   }
   this->m_output->AddDomain(dom,0);
 
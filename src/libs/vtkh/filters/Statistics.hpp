@@ -6,25 +6,68 @@
 #include <vtkh/DataSet.hpp>
 #include <vtkh/filters/Filter.hpp>
 
+#include <string>
+#include <vector>
+
 namespace vtkh
 {
 
+// Computes moments, percentiles and the covariance / correlation matrix
+// of any number of scalar fields in a single pass over the data and a
+// single collective. Percentiles come from mergeable quantile sketches
+// and are approximate.
 class VTKH_API Statistics: public Filter
 {
 public:
+  struct FieldResult
+  {
+    std::string m_name;
+    vtkm::Id m_count;
+    vtkm::Float64 m_min;
+    vtkm::Float64 m_max;
+    vtkm::Float64 m_sum;
+    vtkm::Float64 m_mean;
+    vtkm::Float64 m_sample_variance;
+    vtkm::Float64 m_population_variance;
+    vtkm::Float64 m_skewness;
+    vtkm::Float64 m_kurtosis;
+    // matches the requested percentiles
+    std::vector<vtkm::Float64> m_percentiles;
+  };
+
+  struct Result
+  {
+    std::vector<FieldResult> m_fields;
+    std::vector<vtkm::Float64> m_percentiles;
+    // row major, num_fields x num_fields. Only pairs of fields with
+    // the same association contribute, others are NaN
+    std::vector<vtkm::Float64> m_covariance;
+    std::vector<vtkm::Float64> m_correlation;
+  };
+
   Statistics();
   virtual ~Statistics();
   std::string GetName() const override;
 
   void SetField(const std::string &field_name);
+  void AddField(const std::string &field_name);
+  void SetFields(const std::vector<std::string> &field_names);
   std::string GetField() const;
+  // percentiles in [0,100]
+  void SetPercentiles(const std::vector<vtkm::Float64> &percentiles);
+  // zones with a non-zero ghost value are left out of zonal fields
+  void SetGhostField(const std::string &ghost_field);
+
+  const Result &GetResult() const;
 protected:
   void PreExecute() override;
   void PostExecute() override;
   void DoExecute() override;
 
-  std::string m_field_name;
-
+  std::vector<std::string> m_field_names;
+  std::vector<vtkm::Float64> m_percentiles;
+  std::string m_ghost_field;
+  Result m_result;
 };
 
 } //namespace vtkh
@@ -0,0 +1,270 @@
+#include <vtkh/filters/TemporalAccumulate.hpp>
+#include <vtkh/Error.hpp>
+#include <vtkh/Logger.hpp>
+
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/worklet/DispatcherMapField.h>
+#include <vtkm/worklet/WorkletMapField.h>
+#include <vtkm/Math.h>
+
+#include <limits>
+
+namespace vtkh
+{
+
+namespace detail
+{
+
+class AccumulateValues : public vtkm::worklet::WorkletMapField
+{
+protected:
+  vtkm::Float64 m_count;
+  vtkm::Float64 m_alpha;
+public:
+  VTKM_CONT
+  AccumulateValues(const vtkm::Id count, const vtkm::Float64 alpha)
+    : m_count(static_cast<vtkm::Float64>(count)),
+      m_alpha(alpha)
+  {
+  }
+
+  typedef void ControlSignature(FieldIn, FieldInOut, FieldInOut,
+                                FieldInOut, FieldInOut, FieldInOut);
+  typedef void ExecutionSignature(_1, _2, _3, _4, _5, _6);
+
+  template<typename T>
+  VTKM_EXEC
+  void operator()(const T &value,
+                  vtkm::Float64 &mean,
+                  vtkm::Float64 &m2,
+                  vtkm::Float64 &min,
+                  vtkm::Float64 &max,
+                  vtkm::Float64 &ema) const
+  {
+    const vtkm::Float64 x = static_cast<vtkm::Float64>(value);
+    // Welford
+    const vtkm::Float64 delta = x - mean;
+    mean += delta / m_count;
+    m2 += delta * (x - mean);
+    min = vtkm::Min(min, x);
+    max = vtkm::Max(max, x);
+    ema = m_count == 1. ? x : m_alpha * x + (1. - m_alpha) * ema;
+  }
+}; //class AccumulateValues
+
+class SampleVariance : public vtkm::worklet::WorkletMapField
+{
+protected:
+  vtkm::Float64 m_count;
+public:
+  VTKM_CONT
+  SampleVariance(const vtkm::Id count)
+    : m_count(static_cast<vtkm::Float64>(count))
+  {
+  }
+
+  typedef void ControlSignature(FieldIn, FieldOut);
+  typedef void ExecutionSignature(_1, _2);
+
+  VTKM_EXEC
+  void operator()(const vtkm::Float64 &m2, vtkm::Float64 &variance) const
+  {
+    variance = m_count > 1. ? m2 / (m_count - 1.) : 0.;
+  }
+}; //class SampleVariance
+
+void ResetDomain(TemporalAccumulate::State::Domain &state,
+                 const vtkm::Id size,
+                 const vtkm::cont::Field::Association assoc)
+{
+  state.m_count = 0;
+  state.m_size = size;
+  state.m_assoc = assoc;
+  state.m_mean.AllocateAndFill(size, 0.);
+  state.m_m2.AllocateAndFill(size, 0.);
+  state.m_min.AllocateAndFill(size, std::numeric_limits<vtkm::Float64>::infinity());
+  state.m_max.AllocateAndFill(size, -std::numeric_limits<vtkm::Float64>::infinity());
+  state.m_ema.AllocateAndFill(size, 0.);
+}
+
+// the running arrays are updated in place on the next execution,
+// so outputs get their own copy
+vtkm::cont::ArrayHandle<vtkm::Float64>
+Snapshot(const vtkm::cont::ArrayHandle<vtkm::Float64> &running)
+{
+  vtkm::cont::ArrayHandle<vtkm::Float64> copy;
+  vtkm::cont::ArrayCopy(running, copy);
+  return copy;
+}
+
+} // namespace detail
+
+TemporalAccumulate::TemporalAccumulate()
+  : m_alpha(0.1)
+{
+  m_outputs = {"mean", "variance", "min", "max", "ema"};
+}
+
+TemporalAccumulate::~TemporalAccumulate()
+{
+
+}
+
+void
+TemporalAccumulate::SetField(const std::string &field_name)
+{
+  m_field_name = field_name;
+}
+
+void
+TemporalAccumulate::SetResultPrefix(const std::string &prefix)
+{
+  m_prefix = prefix;
+}
+
+void
+TemporalAccumulate::SetAlpha(const vtkm::Float64 alpha)
+{
+  if(alpha <= 0. || alpha > 1.)
+  {
+    throw Error("TemporalAccumulate: alpha must be in the range (0,1]");
+  }
+  m_alpha = alpha;
+}
+
+void
+TemporalAccumulate::SetOutputs(const std::vector<std::string> &outputs)
+{
+  for(const std::string &output : outputs)
+  {
+    if(output != "mean" && output != "variance" && output != "min" &&
+       output != "max" && output != "ema" && output != "count")
+    {
+      throw Error("TemporalAccumulate: unknown output '" + output + "'");
+    }
+  }
+  m_outputs = outputs;
+}
+
+void
+TemporalAccumulate::SetState(std::shared_ptr<State> state)
+{
+  m_state = state;
+}
+
+void
+TemporalAccumulate::PreExecute()
+{
+  Filter::PreExecute();
+  Filter::CheckForRequiredField(m_field_name);
+  if(m_input->NumberOfComponents(m_field_name) != 1)
+  {
+    throw Error("TemporalAccumulate: field '" + m_field_name + "' must be a scalar");
+  }
+  if(m_prefix == "")
+  {
+    m_prefix = m_field_name;
+  }
+  if(m_state == nullptr)
+  {
+    // nothing to carry over, every execution starts fresh
+    m_state = std::make_shared<State>();
+  }
+}
+
+void
+TemporalAccumulate::PostExecute()
+{
+  Filter::PostExecute();
+}
+
+void
+TemporalAccumulate::DoExecute()
+{
+  VTKH_DATA_OPEN("temporal_accumulate");
+  this->m_output = new DataSet();
+
+  const int num_domains = this->m_input->GetNumberOfDomains();
+
+  for(int i = 0; i < num_domains; ++i)
+  {
+    vtkm::Id domain_id;
+    vtkm::cont::DataSet dom;
+    this->m_input->GetDomain(i, dom, domain_id);
+
+    if(!dom.HasField(m_field_name))
+    {
+      m_output->AddDomain(dom, domain_id);
+      continue;
+    }
+
+    vtkm::cont::Field field = dom.GetField(m_field_name);
+    const vtkm::Id size = field.GetNumberOfValues();
+    const vtkm::cont::Field::Association assoc = field.GetAssociation();
+
+    State::Domain &state = m_state->m_domains[domain_id];
+    if(state.m_count == 0 || state.m_size != size || state.m_assoc != assoc)
+    {
+      // new domain or the mesh changed under us
+      detail::ResetDomain(state, size, assoc);
+    }
+    state.m_count++;
+
+    vtkm::worklet::DispatcherMapField<detail::AccumulateValues>(
+        detail::AccumulateValues(state.m_count, m_alpha))
+      .Invoke(field.GetData().ResetTypes(vtkm::TypeListFieldScalar(),
+                                         VTKM_DEFAULT_STORAGE_LIST{}),
+              state.m_mean,
+              state.m_m2,
+              state.m_min,
+              state.m_max,
+              state.m_ema);
+
+    for(const std::string &output : m_outputs)
+    {
+      const std::string name = m_prefix + "_" + output;
+      if(output == "mean")
+      {
+        dom.AddField(vtkm::cont::Field(name, assoc, detail::Snapshot(state.m_mean)));
+      }
+      else if(output == "variance")
+      {
+        vtkm::cont::ArrayHandle<vtkm::Float64> variance;
+        vtkm::worklet::DispatcherMapField<detail::SampleVariance>(
+            detail::SampleVariance(state.m_count))
+          .Invoke(state.m_m2, variance);
+        dom.AddField(vtkm::cont::Field(name, assoc, variance));
+      }
+      else if(output == "min")
+      {
+        dom.AddField(vtkm::cont::Field(name, assoc, detail::Snapshot(state.m_min)));
+      }
+      else if(output == "max")
+      {
+        dom.AddField(vtkm::cont::Field(name, assoc, detail::Snapshot(state.m_max)));
+      }
+      else if(output == "ema")
+      {
+        dom.AddField(vtkm::cont::Field(name, assoc, detail::Snapshot(state.m_ema)));
+      }
+      else if(output == "count")
+      {
+        vtkm::cont::ArrayHandle<vtkm::Float64> count;
+        count.AllocateAndFill(size, static_cast<vtkm::Float64>(state.m_count));
+        dom.AddField(vtkm::cont::Field(name, assoc, count));
+      }
+    }
+
+    m_output->AddDomain(dom, domain_id);
+  }
+
+  VTKH_DATA_CLOSE();
+}
+
+std::string
+TemporalAccumulate::GetName() const
+{
+  return "vtkh::TemporalAccumulate";
+}
+
+} //  namespace vtkh
@@ -0,0 +1,66 @@
+#ifndef VTK_H_TEMPORAL_ACCUMULATE_HPP
+#define VTK_H_TEMPORAL_ACCUMULATE_HPP
+
+#include <vtkh/vtkh_exports.h>
+#include <vtkh/vtkh.hpp>
+#include <vtkh/filters/Filter.hpp>
+#include <vtkh/DataSet.hpp>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace vtkh
+{
+
+// Keeps running per-value statistics of a field across executions:
+// Welford mean / variance, min, max and an exponential moving average.
+// The running state lives in device arrays inside a State object that
+// the caller keeps alive between executions.
+class VTKH_API TemporalAccumulate : public Filter
+{
+public:
+  struct State
+  {
+    struct Domain
+    {
+      vtkm::Id m_count = 0;
+      vtkm::Id m_size = 0;
+      vtkm::cont::Field::Association m_assoc;
+      vtkm::cont::ArrayHandle<vtkm::Float64> m_mean;
+      vtkm::cont::ArrayHandle<vtkm::Float64> m_m2;
+      vtkm::cont::ArrayHandle<vtkm::Float64> m_min;
+      vtkm::cont::ArrayHandle<vtkm::Float64> m_max;
+      vtkm::cont::ArrayHandle<vtkm::Float64> m_ema;
+    };
+    // keyed by domain id
+    std::map<vtkm::Id, Domain> m_domains;
+  };
+
+  TemporalAccumulate();
+  virtual ~TemporalAccumulate();
+  std::string GetName() const override;
+
+  void SetField(const std::string &field_name);
+  // prefix of the output fields, defaults to the field name
+  void SetResultPrefix(const std::string &prefix);
+  // weight of the newest value in the moving average, in (0,1]
+  void SetAlpha(const vtkm::Float64 alpha);
+  // any of "mean", "variance", "min", "max", "ema" and "count"
+  void SetOutputs(const std::vector<std::string> &outputs);
+  void SetState(std::shared_ptr<State> state);
+protected:
+  void PreExecute() override;
+  void PostExecute() override;
+  void DoExecute() override;
+
+  std::string m_field_name;
+  std::string m_prefix;
+  vtkm::Float64 m_alpha;
+  std::vector<std::string> m_outputs;
+  std::shared_ptr<State> m_state;
+};
+
+} //namespace vtkh
+#endif
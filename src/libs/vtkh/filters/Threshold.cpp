@@ -334,6 +334,8 @@ Threshold::DoExecute()
     }
   }
 
+  // thresholded cells keep the input point ids, cleaning only
+  // compacts the points that are still used
   CleanGrid cleaner;
   cleaner.SetInput(&temp_data);
   cleaner.Update();
@@ -245,6 +245,7 @@ Render::Copy() const
   copy.m_canvas = CreateCanvas();
   copy.m_world_annotation_scale = m_world_annotation_scale;
   copy.m_color_bar_position = m_color_bar_position;
+  copy.m_png = m_png;
   return copy;
 }
 
@@ -317,6 +318,30 @@ Render::Save()
   ascent::PNGEncoder encoder;
   encoder.Encode(color_buffer, width, height, m_comments);
   encoder.Save(m_image_name + ".png");
+  if(m_png)
+  {
+    const unsigned char *png_ptr = (const unsigned char*) encoder.PngBuffer();
+    m_png->assign(png_ptr, png_ptr + encoder.PngBufferSize());
+  }
+}
+
+void
+Render::SetKeepPNG(bool on)
+{
+  if(!on)
+  {
+    m_png.reset();
+  }
+  else if(!m_png)
+  {
+    m_png = std::make_shared<std::vector<unsigned char>>();
+  }
+}
+
+const std::vector<unsigned char>*
+Render::GetPNG() const
+{
+  return m_png.get();
 }
 
 vtkh::Render
@@ -1,6 +1,7 @@
 #ifndef VTK_H_RENDER_HPP
 #define VTK_H_RENDER_HPP
 
+#include <memory>
 #include <vector>
 #include <vtkh/vtkh_exports.h>
 #include <vtkh/DataSet.hpp>
@@ -61,6 +62,10 @@ public:
                                                           const std::vector<vtkm::cont::ColorTable> &colors,
                                                           const std::vector<int> &is_discrete);
   void                            Save();
+  // keep the encoded png in memory when Save is called.
+  // copies of this render share the buffer
+  void                            SetKeepPNG(bool on);
+  const std::vector<unsigned char>* GetPNG() const;
 protected:
   vtkm::rendering::Camera      m_camera;
   std::string                  m_image_name;
@@ -79,6 +84,7 @@ protected:
   bool                         m_shading;
   vtkmCanvas                   m_canvas;
   vtkm::Vec<float,3>           m_world_annotation_scale;
+  std::shared_ptr<std::vector<unsigned char>> m_png;
 };
 
 static float vtkh_default_bg_color[4] = {0.f, 0.f, 0.f, 1.f};
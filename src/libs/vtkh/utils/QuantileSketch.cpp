@@ -0,0 +1,222 @@
+#include <vtkh/utils/QuantileSketch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace vtkh
+{
+
+QuantileSketch::QuantileSketch(const int k)
+  : m_k(std::max(k, 8)),
+    m_count(0),
+    m_retained(0),
+    m_max_retained(0),
+    m_odd(false),
+    m_levels(1)
+{
+  m_levels[0].reserve(m_k);
+  UpdateCapacity();
+}
+
+std::size_t
+QuantileSketch::Capacity(const std::size_t level) const
+{
+  // lower levels shrink geometrically so the total size stays O(k)
+  const std::size_t depth = m_levels.size() - 1 - level;
+  const double cap = std::ceil(m_k * std::pow(2.0 / 3.0, double(depth)));
+  return std::max(std::size_t(2), static_cast<std::size_t>(cap));
+}
+
+void
+QuantileSketch::UpdateCapacity()
+{
+  m_max_retained = 0;
+  for(std::size_t level = 0; level < m_levels.size(); ++level)
+  {
+    m_max_retained += Capacity(level);
+  }
+}
+
+void
+QuantileSketch::Insert(const double value)
+{
+  if(std::isnan(value))
+  {
+    return;
+  }
+  m_levels[0].push_back(value);
+  m_count++;
+  m_retained++;
+  // level 0 may run past its own capacity while higher levels have room,
+  // compacting only once the whole sketch is full keeps inserts cheap
+  if(m_retained >= m_max_retained)
+  {
+    Compress();
+  }
+}
+
+void
+QuantileSketch::Insert(const double *values, const std::size_t size)
+{
+  for(std::size_t i = 0; i < size; ++i)
+  {
+    Insert(values[i]);
+  }
+}
+
+void
+QuantileSketch::Compress()
+{
+  while(m_retained >= m_max_retained)
+  {
+    // when the sketch is full at least one level is at its capacity,
+    // compact the lowest one
+    std::size_t level = 0;
+    while(m_levels[level].size() < Capacity(level))
+    {
+      level++;
+    }
+
+    if(level + 1 == m_levels.size())
+    {
+      m_levels.emplace_back();
+      UpdateCapacity();
+    }
+
+    std::vector<double> &items = m_levels[level];
+    std::sort(items.begin(), items.end());
+
+    // an odd item out stays behind at this level
+    double leftover = 0.;
+    const bool has_leftover = items.size() % 2 == 1;
+    if(has_leftover)
+    {
+      leftover = items.back();
+      items.pop_back();
+    }
+
+    std::vector<double> &next = m_levels[level + 1];
+    const std::size_t offset = m_odd ? 1 : 0;
+    m_odd = !m_odd;
+    for(std::size_t i = offset; i < items.size(); i += 2)
+    {
+      next.push_back(items[i]);
+    }
+
+    m_retained -= items.size() / 2;
+    items.clear();
+    if(has_leftover)
+    {
+      items.push_back(leftover);
+    }
+  }
+}
+
+void
+QuantileSketch::Merge(const QuantileSketch &other)
+{
+  if(other.m_levels.size() > m_levels.size())
+  {
+    m_levels.resize(other.m_levels.size());
+    UpdateCapacity();
+  }
+  for(std::size_t level = 0; level < other.m_levels.size(); ++level)
+  {
+    m_levels[level].insert(m_levels[level].end(),
+                           other.m_levels[level].begin(),
+                           other.m_levels[level].end());
+  }
+  m_count += other.m_count;
+  m_retained += other.m_retained;
+  Compress();
+}
+
+double
+QuantileSketch::Quantile(const double q) const
+{
+  std::vector<std::pair<double, std::uint64_t>> weighted;
+  std::uint64_t total = 0;
+  for(std::size_t level = 0; level < m_levels.size(); ++level)
+  {
+    const std::uint64_t weight = std::uint64_t(1) << level;
+    for(const double value : m_levels[level])
+    {
+      weighted.emplace_back(value, weight);
+      total += weight;
+    }
+  }
+
+  if(weighted.empty())
+  {
+    return 0.;
+  }
+
+  std::sort(weighted.begin(), weighted.end());
+
+  const double clamped = std::min(std::max(q, 0.0), 1.0);
+  const double target = clamped * double(total);
+  std::uint64_t running = 0;
+  for(const auto &item : weighted)
+  {
+    running += item.second;
+    if(double(running) >= target)
+    {
+      return item.first;
+    }
+  }
+  return weighted.back().first;
+}
+
+std::uint64_t
+QuantileSketch::Count() const
+{
+  return m_count;
+}
+
+bool
+QuantileSketch::Empty() const
+{
+  return m_count == 0;
+}
+
+void
+QuantileSketch::Serialize(std::vector<double> &buffer) const
+{
+  // layout: k, count, num_levels, (level size, level items)...
+  buffer.push_back(double(m_k));
+  buffer.push_back(double(m_count));
+  buffer.push_back(double(m_levels.size()));
+  for(const auto &items : m_levels)
+  {
+    buffer.push_back(double(items.size()));
+    buffer.insert(buffer.end(), items.begin(), items.end());
+  }
+}
+
+std::size_t
+QuantileSketch::Deserialize(const double *buffer)
+{
+  std::size_t pos = 0;
+  m_k = static_cast<int>(buffer[pos++]);
+  m_count = static_cast<std::uint64_t>(buffer[pos++]);
+  const std::size_t num_levels = static_cast<std::size_t>(buffer[pos++]);
+  m_levels.clear();
+  m_levels.resize(num_levels);
+  m_retained = 0;
+  for(std::size_t level = 0; level < num_levels; ++level)
+  {
+    const std::size_t size = static_cast<std::size_t>(buffer[pos++]);
+    m_levels[level].assign(buffer + pos, buffer + pos + size);
+    m_retained += size;
+    pos += size;
+  }
+  if(m_levels.empty())
+  {
+    m_levels.resize(1);
+  }
+  UpdateCapacity();
+  return pos;
+}
+
+} //namespace vtkh
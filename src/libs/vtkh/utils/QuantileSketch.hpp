@@ -0,0 +1,50 @@
+#ifndef VTK_H_QUANTILE_SKETCH_HPP
+#define VTK_H_QUANTILE_SKETCH_HPP
+
+#include <vtkh/vtkh_exports.h>
+#include <cstdint>
+#include <vector>
+
+namespace vtkh
+{
+
+// Mergeable streaming quantile sketch (KLL). Memory is O(k) no matter
+// how many values are inserted, rank error is roughly 1.7/k, and two
+// sketches built over disjoint data merge into a sketch of the union.
+class VTKH_API QuantileSketch
+{
+public:
+  explicit QuantileSketch(const int k = 200);
+
+  void Insert(const double value);
+  void Insert(const double *values, const std::size_t size);
+  void Merge(const QuantileSketch &other);
+
+  // q in [0,1]. Returns 0 if the sketch is empty
+  double Quantile(const double q) const;
+  std::uint64_t Count() const;
+  bool Empty() const;
+
+  // flat representation used to ship sketches between ranks
+  void Serialize(std::vector<double> &buffer) const;
+  // returns the number of doubles consumed
+  std::size_t Deserialize(const double *buffer);
+private:
+  std::size_t Capacity(const std::size_t level) const;
+  void UpdateCapacity();
+  void Compress();
+
+  int m_k;
+  std::uint64_t m_count;
+  // items held over all levels and how many fit before compacting
+  std::size_t m_retained;
+  std::size_t m_max_retained;
+  // flips every compaction so that items promoted from even
+  // and odd positions balance out
+  bool m_odd;
+  std::vector<std::vector<double>> m_levels;
+};
+
+} //namespace vtkh
+
+#endif //VTK_H_QUANTILE_SKETCH_HPP
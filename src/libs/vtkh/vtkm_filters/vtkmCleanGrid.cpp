@@ -10,13 +10,21 @@ vtkmCleanGrid::tolerance(const vtkm::Float64 tol)
   m_tolerance = tol;
 }
 
+void
+vtkmCleanGrid::merge_points(const bool on)
+{
+  m_merge_points = on;
+}
+
 vtkm::cont::DataSet
 vtkmCleanGrid::Run(vtkm::cont::DataSet &input,
                    vtkm::filter::FieldSelection map_fields)
 {
   vtkm::filter::clean_grid::CleanGrid cleaner;
 
-  if(m_tolerance != -1.)
+  // without merging this only drops unused points and degenerate cells
+  cleaner.SetMergePoints(m_merge_points);
+  if(m_merge_points && m_tolerance != -1.)
   {
     cleaner.SetTolerance(m_tolerance);
     cleaner.SetToleranceIsAbsolute(true);
@@ -11,8 +11,12 @@ class vtkmCleanGrid
 {
 protected:
   vtkm::Float64 m_tolerance = -1.;
+  bool m_merge_points = false;
 public:
   void tolerance(const vtkm::Float64 tol);
+  // spatial point merging, off by default. Filters already share the
+  // points they generate, so cleaning only compacts the points
+  void merge_points(const bool on);
 
   vtkm::cont::DataSet Run(vtkm::cont::DataSet &input,
                           vtkm::filter::FieldSelection map_fields);
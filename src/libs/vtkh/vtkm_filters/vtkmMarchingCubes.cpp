@@ -13,7 +13,8 @@ vtkmMarchingCubes::Run(vtkm::cont::DataSet &input,
 
   marcher.SetFieldsToPass(map_fields);
   marcher.SetIsoValues(iso_values);
-  marcher.SetMergeDuplicatePoints(false);
+  // points on the same edge are shared by edge id, no clean pass needed
+  marcher.SetMergeDuplicatePoints(true);
   marcher.SetActiveField(field_name);
 
   auto output = marcher.Execute(input);
@@ -20,6 +20,7 @@
 #include <apcomp/apcomp.hpp>
 #include <apcomp/partial_compositor.hpp>
 
+#include <algorithm>
 #include <iostream>
 
 using namespace std;
@@ -69,3 +70,67 @@ TEST(apcomp_partials, apcomp_volume_partial)
   EXPECT_TRUE(check_test_image(output_file, t_apcomp_baseline_dir()));
 }
 
+
+//-----------------------------------------------------------------------------
+TEST(apcomp_partials, apcomp_volume_partial_sort_order)
+{
+  // enough partials to take the radix sort path, with several
+  // partials per pixel and negative depths
+  const int num_pixels = 5000;
+  const int per_pixel = 8;
+  const int num_images = 3;
+
+  std::vector<std::vector<apcomp::VolumePartial<float>>> in_partials;
+  in_partials.resize(num_images);
+  std::vector<apcomp::VolumePartial<float>> all;
+
+  unsigned int seed = 7;
+  for(int p = 0; p < num_pixels; ++p)
+  {
+    for(int i = 0; i < per_pixel; ++i)
+    {
+      seed = seed * 1103515245u + 12345u;
+      apcomp::VolumePartial<float> partial;
+      partial.m_pixel_id = 100 + p * 3;
+      // distinct depths within a pixel, in scrambled order
+      partial.m_depth = float(((i * 5 + p) % per_pixel) - 4) * 0.5f;
+      partial.m_pixel[0] = float(seed % 7u) / 14.f;
+      partial.m_pixel[1] = float(seed % 5u) / 10.f;
+      partial.m_pixel[2] = float(seed % 3u) / 6.f;
+      partial.m_alpha = 0.25f;
+      in_partials[(p + i) % num_images].push_back(partial);
+      all.push_back(partial);
+    }
+  }
+
+  // reference result
+  std::stable_sort(all.begin(), all.end());
+  std::vector<apcomp::VolumePartial<float>> expected;
+  for(size_t i = 0; i < all.size(); ++i)
+  {
+    if(expected.size() == 0 ||
+       expected.back().m_pixel_id != all[i].m_pixel_id)
+    {
+      expected.push_back(all[i]);
+    }
+    else
+    {
+      expected.back().blend(all[i]);
+    }
+  }
+
+  apcomp::PartialCompositor<apcomp::VolumePartial<float>> compositor;
+  std::vector<apcomp::VolumePartial<float>> output;
+  compositor.composite(in_partials, output);
+
+  ASSERT_EQ(output.size(), expected.size());
+  std::sort(output.begin(), output.end());
+  for(size_t i = 0; i < output.size(); ++i)
+  {
+    EXPECT_EQ(output[i].m_pixel_id, expected[i].m_pixel_id);
+    EXPECT_NEAR(output[i].m_pixel[0], expected[i].m_pixel[0], 1e-5f);
+    EXPECT_NEAR(output[i].m_pixel[1], expected[i].m_pixel[1], 1e-5f);
+    EXPECT_NEAR(output[i].m_pixel[2], expected[i].m_pixel[2], 1e-5f);
+    EXPECT_NEAR(output[i].m_alpha, expected[i].m_alpha, 1e-5f);
+  }
+}
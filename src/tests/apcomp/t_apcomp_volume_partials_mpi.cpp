@@ -19,6 +19,7 @@
 #include <apcomp/apcomp.hpp>
 #include <apcomp/partial_compositor.hpp>
 
+#include <algorithm>
 #include <iostream>
 #include <mpi.h>
 
@@ -81,6 +82,85 @@ TEST(apcomp_vpartial_mpi, apcomp_vpartial_mpi)
 
 }
 
+//-----------------------------------------------------------------------------
+TEST(apcomp_vpartial_mpi, apcomp_vpartial_mpi_half_round_trip)
+{
+  int par_rank;
+  int par_size;
+  MPI_Comm comm = MPI_COMM_WORLD;
+  MPI_Comm_rank(comm, &par_rank);
+  MPI_Comm_size(comm, &par_size);
+  apcomp::mpi_comm(MPI_Comm_c2f(comm));
+
+  // every rank makes the same partials and keeps its share, so the
+  // exact result can be computed locally
+  const int num_pixels = 2000;
+  const int per_pixel = 6;
+  std::vector<std::vector<apcomp::VolumePartial<float>>> in_partials;
+  in_partials.resize(1);
+  std::vector<apcomp::VolumePartial<float>> all;
+
+  unsigned int seed = 11;
+  for(int p = 0; p < num_pixels; ++p)
+  {
+    for(int i = 0; i < per_pixel; ++i)
+    {
+      seed = seed * 1103515245u + 12345u;
+      apcomp::VolumePartial<float> partial;
+      partial.m_pixel_id = p * 2;
+      partial.m_depth = float((i * 5 + p) % per_pixel) * 0.1f;
+      partial.m_pixel[0] = float(seed % 101u) / 100.f;
+      partial.m_pixel[1] = float((seed >> 8) % 101u) / 100.f;
+      partial.m_pixel[2] = float((seed >> 16) % 101u) / 100.f;
+      // no fully transparent partials, blending skips those, so the
+      // result would depend on how the partials are grouped
+      partial.m_alpha = float((seed >> 4) % 46u + 5u) / 100.f;
+      all.push_back(partial);
+      if((p + i) % par_size == par_rank)
+      {
+        in_partials[0].push_back(partial);
+      }
+    }
+  }
+
+  std::stable_sort(all.begin(), all.end());
+  std::vector<apcomp::VolumePartial<float>> expected;
+  for(size_t i = 0; i < all.size(); ++i)
+  {
+    if(expected.size() == 0 ||
+       expected.back().m_pixel_id != all[i].m_pixel_id)
+    {
+      expected.push_back(all[i]);
+    }
+    else
+    {
+      expected.back().blend(all[i]);
+    }
+  }
+
+  apcomp::PartialCompositor<apcomp::VolumePartial<float>> compositor;
+  std::vector<apcomp::VolumePartial<float>> output;
+  compositor.composite(in_partials, output);
+
+  if(par_rank == 0)
+  {
+    // colors cross ranks as half floats (11 bits of precision),
+    // depths stay full floats so the blend order is the same.
+    // Blended colors reach ~3 and can be rounded a few times
+    const float tolerance = 5e-3f;
+    ASSERT_EQ(output.size(), expected.size());
+    std::sort(output.begin(), output.end());
+    for(size_t i = 0; i < output.size(); ++i)
+    {
+      EXPECT_EQ(output[i].m_pixel_id, expected[i].m_pixel_id);
+      EXPECT_NEAR(output[i].m_pixel[0], expected[i].m_pixel[0], tolerance);
+      EXPECT_NEAR(output[i].m_pixel[1], expected[i].m_pixel[1], tolerance);
+      EXPECT_NEAR(output[i].m_pixel[2], expected[i].m_pixel[2], tolerance);
+      EXPECT_NEAR(output[i].m_alpha, expected[i].m_alpha, tolerance);
+    }
+  }
+}
+
 int main(int argc, char* argv[])
 {
     int result = 0;
@@ -246,6 +246,123 @@ TEST(ascent_amr, test_amr_render_complex_ghosts)
     ASCENT_ACTIONS_DUMP(actions,output_file,msg);
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_amr, test_amr_nestset_ghosts_republish)
+{
+    Node n;
+    ascent::about(n);
+
+    //
+    // Create an example mesh.
+    //
+    Node data, verify_info;
+    blueprint::mesh::examples::julia_nestsets_complex(EXAMPLE_MESH_SIDE_DIM,
+                                                      EXAMPLE_MESH_SIDE_DIM,
+                                                      -2.0,  2.0, // x range
+                                                      -2.0,  2.0, // y range
+                                                      0.285, 0.01, // c value
+                                                      2, // amr levels
+                                                      data);
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    ASCENT_INFO("Testing nestset ghosts across publishes");
+
+    string output_path = prepare_output_dir();
+
+    Ascent ascent;
+    ascent.open();
+
+    // the second publish reuses the painted ghosts of the first, the
+    // third shrinks the child windows of the first domain to one zone in
+    // place, so only the nestset values change and its ghosts must be
+    // repainted
+    std::vector<std::string> roots;
+    index_t shrunk_windows = 0;
+    for(int i = 0; i < 3; ++i)
+    {
+        if(i == 2)
+        {
+            Node &windows = data.child(0)["nestsets"].child(0)["windows"];
+            for(index_t w = 0; w < windows.number_of_children(); ++w)
+            {
+                Node &window = windows.child(w);
+                if(window["domain_type"].as_string() == "child")
+                {
+                    window["dims/i"] = 1;
+                    window["dims/j"] = 1;
+                    shrunk_windows++;
+                }
+            }
+        }
+
+        string output_file = conduit::utils::join_file_path(output_path,
+                                  "tout_amr_nestset_ghosts_" + std::to_string(i));
+        string output_root = output_file + ".cycle_000100.root";
+        remove_test_file(output_root);
+        roots.push_back(output_root);
+
+        conduit::Node actions;
+        conduit::Node &add_extracts = actions.append();
+        add_extracts["action"] = "add_extracts";
+        conduit::Node &extracts = add_extracts["extracts"];
+        extracts["e1/type"]  = "relay";
+        extracts["e1/params/path"] = output_file;
+        extracts["e1/params/protocol"] = "blueprint/mesh/yaml";
+
+        ascent.publish(data);
+        ascent.execute(actions);
+        EXPECT_TRUE(conduit::utils::is_file(output_root));
+    }
+    ascent.close();
+
+    // the published data is never painted
+    EXPECT_FALSE(data.child(0).has_path("fields/topo_ghosts"));
+
+    Node first, second, third, diff_info;
+    conduit::relay::io::blueprint::read_mesh(roots[0], first);
+    conduit::relay::io::blueprint::read_mesh(roots[1], second);
+    conduit::relay::io::blueprint::read_mesh(roots[2], third);
+    ASSERT_EQ(first.number_of_children(), data.number_of_children());
+    ASSERT_EQ(second.number_of_children(), data.number_of_children());
+    ASSERT_EQ(third.number_of_children(), data.number_of_children());
+
+    index_t ghost_zones = 0;
+    for(index_t i = 0; i < first.number_of_children(); ++i)
+    {
+        const Node &ghosts = first.child(i)["fields/topo_ghosts/values"];
+        EXPECT_FALSE(ghosts.diff(second.child(i)["fields/topo_ghosts/values"],
+                                 diff_info));
+        Node values_node;
+        ghosts.to_int64_array(values_node);
+        int64_array values = values_node.value();
+        for(index_t z = 0; z < values.number_of_elements(); ++z)
+        {
+            ghost_zones += values[z] != 0 ? 1 : 0;
+        }
+    }
+    // coarse zones under finer patches were painted
+    EXPECT_TRUE(ghost_zones > 0);
+
+    // each shrunk window now covers a single zone of the first domain
+    ASSERT_TRUE(shrunk_windows > 0);
+    index_t counts[2] = {0, 0};
+    const Node *meshes[2] = {&first, &third};
+    for(int m = 0; m < 2; ++m)
+    {
+        Node values_node;
+        meshes[m]->child(0)["fields/topo_ghosts/values"].to_int64_array(values_node);
+        int64_array values = values_node.value();
+        for(index_t z = 0; z < values.number_of_elements(); ++z)
+        {
+            counts[m] += values[z] != 0 ? 1 : 0;
+        }
+    }
+    EXPECT_TRUE(counts[1] > 0);
+    EXPECT_TRUE(counts[1] <= shrunk_windows);
+    EXPECT_TRUE(counts[1] < counts[0]);
+}
+
 
 //-----------------------------------------------------------------------------
 int main(int argc, char* argv[])
@@ -15,8 +15,10 @@
 #include <ascent_expression_eval.hpp>
 #include <ascent_hola.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <limits>
 
 #include <conduit_blueprint.hpp>
 
@@ -251,6 +253,217 @@ TEST(ascent_expressions, basic_derived_expressions)
 
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_expressions, derived_fused_reductions)
+{
+  Node n;
+  ascent::about(n);
+  // only run this test if ascent was built with jit support
+  if(n["runtimes/ascent/jit/status"].as_string() == "disabled")
+  {
+      ASCENT_INFO("Ascent JIT support disabled, skipping test\n");
+      return;
+  }
+
+  Node data;
+  conduit::blueprint::mesh::examples::braid("uniform",
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            data);
+  // ascent normally adds this but we are doing an end around
+  data["state/domain_id"] = 0;
+  Node multi_dom;
+  blueprint::mesh::to_multi_domain(data, multi_dom);
+
+  runtime::expressions::register_builtin();
+  runtime::expressions::ExpressionEval eval(&multi_dom);
+
+  conduit::Node res;
+  conduit::Node ref;
+  std::string expr;
+
+  // reductions of derived fields never put the field on the mesh, but
+  // must agree with reducing the original field
+  ref = eval.evaluate("max(field('braid'))");
+  res = eval.evaluate("max(2.0 * field('braid') + 1.0)");
+  EXPECT_EQ(res["type"].as_string(), "value_position");
+  EXPECT_NEAR(res["attrs/value/value"].to_float64(),
+              2.0 * ref["attrs/value/value"].to_float64() + 1.0,
+              1e-8);
+  EXPECT_EQ(res["attrs/element/index"].to_int32(),
+            ref["attrs/element/index"].to_int32());
+  EXPECT_EQ(res["attrs/element/assoc"].as_string(),
+            ref["attrs/element/assoc"].as_string());
+
+  ref = eval.evaluate("min(field('braid'))");
+  res = eval.evaluate("min(field('braid') - 3.0)");
+  EXPECT_NEAR(res["attrs/value/value"].to_float64(),
+              ref["attrs/value/value"].to_float64() - 3.0,
+              1e-8);
+  EXPECT_EQ(res["attrs/element/index"].to_int32(),
+            ref["attrs/element/index"].to_int32());
+
+  ref = eval.evaluate("sum(field('braid'))");
+  res = eval.evaluate("sum(field('braid') * 0.5)");
+  EXPECT_EQ(res["type"].as_string(), "double");
+  EXPECT_NEAR(res["value"].to_float64(),
+              0.5 * ref["value"].to_float64(),
+              1e-8);
+
+  ref = eval.evaluate("avg(field('braid'))");
+  res = eval.evaluate("avg(field('braid') + 1.0)");
+  EXPECT_NEAR(res["value"].to_float64(),
+              ref["value"].to_float64() + 1.0,
+              1e-8);
+
+  // the same derived field feeding a reduction and a comparison
+  expr = "d = field('braid') * field('braid')\n"
+         "top = max(d).value\n"
+         "sum(d > top)";
+  res = eval.evaluate(expr);
+  EXPECT_EQ(res["value"].to_float64(), 0);
+
+  // vector expressions cannot be reduced
+  bool threw = false;
+  try
+  {
+    eval.evaluate("max(field('vel') * 2.0)");
+  }
+  catch(...)
+  {
+    threw = true;
+  }
+  EXPECT_EQ(threw, true);
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_expressions, derived_many_domains)
+{
+  Node n;
+  ascent::about(n);
+  // only run this test if ascent was built with jit support
+  if(n["runtimes/ascent/jit/status"].as_string() == "disabled")
+  {
+      ASCENT_INFO("Ascent JIT support disabled, skipping test\n");
+      return;
+  }
+
+  // domains of different sizes that all generate the same kernel, so
+  // they are executed with a single launch
+  Node multi_dom;
+  const int num_domains = 7;
+  for(int i = 0; i < num_domains; ++i)
+  {
+    const int dim = 4 + i;
+    Node &dom = multi_dom.append();
+    conduit::blueprint::mesh::examples::braid("uniform", dim, dim, dim, dom);
+    dom["state/domain_id"] = i;
+  }
+
+  runtime::expressions::register_builtin();
+  runtime::expressions::ExpressionEval eval(&multi_dom);
+
+  eval.evaluate("2.0 * field('braid') + 1.0", "jagged_braid");
+
+  for(int i = 0; i < num_domains; ++i)
+  {
+    const Node &dom = multi_dom.child(i);
+    ASSERT_TRUE(dom.has_path("fields/jagged_braid"));
+    Node braid, res;
+    dom["fields/braid/values"].to_float64_array(braid);
+    dom["fields/jagged_braid/values"].to_float64_array(res);
+    const double *braid_ptr = braid.as_float64_ptr();
+    const double *res_ptr = res.as_float64_ptr();
+    const int size = res.dtype().number_of_elements();
+    EXPECT_EQ(size, braid.dtype().number_of_elements());
+    for(int v = 0; v < size; ++v)
+    {
+      EXPECT_NEAR(res_ptr[v], 2.0 * braid_ptr[v] + 1.0, 1e-12);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST(ascent_expressions, derived_kernel_manifest)
+{
+  Node n;
+  ascent::about(n);
+  // only run this test if ascent was built with jit support
+  if(n["runtimes/ascent/jit/status"].as_string() == "disabled")
+  {
+      ASCENT_INFO("Ascent JIT support disabled, skipping test\n");
+      return;
+  }
+
+  Node data;
+  conduit::blueprint::mesh::examples::braid("uniform",
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            data);
+
+  const std::string output_path = prepare_output_dir();
+  const std::string cache_dir =
+      conduit::utils::join_file_path(output_path, "tout_jit_cache");
+  const std::string manifest =
+      conduit::utils::join_file_path(cache_dir, "ascent_jit_manifest.json");
+  if(conduit::utils::is_file(manifest))
+  {
+    conduit::utils::remove_file(manifest);
+  }
+
+  Node actions;
+  Node &add_queries = actions.append();
+  add_queries["action"] = "add_queries";
+  add_queries["queries/q1/params/expression"] = "max(field('braid') * 3.0 + 1.0)";
+  add_queries["queries/q1/params/name"] = "manifest_max";
+
+  Node ascent_opts;
+  ascent_opts["runtime/type"] = "ascent";
+  ascent_opts["jit/cache_dir"] = cache_dir;
+
+  Ascent ascent;
+  ascent.open(ascent_opts);
+  ascent.publish(data);
+  ascent.execute(actions);
+  ascent.close();
+
+  // the fused reduction kernel is recorded for the next run
+  ASSERT_TRUE(conduit::utils::is_file(manifest));
+  Node kernels;
+  kernels.load(manifest, "json");
+  EXPECT_GT(kernels.number_of_children(), 0);
+
+  double expected = std::numeric_limits<double>::lowest();
+  const float64_array braid = data["fields/braid/values"].value();
+  for(index_t i = 0; i < braid.number_of_elements(); ++i)
+  {
+    expected = std::max(expected, braid[i] * 3.0 + 1.0);
+  }
+
+  // a second run precompiles them at open and still gets the same answer
+  ascent.open(ascent_opts);
+  ascent.publish(data);
+  ascent.execute(actions);
+  Node info;
+  ascent.info(info);
+  ascent.close();
+  EXPECT_EQ(info["jit/precompiled_kernels"].to_int32(),
+            kernels.number_of_children());
+  const std::string value_path = "expressions/manifest_max/" +
+                                 data["state/cycle"].to_string() +
+                                 "/attrs/value/value";
+  ASSERT_TRUE(info.has_path(value_path));
+  EXPECT_NEAR(info[value_path].to_float64(), expected, 1e-8);
+
+  // the kernel was used again so it stays young in the manifest
+  kernels.load(manifest, "json");
+  EXPECT_GT(kernels.number_of_children(), 0);
+  EXPECT_EQ(kernels.child(0)["age"].to_int32(), 0);
+}
+
 //-----------------------------------------------------------------------------
 
 TEST(ascent_expressions, derived_mesh_specific_paths)
@@ -376,12 +589,40 @@ TEST(ascent_expressions, derived_mesh_specific_paths)
       EXPECT_NEAR(res["value"].to_float64(), 8000.0, 1e-8);
     }
 
-    if(mesh_type == "uniform" || mesh_type == "rectilinear" ||
-       mesh_type == "structured")
+    const bool unstructured = mesh_type == "tets" || mesh_type == "hexs" ||
+                              mesh_type == "tris" || mesh_type == "quads";
+    if(unstructured || mesh_type == "uniform" || mesh_type == "rectilinear")
+    {
+      // values are checked against analytic fields in
+      // derived_unstructured_gradient_values
+      expr = "divergence(field('vel'))";
+      eval.evaluate(expr);
+    }
+
+    if(unstructured)
     {
-      // element to vertex
-      expr = "recenter(field('radial') + 1)";
+      // vertex and element gradients
+      expr = "gradient(field('braid'))";
       eval.evaluate(expr);
+      expr = "gradient(field('radial'))";
+      eval.evaluate(expr);
+
+      // the least squares gradient of a constant is zero
+      expr = "max(magnitude(gradient(constant_field(2.0, 'mesh', 'element'))))";
+      res = eval.evaluate(expr);
+      EXPECT_NEAR(res["value"].to_float64(), 0.0, 1e-8);
+    }
+
+    // element to vertex
+    expr = "recenter(field('radial') + 1)";
+    eval.evaluate(expr);
+
+    if(unstructured)
+    {
+      // averaging a constant over the elements around each vertex is exact
+      expr = "min(recenter(constant_field(3.0, 'mesh', 'element'), 'vertex'))";
+      res = eval.evaluate(expr);
+      EXPECT_NEAR(res["value"].to_float64(), 3.0, 1e-8);
     }
 
     // vertex to element
@@ -390,6 +631,165 @@ TEST(ascent_expressions, derived_mesh_specific_paths)
 
   }
 }
+//-----------------------------------------------------------------------------
+// adds linear fields to an explicit braid mesh, so the exact gradient is
+// known everywhere:
+//   lin_vert, lin_ele : f = 2x - 3y + 0.5z + 1 (ele at the element centers)
+//   lin_vec           : u = x + 2y + 3z, v = 4x + 5y + 6z, w = 7x + 8y + 9z
+//                       with divergence 1 + 5 + 9
+void
+add_linear_fields(Node &data, const index_t verts_per_ele)
+{
+  const int dims = data.has_path("coordsets/coords/values/z") ? 3 : 2;
+  Node &coords = data["coordsets/coords/values"];
+  const index_t num_verts = coords["x"].dtype().number_of_elements();
+  float64_accessor x = coords["x"].value();
+  float64_accessor y = coords["y"].value();
+  std::vector<double> z(num_verts, 0.0);
+  if(dims == 3)
+  {
+    float64_accessor z_vals = coords["z"].value();
+    for(index_t i = 0; i < num_verts; ++i)
+    {
+      z[i] = z_vals[i];
+    }
+  }
+
+  data["fields/lin_vert/association"] = "vertex";
+  data["fields/lin_vert/topology"] = "mesh";
+  data["fields/lin_vert/values"].set(DataType::float64(num_verts));
+  float64 *lin_vert = data["fields/lin_vert/values"].value();
+
+  data["fields/lin_vec/association"] = "vertex";
+  data["fields/lin_vec/topology"] = "mesh";
+  data["fields/lin_vec/values/u"].set(DataType::float64(num_verts));
+  data["fields/lin_vec/values/v"].set(DataType::float64(num_verts));
+  float64 *u = data["fields/lin_vec/values/u"].value();
+  float64 *v = data["fields/lin_vec/values/v"].value();
+  float64 *w = NULL;
+  if(dims == 3)
+  {
+    data["fields/lin_vec/values/w"].set(DataType::float64(num_verts));
+    w = data["fields/lin_vec/values/w"].value();
+  }
+
+  for(index_t i = 0; i < num_verts; ++i)
+  {
+    lin_vert[i] = 2.0 * x[i] - 3.0 * y[i] + 0.5 * z[i] + 1.0;
+    u[i] = x[i] + 2.0 * y[i] + 3.0 * z[i];
+    v[i] = 4.0 * x[i] + 5.0 * y[i] + 6.0 * z[i];
+    if(dims == 3)
+    {
+      w[i] = 7.0 * x[i] + 8.0 * y[i] + 9.0 * z[i];
+    }
+  }
+
+  int64_accessor conn = data["topologies/mesh/elements/connectivity"].value();
+  const index_t num_eles = conn.number_of_elements() / verts_per_ele;
+  data["fields/lin_ele/association"] = "element";
+  data["fields/lin_ele/topology"] = "mesh";
+  data["fields/lin_ele/values"].set(DataType::float64(num_eles));
+  float64 *lin_ele = data["fields/lin_ele/values"].value();
+  for(index_t e = 0; e < num_eles; ++e)
+  {
+    double center[3] = {0.0, 0.0, 0.0};
+    for(index_t i = 0; i < verts_per_ele; ++i)
+    {
+      const index_t vid = conn[e * verts_per_ele + i];
+      center[0] += x[vid];
+      center[1] += y[vid];
+      center[2] += z[vid];
+    }
+    for(int d = 0; d < 3; ++d)
+    {
+      center[d] /= double(verts_per_ele);
+    }
+    lin_ele[e] = 2.0 * center[0] - 3.0 * center[1] + 0.5 * center[2] + 1.0;
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_expressions, derived_unstructured_gradient_values)
+{
+  Node n;
+  ascent::about(n);
+  // only run this test if ascent was built with jit support
+  if(n["runtimes/ascent/jit/status"].as_string() == "disabled")
+  {
+      ASCENT_INFO("Ascent JIT support disabled, skipping test\n");
+      return;
+  }
+
+  struct MeshCase
+  {
+    std::string type;
+    long long   dims[3];
+    index_t     verts_per_ele;
+  };
+  const index_t side = EXAMPLE_MESH_SIDE_DIM;
+  const std::vector<MeshCase> meshes =
+    {
+      {"tets",  {side, side, side}, 4},
+      {"hexs",  {side, side, side}, 8},
+      {"tris",  {side, side, 1}, 3},
+      {"quads", {side, side, 1}, 4}
+    };
+
+  for(const auto &mesh : meshes)
+  {
+    std::cout<<"Running mesh type "<<mesh.type<<"\n";
+    const bool is_3d = mesh.dims[2] != 1;
+
+    Node data;
+    conduit::blueprint::mesh::examples::braid(mesh.type,
+                                              mesh.dims[0],
+                                              mesh.dims[1],
+                                              mesh.dims[2],
+                                              data);
+    add_linear_fields(data, mesh.verts_per_ele);
+    data["state/domain_id"] = 0;
+    Node multi_dom;
+    blueprint::mesh::to_multi_domain(data, multi_dom);
+
+    runtime::expressions::register_builtin();
+    runtime::expressions::ExpressionEval eval(&multi_dom);
+
+    conduit::Node res;
+    std::string expr;
+    const std::string gz = is_3d ? "0.5" : "0.0";
+
+    // vertex gradients are exact for a linear field: tets and tris
+    // solve the linear element, hexs and quads use the (bi/tri)linear
+    // shape functions
+    expr = "g = gradient(field('lin_vert'))\n"
+           "bad = not (abs(g.x - 2.0) < 0.000001 and\n"
+           "           abs(g.y + 3.0) < 0.000001 and\n"
+           "           abs(g.z - " + gz + ") < 0.000001)\n"
+           "sum(bad)";
+    res = eval.evaluate(expr);
+    EXPECT_EQ(res["value"].to_float64(), 0);
+
+    // the least squares fit to neighbor centers is exact for a linear
+    // element field on every element, elements whose face neighbors do
+    // not span the space (e.g. corners) fall back to the vertex neighbors
+    expr = "g = gradient(field('lin_ele'))\n"
+           "bad = not (abs(g.x - 2.0) < 0.000001 and\n"
+           "           abs(g.y + 3.0) < 0.000001 and\n"
+           "           abs(g.z - " + gz + ") < 0.000001)\n"
+           "sum(bad)";
+    res = eval.evaluate(expr);
+    EXPECT_EQ(res["value"].to_float64(), 0);
+
+    // divergence against the analytic value, not against gradients
+    // built by the same code
+    const double div = is_3d ? 15.0 : 6.0;
+    expr = "max(abs(divergence(field('lin_vec')) - " +
+           std::to_string(div) + "))";
+    res = eval.evaluate(expr);
+    EXPECT_NEAR(res["value"].to_float64(), 0.0, 1e-6);
+  }
+}
+
 //-----------------------------------------------------------------------------
 
 TEST(ascent_expressions, braid_sample)
@@ -23,6 +23,7 @@
 
 #include "t_config.hpp"
 #include "t_utils.hpp"
+#include "t_ascent_htg_utils.hpp"
 
 
 using namespace std;
@@ -54,7 +55,8 @@ TEST(ascent_htg, test_htg)
 
     string output_path = prepare_output_dir();
     string output_file = conduit::utils::join_file_path(output_path,"tout_htg_serial_extract");
-    string output_root = output_file + ".htg";
+    // one file per field
+    string output_root = output_file + "_field.htg";
 
     // remove old images before rendering
     remove_test_image(output_root);
@@ -89,6 +91,95 @@ TEST(ascent_htg, test_htg)
 
     // make sure the expected root file exists
     EXPECT_TRUE(conduit::utils::is_file(output_root));
+
+    // a single tree with the cell ids of the mesh
+    Node htg;
+    EXPECT_TRUE(load_htg(output_root, htg));
+    EXPECT_EQ(htg["field"].as_string(), "field");
+    int64_array dims = htg["dimensions"].value();
+    EXPECT_EQ(dims[0], 2);
+    EXPECT_EQ(dims[1], 2);
+    EXPECT_EQ(dims[2], 2);
+    EXPECT_EQ(htg["trees"].number_of_children(), 1);
+    if(htg["trees"].number_of_children() == 1)
+    {
+        const Node &tree = htg["trees"][0];
+        EXPECT_EQ(tree["index"].to_int64(), 0);
+        EXPECT_TRUE(check_htg_basic_tree(tree, EXAMPLE_MESH_SIDE_DIM - 1));
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_htg, test_htg_two_fields)
+{
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::basic("uniform",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+
+    // a second element field, twice the first
+    Node &doubled = data["fields/doubled"];
+    doubled["association"] = "element";
+    doubled["topology"] = data["fields/field/topology"].as_string();
+    data["fields/field/values"].to_float64_array(doubled["values"]);
+    float64_array doubled_vals = doubled["values"].value();
+    for(index_t i = 0; i < doubled_vals.number_of_elements(); ++i)
+    {
+        doubled_vals[i] *= 2.;
+    }
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    string output_path = prepare_output_dir();
+    string output_file = conduit::utils::join_file_path(output_path,"tout_htg_two_fields");
+    string field_root = output_file + "_field.htg";
+    string doubled_root = output_file + "_doubled.htg";
+    remove_test_file(field_root);
+    remove_test_file(doubled_root);
+
+    // no fields listed, so all fields are written
+    conduit::Node actions;
+    conduit::Node &add_extracts = actions.append();
+    add_extracts["action"] = "add_extracts";
+    add_extracts["extracts/e1/type"]  = "htg";
+    add_extracts["extracts/e1/params/path"] = output_file;
+    add_extracts["extracts/e1/params/blank_value"] = float32(-10000.);
+
+    Ascent ascent;
+    ascent.open();
+    ascent.publish(data);
+    ascent.execute(actions);
+    Node info;
+    ascent.info(info);
+    ascent.close();
+
+    EXPECT_EQ(info["extracts"][0]["files"].number_of_children(), 2);
+
+    // each file holds its own field
+    Node htg;
+    EXPECT_TRUE(load_htg(field_root, htg));
+    EXPECT_EQ(htg["field"].as_string(), "field");
+    EXPECT_EQ(htg["trees"].number_of_children(), 1);
+    if(htg["trees"].number_of_children() == 1)
+    {
+        EXPECT_TRUE(check_htg_basic_tree(htg["trees"][0], EXAMPLE_MESH_SIDE_DIM - 1));
+    }
+
+    EXPECT_TRUE(load_htg(doubled_root, htg));
+    EXPECT_EQ(htg["field"].as_string(), "doubled");
+    EXPECT_EQ(htg["trees"].number_of_children(), 1);
+    if(htg["trees"].number_of_children() == 1)
+    {
+        const index_t nx = EXAMPLE_MESH_SIDE_DIM - 1;
+        const float64 mean = float64(nx * nx * nx - 1);
+        float32_array values = htg["trees"][0]["values"].as_float32_array();
+        EXPECT_NEAR(values[0], mean, 1e-4 * mean);
+        // the finest level is in morton order, cell 0 comes first
+        const index_t finest = values.number_of_elements() - nx * nx * nx;
+        EXPECT_EQ(values[finest + 1], 2.f);
+    }
 }
 
 //-----------------------------------------------------------------------------
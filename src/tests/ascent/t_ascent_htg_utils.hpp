@@ -0,0 +1,258 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) Lawrence Livermore National Security, LLC and other Ascent
+// Project developers. See top-level LICENSE AND COPYRIGHT files for dates and
+// other details. No copyright assignment is required to contribute to Ascent.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: t_ascent_htg_utils.hpp
+///
+/// Helpers shared by the serial and mpi htg extract tests.
+///
+//-----------------------------------------------------------------------------
+
+#ifndef T_ASCENT_HTG_UTILS
+#define T_ASCENT_HTG_UTILS
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <math.h>
+#include <sstream>
+
+#include <conduit.hpp>
+
+using namespace conduit;
+
+//-----------------------------------------------------------------------------
+// Reads a hyper tree grid written by the htg extract:
+//   out/dimensions           root grid points (int64 x3)
+//   out/field                name of the cell data array
+//   out/trees/*/{index, number_of_levels, number_of_vertices}
+//   out/trees/*/{descriptor, mask} one uint8 per bit
+//   out/trees/*/nb_vertices_by_level (int64), values (float32)
+// Returns false if the file is malformed, e.g. an array size or offset
+// does not match the header.
+//-----------------------------------------------------------------------------
+inline std::string
+htg_attribute(const std::string &elem, const std::string &name)
+{
+    const std::string key = " " + name + "=\"";
+    size_t start = elem.find(key);
+    if(start == std::string::npos)
+    {
+        return "";
+    }
+    start += key.size();
+    return elem.substr(start, elem.find('"', start) - start);
+}
+
+inline bool
+load_htg(const std::string &path, conduit::Node &out)
+{
+    out.reset();
+    std::ifstream ifs(path.c_str(), std::ios::binary);
+    if(!ifs.is_open())
+    {
+        return false;
+    }
+    std::string content((std::istreambuf_iterator<char>(ifs)),
+                        std::istreambuf_iterator<char>());
+
+    const std::string appended = "<AppendedData encoding=\"raw\">\n   _";
+    const size_t appended_pos = content.find(appended);
+    if(appended_pos == std::string::npos ||
+       content.find("<VTKFile type=\"HyperTreeGrid\"") != 0 ||
+       content.find("header_type=\"UInt64\"") == std::string::npos)
+    {
+        return false;
+    }
+    const size_t data_start = appended_pos + appended.size();
+    const std::string header = content.substr(0, appended_pos);
+
+    size_t pos = header.find("<HyperTreeGrid ");
+    if(pos == std::string::npos)
+    {
+        return false;
+    }
+    std::istringstream dims(htg_attribute(header.substr(pos, header.find('>', pos) - pos),
+                                          "Dimensions"));
+    out["dimensions"].set(DataType::int64(3));
+    int64_array dims_vals = out["dimensions"].value();
+    dims >> dims_vals[0] >> dims_vals[1] >> dims_vals[2];
+
+    // end of the last array read, the footer has to follow it
+    size_t data_end = 0;
+    out["trees"].set(DataType::list());
+    while((pos = header.find("<Tree ", pos)) != std::string::npos)
+    {
+        const size_t tree_end = header.find("</Tree>", pos);
+        const std::string tree_elem = header.substr(pos, header.find('>', pos) - pos);
+        Node &tree = out["trees"].append();
+        tree["index"] = (int64) std::stoll(htg_attribute(tree_elem, "Index"));
+        tree["number_of_levels"] = (int64) std::stoll(htg_attribute(tree_elem, "NumberOfLevels"));
+        tree["number_of_vertices"] = (int64) std::stoll(htg_attribute(tree_elem, "NumberOfVertices"));
+
+        size_t apos = pos;
+        while((apos = header.find("<DataArray ", apos)) < tree_end)
+        {
+            const std::string elem = header.substr(apos, header.find('>', apos) - apos);
+            apos += elem.size();
+            const std::string type = htg_attribute(elem, "type");
+            std::string name = htg_attribute(elem, "Name");
+            const index_t tuples = std::stoll(htg_attribute(elem, "NumberOfTuples"));
+            const size_t offset = data_start + std::stoull(htg_attribute(elem, "offset"));
+
+            uint64 expected = 0;
+            if(type == "Bit")
+            {
+                expected = (tuples + 7) / 8;
+            }
+            else if(type == "Int64")
+            {
+                expected = tuples * sizeof(int64);
+            }
+            else if(type == "Float32")
+            {
+                expected = tuples * sizeof(float32);
+                out["field"] = name;
+                name = "values";
+            }
+            else
+            {
+                return false;
+            }
+
+            if(offset + sizeof(uint64) > content.size())
+            {
+                return false;
+            }
+            uint64 nbytes = 0;
+            memcpy(&nbytes, content.data() + offset, sizeof(uint64));
+            const size_t array_start = offset + sizeof(uint64);
+            if(nbytes != expected || array_start + nbytes > content.size())
+            {
+                return false;
+            }
+            data_end = std::max(data_end, size_t(array_start + nbytes));
+            const char *bytes = content.data() + array_start;
+
+            if(type == "Bit")
+            {
+                // most significant bit first
+                Node &bits = tree[name == "Descriptor" ? "descriptor" : "mask"];
+                bits.set(DataType::uint8(tuples));
+                uint8_array bits_vals = bits.value();
+                for(index_t i = 0; i < tuples; ++i)
+                {
+                    bits_vals[i] = ((uint8) bytes[i / 8] >> (7 - i % 8)) & 1;
+                }
+            }
+            else if(type == "Int64")
+            {
+                tree["nb_vertices_by_level"].set((const int64 *) bytes, tuples);
+            }
+            else
+            {
+                tree[name].set((const float32 *) bytes, tuples);
+            }
+        }
+        pos = tree_end;
+    }
+
+    const std::string footer = "\n  </AppendedData>\n</VTKFile>\n";
+    return content.compare(data_end, std::string::npos, footer) == 0;
+}
+
+//-----------------------------------------------------------------------------
+// Checks a tree written from the "field" of a blueprint basic uniform
+// example with nx^3 cells (values are the cell ids, there are no blanks):
+// every vertex is refined, nothing is masked, the finest level holds the
+// cells in morton order and the root holds their average.
+//-----------------------------------------------------------------------------
+inline bool
+check_htg_basic_tree(const conduit::Node &tree, index_t nx)
+{
+    int64 n_levels = 1;
+    for(index_t dim = nx; dim > 1; dim /= 2)
+    {
+        n_levels++;
+    }
+
+    bool res = tree["number_of_levels"].to_int64() == n_levels;
+    int64_array nb_vertices = tree["nb_vertices_by_level"].as_int64_array();
+    res &= nb_vertices.number_of_elements() == n_levels;
+    int64 n_vertices = 0;
+    int64 level_size = 1;
+    for(int64 l = 0; res && l < n_levels; ++l)
+    {
+        res &= nb_vertices[l] == level_size;
+        n_vertices += level_size;
+        level_size *= 8;
+    }
+    // the vertices of the finest level
+    level_size /= 8;
+    res &= tree["number_of_vertices"].to_int64() == n_vertices;
+    if(!res)
+    {
+        std::cout << "htg tree has the wrong shape" << std::endl;
+        tree.print();
+        return false;
+    }
+
+    uint8_array descriptor = tree["descriptor"].as_uint8_array();
+    res &= descriptor.number_of_elements() == n_vertices - level_size;
+    for(index_t i = 0; i < descriptor.number_of_elements(); ++i)
+    {
+        res &= descriptor[i] == 1;
+    }
+    // trailing zero bits are trimmed, but one bit is always kept
+    uint8_array mask = tree["mask"].as_uint8_array();
+    res &= mask.number_of_elements() == 1 && mask[0] == 0;
+    if(!res)
+    {
+        std::cout << "htg tree has the wrong descriptor or mask" << std::endl;
+        return false;
+    }
+
+    float32_array values = tree["values"].as_float32_array();
+    res &= values.number_of_elements() == n_vertices;
+    const float64 mean = float64(nx * nx * nx - 1) / 2.;
+    if(!res || fabs(values[0] - mean) > 1e-4 * mean)
+    {
+        std::cout << "htg root value " << values[0]
+                  << " expected " << mean << std::endl;
+        return false;
+    }
+
+    const index_t finest = n_vertices - level_size;
+    for(index_t k = 0; k < nx; ++k)
+    {
+        for(index_t j = 0; j < nx; ++j)
+        {
+            for(index_t i = 0; i < nx; ++i)
+            {
+                index_t morton = 0;
+                for(int b = 0; b < n_levels - 1; ++b)
+                {
+                    morton |= ((i >> b) & 1) << (3 * b);
+                    morton |= ((j >> b) & 1) << (3 * b + 1);
+                    morton |= ((k >> b) & 1) << (3 * b + 2);
+                }
+                const float32 expected = float32(i + j * nx + k * nx * nx);
+                if(values[finest + morton] != expected)
+                {
+                    std::cout << "htg cell (" << i << ", " << j << ", " << k
+                              << ") is " << values[finest + morton]
+                              << " expected " << expected << std::endl;
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+#endif
@@ -91,11 +91,95 @@ TEST(ascent_info, info_save)
     std::cout << info_load.to_yaml() << std::endl;
     // NOTE: some things won't be quite the same due to order of exec
 
+    // flow graph details are built when info is requested or saved
+    EXPECT_TRUE(ascent_info.has_child("flow_graph"));
+    EXPECT_TRUE(ascent_info.has_child("flow_graph_dot"));
+    EXPECT_TRUE(ascent_info.has_path("memory/host/conduit/allocations"));
+    EXPECT_TRUE(ascent_info.has_child("actions"));
+    EXPECT_TRUE(ascent_info.has_child("registered_filter_types"));
+    EXPECT_TRUE(info_load.has_child("flow_graph_dot"));
+
     // check that we created an image
     EXPECT_TRUE(check_test_image(output_file));
     std::string msg = "An example saving info via `save_info` action.";
     ASCENT_ACTIONS_DUMP(actions,output_file,msg);
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_info, info_memory_profile)
+{
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("quads",
+                                               20,
+                                               20,
+                                               0,
+                                               data);
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
 
+    // a plain extract is enough to run a few filters
+    Node actions;
+    conduit::Node &add_extracts = actions.append();
+    add_extracts["action"] = "add_extracts";
+    add_extracts["extracts/e1/type"] = "conduit";
+
+    // peaks from the VmHWM baseline, and with the opt in reset
+    for(int reset = 0; reset < 2; ++reset)
+    {
+        Node opts;
+        opts["memory_profile"] = "true";
+        opts["memory_profile_reset_peak"] = reset == 1 ? "true" : "false";
+
+        Ascent ascent;
+        ascent.open(opts);
+        ascent.publish(data);
+        ascent.execute(actions);
+
+        Node ascent_info;
+        ascent.info(ascent_info);
+        ascent.close();
+
+        EXPECT_TRUE(ascent_info.has_path("memory/last_execute/allocated"));
+        EXPECT_TRUE(ascent_info.has_path("memory/last_execute/host_peak"));
+        EXPECT_TRUE(ascent_info.has_path("memory/last_execute/host_resident"));
+        const Node &mem = ascent_info["memory/last_execute"];
+        // the peak is never below what is resident at the end
+        EXPECT_GE(mem["host_peak"].to_uint64(),
+                  mem["host_resident"].to_uint64());
+    }
+}
 
+//-----------------------------------------------------------------------------
+TEST(ascent_info, info_timings)
+{
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("quads",
+                                               20,
+                                               20,
+                                               0,
+                                               data);
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    Node actions;
+    conduit::Node &add_extracts = actions.append();
+    add_extracts["action"] = "add_extracts";
+    add_extracts["extracts/e1/type"] = "conduit";
+
+    Node opts;
+    opts["timings"] = "true";
+
+    Ascent ascent;
+    ascent.open(opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+
+    Node ascent_info;
+    ascent.info(ascent_info);
+    ascent.close();
+
+    // per filter times of the last execute, used by replay's bench mode
+    EXPECT_TRUE(ascent_info.has_path("timings/last_execute/total"));
+    EXPECT_TRUE(ascent_info.has_path("timings/last_execute/filters"));
+    const Node &timings = ascent_info["timings/last_execute"];
+    EXPECT_TRUE(timings["filters"].number_of_children() > 0);
+    EXPECT_GE(timings["total"].to_float64(), 0.0);
+}
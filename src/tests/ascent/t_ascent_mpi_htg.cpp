@@ -0,0 +1,156 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) Lawrence Livermore National Security, LLC and other Ascent
+// Project developers. See top-level LICENSE AND COPYRIGHT files for dates and
+// other details. No copyright assignment is required to contribute to Ascent.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: t_ascent_mpi_htg.cpp
+///
+//-----------------------------------------------------------------------------
+
+
+#include "gtest/gtest.h"
+
+#include <ascent.hpp>
+#include <mpi.h>
+
+#include <iostream>
+#include <math.h>
+
+#include <conduit_blueprint.hpp>
+#include <conduit_relay.hpp>
+
+#include "t_config.hpp"
+#include "t_utils.hpp"
+#include "t_ascent_htg_utils.hpp"
+
+
+using namespace std;
+using namespace conduit;
+using namespace ascent;
+
+
+index_t EXAMPLE_MESH_SIDE_DIM = 17;
+
+//-----------------------------------------------------------------------------
+TEST(ascent_mpi_htg, test_htg_multi_domain)
+{
+    //
+    // Set Up MPI
+    //
+    int par_rank;
+    int par_size;
+    MPI_Comm comm = MPI_COMM_WORLD;
+    MPI_Comm_rank(comm, &par_rank);
+    MPI_Comm_size(comm, &par_size);
+
+    ASCENT_INFO("Rank "
+                  << par_rank
+                  << " of "
+                  << par_size
+                  << " reporting");
+
+    //
+    // Create an example mesh, each rank owns one block along x
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::basic("uniform",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+
+    const float64 x_extent = data["coordsets/coords/spacing/dx"].to_float64() *
+                             float64(EXAMPLE_MESH_SIDE_DIM - 1);
+    data["coordsets/coords/origin/x"] = data["coordsets/coords/origin/x"].to_float64() +
+                                        x_extent * float64(par_rank);
+    data["state/domain_id"] = par_rank;
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    ASCENT_INFO("Testing htg extract in parallel"<<endl);
+
+    string output_path = "";
+    if(par_rank == 0)
+    {
+      output_path = prepare_output_dir();
+    }
+    else
+    {
+      output_path = output_dir();
+    }
+
+    string output_file = conduit::utils::join_file_path(output_path,"tout_htg_mpi_extract");
+    // one file per field
+    string output_root = output_file + "_field.htg";
+
+    if(par_rank == 0)
+    {
+      // remove old files before writing
+      remove_test_image(output_root);
+    }
+    MPI_Barrier(comm);
+
+    conduit::Node extracts;
+    extracts["e1/type"]  = "htg";
+
+    extracts["e1/params/path"] = output_file;
+    extracts["e1/params/blank_value"] = float32(-10000.);
+
+    conduit::Node actions;
+    // add the extracts
+    conduit::Node &add_extracts = actions.append();
+    add_extracts["action"] = "add_extracts";
+    add_extracts["extracts"] = extracts;
+
+    //
+    // Run Ascent
+    //
+    Ascent ascent;
+
+    Node ascent_opts;
+    ascent_opts["runtime"] = "ascent";
+    ascent_opts["mpi_comm"] = MPI_Comm_c2f(comm);
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+    ascent.close();
+
+    MPI_Barrier(comm);
+    // make sure the expected root file exists
+    EXPECT_TRUE(conduit::utils::is_file(output_root));
+
+    if(par_rank == 0)
+    {
+        // one tree per rank along x, written in rank order
+        Node htg;
+        EXPECT_TRUE(load_htg(output_root, htg));
+        EXPECT_EQ(htg["field"].as_string(), "field");
+        int64_array dims = htg["dimensions"].value();
+        EXPECT_EQ(dims[0], par_size + 1);
+        EXPECT_EQ(dims[1], 2);
+        EXPECT_EQ(dims[2], 2);
+        EXPECT_EQ(htg["trees"].number_of_children(), par_size);
+        for(index_t t = 0; t < htg["trees"].number_of_children(); ++t)
+        {
+            const Node &tree = htg["trees"][t];
+            EXPECT_EQ(tree["index"].to_int64(), t);
+            EXPECT_TRUE(check_htg_basic_tree(tree, EXAMPLE_MESH_SIDE_DIM - 1));
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+    int result = 0;
+
+    ::testing::InitGoogleTest(&argc, argv);
+    MPI_Init(&argc, &argv);
+    result = RUN_ALL_TESTS();
+    MPI_Finalize();
+
+    return result;
+}
@@ -0,0 +1,261 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) Lawrence Livermore National Security, LLC and other Ascent
+// Project developers. See top-level LICENSE AND COPYRIGHT files for dates and
+// other details. No copyright assignment is required to contribute to Ascent.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: t_ascent_mpi_rover.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "gtest/gtest.h"
+
+#include <ascent.hpp>
+#include <iostream>
+#include <algorithm>
+#include <map>
+#include <random>
+
+#include <mpi.h>
+
+#include <conduit_blueprint.hpp>
+
+#include <absorption_compositor.hpp>
+#include <vtkh/compositing/PartialCompositor.hpp>
+
+#include "t_config.hpp"
+#include "t_utils.hpp"
+
+using namespace std;
+using namespace conduit;
+using namespace ascent;
+
+//-----------------------------------------------------------------------------
+void
+make_absorption_partials(const int seed,
+                         const int num_partials,
+                         const int num_pixels,
+                         const int num_bins,
+                         std::vector<vtkh::AbsorptionPartial<float>> &partials)
+{
+    // far more partials than pixels so many pixels are hit more than once
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> pixel_dist(0, num_pixels - 1);
+    std::uniform_real_distribution<float> bin_dist(0.9f, 1.f);
+    std::uniform_real_distribution<double> depth_dist(0.0, 10.0);
+    partials.resize(num_partials);
+    for(int i = 0; i < num_partials; ++i)
+    {
+        partials[i].m_pixel_id = pixel_dist(gen);
+        partials[i].m_depth = depth_dist(gen);
+        partials[i].m_bins.resize(num_bins);
+        for(int b = 0; b < num_bins; ++b)
+        {
+            partials[i].m_bins[b] = bin_dist(gen);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// every rank but the last contributes partials, so the last rank
+// takes part in the reduction with nothing to add
+void
+rank_absorption_partials(const int rank,
+                         const int size,
+                         const int num_pixels,
+                         const int num_bins,
+                         std::vector<vtkh::AbsorptionPartial<float>> &partials)
+{
+    partials.clear();
+    if(rank < size - 1 || size == 1)
+    {
+        make_absorption_partials(rank, 2 * num_pixels, num_pixels, num_bins, partials);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+check_absorption_compositor(rover::AbsorptionCompositor<float> &compositor,
+                            const int num_pixels,
+                            const int num_bins)
+{
+    int par_rank;
+    int par_size;
+    MPI_Comm comm = MPI_COMM_WORLD;
+    MPI_Comm_rank(comm, &par_rank);
+    MPI_Comm_size(comm, &par_size);
+
+    std::vector<vtkh::AbsorptionPartial<float>> partials;
+    rank_absorption_partials(par_rank, par_size, num_pixels, num_bins, partials);
+
+    // the generic partial compositor is the reference
+    std::vector<std::vector<vtkh::AbsorptionPartial<float>>> partial_images(1, partials);
+    std::vector<vtkh::AbsorptionPartial<float>> expected;
+    vtkh::PartialCompositor<vtkh::AbsorptionPartial<float>> reference;
+    reference.set_comm_handle(MPI_Comm_c2f(comm));
+    reference.composite(partial_images, expected);
+
+    std::vector<vtkh::AbsorptionPartial<float>> result;
+    compositor.set_comm_handle(MPI_Comm_c2f(comm));
+    compositor.composite(partials, num_pixels, num_bins, result);
+
+    if(par_rank != 0)
+    {
+        return;
+    }
+
+    // the closest depth of each pixel over all ranks
+    std::map<int,double> min_depth;
+    for(int r = 0; r < par_size; ++r)
+    {
+        rank_absorption_partials(r, par_size, num_pixels, num_bins, partials);
+        for(size_t i = 0; i < partials.size(); ++i)
+        {
+            const int id = partials[i].m_pixel_id;
+            if(min_depth.count(id) == 0 || partials[i].m_depth < min_depth[id])
+            {
+                min_depth[id] = partials[i].m_depth;
+            }
+        }
+    }
+
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(expected.size(), min_depth.size());
+    ASSERT_EQ(expected.size(), result.size());
+    for(size_t i = 0; i < result.size(); ++i)
+    {
+        ASSERT_EQ(expected[i].m_pixel_id, result[i].m_pixel_id);
+        EXPECT_EQ(min_depth[result[i].m_pixel_id], result[i].m_depth);
+        ASSERT_EQ(expected[i].m_bins.size(), result[i].m_bins.size());
+        for(size_t b = 0; b < result[i].m_bins.size(); ++b)
+        {
+            EXPECT_NEAR(expected[i].m_bins[b], result[i].m_bins[b], 1e-5f);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_mpi_rover, test_absorption_compositor_reduce)
+{
+    rover::AbsorptionCompositor<float> compositor;
+    check_absorption_compositor(compositor, 64 * 64, 4);
+
+    // many chunks with a short last one
+    compositor.set_max_reduce_values(100 * 4 - 1);
+    check_absorption_compositor(compositor, 64 * 64, 4);
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_mpi_rover, test_absorption_compositor_reduce_scatter)
+{
+    // 32 channels is above the default reduce-scatter threshold
+    rover::AbsorptionCompositor<float> compositor;
+    check_absorption_compositor(compositor, 32 * 32, 32);
+
+    // slices that do not divide the chunk evenly
+    compositor.set_max_reduce_values(101 * 32);
+    check_absorption_compositor(compositor, 32 * 32 + 3, 32);
+
+    // force the scatter path with only a few channels
+    compositor.set_reduce_scatter_min_channels(1);
+    check_absorption_compositor(compositor, 64 * 64, 4);
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_mpi_rover, test_absorption_compositor_all_empty)
+{
+    int par_rank;
+    MPI_Comm comm = MPI_COMM_WORLD;
+    MPI_Comm_rank(comm, &par_rank);
+
+    for(int num_bins = 4; num_bins <= 32; num_bins *= 8)
+    {
+        std::vector<vtkh::AbsorptionPartial<float>> partials;
+        std::vector<vtkh::AbsorptionPartial<float>> result;
+        rover::AbsorptionCompositor<float> compositor;
+        compositor.set_comm_handle(MPI_Comm_c2f(comm));
+        compositor.composite(partials, 64 * 64, num_bins, result);
+        // no rank hit anything, so there is no placeholder pixel
+        EXPECT_TRUE(result.empty());
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_mpi_rover, test_xray_absorption_mpi)
+{
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent vtkm support disabled, skipping test");
+        return;
+    }
+
+    int par_rank;
+    int par_size;
+    MPI_Comm comm = MPI_COMM_WORLD;
+    MPI_Comm_rank(comm, &par_rank);
+    MPI_Comm_size(comm, &par_size);
+
+    Node data, verify_info;
+    create_3d_example_dataset(data,32,par_rank,par_size);
+    conduit::blueprint::mesh::verify(data,verify_info);
+
+    string output_path = "";
+    if(par_rank == 0)
+    {
+        output_path = prepare_output_dir();
+    }
+    else
+    {
+        output_path = output_dir();
+    }
+
+    string output_file = conduit::utils::join_file_path(output_path,
+                                                        "tout_rover_mpi_xray_absorption");
+    // energy group images are written one file per channel
+    string channel_file = output_file + "_0.png";
+    if(par_rank == 0)
+    {
+        conduit::utils::remove_path_if_exists(channel_file);
+    }
+
+    conduit::Node actions;
+    conduit::Node &add_extracts = actions.append();
+    add_extracts["action"] = "add_extracts";
+    conduit::Node &extracts = add_extracts["extracts"];
+    extracts["e1/type"]  = "xray";
+    extracts["e1/params/absorption"] = "radial_ele";
+    extracts["e1/params/filename"] = output_file;
+
+    Ascent ascent;
+    Node ascent_opts;
+    ascent_opts["mpi_comm"] = MPI_Comm_c2f(comm);
+    ascent_opts["runtime/type"] = "ascent";
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+    ascent.close();
+    MPI_Barrier(comm);
+
+    if(par_rank == 0)
+    {
+        EXPECT_TRUE(conduit::utils::is_file(channel_file));
+    }
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+    int result = 0;
+
+    ::testing::InitGoogleTest(&argc, argv);
+    MPI_Init(&argc, &argv);
+    result = RUN_ALL_TESTS();
+    MPI_Finalize();
+
+    return result;
+}
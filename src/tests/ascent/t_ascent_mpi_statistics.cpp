@@ -99,6 +99,71 @@ TEST(ascent_mpi_stats, mpi_stats)
     MPI_Barrier(comm);
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_mpi_statistics, mpi_statistics_multi_field)
+{
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent vtkm support disabled, skipping test");
+        return;
+    }
+
+    int par_rank;
+    int par_size;
+    MPI_Comm comm = MPI_COMM_WORLD;
+    MPI_Comm_rank(comm, &par_rank);
+    MPI_Comm_size(comm, &par_size);
+
+    Node data, verify_info;
+    create_3d_example_dataset(data,32,par_rank,par_size);
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    conduit::Node extracts;
+    extracts["e1/type"] = "statistics";
+    conduit::Node &params = extracts["e1/params"];
+    params["fields"].append() = "radial_vert";
+    params["fields"].append() = "rank_ele";
+    params["percentiles"].append() = 50.0;
+    params["percentiles"].append() = 90.0;
+
+    conduit::Node actions;
+    conduit::Node &add_extracts = actions.append();
+    add_extracts["action"] = "add_extracts";
+    add_extracts["extracts"] = extracts;
+
+    Ascent ascent;
+
+    Node ascent_opts;
+    ascent_opts["mpi_comm"] = MPI_Comm_c2f(comm);
+    ascent_opts["runtime"] = "ascent";
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+
+    Node info;
+    ascent.info(info);
+    ascent.close();
+
+    EXPECT_TRUE(info.has_path("extracts"));
+    const Node &stats = info["extracts"].child(0);
+    EXPECT_EQ(stats["type"].as_string(), "statistics");
+    const Node &radial = stats["fields/radial_vert"];
+    EXPECT_TRUE(radial["min"].to_float64() <= radial["mean"].to_float64());
+    EXPECT_TRUE(radial["mean"].to_float64() <= radial["max"].to_float64());
+    EXPECT_EQ(radial["percentiles"].dtype().number_of_elements(), 2);
+    // rank_ele is the owning rank of every element
+    const Node &ranks = stats["fields/rank_ele"];
+    EXPECT_EQ(ranks["min"].to_float64(), 0.0);
+    EXPECT_EQ(ranks["max"].to_float64(), double(par_size - 1));
+    EXPECT_EQ(stats["covariance"].dtype().number_of_elements(), 4);
+
+    MPI_Barrier(comm);
+}
+
 
 //-----------------------------------------------------------------------------
 int main(int argc, char* argv[])
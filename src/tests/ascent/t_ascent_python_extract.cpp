@@ -14,7 +14,9 @@
 
 #include <ascent.hpp>
 
+#include <cstdint>
 #include <iostream>
+#include <sstream>
 #include <conduit_blueprint.hpp>
 
 #include "t_config.hpp"
@@ -183,6 +185,84 @@ TEST(ascent_runtime, test_python_script_extract_from_bad_file)
 
 
 
+//-----------------------------------------------------------------------------
+std::string py_script_view = "\n"
+"import ascent_extract\n"
+"# we treat everything as a multi_domain in ascent so grab child 0\n"
+"dom = ascent_data().child_names()[0]\n"
+"vals = ascent_data_view(dom + '/fields/radial_vert/values')\n"
+"assert not vals.flags.writeable\n"
+"assert vals.shape[0] == ascent_data().child(0)['fields/radial_vert/values'].shape[0]\n"
+"# module state persists across executes, the test publishes\n"
+"# cycle 101 first and bumps the cycle each execute\n"
+"cycle = int(ascent_data().child(0)['state/cycle'])\n"
+"if cycle == 101:\n"
+"    ascent_extract.calls = 0\n"
+"ascent_extract.calls = getattr(ascent_extract, 'calls', 0) + 1\n"
+"print('python extract call', ascent_extract.calls)\n"
+"assert ascent_extract.calls == cycle - 100\n"
+"\n";
+
+//-----------------------------------------------------------------------------
+TEST(ascent_runtime, test_python_script_extract_view)
+{
+    //
+    // Create the data.
+    //
+    Node data, verify_info;
+    create_3d_example_dataset(data,32,0,1);
+    data["state/cycle"] = 101;
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    //
+    // Create the actions.
+    //
+
+    // the view must point at the published values, not a copy
+    std::ostringstream zero_copy_check;
+    zero_copy_check
+        << "import numpy as np\n"
+        << "assert np.shares_memory(vals, ascent_data().child(0)['fields/radial_vert/values'])\n"
+        << "assert vals.__array_interface__['data'][0] == "
+        << reinterpret_cast<std::uintptr_t>(
+               data["fields/radial_vert/values"].element_ptr(0))
+        << "\n";
+
+    conduit::Node extracts;
+    extracts["e1/type"]  = "python";
+    extracts["e1/params/source"] = py_script_view + zero_copy_check.str();
+
+    conduit::Node actions;
+    // add the extracts
+    conduit::Node &add_extracts = actions.append();
+    add_extracts["action"] = "add_extracts";
+    add_extracts["extracts"] = extracts;
+
+    actions.print();
+
+    //
+    // Run Ascent
+    //
+
+    Node ascent_opts;
+    ascent_opts["ascent_info"] = "verbose";
+    ascent_opts["exceptions"] = "forward";
+
+    Ascent ascent;
+    ascent.open(ascent_opts);
+    // run three times, later passes reuse the compiled script and
+    // the script asserts on the call count it kept in its module
+    for(int cycle = 101; cycle <= 103; ++cycle)
+    {
+        data["state/cycle"] = cycle;
+        ascent.publish(data);
+        EXPECT_NO_THROW(ascent.execute(actions));
+    }
+    ascent.close();
+
+}
+
 std::string py_script_mod_driver = "\n"
 "import tout_my_test_module\n"
 "print ('calling go from test module')\n"
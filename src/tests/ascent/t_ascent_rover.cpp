@@ -23,6 +23,13 @@
 #include "t_config.hpp"
 #include "t_utils.hpp"
 
+#if defined(ASCENT_VTKM_ENABLED)
+#include <algorithm>
+#include <map>
+#include <random>
+#include <absorption_compositor.hpp>
+#include <vtkh/compositing/PartialCompositor.hpp>
+#endif
 
 
 
@@ -393,3 +400,106 @@ TEST(ascent_rover, test_xray_blueprint)
     ascent.execute(actions);
     ascent.close();
 }
+
+#if defined(ASCENT_VTKM_ENABLED)
+//-----------------------------------------------------------------------------
+void
+make_absorption_partials(const int seed,
+                         const int num_partials,
+                         const int num_pixels,
+                         const int num_bins,
+                         std::vector<vtkh::AbsorptionPartial<float>> &partials)
+{
+    // far more partials than pixels so many pixels are hit more than once
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> pixel_dist(0, num_pixels - 1);
+    std::uniform_real_distribution<float> bin_dist(0.9f, 1.f);
+    std::uniform_real_distribution<double> depth_dist(0.0, 10.0);
+    partials.resize(num_partials);
+    for(int i = 0; i < num_partials; ++i)
+    {
+        partials[i].m_pixel_id = pixel_dist(gen);
+        partials[i].m_depth = depth_dist(gen);
+        partials[i].m_bins.resize(num_bins);
+        for(int b = 0; b < num_bins; ++b)
+        {
+            partials[i].m_bins[b] = bin_dist(gen);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+check_absorption_result(std::vector<vtkh::AbsorptionPartial<float>> &inputs,
+                        std::vector<vtkh::AbsorptionPartial<float>> &expected,
+                        std::vector<vtkh::AbsorptionPartial<float>> &result)
+{
+    std::map<int,double> min_depth;
+    for(size_t i = 0; i < inputs.size(); ++i)
+    {
+        const int id = inputs[i].m_pixel_id;
+        if(min_depth.count(id) == 0 || inputs[i].m_depth < min_depth[id])
+        {
+            min_depth[id] = inputs[i].m_depth;
+        }
+    }
+
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(expected.size(), min_depth.size());
+    ASSERT_EQ(expected.size(), result.size());
+    for(size_t i = 0; i < result.size(); ++i)
+    {
+        ASSERT_EQ(expected[i].m_pixel_id, result[i].m_pixel_id);
+        EXPECT_EQ(min_depth[result[i].m_pixel_id], result[i].m_depth);
+        ASSERT_EQ(expected[i].m_bins.size(), result[i].m_bins.size());
+        for(size_t b = 0; b < result[i].m_bins.size(); ++b)
+        {
+            EXPECT_NEAR(expected[i].m_bins[b], result[i].m_bins[b], 1e-5f);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_rover, test_absorption_compositor)
+{
+    const int num_pixels = 64 * 64;
+    const int num_bins = 4;
+    std::vector<vtkh::AbsorptionPartial<float>> partials;
+    make_absorption_partials(0, 3 * num_pixels, num_pixels, num_bins, partials);
+    std::vector<vtkh::AbsorptionPartial<float>> inputs = partials;
+
+    // the generic partial compositor is the reference
+    std::vector<std::vector<vtkh::AbsorptionPartial<float>>> partial_images(1, partials);
+    std::vector<vtkh::AbsorptionPartial<float>> expected;
+    vtkh::PartialCompositor<vtkh::AbsorptionPartial<float>> reference;
+    reference.composite(partial_images, expected);
+
+    std::vector<vtkh::AbsorptionPartial<float>> result;
+    rover::AbsorptionCompositor<float> compositor;
+    compositor.composite(partials, num_pixels, num_bins, result);
+    check_absorption_result(inputs, expected, result);
+
+    // small reductions split the image into many chunks, including
+    // a short last chunk
+    partials = inputs;
+    compositor.set_max_reduce_values(100 * num_bins - 1);
+    compositor.composite(partials, num_pixels, num_bins, result);
+    check_absorption_result(inputs, expected, result);
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_rover, test_absorption_compositor_empty)
+{
+    std::vector<vtkh::AbsorptionPartial<float>> partials;
+    std::vector<vtkh::AbsorptionPartial<float>> result;
+    rover::AbsorptionCompositor<float> compositor;
+
+    // no partials means no hit pixels, not a placeholder pixel
+    compositor.composite(partials, 64 * 64, 4, result);
+    EXPECT_TRUE(result.empty());
+
+    make_absorption_partials(0, 10, 64 * 64, 4, partials);
+    compositor.composite(partials, 0, 4, result);
+    EXPECT_TRUE(result.empty());
+}
+#endif
@@ -19,6 +19,7 @@
 #include <sstream>
 
 #include <conduit_blueprint.hpp>
+#include <flow.hpp>
 
 #include "t_config.hpp"
 #include "t_utils.hpp"
@@ -1166,3 +1167,64 @@ TEST(ascent_runtime_options, test_field_filtering_lineout)
     ascent.publish(data);
     ascent.execute(actions);
 }
+
+//-----------------------------------------------------------------------------
+TEST(ascent_runtime_options, test_trace)
+{
+    //
+    // Create an example mesh.
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    string output_path = prepare_output_dir();
+    string trace_file = conduit::utils::join_file_path(output_path,
+                                                       "ascent_trace_0.json");
+    string summary_file = conduit::utils::join_file_path(output_path,
+                                                         "ascent_trace_summary.json");
+    remove_test_file(trace_file);
+    remove_test_file(summary_file);
+
+    conduit::Node actions;
+    conduit::Node &add_queries = actions.append();
+    add_queries["action"] = "add_queries";
+    add_queries["queries/q1/params/expression"] = "max(field('braid'))";
+    add_queries["queries/q1/params/name"] = "max_braid";
+
+    //
+    // Run Ascent
+    //
+
+    Ascent ascent;
+
+    Node ascent_opts;
+    ascent_opts["runtime/type"] = "ascent";
+    ascent_opts["trace"] = "true";
+    ascent_opts["default_dir"] = output_path;
+    ascent.open(ascent_opts);
+    for(int i = 0; i < 2; ++i)
+    {
+      ascent.publish(data);
+      ascent.execute(actions);
+    }
+    ascent.close();
+
+    EXPECT_TRUE(check_test_file(trace_file));
+    EXPECT_TRUE(check_test_file(summary_file));
+
+    Node summary;
+    summary.load(summary_file, "json");
+    summary.print();
+    EXPECT_EQ(summary["number_of_ranks"].to_int64(), 1);
+    EXPECT_TRUE(summary["regions"].has_child("execute"));
+    EXPECT_EQ(summary["regions"].child("execute")["count"].to_int64(), 2);
+
+    // recording stops at close
+    EXPECT_FALSE(flow::Trace::enabled());
+}
@@ -0,0 +1,174 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) Lawrence Livermore National Security, LLC and other Ascent
+// Project developers. See top-level LICENSE AND COPYRIGHT files for dates and
+// other details. No copyright assignment is required to contribute to Ascent.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: t_ascent_temporal_accumulate.cpp
+///
+//-----------------------------------------------------------------------------
+
+
+#include "gtest/gtest.h"
+
+#include <ascent.hpp>
+
+#include <iostream>
+#include <math.h>
+
+#include <conduit_blueprint.hpp>
+
+#include "t_config.hpp"
+#include "t_utils.hpp"
+
+
+using namespace std;
+using namespace conduit;
+using namespace ascent;
+
+
+index_t EXAMPLE_MESH_SIDE_DIM = 10;
+
+//-----------------------------------------------------------------------------
+// sets the "accum" element field to cycle * (1 + i % 5)
+void
+set_cycle_field(int cycle, Node &data)
+{
+    data["state/cycle"] = (uint64) cycle;
+    const index_t num_elems = data["fields/radial/values"].dtype().number_of_elements();
+    Node &field = data["fields/accum"];
+    field["association"] = "element";
+    field["topology"] = "mesh";
+    field["values"].set(DataType::float64(num_elems));
+    float64_array values = field["values"].value();
+    for(index_t i = 0; i < num_elems; ++i)
+    {
+        values[i] = float64(cycle) * float64(1 + i % 5);
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_temporal_accumulate, test_running_stats)
+{
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent vtkm support disabled, skipping test");
+        return;
+    }
+
+    //
+    // Create an example mesh.
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+    set_cycle_field(1, data);
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    ASCENT_INFO("Testing temporal accumulate across cycles");
+
+    const float64 alpha = 0.5;
+
+    conduit::Node actions;
+    conduit::Node &add_pipelines = actions.append();
+    add_pipelines["action"] = "add_pipelines";
+    conduit::Node &pipelines = add_pipelines["pipelines"];
+    pipelines["pl1/f1/type"] = "accumulate";
+    conduit::Node &params = pipelines["pl1/f1/params"];
+    params["field"] = "accum";
+    params["alpha"] = alpha;
+    // start over on cycle 4
+    params["reset"] = "cycle() == 4";
+    params["outputs"].append() = "mean";
+    params["outputs"].append() = "variance";
+    params["outputs"].append() = "min";
+    params["outputs"].append() = "max";
+    params["outputs"].append() = "ema";
+    params["outputs"].append() = "count";
+
+    conduit::Node &add_extracts = actions.append();
+    add_extracts["action"] = "add_extracts";
+    conduit::Node &extracts = add_extracts["extracts"];
+    extracts["e1/type"]  = "conduit";
+    extracts["e1/pipeline"] = "pl1";
+
+    Ascent ascent;
+    ascent.open();
+
+    // ema of the unit series 1, 2, 3, ...
+    float64 unit_ema = 0.;
+    for(int cycle = 1; cycle <= 5; ++cycle)
+    {
+        set_cycle_field(cycle, data);
+        ascent.publish(data);
+        ascent.execute(actions);
+
+        conduit::Node info;
+        ascent.info(info);
+        const Node &fields = info["extracts"][0]["data"][0]["fields"];
+
+        Node mean, variance, min, max, ema, count;
+        fields["accum_mean/values"].to_float64_array(mean);
+        fields["accum_variance/values"].to_float64_array(variance);
+        fields["accum_min/values"].to_float64_array(min);
+        fields["accum_max/values"].to_float64_array(max);
+        fields["accum_ema/values"].to_float64_array(ema);
+        fields["accum_count/values"].to_float64_array(count);
+
+        // cycle 4 resets, so cycle 4 and 5 see the series 4, 5
+        const float64 first = cycle < 4 ? 1. : 4.;
+        const float64 num = cycle - first + 1.;
+        // mean of first..cycle, sample variance of num consecutive
+        // integers is num (num + 1) / 12
+        const float64 unit_mean = (first + cycle) / 2.;
+        const float64 unit_variance = num > 1. ? num * (num + 1.) / 12. : 0.;
+        unit_ema = num == 1. ? cycle : alpha * cycle + (1. - alpha) * unit_ema;
+
+        float64_array mean_vals = mean.value();
+        float64_array variance_vals = variance.value();
+        float64_array min_vals = min.value();
+        float64_array max_vals = max.value();
+        float64_array ema_vals = ema.value();
+        float64_array count_vals = count.value();
+
+        const index_t num_elems = mean_vals.number_of_elements();
+        EXPECT_EQ(num_elems, data["fields/accum/values"].dtype().number_of_elements());
+        for(index_t i = 0; i < num_elems; ++i)
+        {
+            const float64 s = float64(1 + i % 5);
+            EXPECT_NEAR(mean_vals[i], s * unit_mean, 1e-10);
+            EXPECT_NEAR(variance_vals[i], s * s * unit_variance, 1e-10);
+            EXPECT_EQ(min_vals[i], s * first);
+            EXPECT_EQ(max_vals[i], s * cycle);
+            EXPECT_NEAR(ema_vals[i], s * unit_ema, 1e-10);
+            EXPECT_EQ(count_vals[i], num);
+        }
+    }
+
+    ascent.close();
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+    int result = 0;
+
+    ::testing::InitGoogleTest(&argc, argv);
+
+    // allow override of the data size via the command line
+    if(argc == 2)
+    {
+        EXAMPLE_MESH_SIDE_DIM = atoi(argv[1]);
+    }
+
+    result = RUN_ALL_TESTS();
+    return result;
+}
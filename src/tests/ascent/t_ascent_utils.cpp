@@ -14,6 +14,8 @@
 
 #include <ascent.hpp>
 #include <ascent_resources.hpp>
+#include <ascent_runtime_utils.hpp>
+#include <conduit_blueprint.hpp>
 
 #include <iostream>
 #include <math.h>
@@ -64,3 +66,39 @@ TEST(ascent_utils, ascent_copy_dir)
     EXPECT_TRUE(conduit::utils::is_file(idx_fpath));
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_utils, blueprint_verify_cache)
+{
+    Node data;
+    conduit::blueprint::mesh::examples::braid("hexs", 10, 10, 10, data);
+    Node multi_dom;
+    multi_dom.append().set_external(data);
+    multi_dom.append().set_external(data);
+
+    runtime::filters::BlueprintVerifyCache cache;
+    Node info;
+    EXPECT_TRUE(cache.verify_mesh(multi_dom, info));
+    EXPECT_EQ(cache.last_num_verified(), 2);
+
+    // nothing changed, nothing is verified
+    EXPECT_TRUE(cache.verify_mesh(multi_dom, info));
+    EXPECT_EQ(cache.last_num_verified(), 0);
+
+    // a changed small leaf is caught
+    multi_dom.child(1)["topologies/mesh/elements/shape"] = "bogus";
+    EXPECT_FALSE(cache.verify_mesh(multi_dom, info));
+    EXPECT_EQ(cache.last_num_verified(), 1);
+    EXPECT_TRUE(info.has_path("domains"));
+
+    // so is an array that moved
+    multi_dom.child(1)["topologies/mesh/elements/shape"] = "hex";
+    Node coords;
+    coords.set(data["coordsets/coords/values/x"]);
+    multi_dom.child(0)["coordsets/coords/values/x"].set_external(coords);
+    EXPECT_TRUE(cache.verify_mesh(multi_dom, info));
+    EXPECT_EQ(cache.last_num_verified(), 2);
+
+    cache.reset();
+    EXPECT_TRUE(cache.verify_mesh(multi_dom, info));
+    EXPECT_EQ(cache.last_num_verified(), 2);
+}
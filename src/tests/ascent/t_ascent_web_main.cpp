@@ -14,6 +14,7 @@
 #include "gtest/gtest.h"
 
 #include <ascent.hpp>
+#include <ascent_web_interface.hpp>
 
 #include <iostream>
 #include <math.h>
@@ -112,6 +113,39 @@ TEST(ascent_web, test_ascent_main_web_launch)
     ascent.close();
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_web, test_web_interface_push_and_shutdown)
+{
+    Node n;
+    ascent::about(n);
+    if(n["runtimes/ascent/webserver/status"].as_string() != "enabled")
+    {
+        ASCENT_INFO("Ascent web server support disabled, skipping test");
+        return;
+    }
+
+    conduit::Node renders;
+    renders.append() = "tout_does_not_exist.png";
+
+    {
+        WebInterface web;
+        web.SetPoll(10);
+        web.SetTimeout(10);
+        web.Enable();
+        EXPECT_TRUE(web.IsEnabled());
+
+        // no client ever connects, pushes must not block or queue up
+        // and the destructor must join the send thread
+        for(int i = 0; i < 10; ++i)
+        {
+            conduit::Node msg;
+            msg["state/cycle"] = i;
+            web.PushMessage(msg);
+            web.PushRenders(renders);
+        }
+    }
+}
+
 
 //-----------------------------------------------------------------------------
 int main(int argc, char* argv[])
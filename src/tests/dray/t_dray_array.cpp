@@ -6,6 +6,9 @@
 #include "gtest/gtest.h"
 #include <dray/array.hpp>
 
+#include <memory>
+#include <vector>
+
 TEST (dray_array, dray_array_basic)
 {
   dray::Array<int> int_array;
@@ -18,3 +21,59 @@ TEST (dray_array, dray_array_basic)
   ASSERT_EQ (host2[0], 0);
   ASSERT_EQ (host2[1], 1);
 }
+
+TEST (dray_array, dray_array_borrow)
+{
+  std::shared_ptr<std::vector<int>> owner =
+    std::make_shared<std::vector<int>> (std::vector<int>{3, 4, 5});
+
+  dray::Array<int> int_array;
+  int_array.borrow (owner->data (), owner->size (), false, owner);
+  ASSERT_TRUE (int_array.is_borrowed ());
+  ASSERT_EQ (int_array.size (), size_t (3));
+  // no copy was made
+  ASSERT_EQ (int_array.get_host_ptr_const (), owner->data ());
+
+  // the array keeps the owner alive
+  std::weak_ptr<std::vector<int>> watcher = owner;
+  owner.reset ();
+  ASSERT_FALSE (watcher.expired ());
+  ASSERT_EQ (int_array.get_value (2), 5);
+
+  // resizing drops the borrowed data
+  int_array.resize (2);
+  ASSERT_FALSE (int_array.is_borrowed ());
+  ASSERT_TRUE (watcher.expired ());
+}
+
+TEST (dray_array, dray_array_borrow_copy_on_write)
+{
+  std::vector<int> data{3, 4, 5};
+
+  // a write through the host pointer works on a private copy
+  dray::Array<int> host_array;
+  host_array.borrow (data.data (), data.size (), false, nullptr);
+  int *host = host_array.get_host_ptr ();
+  ASSERT_NE (host, data.data ());
+  ASSERT_FALSE (host_array.is_borrowed ());
+  host[0] = 7;
+  ASSERT_EQ (data[0], 3);
+  ASSERT_EQ (host_array.get_value (0), 7);
+
+  // same for the device pointer, and the result does not end up in the
+  // borrowed memory when it comes back to the host
+  dray::Array<int> device_array;
+  device_array.borrow (data.data (), data.size (), false, nullptr);
+  device_array.get_device_ptr ();
+  ASSERT_FALSE (device_array.is_borrowed ());
+  ASSERT_NE (device_array.get_host_ptr_const (), data.data ());
+  ASSERT_EQ (device_array.get_value (1), 4);
+  ASSERT_EQ (data[1], 4);
+
+  // reads keep borrowing
+  dray::Array<int> read_array;
+  read_array.borrow (data.data (), data.size (), false, nullptr);
+  read_array.get_device_ptr_const ();
+  ASSERT_TRUE (read_array.is_borrowed ());
+  ASSERT_EQ (read_array.get_host_ptr_const (), data.data ());
+}
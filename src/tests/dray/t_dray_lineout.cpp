@@ -9,12 +9,17 @@
 #include "t_utils.hpp"
 #include "t_config.hpp"
 
+#include <conduit_blueprint.hpp>
+
 #include <dray/io/blueprint_reader.hpp>
+#include <dray/io/blueprint_low_order.hpp>
+#include <dray/data_model/mesh_utils.hpp>
 #include <dray/queries/lineout.hpp>
 
 #include <dray/math.hpp>
 
 #include <fstream>
+#include <random>
 #include <stdlib.h>
 
 using namespace dray;
@@ -150,3 +155,90 @@ TEST (dray_locate_2d, dray_lineout_failure)
   }
 
 }
+
+void check_locate_batch(const std::string mesh_type)
+{
+  conduit::Node data;
+  conduit::blueprint::mesh::examples::braid(mesh_type, 10, 10, 10, data);
+
+  DataSet domain = BlueprintLowOrder::import(data);
+  Mesh *mesh = domain.mesh();
+  AABB<3> bounds = mesh->bounds();
+
+  // samples along a few lines plus random points, some outside the mesh
+  const int num_points = 4000;
+  Array<Vec<Float,3>> points;
+  points.resize(num_points);
+  Vec<Float,3> *points_ptr = points.get_host_ptr();
+
+  std::linear_congruential_engine<std::uint_fast32_t, 48271, 0, 2147483647> rgen{ 0 };
+  std::uniform_real_distribution<Float> dist{ -0.1f, 1.1f };
+  for(int i = 0; i < num_points; ++i)
+  {
+    Vec<Float,3> t;
+    if(i < num_points / 2)
+    {
+      const int line = i / 100;
+      t[0] = (Float(i % 100) + 0.5f) / 100.f;
+      t[1] = Float(line % 5) / 5.f + 0.05f;
+      t[2] = Float(line / 5) / 4.f + 0.05f;
+    }
+    else
+    {
+      t = {{dist(rgen), dist(rgen), dist(rgen)}};
+    }
+    for(int d = 0; d < 3; ++d)
+    {
+      points_ptr[i][d] = bounds.m_ranges[d].min() +
+                         t[d] * bounds.m_ranges[d].length();
+    }
+  }
+
+  Array<Location> expected = mesh->locate(points);
+  Array<Location> actual = mesh->locate_batch(points);
+  const Location *expected_ptr = expected.get_host_ptr_const();
+  const Location *actual_ptr = actual.get_host_ptr_const();
+
+  // points sorted by the caller over wider bounds, like PointLocation
+  // does for all the domains of a collection
+  AABB<3> wide_bounds = bounds;
+  wide_bounds.scale(2.f);
+  Array<int32> order = detail::morton_order(points, wide_bounds);
+  Array<Location> presorted = mesh->locate_batch(points, order);
+  const Location *presorted_ptr = presorted.get_host_ptr_const();
+
+  int found = 0;
+  int other_cell = 0;
+  for(int i = 0; i < num_points; ++i)
+  {
+    EXPECT_EQ(expected_ptr[i].m_cell_id == -1, actual_ptr[i].m_cell_id == -1);
+    EXPECT_EQ(expected_ptr[i].m_cell_id == -1, presorted_ptr[i].m_cell_id == -1);
+    if(expected_ptr[i].m_cell_id == -1)
+    {
+      continue;
+    }
+    found++;
+    // points on a shared face can land in either element
+    if(expected_ptr[i].m_cell_id != actual_ptr[i].m_cell_id)
+    {
+      other_cell++;
+      continue;
+    }
+    for(int d = 0; d < 3; ++d)
+    {
+      EXPECT_NEAR(expected_ptr[i].m_ref_pt[d], actual_ptr[i].m_ref_pt[d], 1e-3);
+    }
+  }
+  EXPECT_GT(found, num_points / 2);
+  EXPECT_LT(other_cell, found / 100 + 1);
+}
+
+TEST (dray_locate_batch, dray_hexs)
+{
+  check_locate_batch("hexs");
+}
+
+TEST (dray_locate_batch, dray_tets)
+{
+  check_locate_batch("tets");
+}
@@ -21,7 +21,9 @@
 
 #include <dray/math.hpp>
 
+#include <chrono>
 #include <fstream>
+#include <thread>
 #include <stdlib.h>
 
 int EXAMPLE_MESH_SIDE_DIM = 20;
@@ -224,3 +226,95 @@ TEST (dray_low_order, dray_structured_hexs)
 
   render_3d(data, "structured_hexs");
 }
+
+TEST (dray_low_order, dray_progressive)
+{
+  conduit::Node data;
+  conduit::blueprint::mesh::examples::braid("uniform",
+                                             EXAMPLE_MESH_SIDE_DIM,
+                                             EXAMPLE_MESH_SIDE_DIM,
+                                             EXAMPLE_MESH_SIDE_DIM,
+                                             data);
+
+  std::string output_path = prepare_output_dir ();
+  std::string output_file =
+  conduit::utils::join_file_path (output_path, "progressive_hexs");
+  remove_test_image (output_file);
+
+  dray::DataSet domain = dray::BlueprintLowOrder::import(data);
+
+  dray::Collection dataset;
+  dataset.add_domain(domain);
+
+  dray::MeshBoundary boundary;
+  dray::Collection faces = boundary.execute(dataset);
+
+  const int c_width  = 512;
+  const int c_height = 512;
+
+  dray::Camera camera;
+  camera.set_width (c_width);
+  camera.set_height (c_height);
+  camera.elevate(10);
+  camera.azimuth(40);
+  camera.reset_to_bounds (dataset.bounds());
+
+  std::shared_ptr<dray::Surface> surface
+    = std::make_shared<dray::Surface>(faces);
+  surface->field("braid");
+  surface->color_map().color_table(dray::ColorTable("cool2warm"));
+
+  dray::Renderer renderer;
+  renderer.add(surface);
+  renderer.color_bar(false);
+  dray::Framebuffer full = renderer.render(camera);
+
+  // no budget: smooth blocks are interpolated, everything else is traced
+  renderer.progressive(true);
+  dray::Framebuffer progressive = renderer.render(camera);
+  dray::ProgressiveInfo info = renderer.progressive_info();
+  EXPECT_FALSE(info.m_budget_hit);
+  EXPECT_EQ(info.m_stride, 1);
+  EXPECT_FLOAT_EQ(info.quality(), 1.f);
+  EXPECT_GT(info.m_traced, 0.f);
+  EXPECT_LT(info.m_traced, 1.f);
+
+  const dray::Vec<dray::float32,4> *full_ptr = full.colors().get_host_ptr_const();
+  const dray::Vec<dray::float32,4> *prog_ptr = progressive.colors().get_host_ptr_const();
+  int differ = 0;
+  for(int i = 0; i < c_width * c_height; ++i)
+  {
+    for(int c = 0; c < 4; ++c)
+    {
+      if(std::abs(full_ptr[i][c] - prog_ptr[i][c]) > 0.1f)
+      {
+        differ++;
+        break;
+      }
+    }
+  }
+  EXPECT_LT(differ, c_width * c_height / 100);
+
+  progressive.composite_background();
+  progressive.save(output_file);
+
+  // a budget that can't be met stops after the coarse pass
+  renderer.time_budget(1e-9f);
+  renderer.render(camera);
+  info = renderer.progressive_info();
+  EXPECT_TRUE(info.m_budget_hit);
+  EXPECT_EQ(info.m_stride, info.m_coarse_stride);
+  EXPECT_FLOAT_EQ(info.quality(), 0.f);
+  EXPECT_LT(info.m_traced, 0.05f);
+
+  // a shared budget spans renders, so once it is used up the next
+  // render stops after the coarse pass even with time to spare
+  // for that render alone
+  renderer.time_budget(0.5f);
+  renderer.start_time_budget();
+  std::this_thread::sleep_for(std::chrono::milliseconds(600));
+  renderer.render(camera);
+  info = renderer.progressive_info();
+  EXPECT_TRUE(info.m_budget_hit);
+  EXPECT_EQ(info.m_stride, info.m_coarse_stride);
+}
@@ -11,9 +11,14 @@
 
 #include <dray/rendering/renderer.hpp>
 #include <dray/rendering/volume.hpp>
+#include <dray/rendering/preintegration.hpp>
 #include <dray/io/blueprint_reader.hpp>
+#include <dray/io/blueprint_low_order.hpp>
 #include <dray/math.hpp>
 
+#include <conduit_blueprint.hpp>
+
+#include <cmath>
 #include <fstream>
 #include <stdlib.h>
 
@@ -29,6 +34,154 @@ mfem_enabled()
 }
 
 
+TEST (dray_volume_render, dray_preintegrated_table)
+{
+  // a thin opaque band that point samples at 0.4 and 0.6 both miss
+  dray::ColorTable color_table ("cool2warm");
+  color_table.clear_alphas ();
+  color_table.add_alpha (0.00f, 0.0f);
+  color_table.add_alpha (0.49f, 0.0f);
+  color_table.add_alpha (0.50f, 0.9f);
+  color_table.add_alpha (0.51f, 0.0f);
+  color_table.add_alpha (1.00f, 0.0f);
+
+  dray::ColorMap color_map;
+  color_map.color_table (color_table);
+  dray::Range range;
+  range.include (0.f);
+  range.include (1.f);
+  color_map.scalar_range (range);
+
+  const int size = 101;
+  dray::PreintegratedTable table (color_map, size);
+  EXPECT_EQ (table.size (), size);
+
+  // the diagonal is the color map
+  dray::Array<dray::Vec<dray::float32, 4>> colors = color_map.colors ();
+  const int num_colors = colors.size ();
+  const dray::Vec<dray::float32, 4> color = colors.get_value ((num_colors - 1) / 4);
+  const dray::Vec<dray::float32, 4> entry = table.entry (25, 25);
+  for (int c = 0; c < 3; ++c)
+  {
+    EXPECT_NEAR (entry[c], color[c], 1e-2f);
+  }
+  EXPECT_NEAR (entry[3], 0.f, 1e-5f);
+
+  // crossing the band in either direction is opaque
+  const dray::Vec<dray::float32, 4> forward = table.entry (40, 60);
+  const dray::Vec<dray::float32, 4> backward = table.entry (60, 40);
+  EXPECT_NEAR (table.entry (40, 40)[3], 0.f, 1e-5f);
+  EXPECT_NEAR (table.entry (60, 60)[3], 0.f, 1e-5f);
+  EXPECT_GT (forward[3], 0.f);
+  EXPECT_NEAR (forward[3], backward[3], 1e-5f);
+
+  // segments beside the band stay transparent
+  EXPECT_NEAR (table.entry (10, 30)[3], 0.f, 1e-5f);
+}
+
+// renders braid with a thin opaque band in the transfer function and
+// returns the image, and the number of samples taken
+dray::Array<dray::Vec<dray::float32, 4>>
+render_braid_band(dray::Collection &dataset,
+                  const int samples,
+                  const bool use_preintegration,
+                  const float max_step_factor,
+                  dray::int64 &samples_taken)
+{
+  dray::ColorTable color_table ("cool2warm");
+  color_table.clear_alphas ();
+  color_table.add_alpha (0.00f, 0.0f);
+  color_table.add_alpha (0.60f, 0.0f);
+  color_table.add_alpha (0.62f, 0.8f);
+  color_table.add_alpha (0.64f, 0.0f);
+  color_table.add_alpha (1.00f, 0.0f);
+
+  dray::Camera camera;
+  camera.set_width (256);
+  camera.set_height (256);
+  camera.azimuth (30);
+  camera.elevate (20);
+  camera.reset_to_bounds (dataset.bounds());
+
+  std::shared_ptr<dray::Volume> volume
+    = std::make_shared<dray::Volume>(dataset);
+  volume->field("braid");
+  volume->use_lighting(false);
+  volume->samples(samples);
+  volume->use_preintegration(use_preintegration);
+  volume->max_step_factor(max_step_factor);
+  volume->color_map().color_table(color_table);
+
+  dray::Renderer renderer;
+  renderer.volume(volume);
+  dray::Framebuffer fb = renderer.render(camera);
+  samples_taken = volume->samples_taken();
+  return fb.colors();
+}
+
+// mean absolute difference over all color channels
+double
+image_error(dray::Array<dray::Vec<dray::float32, 4>> &image,
+            dray::Array<dray::Vec<dray::float32, 4>> &baseline)
+{
+  const dray::Vec<dray::float32, 4> *image_ptr = image.get_host_ptr_const();
+  const dray::Vec<dray::float32, 4> *base_ptr = baseline.get_host_ptr_const();
+  const int size = image.size();
+  double error = 0.0;
+  for(int i = 0; i < size; ++i)
+  {
+    for(int c = 0; c < 4; ++c)
+    {
+      error += std::abs(double(image_ptr[i][c]) - double(base_ptr[i][c]));
+    }
+  }
+  return error / double(size * 4);
+}
+
+TEST (dray_volume_render, dray_volume_render_step_modes)
+{
+  conduit::Node data;
+  conduit::blueprint::mesh::examples::braid("hexs", 20, 20, 20, data);
+  dray::DataSet domain = dray::BlueprintLowOrder::import(data);
+  dray::Collection dataset;
+  dataset.add_domain(domain);
+
+  dray::int64 baseline_samples, coarse_samples, preint_samples;
+  dray::int64 fixed_samples, adaptive_samples;
+
+  // a fixed step fine enough to resolve the band
+  dray::Array<dray::Vec<dray::float32, 4>> baseline
+    = render_braid_band(dataset, 2000, false, 1.f, baseline_samples);
+
+  // coarse point samples step over the band, the preintegrated table
+  // accounts for it between samples
+  dray::Array<dray::Vec<dray::float32, 4>> coarse
+    = render_braid_band(dataset, 50, false, 1.f, coarse_samples);
+  dray::Array<dray::Vec<dray::float32, 4>> preint
+    = render_braid_band(dataset, 50, true, 1.f, preint_samples);
+  EXPECT_EQ(coarse_samples, preint_samples);
+  const double coarse_error = image_error(coarse, baseline);
+  const double preint_error = image_error(preint, baseline);
+  std::cout << "coarse error " << coarse_error
+            << " preintegrated error " << preint_error << "\n";
+  EXPECT_LT(preint_error, coarse_error);
+
+  // adaptive steps skip the transparent regions with fewer samples
+  // and stay close to the fixed step image
+  dray::Array<dray::Vec<dray::float32, 4>> fixed
+    = render_braid_band(dataset, 500, false, 1.f, fixed_samples);
+  dray::Array<dray::Vec<dray::float32, 4>> adaptive
+    = render_braid_band(dataset, 500, false, 8.f, adaptive_samples);
+  std::cout << "fixed samples " << fixed_samples
+            << " adaptive samples " << adaptive_samples << "\n";
+  EXPECT_LT(adaptive_samples, fixed_samples);
+  const double fixed_error = image_error(fixed, baseline);
+  const double adaptive_error = image_error(adaptive, baseline);
+  std::cout << "fixed error " << fixed_error
+            << " adaptive error " << adaptive_error << "\n";
+  EXPECT_LT(adaptive_error, fixed_error + 0.01);
+}
+
 TEST (dray_volume_render, dray_volume_render_simple)
 {
   if(!mfem_enabled())
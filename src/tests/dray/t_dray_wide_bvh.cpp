@@ -0,0 +1,93 @@
+// Copyright 2019 Lawrence Livermore National Security, LLC and other
+// Devil Ray Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "gtest/gtest.h"
+
+#include <dray/linear_bvh_builder.hpp>
+#include <dray/device_bvh.hpp>
+
+#include <vector>
+
+using namespace dray;
+
+TEST (dray_wide_bvh, dray_wide_bvh_collapse)
+{
+  // a small grid of unit boxes
+  const int32 dims = 6;
+  const int32 size = dims * dims * dims;
+  Array<AABB<>> aabbs;
+  aabbs.resize (size);
+  AABB<> *aabb_ptr = aabbs.get_host_ptr ();
+  for (int32 i = 0; i < size; ++i)
+  {
+    const float32 x = float32 (i % dims);
+    const float32 y = float32 ((i / dims) % dims);
+    const float32 z = float32 (i / (dims * dims));
+    AABB<> aabb;
+    aabb.include (make_vec3f (x, y, z));
+    aabb.include (make_vec3f (x + 1.f, y + 1.f, z + 1.f));
+    aabb_ptr[i] = aabb;
+  }
+
+  LinearBVHBuilder builder;
+  BVH bvh = builder.construct (aabbs);
+
+#ifdef DRAY_DEVICE_ENABLED
+  // the wide layout is only built for host execution
+  ASSERT_EQ (bvh.m_wide.m_nodes.size (), 0);
+#else
+  constexpr int32 width = WideBVH::width;
+  const int32 num_nodes = bvh.m_wide.m_children.size () / width;
+  ASSERT_GT (num_nodes, 0);
+  ASSERT_EQ (bvh.m_wide.m_nodes.size (), num_nodes * WideBVH::node_stride);
+
+  // every leaf must be reachable exactly once
+  const int32 *children = bvh.m_wide.m_children.get_host_ptr_const ();
+  std::vector<int32> leaf_count (bvh.m_leaf_nodes.size (), 0);
+  for (int32 i = 0; i < num_nodes * width; ++i)
+  {
+    if (children[i] == WideBVH::empty_child) continue;
+    if (children[i] < 0)
+    {
+      leaf_count[-children[i] - 1]++;
+    }
+  }
+  for (size_t i = 0; i < leaf_count.size (); ++i)
+  {
+    EXPECT_EQ (leaf_count[i], 1);
+  }
+
+  // point queries should find exactly the leaves containing the point
+  DeviceWideBVH wide (bvh.m_wide);
+  const int32 *leaf_ptr = bvh.m_leaf_nodes.get_host_ptr_const ();
+  const Vec<float32, 3> point = make_vec3f (2.5f, 3.5f, 4.5f);
+  const int32 expected = 2 + 3 * dims + 4 * dims * dims;
+
+  int32 found = 0;
+  std::vector<int32> todo (1, 0);
+  while (!todo.empty ())
+  {
+    const int32 node = todo.back ();
+    todo.pop_back ();
+    int32 hit[width];
+    wide.contains (node, point, hit);
+    for (int32 c = 0; c < width; ++c)
+    {
+      if (!hit[c]) continue;
+      const int32 child = wide.child (node, c);
+      if (child >= 0)
+      {
+        todo.push_back (child);
+      }
+      else
+      {
+        EXPECT_EQ (leaf_ptr[-child - 1], expected);
+        found++;
+      }
+    }
+  }
+  EXPECT_EQ (found, 1);
+#endif
+}
@@ -19,6 +19,8 @@
 #include <flow_python_interpreter.hpp>
 
 
+#include <sstream>
+
 #include "t_config.hpp"
 
 using namespace std;
@@ -104,8 +106,49 @@ TEST(flow_py_interp_exe, flow_python_interpreter_bad_file)
 
 }
 
+//-----------------------------------------------------------------------------
+TEST(flow_py_interp_exe, flow_python_interpreter_script_cache)
+{
+    PythonInterpreter py_interp;
 
+    EXPECT_TRUE(py_interp.initialize());
+    PyObject *py_dict = py_interp.global_dict();
+
+    py_interp.set_script_cache_capacity(2);
+    EXPECT_EQ(py_interp.script_cache_capacity(),2);
+
+    EXPECT_TRUE(py_interp.run_cached_script("a = 1",py_dict));
+    EXPECT_TRUE(py_interp.run_cached_script("a = a + 1",py_dict));
+    // a hit does not add an entry
+    EXPECT_TRUE(py_interp.run_cached_script("a = 1",py_dict));
+    EXPECT_EQ(py_interp.script_cache_size(),2);
+
+    // a new script evicts the least recently used one, "a = a + 1"
+    EXPECT_TRUE(py_interp.run_cached_script("b = a * 10",py_dict));
+    EXPECT_EQ(py_interp.script_cache_size(),2);
+
+    // generated sources stay bounded
+    for(int i = 0; i < 10; ++i)
+    {
+        std::ostringstream oss;
+        oss << "c = " << i;
+        EXPECT_TRUE(py_interp.run_cached_script(oss.str(),py_dict));
+        EXPECT_TRUE(py_interp.script_cache_size() <= 2);
+    }
+
+    // evicted scripts still run correctly when they come back
+    EXPECT_TRUE(py_interp.run_cached_script("a = 1",py_dict));
+    EXPECT_TRUE(py_interp.run_cached_script("a = a + 1",py_dict));
+    int a_cpp = 0;
+    EXPECT_TRUE(PythonInterpreter::PyObject_to_int(py_interp.get_global_object("a"),a_cpp));
+    EXPECT_EQ(a_cpp,2);
+
+    // shrinking the capacity drops entries right away
+    py_interp.set_script_cache_capacity(1);
+    EXPECT_EQ(py_interp.script_cache_size(),1);
 
+    py_interp.reset();
+    EXPECT_EQ(py_interp.script_cache_size(),0);
 
-
-
+    py_interp.shutdown();
+}
@@ -0,0 +1,217 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) Lawrence Livermore National Security, LLC and other Ascent
+// Project developers. See top-level LICENSE AND COPYRIGHT files for dates and
+// other details. No copyright assignment is required to contribute to Ascent.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: t_flow_trace.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "gtest/gtest.h"
+
+#include <flow.hpp>
+
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "t_config.hpp"
+#include "t_utils.hpp"
+
+
+using namespace std;
+using namespace conduit;
+using namespace flow;
+
+
+//-----------------------------------------------------------------------------
+TEST(flow_trace, disabled_is_noop)
+{
+    Trace::enable(false);
+    Trace::clear();
+    Trace::begin("a");
+    Trace::value("v", 1.0);
+    Trace::end();
+
+    Node summary;
+    Trace::summary(summary);
+    EXPECT_EQ(summary.number_of_children(), 0);
+}
+
+//-----------------------------------------------------------------------------
+TEST(flow_trace, nested_regions)
+{
+    Trace::set_capacity(1024);
+    Trace::enable(true);
+    for(int i = 0; i < 3; ++i)
+    {
+        TraceRegion outer("outer");
+        {
+            TraceRegion inner("inner");
+            Trace::value("iteration", i);
+            Trace::text("note", "inner");
+        }
+    }
+    // unbalanced end is ignored
+    Trace::end();
+    Trace::enable(false);
+
+    Node summary;
+    Trace::summary(summary);
+    summary.print();
+
+    EXPECT_TRUE(summary.has_child("outer"));
+    EXPECT_TRUE(summary.has_child("outer/inner"));
+    EXPECT_EQ(summary.child("outer")["count"].to_int64(), 3);
+    EXPECT_EQ(summary.child("outer/inner")["count"].to_int64(), 3);
+    EXPECT_LE(summary.child("outer/inner")["min"].to_float64(),
+              summary.child("outer/inner")["max"].to_float64());
+    EXPECT_LE(summary.child("outer/inner")["total"].to_float64(),
+              summary.child("outer")["total"].to_float64());
+    EXPECT_EQ(Trace::dropped(), 0);
+}
+
+//-----------------------------------------------------------------------------
+TEST(flow_trace, threads)
+{
+    Trace::set_capacity(1 << 16);
+    Trace::enable(true);
+
+    const int num_threads = 4;
+    const int num_regions = 100;
+    std::vector<std::thread> threads;
+    for(int t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([num_regions]()
+        {
+            for(int i = 0; i < num_regions; ++i)
+            {
+                TraceRegion region("work");
+            }
+        });
+    }
+    for(auto &thread : threads)
+    {
+        thread.join();
+    }
+    Trace::enable(false);
+
+    Node summary;
+    Trace::summary(summary);
+    EXPECT_EQ(summary.child("work")["count"].to_int64(),
+              num_threads * num_regions);
+}
+
+//-----------------------------------------------------------------------------
+TEST(flow_trace, wrap_and_chrome_export)
+{
+    string output_path = prepare_output_dir();
+    string output_file = conduit::utils::join_file_path(output_path,
+                                                        "tout_flow_trace.json");
+    remove_test_file(output_file);
+
+    // smaller than the number of events, the oldest are overwritten.
+    // with an odd size the oldest surviving event is an end
+    Trace::set_capacity(15);
+    Trace::set_rank(0);
+    Trace::enable(true);
+    for(int i = 0; i < 20; ++i)
+    {
+        TraceRegion region("step \"quoted\"");
+    }
+    Trace::enable(false);
+
+    EXPECT_EQ(Trace::dropped(), 40 - 15);
+
+    // the statistics don't depend on the buffer
+    Node summary;
+    Trace::summary(summary);
+    EXPECT_EQ(summary.child("step \"quoted\"")["count"].to_int64(), 20);
+
+    Trace::write_chrome_trace(output_file);
+    EXPECT_TRUE(conduit::utils::is_file(output_file));
+
+    Node trace;
+    trace.load(output_file, "json");
+    // process name metadata + the surviving events, less the end whose
+    // begin was overwritten
+    EXPECT_EQ(trace["traceEvents"].number_of_children(), 1 + 15 - 1);
+    EXPECT_EQ(trace["otherData/dropped"].to_int64(), 40 - 15);
+
+    // every end has a begin
+    int depth = 0;
+    NodeConstIterator itr = trace["traceEvents"].children();
+    while(itr.has_next())
+    {
+        const std::string ph = itr.next()["ph"].as_string();
+        if(ph == "B")
+        {
+            depth++;
+        }
+        else if(ph == "E")
+        {
+            depth--;
+            EXPECT_GE(depth, 0);
+        }
+    }
+    EXPECT_EQ(depth, 0);
+
+    Trace::clear();
+    Trace::set_capacity(1 << 20);
+}
+
+//-----------------------------------------------------------------------------
+TEST(flow_trace, shared_users)
+{
+    Trace::acquire(64);
+    const index_t session = Trace::sessions();
+    EXPECT_TRUE(Trace::enabled());
+    EXPECT_EQ(Trace::capacity(), 64);
+    {
+        TraceRegion region("first");
+    }
+
+    // a second user joins the running trace, it doesn't resize or clear it
+    Trace::acquire(128);
+    EXPECT_EQ(Trace::capacity(), 64);
+    EXPECT_EQ(Trace::sessions(), session);
+    {
+        TraceRegion region("second");
+    }
+
+    // resizing while recording is ignored
+    Trace::set_capacity(8);
+    EXPECT_EQ(Trace::capacity(), 64);
+
+    // the first release keeps recording
+    EXPECT_FALSE(Trace::release());
+    EXPECT_TRUE(Trace::enabled());
+    {
+        TraceRegion region("third");
+    }
+
+    // the last release stops it, nothing was lost
+    EXPECT_TRUE(Trace::release());
+    EXPECT_FALSE(Trace::enabled());
+    EXPECT_FALSE(Trace::release());
+
+    Node summary;
+    Trace::summary(summary);
+    EXPECT_TRUE(summary.has_child("first"));
+    EXPECT_TRUE(summary.has_child("second"));
+    EXPECT_TRUE(summary.has_child("third"));
+
+    // the next acquire starts a new, empty trace
+    Trace::acquire(32);
+    EXPECT_EQ(Trace::sessions(), session + 1);
+    EXPECT_EQ(Trace::capacity(), 32);
+    Trace::summary(summary);
+    EXPECT_EQ(summary.number_of_children(), 0);
+    EXPECT_TRUE(Trace::release());
+
+    Trace::clear();
+    Trace::set_capacity(1 << 20);
+}
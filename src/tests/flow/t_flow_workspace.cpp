@@ -15,6 +15,7 @@
 #include <flow.hpp>
 #include <flow_builtin_filters.hpp>
 
+#include <algorithm>
 #include <iostream>
 #include <math.h>
 
@@ -199,6 +200,59 @@ TEST(ascent_flow_workspace, linear_graph)
     Workspace::clear_supported_filter_types();
 }
 
+//-----------------------------------------------------------------------------
+// fake probe: every sample looks like another 100 bytes were allocated
+static size_t test_probe_allocated = 0;
+
+void
+test_memory_probe(bool reset_peak, MemoryUsage &usage)
+{
+    test_probe_allocated += 100;
+    usage.allocated      = test_probe_allocated;
+    usage.host_current   = 10;
+    usage.host_peak      = 20;
+    usage.device_current = 0;
+    usage.device_peak    = 0;
+    (void) reset_peak;
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_flow_workspace, linear_graph_memory_info)
+{
+    Workspace::register_filter_type<SrcFilter>();
+    Workspace::register_filter_type<IncFilter>();
+
+    Workspace w;
+    w.graph().add_filter("src","s");
+    w.graph().add_filter("inc","a");
+    w.graph().connect("s","a","in");
+
+    // nothing is recorded unless enabled
+    Workspace::set_memory_probe(test_memory_probe);
+    w.execute();
+    EXPECT_EQ(w.memory_info(), "");
+    w.registry().consume("a");
+
+    w.reset_memory_info();
+    w.enable_memory_info(true);
+    w.execute();
+    w.registry().consume("a");
+
+    std::string mem_info = w.memory_info();
+    ASCENT_INFO(mem_info);
+    // one line per filter plus the total
+    EXPECT_EQ(std::count(mem_info.begin(), mem_info.end(), '\n'), 3);
+    EXPECT_NE(mem_info.find("0 s 100 20 0 10 0"), std::string::npos);
+    EXPECT_NE(mem_info.find("[total]"), std::string::npos);
+
+    Node last;
+    w.last_memory_usage(last);
+    EXPECT_EQ(last["host_peak"].to_uint64(), 20);
+
+    Workspace::set_memory_probe(NULL);
+    Workspace::clear_supported_filter_types();
+}
+
 //-----------------------------------------------------------------------------
 TEST(ascent_flow_workspace, linear_graph_using_filter_ptr_iface)
 {
@@ -9,6 +9,7 @@
 #include <vtkh/vtkh.hpp>
 #include <vtkh/DataSet.hpp>
 #include <vtkh/filters/GhostStripper.hpp>
+#include <vtkh/filters/Histogram.hpp>
 #include <vtkh/rendering/RayTracer.hpp>
 #include <vtkh/rendering/Scene.hpp>
 
@@ -108,3 +109,105 @@ TEST(vtkh_ghost_stripper, vtkh_ghost_stripper_no_strip)
   assert(before_cells == after_cells);
   delete stripped_output;
 }
+
+//----------------------------------------------------------------------------
+TEST(vtkh_ghost_stripper, vtkh_ghost_stripper_cached_extents)
+{
+#ifdef VTKM_ENABLE_KOKKOS
+  vtkh::InitializeKokkos();
+#endif
+  vtkh::DataSet data_set;
+
+  const int base_size = 32;
+  const int num_blocks = 2;
+
+  for(int i = 0; i < num_blocks; ++i)
+  {
+    data_set.AddDomain(CreateTestData(i, num_blocks, base_size), i);
+  }
+
+  vtkh::GhostStripper::ClearCache();
+
+  // the first pass computes the extents, the second one
+  // reuses them and has to produce the same result
+  vtkm::Id cells[2];
+  vtkm::Bounds bounds[2];
+  for(int pass = 0; pass < 2; ++pass)
+  {
+    vtkh::GhostStripper stripper;
+    stripper.SetInput(&data_set);
+    stripper.SetField("ghosts");
+    stripper.AddMapField("point_data_Float64");
+    stripper.Update();
+
+    vtkh::DataSet *stripped_output = stripper.GetOutput();
+    cells[pass] = stripped_output->GetNumberOfCells();
+    bounds[pass] = stripped_output->GetGlobalBounds();
+    delete stripped_output;
+  }
+
+  EXPECT_EQ(cells[0], cells[1]);
+  EXPECT_TRUE(bounds[0] == bounds[1]);
+  vtkh::GhostStripper::ClearCache();
+}
+
+//----------------------------------------------------------------------------
+TEST(vtkh_ghost_stripper, vtkh_histogram_ghost_mask)
+{
+#ifdef VTKM_ENABLE_KOKKOS
+  vtkh::InitializeKokkos();
+#endif
+  vtkh::DataSet data_set;
+
+  const int base_size = 16;
+  const int num_blocks = 2;
+
+  for(int i = 0; i < num_blocks; ++i)
+  {
+    data_set.AddDomain(CreateTestData(i, num_blocks, base_size), i);
+  }
+
+  const std::string field = "cell_data_Float64";
+  const vtkm::Range range = data_set.GetGlobalRange(field).ReadPortal().Get(0);
+  const int num_bins = 32;
+
+  // masking the ghosts has to count exactly the zones
+  // that are left after stripping them
+  vtkh::Histogram masked;
+  masked.SetNumBins(num_bins);
+  masked.SetRange(range);
+  masked.SetGhostField("ghosts");
+  vtkh::Histogram::HistogramResult masked_res = masked.Run(data_set, field);
+
+  vtkh::GhostStripper stripper;
+  stripper.SetInput(&data_set);
+  stripper.SetField("ghosts");
+  stripper.AddMapField(field);
+  stripper.Update();
+  vtkh::DataSet *stripped_output = stripper.GetOutput();
+
+  vtkh::Histogram stripped;
+  stripped.SetNumBins(num_bins);
+  stripped.SetRange(range);
+  vtkh::Histogram::HistogramResult stripped_res = stripped.Run(*stripped_output, field);
+
+  vtkh::Histogram all;
+  all.SetNumBins(num_bins);
+  all.SetRange(range);
+  vtkh::Histogram::HistogramResult all_res = all.Run(data_set, field);
+
+  ASSERT_EQ(masked_res.m_bins.GetNumberOfValues(), num_bins);
+  ASSERT_EQ(stripped_res.m_bins.GetNumberOfValues(), num_bins);
+  auto masked_bins = masked_res.m_bins.ReadPortal();
+  auto stripped_bins = stripped_res.m_bins.ReadPortal();
+  for(int i = 0; i < num_bins; ++i)
+  {
+    EXPECT_EQ(masked_bins.Get(i), stripped_bins.Get(i));
+  }
+  EXPECT_EQ(masked_res.totalCount(), stripped_output->GetNumberOfCells());
+  // without the mask the ghost zones are counted
+  EXPECT_EQ(all_res.totalCount(), data_set.GetNumberOfCells());
+  EXPECT_LT(masked_res.totalCount(), all_res.totalCount());
+
+  delete stripped_output;
+}
@@ -100,6 +100,12 @@ TEST(vtkh_iso_volume, vtkh_iso_volume_empty)
 
   vtkh::DataSet *iso_output = iso.GetOutput();
 
+  // the culled domain is still there, just empty
+  EXPECT_EQ(iso_output->GetNumberOfDomains(), num_blocks);
+  EXPECT_EQ(iso_output->GetGlobalNumberOfCells(), 0);
+  EXPECT_TRUE(iso_output->GlobalFieldExists("point_data_Float64"));
+  EXPECT_TRUE(iso_output->GlobalFieldExists("cell_data_Float64"));
+
   vtkm::Bounds bounds = iso_output->GetGlobalBounds();
 
   vtkm::rendering::Camera camera;
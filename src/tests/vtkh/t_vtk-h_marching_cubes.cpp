@@ -8,6 +8,7 @@
 
 #include <vtkh/vtkh.hpp>
 #include <vtkh/DataSet.hpp>
+#include <vtkh/filters/BlockRanges.hpp>
 #include <vtkh/filters/MarchingCubes.hpp>
 #include <vtkh/rendering/RayTracer.hpp>
 #include <vtkh/rendering/Scene.hpp>
@@ -175,3 +176,78 @@ TEST(vtkh_marching_cubes, vtkh_marching_cubes_recenter)
 
   delete iso_output;
 }
+
+//----------------------------------------------------------------------------
+TEST(vtkh_marching_cubes, vtkh_block_ranges)
+{
+#ifdef VTKM_ENABLE_KOKKOS
+  vtkh::InitializeKokkos();
+#endif
+  const int base_size = 32;
+  vtkm::cont::DataSet dom = CreateTestData(0, 1, base_size);
+  vtkh::BlockRanges::ClearCache();
+
+  // the field is the distance from the origin + 1
+  auto ranges = vtkh::BlockRanges::Get(dom, 0, "point_data_Float64");
+  EXPECT_TRUE(ranges->IsStructured());
+  EXPECT_EQ(ranges->GetNumberOfBlocks(), 8);
+  EXPECT_NEAR(ranges->GetRange().Min, 1., 1e-6);
+
+  // same data, same pyramid
+  EXPECT_EQ(ranges, vtkh::BlockRanges::Get(dom, 0, "point_data_Float64"));
+
+  // only the block at the origin reaches below 1.5
+  std::vector<vtkm::Range> intervals = {vtkm::Range(1.5, 1.5)};
+  vtkm::cont::DataSet culled;
+  EXPECT_TRUE(vtkh::BlockRanges::Cull(dom, 0, "point_data_Float64",
+                                      intervals, true, culled));
+  EXPECT_EQ(culled.GetNumberOfCells(), 16 * 16 * 16);
+  EXPECT_TRUE(culled.HasField("cell_data_Float64"));
+
+  // nothing reaches 1000
+  intervals[0] = vtkm::Range(1000., 1000.);
+  EXPECT_FALSE(vtkh::BlockRanges::Cull(dom, 0, "point_data_Float64",
+                                       intervals, true, culled));
+
+  vtkh::DataSet data_set;
+  data_set.AddDomain(dom, 0);
+  vtkh::MarchingCubes marcher;
+  marcher.SetInput(&data_set);
+  marcher.SetField("point_data_Float64");
+  marcher.SetIsoValue(1000.);
+  marcher.Update();
+
+  // the culled domain is emitted empty, with its fields
+  vtkh::DataSet *iso_output = marcher.GetOutput();
+  EXPECT_EQ(iso_output->GetGlobalNumberOfCells(), 0);
+  EXPECT_EQ(iso_output->GetNumberOfDomains(), 1);
+  EXPECT_TRUE(iso_output->GlobalFieldExists("cell_data_Float64"));
+  delete iso_output;
+
+  vtkh::BlockRanges::ClearCache();
+}
+
+//----------------------------------------------------------------------------
+TEST(vtkh_marching_cubes, vtkh_shared_points)
+{
+#ifdef VTKM_ENABLE_KOKKOS
+  vtkh::InitializeKokkos();
+#endif
+  vtkh::DataSet data_set;
+  data_set.AddDomain(CreateTestData(0, 1, 32), 0);
+
+  vtkh::MarchingCubes marcher;
+  marcher.SetInput(&data_set);
+  marcher.SetField("point_data_Float64");
+  marcher.SetIsoValue(20.);
+  marcher.Update();
+
+  vtkh::DataSet *iso_output = marcher.GetOutput();
+  ASSERT_EQ(iso_output->GetNumberOfDomains(), 1);
+  vtkm::cont::DataSet dom = iso_output->GetDomain(0);
+  // triangles share the points on their edges, without merging
+  // every triangle would have its own 3 points
+  EXPECT_GT(dom.GetNumberOfCells(), 0);
+  EXPECT_LT(dom.GetNumberOfPoints(), dom.GetNumberOfCells());
+  delete iso_output;
+}
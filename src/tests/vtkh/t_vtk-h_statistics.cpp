@@ -0,0 +1,100 @@
+//-----------------------------------------------------------------------------
+///
+/// file: t_vtk-h_statistics.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "gtest/gtest.h"
+
+#include <vtkh/vtkh.hpp>
+#include <vtkh/DataSet.hpp>
+#include <vtkh/filters/Statistics.hpp>
+#include <vtkh/utils/QuantileSketch.hpp>
+#include "t_vtkm_test_utils.hpp"
+
+#include <cmath>
+#include <iostream>
+
+//----------------------------------------------------------------------------
+TEST(vtkh_statistics, vtkh_quantile_sketch)
+{
+  const int size = 100000;
+  // build two halves separately to exercise merging
+  vtkh::QuantileSketch a, b;
+  for(int i = 0; i < size; ++i)
+  {
+    // shuffle the insertion order a bit
+    const double value = double((i * 7919) % size);
+    if(i % 2 == 0)
+    {
+      a.Insert(value);
+    }
+    else
+    {
+      b.Insert(value);
+    }
+  }
+
+  std::vector<double> buffer;
+  b.Serialize(buffer);
+  vtkh::QuantileSketch c;
+  EXPECT_EQ(c.Deserialize(buffer.data()), buffer.size());
+  a.Merge(c);
+
+  EXPECT_EQ(a.Count(), static_cast<std::uint64_t>(size));
+  for(int p = 1; p < 100; ++p)
+  {
+    const double q = p / 100.;
+    // default k keeps the rank error under 1%
+    EXPECT_NEAR(a.Quantile(q), q * size, 0.01 * size);
+  }
+
+  // the merged sketch stays small
+  buffer.clear();
+  a.Serialize(buffer);
+  EXPECT_LT(buffer.size(), 1000u);
+}
+
+//----------------------------------------------------------------------------
+TEST(vtkh_statistics, vtkh_multi_field_stats)
+{
+#ifdef VTKM_ENABLE_KOKKOS
+  vtkh::InitializeKokkos();
+#endif
+  vtkh::DataSet data_set;
+
+  const int base_size = 32;
+  const int num_blocks = 2;
+
+  for(int i = 0; i < num_blocks; ++i)
+  {
+    data_set.AddDomain(CreateTestData(i, num_blocks, base_size), i);
+  }
+
+  vtkh::Statistics stats;
+  stats.SetFields({"point_data_Float64", "point_data_Float32", "cell_data_Float64"});
+  stats.SetPercentiles({50.});
+  stats.SetInput(&data_set);
+  stats.Update();
+  delete stats.GetOutput();
+
+  const vtkh::Statistics::Result &res = stats.GetResult();
+  ASSERT_EQ(res.m_fields.size(), 3);
+  for(const auto &field : res.m_fields)
+  {
+    EXPECT_GT(field.m_count, 0);
+    EXPECT_LE(field.m_min, field.m_mean);
+    EXPECT_LE(field.m_mean, field.m_max);
+    ASSERT_EQ(field.m_percentiles.size(), 1);
+    EXPECT_LE(field.m_min, field.m_percentiles[0]);
+    EXPECT_LE(field.m_percentiles[0], field.m_max);
+  }
+
+  // the point fields hold the same values in different precisions
+  ASSERT_EQ(res.m_correlation.size(), 9);
+  EXPECT_NEAR(res.m_correlation[0 * 3 + 1], 1.0, 1e-5);
+  EXPECT_NEAR(res.m_covariance[0 * 3 + 0],
+              res.m_fields[0].m_sample_variance, 1e-9);
+  // point and cell fields do not share an index space
+  EXPECT_TRUE(std::isnan(res.m_correlation[0 * 3 + 2]));
+}
@@ -0,0 +1,110 @@
+//-----------------------------------------------------------------------------
+///
+/// file: t_vtk-h_temporal_accumulate.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "gtest/gtest.h"
+
+#include <vtkh/vtkh.hpp>
+#include <vtkh/DataSet.hpp>
+#include <vtkh/filters/TemporalAccumulate.hpp>
+#include "t_vtkm_test_utils.hpp"
+
+#include <vtkm/cont/ArrayCopy.h>
+
+#include <iostream>
+
+//----------------------------------------------------------------------------
+// value of the accumulated field at cycle k (1 based): k * (1 + i % 5)
+vtkm::cont::DataSet CycleData(const int cycle, const int base_size)
+{
+  vtkm::cont::DataSet dom = CreateTestData(0, 1, base_size);
+  const vtkm::Id num_cells = dom.GetNumberOfCells();
+  std::vector<vtkm::Float64> values(num_cells);
+  for(vtkm::Id i = 0; i < num_cells; ++i)
+  {
+    values[i] = double(cycle) * double(1 + i % 5);
+  }
+  dom.AddCellField("accum", values);
+  return dom;
+}
+
+//----------------------------------------------------------------------------
+TEST(vtkh_temporal_accumulate, vtkh_running_stats)
+{
+#ifdef VTKM_ENABLE_KOKKOS
+  vtkh::InitializeKokkos();
+#endif
+  const int base_size = 16;
+  const double alpha = 0.25;
+
+  auto state = std::make_shared<vtkh::TemporalAccumulate::State>();
+
+  // the output of the previous cycle, which must not change when
+  // the running state is updated again
+  vtkm::cont::ArrayHandle<vtkm::Float64> prev_mean;
+  double prev_unit_mean = 0.;
+
+  // ema of the unit series 1, 2, 3, ...
+  double unit_ema = 0.;
+  const int num_cycles = 4;
+  for(int cycle = 1; cycle <= num_cycles; ++cycle)
+  {
+    vtkh::DataSet data_set;
+    data_set.AddDomain(CycleData(cycle, base_size), 0);
+
+    vtkh::TemporalAccumulate accumulate;
+    accumulate.SetInput(&data_set);
+    accumulate.SetField("accum");
+    accumulate.SetAlpha(alpha);
+    accumulate.SetOutputs({"mean", "variance", "min", "max", "ema", "count"});
+    accumulate.SetState(state);
+    accumulate.Update();
+
+    vtkh::DataSet *output = accumulate.GetOutput();
+    vtkm::cont::DataSet &dom = output->GetDomain(0);
+
+    vtkm::cont::ArrayHandle<vtkm::Float64> mean, variance, min, max, ema, count;
+    vtkm::cont::ArrayCopyShallowIfPossible(dom.GetField("accum_mean").GetData(), mean);
+    vtkm::cont::ArrayCopyShallowIfPossible(dom.GetField("accum_variance").GetData(), variance);
+    vtkm::cont::ArrayCopyShallowIfPossible(dom.GetField("accum_min").GetData(), min);
+    vtkm::cont::ArrayCopyShallowIfPossible(dom.GetField("accum_max").GetData(), max);
+    vtkm::cont::ArrayCopyShallowIfPossible(dom.GetField("accum_ema").GetData(), ema);
+    vtkm::cont::ArrayCopyShallowIfPossible(dom.GetField("accum_count").GetData(), count);
+
+    // for the series k * s, k = 1..n:
+    // mean = s (n + 1) / 2, sample variance = s^2 n (n + 1) / 12
+    const double n = cycle;
+    const double unit_mean = (n + 1.) / 2.;
+    const double unit_variance = n > 1. ? n * (n + 1.) / 12. : 0.;
+    unit_ema = cycle == 1 ? 1. : alpha * n + (1. - alpha) * unit_ema;
+
+    auto mean_portal = mean.ReadPortal();
+    const vtkm::Id size = mean.GetNumberOfValues();
+    EXPECT_EQ(size, dom.GetNumberOfCells());
+    for(vtkm::Id i = 0; i < size; ++i)
+    {
+      const double s = double(1 + i % 5);
+      EXPECT_NEAR(mean_portal.Get(i), s * unit_mean, 1e-12);
+      EXPECT_NEAR(variance.ReadPortal().Get(i), s * s * unit_variance, 1e-12);
+      EXPECT_EQ(min.ReadPortal().Get(i), s);
+      EXPECT_EQ(max.ReadPortal().Get(i), s * n);
+      EXPECT_NEAR(ema.ReadPortal().Get(i), s * unit_ema, 1e-12);
+      EXPECT_EQ(count.ReadPortal().Get(i), n);
+    }
+
+    if(cycle > 1)
+    {
+      auto prev_portal = prev_mean.ReadPortal();
+      for(vtkm::Id i = 0; i < size; ++i)
+      {
+        EXPECT_NEAR(prev_portal.Get(i), double(1 + i % 5) * prev_unit_mean, 1e-12);
+      }
+    }
+    prev_mean = mean;
+    prev_unit_mean = unit_mean;
+
+    delete output;
+  }
+}
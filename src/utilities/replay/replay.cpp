@@ -17,6 +17,8 @@
 #include <fstream>
 #include <vector>
 #include <algorithm>
+#include <future>
+#include <map>
 
 #if defined(ASCENT_REPLAY_MPI)
 #include <mpi.h>
@@ -42,11 +44,20 @@ void usage()
   std::cout<<"  --cycles  : a text file containing a list of root files, one per line.\n";
   std::cout<<"              Each file will be loaded and sent to Ascent in order.\n";
   std::cout<<"  --actions : a yaml file containing ascent actions. Default value\n";
-  std::cout<<"              is 'ascent_actions.yaml'.\n\n";
+  std::cout<<"              is 'ascent_actions.yaml'.\n";
+  std::cout<<"  --prefetch: load the next root file on a background thread while the\n";
+  std::cout<<"              current one executes. The mpi version needs MPI_THREAD_MULTIPLE\n";
+  std::cout<<"              and HDF5 must be thread safe if the actions also write HDF5.\n";
+  std::cout<<"  --bench   : publish and execute each root file N times with filter\n";
+  std::cout<<"              timings on, and write the min/median/max across ranks of\n";
+  std::cout<<"              the per rank median of each phase and filter as json.\n";
+  std::cout<<"  --bench_output : the json file written by --bench. Default value\n";
+  std::cout<<"              is 'ascent_replay_bench.json'.\n\n";
   std::cout<<"======================== Examples =========================\n";
   std::cout<<"./ascent_replay --root=clover.cycle_000060.root\n";
   std::cout<<"./ascent_replay --root=clover.cycle_000060.root --actions=my_actions.yaml\n";
   std::cout<<"srun -n 4 ascent_replay_mpi --cycles=cycles_file\n";
+  std::cout<<"srun -n 4 ascent_replay_mpi --cycles=cycles_file --prefetch --bench=5\n";
   std::cout<<"\n\n";
 }
 
@@ -55,12 +66,32 @@ struct Options
   std::string m_actions_file = "ascent_actions.yaml";
   std::string m_root_file;
   std::string m_cycles_file;
+  std::string m_bench_file = "ascent_replay_bench.json";
+  bool m_prefetch = false;
+  // number of times each cycle is executed, 0 means no benchmarking
+  int m_bench_repeats = 0;
 
   void parse(int argc, char** argv)
   {
     for(int i = 1; i < argc; ++i)
     {
-      if(contains(argv[i], "--root="))
+      if(std::string(argv[i]) == "--prefetch")
+      {
+        m_prefetch = true;
+      }
+      else if(contains(argv[i], "--bench="))
+      {
+        m_bench_repeats = atoi(get_arg(argv[i]).c_str());
+        if(m_bench_repeats < 1)
+        {
+          bad_arg(argv[i]);
+        }
+      }
+      else if(contains(argv[i], "--bench_output="))
+      {
+        m_bench_file = get_arg(argv[i]);
+      }
+      else if(contains(argv[i], "--root="))
       {
         m_root_file = get_arg(argv[i]);
       }
@@ -242,6 +273,94 @@ void load_actions(const std::string &file_name, int mpi_comm_id, conduit::Node &
 #endif
 }
 
+double median(std::vector<double> values)
+{
+  if(values.empty())
+  {
+    return 0.0;
+  }
+  std::sort(values.begin(), values.end());
+  const size_t mid = values.size() / 2;
+  if(values.size() % 2 == 0)
+  {
+    return 0.5 * (values[mid - 1] + values[mid]);
+  }
+  return values[mid];
+}
+
+// seconds of every execution of the replay phases (load, publish, execute)
+// and of every filter on this rank
+struct BenchTimings
+{
+  std::map<std::string, std::vector<double>> m_phases;
+  std::map<std::string, std::vector<double>> m_filters;
+
+  void add_phase(const std::string &name, const double seconds)
+  {
+    m_phases[name].push_back(seconds);
+  }
+
+  // info["timings/last_execute"] of an ascent instance opened with
+  // timings enabled
+  void add_execute(const conduit::Node &last_execute)
+  {
+    if(!last_execute.has_child("filters"))
+    {
+      return;
+    }
+    const conduit::Node &filters = last_execute["filters"];
+    for(conduit::index_t i = 0; i < filters.number_of_children(); ++i)
+    {
+      m_filters[filters.child(i).name()].push_back(filters.child(i).to_float64());
+    }
+  }
+
+  // the median over the executions of each phase and filter
+  void medians(conduit::Node &out) const
+  {
+    out.reset();
+    for(const auto &phase : m_phases)
+    {
+      out["phases"].add_child(phase.first) = median(phase.second);
+    }
+    for(const auto &filter : m_filters)
+    {
+      out["filters"].add_child(filter.first) = median(filter.second);
+    }
+  }
+};
+
+// ranks is a list with the medians of every rank, out gets the min, median
+// and max across the ranks that ran each phase and filter
+void rank_statistics(const conduit::Node &ranks, conduit::Node &out)
+{
+  const std::vector<std::string> groups = {"phases", "filters"};
+  for(const std::string &group : groups)
+  {
+    std::map<std::string, std::vector<double>> values;
+    for(conduit::index_t r = 0; r < ranks.number_of_children(); ++r)
+    {
+      if(!ranks.child(r).has_child(group))
+      {
+        continue;
+      }
+      const conduit::Node &entries = ranks.child(r)[group];
+      for(conduit::index_t i = 0; i < entries.number_of_children(); ++i)
+      {
+        values[entries.child(i).name()].push_back(entries.child(i).to_float64());
+      }
+    }
+    for(auto &entry : values)
+    {
+      conduit::Node &stats = out[group].add_child(entry.first);
+      stats["min"] = *std::min_element(entry.second.begin(), entry.second.end());
+      stats["median"] = median(entry.second);
+      stats["max"] = *std::max_element(entry.second.begin(), entry.second.end());
+      stats["ranks"] = (conduit::int64) entry.second.size();
+    }
+  }
+}
+
 //---------------------------------------------------------------------------//
 int
 main(int argc, char *argv[])
@@ -275,15 +394,41 @@ main(int argc, char *argv[])
   int rank = 0;
 
 #if defined(ASCENT_REPLAY_MPI)
-  MPI_Init(NULL,NULL);
+  const bool requested_prefetch = options.m_prefetch;
+  if(options.m_prefetch)
+  {
+    // the prefetch thread loads with its own communicator while the main
+    // thread executes
+    int provided = MPI_THREAD_SINGLE;
+    MPI_Init_thread(NULL, NULL, MPI_THREAD_MULTIPLE, &provided);
+    if(provided < MPI_THREAD_MULTIPLE)
+    {
+      options.m_prefetch = false;
+    }
+  }
+  else
+  {
+    MPI_Init(NULL,NULL);
+  }
   MPI_Comm_size(MPI_COMM_WORLD, &comm_size);
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm load_comm;
+  MPI_Comm_dup(MPI_COMM_WORLD, &load_comm);
+  if(requested_prefetch && !options.m_prefetch && rank == 0)
+  {
+    std::cout<<"MPI_THREAD_MULTIPLE is not available, prefetch disabled\n";
+  }
 #endif
 
-  conduit::Node replay_data;
-  //replay_data.print();
+  const bool bench = options.m_bench_repeats > 0;
+  const int repeats = bench ? options.m_bench_repeats : 1;
+
   conduit::Node ascent_opts;
   ascent_opts["ascent_info"] = "verbose";
+  if(bench)
+  {
+    ascent_opts["timings"] = "true";
+  }
 #if defined(ASCENT_REPLAY_MPI)
   ascent_opts["mpi_comm"] = MPI_Comm_c2f(MPI_COMM_WORLD);
 #endif
@@ -298,7 +443,23 @@ main(int argc, char *argv[])
   ascent::Ascent ascent;
   ascent.open(ascent_opts);
 
-  for(int i = 0; i < time_steps.size(); ++i)
+  auto load_mesh = [&](const size_t index, conduit::Node &data)
+  {
+#if defined(ASCENT_REPLAY_MPI)
+    conduit::relay::mpi::io::blueprint::load_mesh(time_steps[index],data,load_comm);
+#else
+    conduit::relay::io::blueprint::load_mesh(time_steps[index],data);
+#endif
+  };
+
+  // ascent keeps pointers to the published data until the next publish,
+  // so the next cycle is loaded into a second buffer once that happened
+  conduit::Node replay_data;
+  conduit::Node prefetch_data;
+  std::future<void> prefetch;
+  BenchTimings timings;
+
+  for(size_t i = 0; i < time_steps.size(); ++i)
   {
     if(rank == 0)
     {
@@ -306,42 +467,106 @@ main(int argc, char *argv[])
     }
     flow::Timer load;
 
-#if defined(ASCENT_REPLAY_MPI)
-    MPI_Comm comm  = MPI_Comm_f2c(ascent_opts["mpi_comm"].to_int());
-    conduit::relay::mpi::io::blueprint::load_mesh(time_steps[i],replay_data,comm);
-#else
-    conduit::relay::io::blueprint::load_mesh(time_steps[i],replay_data);
-#endif
+    if(prefetch.valid())
+    {
+      // rethrows anything the load threw
+      prefetch.get();
+      replay_data.swap(prefetch_data);
+    }
+    else
+    {
+      load_mesh(i, replay_data);
+    }
 
 #if defined(ASCENT_REPLAY_MPI)
     MPI_Barrier(MPI_COMM_WORLD);
 #endif
+    // with prefetch, this is only the time not hidden behind the
+    // previous execute
     float load_time = load.elapsed();
+    timings.add_phase("load", load_time);
 
-    flow::Timer publish;
-    ascent.publish(replay_data);
+    for(int r = 0; r < repeats; ++r)
+    {
+      flow::Timer publish;
+      ascent.publish(replay_data);
 #if defined(ASCENT_REPLAY_MPI)
-    MPI_Barrier(MPI_COMM_WORLD);
+      MPI_Barrier(MPI_COMM_WORLD);
 #endif
-    float publish_time = publish.elapsed();
+      float publish_time = publish.elapsed();
 
-    flow::Timer execute;
-    ascent.execute(actions);
+      // ascent let go of the previous cycle, its buffer can be reused
+      if(r == 0 && options.m_prefetch && i + 1 < time_steps.size())
+      {
+        prefetch = std::async(std::launch::async,
+                              load_mesh,
+                              i + 1,
+                              std::ref(prefetch_data));
+      }
+
+      flow::Timer execute;
+      ascent.execute(actions);
 #if defined(ASCENT_REPLAY_MPI)
-    MPI_Barrier(MPI_COMM_WORLD);
+      MPI_Barrier(MPI_COMM_WORLD);
+#endif
+      float execute_time = execute.elapsed();
+
+      timings.add_phase("publish", publish_time);
+      timings.add_phase("execute", execute_time);
+      if(bench)
+      {
+        conduit::Node info;
+        ascent.info(info);
+        if(info.has_path("timings/last_execute"))
+        {
+          timings.add_execute(info["timings/last_execute"]);
+        }
+      }
+
+      if(rank == 0)
+      {
+        std::string label = "[" + std::to_string(i) + "]";
+        if(bench)
+        {
+          label += "[" + std::to_string(r) + "]";
+        }
+        if(r == 0)
+        {
+          std::cout<< label << ": Load -----: "<<load_time<<"\n";
+        }
+        std::cout<< label << ": Publish --: "<<publish_time<<"\n";
+        std::cout<< label << ": Execute --: "<<execute_time<<"\n";
+      }
+    }
+  }
+
+  if(bench)
+  {
+    conduit::Node local;
+    timings.medians(local);
+    conduit::Node all_ranks;
+#if defined(ASCENT_REPLAY_MPI)
+    conduit::relay::mpi::gather_using_schema(local, all_ranks, 0, MPI_COMM_WORLD);
+#else
+    all_ranks.append().set(local);
 #endif
-    float execute_time = execute.elapsed();
     if(rank == 0)
     {
-      std::cout<< "[" << i << "]: Load -----: "<<load_time<<"\n";
-      std::cout<< "[" << i << "]: Publish --: "<<publish_time<<"\n";
-      std::cout<< "[" << i << "]: Execute --: "<<execute_time<<"\n";
+      conduit::Node report;
+      report["ranks"] = comm_size;
+      report["cycles"] = (int) time_steps.size();
+      report["repeats"] = repeats;
+      report["prefetch"] = options.m_prefetch ? "true" : "false";
+      rank_statistics(all_ranks, report);
+      report.save(options.m_bench_file, "json");
+      std::cout<<"Benchmark results written to "<<options.m_bench_file<<"\n";
     }
   }
 
   ascent.close();
 
 #if defined(ASCENT_REPLAY_MPI)
+  MPI_Comm_free(&load_comm);
   MPI_Finalize();
 #endif
   return 0;